@@ -0,0 +1,102 @@
+#pragma once
+
+// Host microbenchmark harness for env:bench_native (bench/README.md).
+//
+// A case is a callable run(n) that performs its operation n times. Runner::run sizes n so one
+// repetition takes about Options::min_ms, times Options::reps repetitions and keeps the
+// fastest; heap allocations are counted over all of them. Results are printed as a table and,
+// on request, written as a baseline that a later run compares against.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace naviga {
+namespace bench {
+
+/** operator new calls so far in this process (counted by bench_main.cpp). */
+uint64_t allocation_count();
+
+/** Keep v, and the stores that produced it, from being optimized away. GCC/Clang only. */
+template <typename T>
+inline void keep(const T& v) {
+  asm volatile("" : : "g"(&v) : "memory");
+}
+
+struct Result {
+  char name[48];
+  double ns_per_op;
+  double allocs_per_op;
+  uint64_t iterations;  ///< Operations per timed repetition.
+};
+
+struct Options {
+  uint32_t min_ms = 50;          ///< Target duration of one timed repetition.
+  uint32_t reps = 5;             ///< Timed repetitions; the fastest is reported.
+  const char* filter = nullptr;  ///< Run only cases whose name contains this; nullptr = all.
+};
+
+class Runner {
+ public:
+  static constexpr size_t kMaxResults = 64;
+
+  explicit Runner(const Options& opt) : opt_(opt) {}
+
+  /** Measure run(n). False if the case is filtered out or the result table is full. */
+  template <typename Fn>
+  bool run(const char* name, Fn run) {
+    if ((opt_.filter && !std::strstr(name, opt_.filter)) || count_ >= kMaxResults) {
+      return false;
+    }
+    // Grow n until one pass is long enough to scale from, then aim at min_ms.
+    uint64_t n = 1;
+    double ns = elapsed_ns(run, n);
+    while (ns < 1e6 && n < (1ull << 40)) {
+      n *= 4;
+      ns = elapsed_ns(run, n);
+    }
+    const double target_ns = static_cast<double>(opt_.min_ms) * 1e6;
+    if (ns < target_ns) {
+      n = static_cast<uint64_t>(static_cast<double>(n) * target_ns / ns) + 1;
+    }
+
+    const uint64_t allocs_before = allocation_count();
+    double best = 0;
+    for (uint32_t r = 0; r < opt_.reps; ++r) {
+      const double t = elapsed_ns(run, n);
+      if (r == 0 || t < best) {
+        best = t;
+      }
+    }
+    const uint64_t allocs = allocation_count() - allocs_before;
+
+    Result& res = results_[count_++];
+    std::snprintf(res.name, sizeof(res.name), "%s", name);
+    res.ns_per_op = best / static_cast<double>(n);
+    res.allocs_per_op = static_cast<double>(allocs) / (static_cast<double>(n) * opt_.reps);
+    res.iterations = n;
+    return true;
+  }
+
+  size_t count() const { return count_; }
+  const Result& result(size_t i) const { return results_[i]; }
+
+ private:
+  template <typename Fn>
+  static double elapsed_ns(Fn& run, uint64_t n) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    run(n);
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+
+  Options opt_;
+  Result results_[kMaxResults] = {};
+  size_t count_ = 0;
+};
+
+} // namespace bench
+} // namespace naviga
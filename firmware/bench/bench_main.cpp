@@ -0,0 +1,778 @@
+// Native codec / RX-path microbenchmarks: pio run -e bench_native, then
+//   .pio/build/bench_native/program [--filter=pos_full] [--json=bench.json] [--compare=base.json]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "bench.h"
+#include "domain/beacon_logic.h"
+#include "domain/node_table.h"
+#include "services/gnss_ublox_service.h"
+#include "services/ubx_nav_pvt_parser.h"
+#include "../protocol/alive_codec.h"
+#include "../protocol/ble_node_table_bridge.h"
+#include "../protocol/bundle_codec.h"
+#include "../protocol/fec_codec.h"
+#include "../protocol/geo_beacon_codec.h"
+#include "../protocol/geo_u24.h"
+#include "../protocol/info_codec.h"
+#include "../protocol/packet_header.h"
+#include "../protocol/pos_delta_codec.h"
+#include "../protocol/pos_full_codec.h"
+#include "../protocol/short_addr_codec.h"
+#include "../protocol/status_codec.h"
+#include "../protocol/tail1_codec.h"
+#include "../protocol/tail2_codec.h"
+
+namespace {
+
+uint64_t g_allocations = 0;
+
+} // namespace
+
+// Every heap allocation of the process goes through here, so allocs/op covers the code under
+// test and anything it calls.
+void* operator new(size_t size) {
+  ++g_allocations;
+  void* p = std::malloc(size ? size : 1);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+namespace naviga {
+namespace bench {
+
+uint64_t allocation_count() { return g_allocations; }
+
+} // namespace bench
+} // namespace naviga
+
+using naviga::bench::keep;
+using naviga::bench::Options;
+using naviga::bench::Result;
+using naviga::bench::Runner;
+using naviga::domain::BeaconLogic;
+using naviga::domain::NodeEntry;
+using naviga::domain::NodeTable;
+
+namespace p = naviga::protocol;
+
+namespace {
+
+constexpr uint64_t kNodeId = 0x0000AABBCCDDEEFFULL;
+constexpr uint32_t kMaxRegressPctDefault = 10;
+
+// ── Fixtures ───────────────────────────────────────────────────────────────────
+
+struct Frame {
+  uint8_t bytes[p::kMaxFrameSize];
+  size_t len;
+};
+
+p::PosFullFields pos_full_fields(uint64_t node_id, uint16_t seq16, int32_t lat_e7, int32_t lon_e7) {
+  p::PosFullFields f;
+  f.node_id = node_id;
+  f.seq16 = seq16;
+  f.lat_e7 = lat_e7;
+  f.lon_e7 = lon_e7;
+  f.fix_type = 3;
+  f.pos_sats = 11;
+  f.pos_accuracy_bucket = 2;
+  f.pos_flags_small = 1;
+  return f;
+}
+
+p::StatusFields status_fields(uint64_t node_id, uint16_t seq16) {
+  p::StatusFields f;
+  f.node_id = node_id;
+  f.seq16 = seq16;
+  f.battery_percent = 80;
+  f.battery_est_rem_time = 12;
+  f.uptime10m = 30;
+  f.role_id = 1;
+  f.max_silence_10s = 9;
+  f.hw_profile_id = 0x0102;
+  f.fw_version_id = 0x0304;
+  f.radio_caps = p::radio_caps_make(0x07, 1, false);
+  return f;
+}
+
+Frame make_pos_full(uint64_t node_id, uint16_t seq16, int32_t lat_e7, int32_t lon_e7) {
+  Frame fr;
+  fr.len = p::encode_pos_full_frame(pos_full_fields(node_id, seq16, lat_e7, lon_e7), fr.bytes,
+                                    sizeof(fr.bytes));
+  return fr;
+}
+
+Frame make_status(uint64_t node_id, uint16_t seq16) {
+  Frame fr;
+  fr.len = p::encode_status_frame(status_fields(node_id, seq16), fr.bytes, sizeof(fr.bytes));
+  return fr;
+}
+
+/**
+ * Received traffic of kTraceNodes peers moving a few metres per frame: per peer, cycles of
+ * Pos_Full, two Pos_Delta, Status, Alive, and a Pos_Full + Status bundle, seq16 advancing.
+ */
+constexpr size_t kTraceNodes = 16;
+constexpr size_t kTraceRounds = 128;
+
+std::vector<Frame> make_mixed_trace() {
+  std::vector<Frame> trace;
+  trace.reserve(kTraceNodes * kTraceRounds);
+  for (size_t round = 0; round < kTraceRounds; ++round) {
+    for (size_t n = 0; n < kTraceNodes; ++n) {
+      const uint64_t node_id = 0x0000100000000000ULL + n * 0x10101ULL;
+      // Odd seq16 per round: the bundled Status below takes the even one in between.
+      const uint16_t seq16 = static_cast<uint16_t>(2 * round + 1);
+      const int32_t lat_e7 = 557500000 + static_cast<int32_t>(n * 20000 + round * 300);
+      const int32_t lon_e7 = 376100000 + static_cast<int32_t>(n * 20000 + round * 200);
+      Frame fr;
+      switch (round % 6) {
+        case 0:
+          fr = make_pos_full(node_id, seq16, lat_e7, lon_e7);
+          break;
+        case 1:
+        case 2: {
+          p::PosDeltaFields d;
+          d.node_id = node_id;
+          d.seq16 = seq16;
+          d.ref_seq8 = static_cast<uint8_t>(seq16 - 2 * (round % 6));  // this cycle's Pos_Full
+          d.lat_lsb = static_cast<uint16_t>(p::lat_e7_to_u24(lat_e7) & p::kPosDeltaLsbMask);
+          d.lon_lsb = static_cast<uint16_t>(p::lon_e7_to_u24(lon_e7) & p::kPosDeltaLsbMask);
+          fr.len = p::encode_pos_delta_frame(d, fr.bytes, sizeof(fr.bytes));
+          break;
+        }
+        case 3:
+          fr = make_status(node_id, seq16);
+          break;
+        case 4: {
+          p::AliveFields a;
+          a.node_id = node_id;
+          a.seq = seq16;
+          fr.len = p::encode_alive_frame(a, fr.bytes, sizeof(fr.bytes));
+          break;
+        }
+        default: {
+          const Frame pos = make_pos_full(node_id, seq16, lat_e7, lon_e7);
+          const Frame st = make_status(node_id, static_cast<uint16_t>(seq16 + 1));
+          p::bundle_begin(node_id, fr.bytes, sizeof(fr.bytes), &fr.len);
+          p::bundle_append_frame(pos.bytes, pos.len, fr.bytes, sizeof(fr.bytes), &fr.len);
+          p::bundle_append_frame(st.bytes, st.len, fr.bytes, sizeof(fr.bytes), &fr.len);
+          break;
+        }
+      }
+      trace.push_back(fr);
+    }
+  }
+  return trace;
+}
+
+/** Table holding self plus `peers` remote nodes, each with a position at seq16 1. */
+void fill_table(NodeTable* table, size_t peers, uint32_t now_ms) {
+  *table = NodeTable();
+  table->init_self(kNodeId, 0);
+  for (size_t i = 0; i < peers; ++i) {
+    const Frame fr = make_pos_full(0x0000200000000000ULL + i * 0x777ULL, 1,
+                                   557500000 + static_cast<int32_t>(i * 1000), 376100000);
+    table->apply_pos_full(p::PosFullView(fr.bytes + p::kHeaderSize, fr.len - p::kHeaderSize), -70,
+                          now_ms);
+  }
+}
+
+// ── Cases ──────────────────────────────────────────────────────────────────────
+
+void bench_header(Runner& r) {
+  r.run("header/encode", [](uint64_t n) {
+    p::PacketHeader hdr;
+    hdr.msg_type = p::MsgType::BeaconPosFull;
+    uint8_t out[p::kHeaderSize];
+    for (uint64_t i = 0; i < n; ++i) {
+      hdr.payload_len = static_cast<uint8_t>(i & 0x3F);
+      keep(p::encode_header(hdr, out, sizeof(out)));
+      keep(out);
+    }
+  });
+  const Frame fr = make_pos_full(kNodeId, 1, 0, 0);
+  r.run("header/decode", [&fr](uint64_t n) {
+    p::PacketHeader hdr;
+    for (uint64_t i = 0; i < n; ++i) {
+      keep(fr);
+      keep(p::decode_header(fr.bytes, fr.len, &hdr));
+      keep(hdr);
+    }
+  });
+}
+
+/** encode: fields -> frame with seq16 varying; decode: that frame's payload -> fields. */
+template <typename Fields, typename Encode, typename Decode>
+void bench_codec(Runner& r, const char* encode_name, const char* decode_name, Fields fields,
+                 Encode encode, Decode decode) {
+  r.run(encode_name, [&fields, &encode](uint64_t n) {
+    uint8_t out[p::kMaxFrameSize];
+    for (uint64_t i = 0; i < n; ++i) {
+      fields.seq16 = static_cast<uint16_t>(i);
+      keep(fields);
+      keep(encode(fields, out, sizeof(out)));
+      keep(out);
+    }
+  });
+  Frame fr;
+  fr.len = encode(fields, fr.bytes, sizeof(fr.bytes));
+  r.run(decode_name, [&fr, &decode](uint64_t n) {
+    Fields out;
+    for (uint64_t i = 0; i < n; ++i) {
+      keep(fr);
+      keep(decode(fr.bytes + p::kHeaderSize, fr.len - p::kHeaderSize, &out));
+      keep(out);
+    }
+  });
+}
+
+void bench_codecs(Runner& r) {
+  p::AliveFields alive;
+  alive.node_id = kNodeId;
+  r.run("alive/encode", [&alive](uint64_t n) {
+    uint8_t out[p::kAliveFrameMax];
+    for (uint64_t i = 0; i < n; ++i) {
+      alive.seq = static_cast<uint16_t>(i);
+      keep(alive);
+      keep(p::encode_alive_frame(alive, out, sizeof(out)));
+      keep(out);
+    }
+  });
+  Frame alive_fr;
+  alive_fr.len = p::encode_alive_frame(alive, alive_fr.bytes, sizeof(alive_fr.bytes));
+  r.run("alive/decode", [&alive_fr](uint64_t n) {
+    p::AliveFields out;
+    for (uint64_t i = 0; i < n; ++i) {
+      keep(alive_fr);
+      keep(p::decode_alive_payload(alive_fr.bytes + p::kHeaderSize,
+                                   alive_fr.len - p::kHeaderSize, &out));
+      keep(out);
+    }
+  });
+
+  bench_codec(r, "pos_full/encode", "pos_full/decode",
+              pos_full_fields(kNodeId, 1, 557558000, 376173000), p::encode_pos_full_frame,
+              p::decode_pos_full_payload);
+  const Frame pos = make_pos_full(kNodeId, 1, 557558000, 376173000);
+  r.run("pos_full/view", [&pos](uint64_t n) {
+    for (uint64_t i = 0; i < n; ++i) {
+      keep(pos);
+      const p::PosFullView view(pos.bytes + p::kHeaderSize, pos.len - p::kHeaderSize);
+      if (view.ok()) {
+        keep(view.node_id());
+        keep(view.seq16());
+        keep(view.lat_e7());
+        keep(view.lon_e7());
+        keep(view.quality());
+      }
+    }
+  });
+
+  p::PosDeltaFields delta;
+  delta.node_id = kNodeId;
+  delta.lat_lsb = 0xABC;
+  delta.lon_lsb = 0x123;
+  bench_codec(r, "pos_delta/encode", "pos_delta/decode", delta, p::encode_pos_delta_frame,
+              p::decode_pos_delta_payload);
+  bench_codec(r, "status/encode", "status/decode", status_fields(kNodeId, 1),
+              p::encode_status_frame, p::decode_status_payload);
+
+  p::Tail1Fields t1;
+  t1.node_id = kNodeId;
+  t1.ref_core_seq16 = 7;
+  t1.has_pos_flags = true;
+  t1.pos_flags = 0x05;
+  t1.has_sats = true;
+  t1.sats = 9;
+  bench_codec(r, "tail1/encode", "tail1/decode", t1, p::encode_tail1_frame,
+              p::decode_tail1_payload);
+  p::Tail2Fields t2;
+  t2.node_id = kNodeId;
+  t2.has_battery = true;
+  t2.battery_percent = 77;
+  t2.has_uptime = true;
+  t2.uptime_sec = 3600;
+  bench_codec(r, "tail2/encode", "tail2/decode", t2, p::encode_tail2_frame,
+              p::decode_tail2_payload);
+  p::InfoFields info;
+  info.node_id = kNodeId;
+  info.has_max_silence = true;
+  info.max_silence_10s = 9;
+  info.has_hw_profile = true;
+  info.hw_profile_id = 0x0203;
+  info.has_fw_version = true;
+  info.fw_version_id = 0x0405;
+  bench_codec(r, "info/encode", "info/decode", info, p::encode_info_frame,
+              p::decode_info_payload);
+
+  p::GeoBeaconFields geo;
+  geo.node_id = kNodeId;
+  geo.pos_valid = 1;
+  geo.lat_e7 = 557558000;
+  geo.lon_e7 = 376173000;
+  r.run("geo_beacon/encode", [&geo](uint64_t n) {
+    uint8_t out[p::kMaxFrameSize];
+    for (uint64_t i = 0; i < n; ++i) {
+      geo.seq = static_cast<uint16_t>(i);
+      keep(geo);
+      keep(p::encode_geo_beacon(geo, p::ByteSpan{out, sizeof(out)}));
+      keep(out);
+    }
+  });
+  Frame geo_fr;
+  geo_fr.len = p::encode_geo_beacon(geo, p::ByteSpan{geo_fr.bytes, sizeof(geo_fr.bytes)});
+  r.run("geo_beacon/decode", [&geo_fr](uint64_t n) {
+    p::GeoBeaconFields out;
+    for (uint64_t i = 0; i < n; ++i) {
+      keep(geo_fr);
+      keep(p::decode_geo_beacon_frame(p::ConstByteSpan{geo_fr.bytes, geo_fr.len}, &out));
+      keep(out);
+    }
+  });
+
+  const Frame st = make_status(kNodeId, 2);
+  r.run("bundle/pack", [&pos, &st](uint64_t n) {
+    uint8_t out[p::kMaxFrameSize];
+    size_t len = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+      keep(pos);
+      p::bundle_begin(kNodeId, out, sizeof(out), &len);
+      p::bundle_append_frame(pos.bytes, pos.len, out, sizeof(out), &len);
+      p::bundle_append_frame(st.bytes, st.len, out, sizeof(out), &len);
+      keep(out);
+    }
+  });
+  Frame bundle;
+  p::bundle_begin(kNodeId, bundle.bytes, sizeof(bundle.bytes), &bundle.len);
+  p::bundle_append_frame(pos.bytes, pos.len, bundle.bytes, sizeof(bundle.bytes), &bundle.len);
+  p::bundle_append_frame(st.bytes, st.len, bundle.bytes, sizeof(bundle.bytes), &bundle.len);
+  r.run("bundle/unpack", [&bundle](uint64_t n) {
+    uint8_t sub[p::kMaxFrameSize];
+    for (uint64_t i = 0; i < n; ++i) {
+      keep(bundle);
+      for (size_t k = 0; p::bundle_unpack(bundle.bytes + p::kHeaderSize,
+                                          bundle.len - p::kHeaderSize, k, sub, sizeof(sub)) != 0;
+           ++k) {
+        keep(sub);
+      }
+    }
+  });
+
+  r.run("short_addr/compact", [&pos](uint64_t n) {
+    uint8_t out[p::kMaxFrameSize];
+    for (uint64_t i = 0; i < n; ++i) {
+      keep(pos);
+      keep(p::short_addr_compact(pos.bytes, pos.len, 0x1234, out, sizeof(out)));
+      keep(out);
+    }
+  });
+  Frame short_fr;
+  short_fr.len = p::short_addr_compact(pos.bytes, pos.len, 0x1234, short_fr.bytes,
+                                       sizeof(short_fr.bytes));
+  r.run("short_addr/expand", [&short_fr](uint64_t n) {
+    uint8_t out[p::kMaxFrameSize];
+    for (uint64_t i = 0; i < n; ++i) {
+      keep(short_fr);
+      keep(p::short_addr_expand(short_fr.bytes, short_fr.len, kNodeId, out, sizeof(out)));
+      keep(out);
+    }
+  });
+
+  r.run("fec/wrap", [&pos](uint64_t n) {
+    uint8_t out[p::kMaxFrameSize];
+    for (uint64_t i = 0; i < n; ++i) {
+      keep(pos);
+      keep(p::fec_wrap(pos.bytes, pos.len, 8, out, sizeof(out)));
+      keep(out);
+    }
+  });
+  Frame fec_fr;
+  fec_fr.len = p::fec_wrap(pos.bytes, pos.len, 8, fec_fr.bytes, sizeof(fec_fr.bytes));
+  r.run("fec/unwrap", [&fec_fr](uint64_t n) {
+    uint8_t out[p::kMaxFrameSize];
+    for (uint64_t i = 0; i < n; ++i) {
+      keep(fec_fr);
+      keep(p::fec_unwrap(fec_fr.bytes, fec_fr.len, out, sizeof(out)));
+      keep(out);
+    }
+  });
+  // Four corrupted bytes: the full Berlekamp-Massey / Chien / Forney path.
+  Frame fec_bad = fec_fr;
+  fec_bad.bytes[4] ^= 0x5A;
+  fec_bad.bytes[11] ^= 0x01;
+  fec_bad.bytes[17] ^= 0xFF;
+  fec_bad.bytes[fec_bad.len - 2] ^= 0x80;
+  r.run("fec/unwrap_4err", [&fec_bad](uint64_t n) {
+    uint8_t out[p::kMaxFrameSize];
+    for (uint64_t i = 0; i < n; ++i) {
+      keep(fec_bad);
+      keep(p::fec_unwrap(fec_bad.bytes, fec_bad.len, out, sizeof(out)));
+      keep(out);
+    }
+  });
+}
+
+void bench_rx(Runner& r) {
+  // The table starts over each time the trace wraps, so every pass applies the same mix of
+  // new frames; the reset is amortized over kTraceNodes * kTraceRounds operations.
+  const std::vector<Frame> trace = make_mixed_trace();
+  {
+    BeaconLogic logic;
+    NodeTable table;
+    table.init_self(kNodeId, 0);
+    size_t applied = 0;
+    for (size_t i = 0; i < trace.size(); ++i) {
+      applied += logic.on_rx(static_cast<uint32_t>(i * 50), trace[i].bytes, trace[i].len, -80,
+                             table) ? 1 : 0;
+    }
+    if (applied != trace.size()) {
+      std::fprintf(stderr, "warning: mixed trace: %u of %u frames applied\n",
+                   static_cast<unsigned>(applied), static_cast<unsigned>(trace.size()));
+    }
+  }
+  r.run("on_rx/mixed_trace", [&trace](uint64_t n) {
+    BeaconLogic logic;
+    NodeTable table;
+    size_t next = trace.size();
+    uint32_t now_ms = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+      if (next == trace.size()) {
+        table = NodeTable();
+        table.init_self(kNodeId, 0);
+        next = 0;
+      }
+      const Frame& fr = trace[next++];
+      now_ms += 50;
+      keep(logic.on_rx(now_ms, fr.bytes, fr.len, -80, table));
+    }
+  });
+
+  // One new seq16 per operation for a peer picked round-robin from the table.
+  static const size_t kFill[] = {10, 50, 99};
+  for (size_t f = 0; f < sizeof(kFill) / sizeof(kFill[0]); ++f) {
+    const size_t peers = kFill[f];
+    char name[48];
+    std::snprintf(name, sizeof(name), "node_table/apply_pos_full/%u", static_cast<unsigned>(peers));
+    std::vector<Frame> frames(peers);
+    for (size_t i = 0; i < peers; ++i) {
+      frames[i] = make_pos_full(0x0000200000000000ULL + i * 0x777ULL, 1,
+                                557500000 + static_cast<int32_t>(i * 1000), 376100000);
+    }
+    NodeTable table;
+    r.run(name, [&frames, &table, peers](uint64_t n) {
+      fill_table(&table, peers, 1000);
+      uint16_t seq16 = 1;
+      size_t k = 0;
+      for (uint64_t i = 0; i < n; ++i) {
+        if (k == 0) {
+          ++seq16;
+        }
+        Frame& fr = frames[k];
+        uint8_t* payload = fr.bytes + p::kHeaderSize;
+        p::wire::write_u16_le(payload + p::kBundlePrefixSize, seq16);
+        keep(table.apply_pos_full(p::PosFullView(payload, fr.len - p::kHeaderSize), -70,
+                                  static_cast<uint32_t>(1000 + i)));
+        k = k + 1 == peers ? 0 : k + 1;
+      }
+    });
+  }
+
+  NodeTable table;
+  fill_table(&table, 10, 1000);
+  NodeEntry entry;
+  table.find_entry_by_node_id(0x0000200000000000ULL, &entry);
+  std::strncpy(entry.node_name, "bench-peer", sizeof(entry.node_name) - 1);
+  r.run("ble/pack_record", [&entry, &table](uint64_t n) {
+    uint8_t out[p::BleNodeTableBridge::kRecordBytesBle];
+    for (uint64_t i = 0; i < n; ++i) {
+      keep(entry);
+      keep(p::pack_ble_record(entry, 5000, table, out));
+      keep(out);
+    }
+  });
+}
+
+// ── GNSS UART ──────────────────────────────────────────────────────────────────
+
+/** IGnssUbxIo over a recorded byte stream that starts over when it runs out. */
+class StreamUbxIo : public naviga::IGnssUbxIo {
+ public:
+  explicit StreamUbxIo(const std::vector<uint8_t>& bytes) : bytes_(bytes) {}
+  bool begin(uint32_t, int8_t, int8_t) override { return true; }
+  int available() override { return static_cast<int>(bytes_.size() - pos_); }
+  int read_byte() override {
+    if (pos_ == bytes_.size()) {
+      return -1;
+    }
+    return bytes_[pos_++];
+  }
+  size_t read_bytes(uint8_t* buf, size_t n) override {
+    if (n > bytes_.size() - pos_) {
+      n = bytes_.size() - pos_;
+    }
+    std::memcpy(buf, bytes_.data() + pos_, n);
+    pos_ += n;
+    return n;
+  }
+  size_t write_bytes(const uint8_t*, size_t len) override { return len; }
+  void rewind() { pos_ = 0; }
+
+ private:
+  const std::vector<uint8_t>& bytes_;
+  size_t pos_ = 0;
+};
+
+void put_u32_le(uint8_t* dst, uint32_t v) {
+  p::wire::write_u16_le(dst, static_cast<uint16_t>(v & 0xFFFFu));
+  p::wire::write_u16_le(dst + 2, static_cast<uint16_t>(v >> 16));
+}
+
+/**
+ * One second of a 115200-baud GNSS UART at full line rate (11520 bytes): NAV-PVT frames, each
+ * followed by GGA and RMC sentences the parser has to skip.
+ */
+std::vector<uint8_t> make_ubx_second() {
+  static const char kNmea[] =
+      "$GNGGA,123519.00,5544.00000,N,03736.00000,E,1,08,0.9,545.4,M,46.9,M,,*5C\r\n"
+      "$GNRMC,123519.00,A,5544.00000,N,03736.00000,E,0.02,,181026,,,A*6B\r\n";
+  const size_t kLineBytesPerS = 115200 / 10;
+  std::vector<uint8_t> out;
+  out.reserve(kLineBytesPerS);
+  uint32_t itow_ms = 345600000;
+  while (out.size() < kLineBytesPerS) {
+    uint8_t payload[naviga::UbxStreamParser::kNavPvtPayloadLen] = {};
+    put_u32_le(payload, itow_ms);
+    payload[11] = 0x07;
+    payload[20] = 3;
+    payload[21] = naviga::UbxNavPvt::kFlagGnssFixOk;
+    payload[23] = 11;
+    put_u32_le(payload + 24, 376000000u + itow_ms % 1000u);
+    put_u32_le(payload + 28, 557000000u);
+    put_u32_le(payload + 40, 2500);
+    const uint8_t head[6] = {naviga::UbxStreamParser::kSync1, naviga::UbxStreamParser::kSync2,
+                             naviga::UbxStreamParser::kClassNav, naviga::UbxStreamParser::kIdNavPvt,
+                             static_cast<uint8_t>(sizeof(payload)), 0};
+    uint8_t ck_a = 0;
+    uint8_t ck_b = 0;
+    for (size_t i = 2; i < sizeof(head); ++i) {
+      ck_a = static_cast<uint8_t>(ck_a + head[i]);
+      ck_b = static_cast<uint8_t>(ck_b + ck_a);
+    }
+    for (uint8_t b : payload) {
+      ck_a = static_cast<uint8_t>(ck_a + b);
+      ck_b = static_cast<uint8_t>(ck_b + ck_a);
+    }
+    out.insert(out.end(), head, head + sizeof(head));
+    out.insert(out.end(), payload, payload + sizeof(payload));
+    out.push_back(ck_a);
+    out.push_back(ck_b);
+    out.insert(out.end(), kNmea, kNmea + sizeof(kNmea) - 1);
+    itow_ms += 100;
+  }
+  out.resize(kLineBytesPerS);
+  return out;
+}
+
+void bench_gnss(Runner& r) {
+  // One operation = one second of line data, drained 256 bytes per tick as GnssUbloxService does.
+  const size_t kMaxReadPerTick = 256;
+  const std::vector<uint8_t> second = make_ubx_second();
+  StreamUbxIo io(second);
+
+  r.run("gnss/uart_115200_1s/byte", [&io](uint64_t n) {
+    naviga::UbxStreamParser parser;
+    naviga::GnssSnapshot snap{};
+    for (uint64_t i = 0; i < n; ++i) {
+      io.rewind();
+      while (io.available() > 0) {
+        for (size_t k = 0; k < kMaxReadPerTick; ++k) {
+          const int c = io.read_byte();
+          if (c < 0) {
+            break;
+          }
+          naviga::UbxFrameView frame{};
+          naviga::UbxNavPvt pvt;
+          if (parser.push_byte(static_cast<uint8_t>(c), &frame) == naviga::UbxParseStatus::FrameOk &&
+              naviga::parse_nav_pvt(frame, &pvt)) {
+            naviga::apply_nav_pvt(pvt, static_cast<uint32_t>(i), &snap);
+          }
+        }
+      }
+      keep(snap);
+    }
+  });
+
+  r.run("gnss/uart_115200_1s/block", [&io](uint64_t n) {
+    naviga::UbxStreamParser parser;
+    naviga::GnssSnapshot snap{};
+    uint8_t buf[kMaxReadPerTick];
+    for (uint64_t i = 0; i < n; ++i) {
+      io.rewind();
+      size_t got = 0;
+      while ((got = io.read_bytes(buf, sizeof(buf))) > 0) {
+        size_t off = 0;
+        while (off < got) {
+          naviga::UbxFrameView frame{};
+          naviga::UbxParseStatus st = naviga::UbxParseStatus::None;
+          off += parser.push_bytes(buf + off, got - off, &frame, &st);
+          naviga::UbxNavPvt pvt;
+          if (st == naviga::UbxParseStatus::FrameOk && naviga::parse_nav_pvt(frame, &pvt)) {
+            naviga::apply_nav_pvt(pvt, static_cast<uint32_t>(i), &snap);
+          }
+        }
+      }
+      keep(snap);
+    }
+  });
+}
+
+// ── Output ─────────────────────────────────────────────────────────────────────
+
+const char* arg_value(const char* arg, const char* name) {
+  const size_t n = std::strlen(name);
+  if (std::strncmp(arg, name, n) == 0 && arg[n] == '=') {
+    return arg + n + 1;
+  }
+  return nullptr;
+}
+
+void print_usage() {
+  std::printf(
+      "usage: program [--filter=SUBSTR] [--min-ms=MS] [--reps=N]\n"
+      "               [--json=FILE] [--compare=FILE] [--max-regress=PCT]\n");
+}
+
+/** One line per result, so compare can read it back with sscanf. */
+bool write_json(const char* path, const Runner& r, const Options& opt) {
+  FILE* f = std::fopen(path, "w");
+  if (!f) {
+    return false;
+  }
+  std::fprintf(f, "{\n  \"format\": \"naviga-bench/1\",\n  \"min_ms\": %u,\n  \"reps\": %u,\n",
+               opt.min_ms, opt.reps);
+  std::fprintf(f, "  \"results\": [\n");
+  for (size_t i = 0; i < r.count(); ++i) {
+    const Result& res = r.result(i);
+    std::fprintf(f,
+                 "    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"allocs_per_op\": %.3f, "
+                 "\"iterations\": %llu}%s\n",
+                 res.name, res.ns_per_op, res.allocs_per_op,
+                 static_cast<unsigned long long>(res.iterations), i + 1 < r.count() ? "," : "");
+  }
+  std::fprintf(f, "  ]\n}\n");
+  return std::fclose(f) == 0;
+}
+
+/** Result named name from a baseline written by write_json; false if absent. */
+bool find_baseline(FILE* f, const char* name, Result* out) {
+  std::rewind(f);
+  char line[256];
+  while (std::fgets(line, sizeof(line), f)) {
+    Result res;
+    if (std::sscanf(line, " {\"name\": \"%47[^\"]\", \"ns_per_op\": %lf, \"allocs_per_op\": %lf",
+                    res.name, &res.ns_per_op, &res.allocs_per_op) == 3 &&
+        std::strcmp(res.name, name) == 0) {
+      *out = res;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Print results; with a baseline, also the change against it. Returns the number of
+ * regressions: slower by more than max_regress_pct, or more allocations per op.
+ */
+size_t report(const Runner& r, FILE* baseline, uint32_t max_regress_pct) {
+  size_t regressions = 0;
+  std::printf("%-32s %12s %10s %12s\n", "case", "ns/op", "allocs/op",
+              baseline ? "vs baseline" : "");
+  for (size_t i = 0; i < r.count(); ++i) {
+    const Result& res = r.result(i);
+    std::printf("%-32s %12.2f %10.2f", res.name, res.ns_per_op, res.allocs_per_op);
+    Result base;
+    if (baseline && find_baseline(baseline, res.name, &base) && base.ns_per_op > 0) {
+      const double pct = (res.ns_per_op / base.ns_per_op - 1.0) * 100.0;
+      const bool slower = pct > static_cast<double>(max_regress_pct);
+      const bool allocs = res.allocs_per_op > base.allocs_per_op + 1e-9;
+      std::printf(" %+11.1f%%%s", pct, slower || allocs ? "  REGRESSION" : "");
+      if (slower || allocs) {
+        ++regressions;
+      }
+    } else if (baseline) {
+      std::printf(" %12s", "new");
+    }
+    std::printf("\n");
+  }
+  return regressions;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  const char* json_path = nullptr;
+  const char* compare_path = nullptr;
+  uint32_t max_regress_pct = kMaxRegressPctDefault;
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    const char* v = nullptr;
+    if ((v = arg_value(a, "--filter"))) {
+      opt.filter = v;
+    } else if ((v = arg_value(a, "--min-ms"))) {
+      opt.min_ms = static_cast<uint32_t>(std::strtoul(v, nullptr, 10));
+    } else if ((v = arg_value(a, "--reps"))) {
+      opt.reps = static_cast<uint32_t>(std::strtoul(v, nullptr, 10));
+    } else if ((v = arg_value(a, "--json"))) {
+      json_path = v;
+    } else if ((v = arg_value(a, "--compare"))) {
+      compare_path = v;
+    } else if ((v = arg_value(a, "--max-regress"))) {
+      max_regress_pct = static_cast<uint32_t>(std::strtoul(v, nullptr, 10));
+    } else {
+      print_usage();
+      return std::strcmp(a, "--help") == 0 ? 0 : 2;
+    }
+  }
+  if (opt.min_ms == 0 || opt.reps == 0) {
+    print_usage();
+    return 2;
+  }
+
+  Runner runner(opt);
+  bench_header(runner);
+  bench_codecs(runner);
+  bench_rx(runner);
+  bench_gnss(runner);
+
+  FILE* baseline = nullptr;
+  if (compare_path) {
+    baseline = std::fopen(compare_path, "r");
+    if (!baseline) {
+      std::fprintf(stderr, "cannot read baseline %s\n", compare_path);
+      return 2;
+    }
+  }
+  const size_t regressions = report(runner, baseline, max_regress_pct);
+  if (baseline) {
+    std::fclose(baseline);
+  }
+  if (json_path && !write_json(json_path, runner, opt)) {
+    std::fprintf(stderr, "cannot write %s\n", json_path);
+    return 2;
+  }
+  return regressions == 0 ? 0 : 1;
+}
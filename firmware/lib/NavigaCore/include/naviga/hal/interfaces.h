@@ -3,6 +3,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "naviga/hal/radio_preset.h"
+
 namespace naviga {
 
 enum class GNSSFixState : uint8_t {
@@ -17,6 +19,13 @@ struct GnssSnapshot {
   int32_t lat_e7;
   int32_t lon_e7;
   uint32_t last_fix_ms; // monotonic uptime ms of last valid fix; 0 when never fixed
+  bool time_valid;      // GNSS time known (UBX NAV-PVT validTime); false for providers without it
+  uint32_t tow_ms;      // GPS time of week (NAV-PVT iTOW) of the last solution, ms
+  uint32_t tow_at_ms;   // monotonic uptime ms at which tow_ms was GPS time (epoch, output latency removed)
+  bool quality_valid;   // num_sv/h_acc_mm/g_speed_mm_s reported (UBX NAV-PVT); false for providers without them
+  uint8_t num_sv;       // satellites used in the last solution
+  uint32_t h_acc_mm;    // horizontal accuracy estimate of the last solution, mm
+  uint32_t g_speed_mm_s; // ground speed of the last solution, mm/s
 };
 
 enum class RadioBootConfigResult : uint8_t {
@@ -25,15 +34,57 @@ enum class RadioBootConfigResult : uint8_t {
   RepairFailed = 2,
 };
 
+enum class RadioTxStatus : uint8_t {
+  IDLE = 0,       // No async send started since the last completion was reported.
+  IN_FLIGHT = 1,  // Bytes handed to the module; frame not yet (fully) on air.
+  DONE = 2,       // Module finished the frame (reported once).
+  FAILED = 3,     // Module did not finish in time (reported once).
+};
+
 class IRadio {
  public:
   virtual ~IRadio() = default;
   virtual bool send(const uint8_t* data, size_t len) = 0;
+  /**
+   * Start a send and return without waiting for the module; false if not accepted (not ready,
+   * bad length, previous async send still in flight). Completion via poll_tx_done().
+   */
+  virtual bool send_async(const uint8_t* data, size_t len) = 0;
+  virtual RadioTxStatus poll_tx_done() = 0;
   virtual bool recv(uint8_t* out, size_t max_len, size_t* out_len) = 0;
   virtual int8_t last_rssi_dbm() const = 0;
   virtual bool rssi_available() const = 0;
   virtual RadioBootConfigResult boot_config_result() const = 0;
   virtual const char* boot_config_message() const = 0;
+  /**
+   * Move the module to another preset at runtime (link-adaptive preset selection); blocks for
+   * the reconfiguration. false if unsupported, a send is in flight, or the module did not
+   * verify the new setting. Default: unsupported.
+   */
+  virtual bool apply_preset(const RadioPreset& preset) {
+    (void)preset;
+    return false;
+  }
+};
+
+/**
+ * Raw access to a radio module's UART in normal (transparent) mode, next to IRadio: module
+ * commands (e.g. ambient RSSI) that share the line with received frames.
+ */
+class IRadioCmdIo {
+ public:
+  virtual ~IRadioCmdIo() = default;
+  virtual int available() = 0;
+  /** Next byte without consuming it; -1 if none. */
+  virtual int peek_byte() = 0;
+  virtual int read_byte() = 0;
+  virtual size_t write_bytes(const uint8_t* data, size_t len) = 0;
+  /**
+   * The reply to the last command (\a reply_len bytes starting with \a first_byte) was not read:
+   * it is late or behind frame bytes. recv() drops it once it reaches the head of the UART
+   * instead of returning it as a frame.
+   */
+  virtual void drop_late_reply(uint8_t first_byte, size_t reply_len) = 0;
 };
 
 enum class ChannelSenseState : uint8_t {
@@ -82,6 +133,11 @@ class IBleTransport {
   virtual const uint8_t* profile_read_response_data() const = 0;
   virtual size_t profile_read_response_len() const = 0;
   virtual void clear_profile_read_request() = 0;
+
+  /** Per-peer link stats payload (format_ver, count, count × 16-byte entries). Single read. */
+  virtual void set_link_stats(const uint8_t* data, size_t len) = 0;
+  virtual const uint8_t* link_stats_data() const = 0;
+  virtual size_t link_stats_len() const = 0;
 };
 
 class IGnss {
@@ -90,6 +146,20 @@ class IGnss {
   virtual bool get_snapshot(GnssSnapshot* out) = 0;
 };
 
+/**
+ * Raw NOR-flash region (erase-before-write sectors), e.g. a dedicated data partition.
+ * Offsets are region-relative. write() may only clear bits (1→0); erase sets a sector to 0xFF.
+ */
+class IFlashRegion {
+ public:
+  virtual ~IFlashRegion() = default;
+  virtual size_t sector_size() const = 0;
+  virtual size_t sector_count() const = 0;
+  virtual bool erase_sector(size_t sector) = 0;
+  virtual bool write(size_t offset, const uint8_t* data, size_t len) = 0;
+  virtual bool read(size_t offset, uint8_t* out, size_t len) const = 0;
+};
+
 class ILog {
  public:
   virtual ~ILog() = default;
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "naviga/hal/interfaces.h"
+
+namespace naviga {
+
+/**
+ * Host file-backed IFlashRegion for tests and offline tools. Emulates NOR semantics:
+ * erase fills a sector with 0xFF, write ANDs data into existing contents. Counts erases per sector.
+ */
+class FileFlashRegion : public IFlashRegion {
+ public:
+  FileFlashRegion(const char* path, size_t sector_size, size_t sector_count);
+  ~FileFlashRegion() override;
+
+  /** Open (create and fill with 0xFF if missing or wrong size). */
+  bool open();
+  void close();
+
+  size_t sector_size() const override { return sector_size_; }
+  size_t sector_count() const override { return sector_count_; }
+  bool erase_sector(size_t sector) override;
+  bool write(size_t offset, const uint8_t* data, size_t len) override;
+  bool read(size_t offset, uint8_t* out, size_t len) const override;
+
+  uint32_t erase_count(size_t sector) const;
+  uint32_t write_calls() const { return write_calls_; }
+
+ private:
+  char path_[256] = {0};
+  size_t sector_size_ = 0;
+  size_t sector_count_ = 0;
+  void* file_ = nullptr;
+  std::vector<uint32_t> erase_counts_;
+  uint32_t write_calls_ = 0;
+};
+
+} // namespace naviga
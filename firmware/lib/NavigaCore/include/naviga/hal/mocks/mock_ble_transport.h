@@ -31,6 +31,10 @@ class MockBleTransport : public IBleTransport {
   size_t profile_read_response_len() const override;
   void clear_profile_read_request() override;
 
+  void set_link_stats(const uint8_t* data, size_t len) override;
+  const uint8_t* link_stats_data() const override;
+  size_t link_stats_len() const override;
+
   const uint8_t* subscription_update_data() const { return subscription_update_buf_; }
   size_t subscription_update_len() const { return subscription_update_len_; }
 
@@ -77,6 +81,9 @@ class MockBleTransport : public IBleTransport {
   static constexpr size_t kMaxProfileReadResponseLen = 64;
   uint8_t profile_read_response_buf_[kMaxProfileReadResponseLen] = {0};
   size_t profile_read_response_len_ = 0;
+  static constexpr size_t kMaxLinkStatsLen = 2 + 31 * 16;
+  uint8_t link_stats_buf_[kMaxLinkStatsLen] = {0};
+  size_t link_stats_len_ = 0;
 };
 
 } // namespace naviga
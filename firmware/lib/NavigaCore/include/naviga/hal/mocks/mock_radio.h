@@ -10,6 +10,8 @@ namespace naviga {
 class MockRadio : public IRadio {
  public:
   bool send(const uint8_t* data, size_t len) override;
+  bool send_async(const uint8_t* data, size_t len) override;
+  RadioTxStatus poll_tx_done() override;
   bool recv(uint8_t* out, size_t max_len, size_t* out_len) override;
   int8_t last_rssi_dbm() const override;
   bool rssi_available() const override { return false; }
@@ -21,12 +23,19 @@ class MockRadio : public IRadio {
   void inject_rx(const uint8_t* data, size_t len, int8_t rssi_dbm);
   size_t tx_count() const;
   size_t last_tx_len() const;
+  /** Next async sends stay IN_FLIGHT for this many polls, then complete with ok. */
+  void set_async_completion(size_t in_flight_polls, bool ok);
 
  private:
   uint8_t last_tx_[256] = {0};
   size_t last_tx_len_ = 0;
   size_t tx_count_ = 0;
 
+  bool async_in_flight_ = false;
+  size_t async_polls_left_ = 0;
+  size_t async_in_flight_polls_ = 0;
+  bool async_ok_ = true;
+
   uint8_t rx_buf_[256] = {0};
   size_t rx_len_ = 0;
   int8_t last_rssi_dbm_ = 0;
@@ -0,0 +1,101 @@
+#include "naviga/hal/mocks/file_flash_region.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace naviga {
+
+namespace {
+
+std::FILE* as_file(void* f) {
+  return static_cast<std::FILE*>(f);
+}
+
+} // namespace
+
+FileFlashRegion::FileFlashRegion(const char* path, size_t sector_size, size_t sector_count)
+    : sector_size_(sector_size), sector_count_(sector_count), erase_counts_(sector_count, 0) {
+  if (path) {
+    std::strncpy(path_, path, sizeof(path_) - 1);
+  }
+}
+
+FileFlashRegion::~FileFlashRegion() {
+  close();
+}
+
+bool FileFlashRegion::open() {
+  close();
+  const long total = static_cast<long>(sector_size_ * sector_count_);
+  std::FILE* f = std::fopen(path_, "r+b");
+  if (f) {
+    std::fseek(f, 0, SEEK_END);
+    if (std::ftell(f) != total) {
+      std::fclose(f);
+      f = nullptr;
+    }
+  }
+  if (!f) {
+    f = std::fopen(path_, "w+b");
+    if (!f) {
+      return false;
+    }
+    for (long i = 0; i < total; ++i) {
+      std::fputc(0xFF, f);
+    }
+    std::fflush(f);
+  }
+  file_ = f;
+  return true;
+}
+
+void FileFlashRegion::close() {
+  if (file_) {
+    std::fclose(as_file(file_));
+    file_ = nullptr;
+  }
+}
+
+bool FileFlashRegion::erase_sector(size_t sector) {
+  if (!file_ || sector >= sector_count_) {
+    return false;
+  }
+  std::vector<uint8_t> blank(sector_size_, 0xFF);
+  std::fseek(as_file(file_), static_cast<long>(sector * sector_size_), SEEK_SET);
+  const size_t n = std::fwrite(blank.data(), 1, blank.size(), as_file(file_));
+  std::fflush(as_file(file_));
+  erase_counts_[sector]++;
+  return n == blank.size();
+}
+
+bool FileFlashRegion::write(size_t offset, const uint8_t* data, size_t len) {
+  if (!file_ || !data || offset + len > sector_size_ * sector_count_) {
+    return false;
+  }
+  std::vector<uint8_t> cur(len, 0xFF);
+  if (!read(offset, cur.data(), len)) {
+    return false;
+  }
+  for (size_t i = 0; i < len; ++i) {
+    cur[i] = static_cast<uint8_t>(cur[i] & data[i]);
+  }
+  std::fseek(as_file(file_), static_cast<long>(offset), SEEK_SET);
+  const size_t n = std::fwrite(cur.data(), 1, len, as_file(file_));
+  std::fflush(as_file(file_));
+  write_calls_++;
+  return n == len;
+}
+
+bool FileFlashRegion::read(size_t offset, uint8_t* out, size_t len) const {
+  if (!file_ || !out || offset + len > sector_size_ * sector_count_) {
+    return false;
+  }
+  std::fseek(as_file(file_), static_cast<long>(offset), SEEK_SET);
+  return std::fread(out, 1, len, as_file(file_)) == len;
+}
+
+uint32_t FileFlashRegion::erase_count(size_t sector) const {
+  return sector < erase_counts_.size() ? erase_counts_[sector] : 0;
+}
+
+} // namespace naviga
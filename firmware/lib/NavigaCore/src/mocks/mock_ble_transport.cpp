@@ -124,6 +124,22 @@ void MockBleTransport::clear_profile_read_request() {
   has_profile_read_request_ = false;
 }
 
+void MockBleTransport::set_link_stats(const uint8_t* data, size_t len) {
+  const size_t copy_len = std::min(len, sizeof(link_stats_buf_));
+  if (data && copy_len > 0) {
+    std::memcpy(link_stats_buf_, data, copy_len);
+  }
+  link_stats_len_ = copy_len;
+}
+
+const uint8_t* MockBleTransport::link_stats_data() const {
+  return link_stats_buf_;
+}
+
+size_t MockBleTransport::link_stats_len() const {
+  return link_stats_len_;
+}
+
 size_t MockBleTransport::device_info_len() const {
   return device_info_len_;
 }
@@ -15,6 +15,28 @@ bool MockRadio::send(const uint8_t* data, size_t len) {
   return true;
 }
 
+bool MockRadio::send_async(const uint8_t* data, size_t len) {
+  if (async_in_flight_) {
+    return false;
+  }
+  send(data, len);
+  async_in_flight_ = true;
+  async_polls_left_ = async_in_flight_polls_;
+  return true;
+}
+
+RadioTxStatus MockRadio::poll_tx_done() {
+  if (!async_in_flight_) {
+    return RadioTxStatus::IDLE;
+  }
+  if (async_polls_left_ > 0) {
+    async_polls_left_--;
+    return RadioTxStatus::IN_FLIGHT;
+  }
+  async_in_flight_ = false;
+  return async_ok_ ? RadioTxStatus::DONE : RadioTxStatus::FAILED;
+}
+
 bool MockRadio::recv(uint8_t* out, size_t max_len, size_t* out_len) {
   if (!has_rx_) {
     if (out_len) {
@@ -56,4 +78,9 @@ size_t MockRadio::last_tx_len() const {
   return last_tx_len_;
 }
 
+void MockRadio::set_async_completion(size_t in_flight_polls, bool ok) {
+  async_in_flight_polls_ = in_flight_polls;
+  async_ok_ = ok;
+}
+
 } // namespace naviga
@@ -4,7 +4,7 @@
 #include <cstdint>
 
 #include "packet_header.h"
-#include "wire_helpers.h"
+#include "wire_schema.h"
 
 namespace naviga {
 namespace protocol {
@@ -33,11 +33,23 @@ struct AliveFields {
 /** Alive payload version byte. */
 constexpr uint8_t kAlivePayloadVersion = 0x00;
 
+/** Alive payload schema (wire_schema.h), and the optional aliveStatus. */
+typedef wire::Layout<0,
+    wire::Const<8, kAlivePayloadVersion>,
+    wire::Field<AliveFields, uint64_t, &AliveFields::node_id, 48>,
+    wire::Field<AliveFields, uint16_t, &AliveFields::seq, 16>>
+    AliveWire;
+typedef wire::Layout<AliveWire::kEnd,
+    wire::Field<AliveFields, uint8_t, &AliveFields::alive_status, 8>>
+    AliveStatusWire;
+
 /** Minimum Alive payload size (without aliveStatus). */
-constexpr size_t kAlivePayloadMin = 9;
+constexpr size_t kAlivePayloadMin = AliveWire::kSize;
 
 /** Maximum Alive payload size (with aliveStatus). */
-constexpr size_t kAlivePayloadMax = 10;
+constexpr size_t kAlivePayloadMax = AliveStatusWire::kEnd;
+
+static_assert(kAlivePayloadMin == 9 && kAlivePayloadMax == 10, "Alive payload is 9 or 10 bytes");
 
 /** Minimum on-air Alive frame size (header + min payload). */
 constexpr size_t kAliveFrameMin = kHeaderSize + kAlivePayloadMin;
@@ -78,11 +90,9 @@ inline size_t encode_alive_frame(const AliveFields& fields, uint8_t* out, size_t
   }
 
   uint8_t* p = out + kHeaderSize;
-  p[0] = kAlivePayloadVersion;
-  wire::write_nodeid48_le(p + 1, fields.node_id);
-  wire::write_u16_le(p + 7, fields.seq);
+  AliveWire::encode(fields, p);
   if (fields.has_status) {
-    p[9] = fields.alive_status;
+    AliveStatusWire::encode(fields, p);
   }
 
   return frame_size;
@@ -108,14 +118,17 @@ inline AliveDecodeError decode_alive_payload(const uint8_t* payload, size_t payl
   if (payload_len != kAlivePayloadMin && payload_len != kAlivePayloadMax) {
     return AliveDecodeError::BadPayloadLen;
   }
-  if (payload[0] != kAlivePayloadVersion) {
+  if (!AliveWire::valid(payload)) {
     return AliveDecodeError::BadPayloadVersion;
   }
 
-  out->node_id      = wire::read_nodeid48_le(payload + 1);
-  out->seq          = wire::read_u16_le(payload + 7);
-  out->has_status   = (payload_len >= kAlivePayloadMax);
-  out->alive_status = out->has_status ? payload[9] : 0x00u;
+  AliveWire::decode(payload, out);
+  out->has_status = (payload_len >= kAlivePayloadMax);
+  if (out->has_status) {
+    AliveStatusWire::decode(payload, out);
+  } else {
+    out->alive_status = 0x00u;
+  }
 
   return AliveDecodeError::Ok;
 }
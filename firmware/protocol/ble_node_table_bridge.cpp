@@ -42,7 +42,8 @@ void write_u64_le_at(uint8_t* out, size_t offset, uint64_t value) {
   }
 }
 
-/** S04 #464: Pack one NodeEntry to canon BLE record (72 bytes). Excludes last_seq, last_seen_ms, etc. */
+} // namespace
+
 size_t pack_ble_record(const domain::NodeEntry& e,
                        uint32_t snapshot_time_ms,
                        const domain::NodeTable& table,
@@ -65,12 +66,16 @@ size_t pack_ble_record(const domain::NodeEntry& e,
   if (is_stale) flags1 |= 0x08;
   out[10] = flags1;
   write_u16_le(out + 11, age_s);
-  write_u32_le_at(out, 13, static_cast<uint32_t>(e.pos_valid ? e.lat_e7 : 0));
-  write_u32_le_at(out, 17, static_cast<uint32_t>(e.pos_valid ? e.lon_e7 : 0));
+  int32_t lat_e7 = 0;
+  int32_t lon_e7 = 0;
+  const bool predicted = domain::NodeTable::predicted_position(e, snapshot_time_ms, &lat_e7, &lon_e7);
+  write_u32_le_at(out, 13, static_cast<uint32_t>(e.pos_valid ? lat_e7 : 0));
+  write_u32_le_at(out, 17, static_cast<uint32_t>(e.pos_valid ? lon_e7 : 0));
   write_u16_le(out + 21, e.pos_valid ? e.pos_age_s : 0);
   uint8_t flags2 = 0;
   if (e.has_pos_flags) flags2 |= 0x01;
   if (e.has_sats) flags2 |= 0x02;
+  if (predicted) flags2 |= 0x04;
   out[23] = flags2;
   out[24] = e.pos_flags;
   out[25] = e.sats;
@@ -98,6 +103,8 @@ size_t pack_ble_record(const domain::NodeEntry& e,
   return BleNodeTableBridge::kRecordBytesBle;
 }
 
+namespace {
+
 /** Canonical change hash: hash of the exact 72-byte record we would send. Use reference_time for age/stale so ticking alone does not trigger. */
 uint32_t entry_hash_canon(const domain::NodeEntry& e,
                           uint32_t reference_time_ms,
@@ -391,5 +398,56 @@ void BleNodeTableBridge::update_subscription_batch(uint32_t now_ms,
   });
 }
 
+static_assert(2 + BleNodeTableBridge::kMaxLinkStatsEntries * BleNodeTableBridge::kLinkStatsEntryBytes ==
+                  BleTransportCore::kMaxLinkStatsLen,
+              "link stats payload must match transport buffer");
+
+void BleNodeTableBridge::update_link_stats(const domain::NodeTable& table,
+                                           IBleTransport& transport) const {
+  // Keep the kMaxLinkStatsEntries most recently heard peers, newest first (insertion into a small array).
+  std::array<const domain::NodeEntry*, kMaxLinkStatsEntries> picked{};
+  size_t picked_count = 0;
+  table.for_each_used_entry([&picked, &picked_count](const domain::NodeEntry& e) {
+    if (e.is_self || e.link.rx_count == 0) {
+      return;
+    }
+    size_t pos = picked_count;
+    while (pos > 0 && picked[pos - 1]->link.last_rx_ms < e.link.last_rx_ms) {
+      --pos;
+    }
+    if (pos >= picked.size()) {
+      return;
+    }
+    const size_t last = (picked_count < picked.size()) ? picked_count : picked.size() - 1;
+    for (size_t i = last; i > pos; --i) {
+      picked[i] = picked[i - 1];
+    }
+    picked[pos] = &e;
+    if (picked_count < picked.size()) {
+      ++picked_count;
+    }
+  });
+
+  std::array<uint8_t, BleTransportCore::kMaxLinkStatsLen> buf{};
+  buf[0] = kLinkStatsFormatVer;
+  buf[1] = static_cast<uint8_t>(picked_count);
+  size_t offset = 2;
+  for (size_t i = 0; i < picked_count; ++i) {
+    const domain::NodeEntry& e = *picked[i];
+    uint8_t* out = buf.data() + offset;
+    for (int b = 0; b < 6; ++b) {
+      out[b] = static_cast<uint8_t>((e.node_id >> (8 * b)) & 0xFF);
+    }
+    out[6] = static_cast<uint8_t>(domain::link_stats_rssi_dbm(e.link));
+    out[7] = domain::link_stats_pdr_pct(e.link);
+    write_u16_le(out + 8, e.link.ia_mean_10ms);
+    write_u16_le(out + 10, e.link.ia_jitter_10ms);
+    write_u16_le(out + 12, e.link.dup_count);
+    write_u16_le(out + 14, e.link.lost_count);
+    offset += kLinkStatsEntryBytes;
+  }
+  transport.set_link_stats(buf.data(), offset);
+}
+
 } // namespace protocol
 } // namespace naviga
@@ -38,6 +38,32 @@ struct DeviceInfoModel {
   uint32_t capabilities = 0;
 };
 
+/**
+ * S04 #464: Pack one NodeEntry to the canon BLE record (BleNodeTableBridge::kRecordBytesBle
+ * bytes at \a out). Excludes last_seq, last_seen_ms, etc.; age and stale are taken at
+ * snapshot_time_ms. lat/lon are the position extrapolated to snapshot_time_ms when the peer
+ * sends a velocity (NodeTable::predicted_position; flags2 bit 2 set). Returns the record size,
+ * or 0 if out is null.
+ *
+ * Layout (LE):
+ *   0  node_id u64          8  short_id u16
+ *   10 flags1: bit0 is_self, bit1 short_id_collision, bit2 pos_valid, bit3 stale
+ *   11 age_s u16            13 lat_e7 i32, 17 lon_e7 i32 (0 when !pos_valid)
+ *   21 pos_age_s u16
+ *   23 flags2: bit0 pos_flags valid, bit1 sats valid, bit2 predicted (lat/lon extrapolated
+ *      along the peer's Pos_Velocity, not the last received position)
+ *   24 pos_flags            25 sats
+ *   26 flags3: bit0 battery, bit1 uptime, bit2 max_silence, bit3 hw_profile, bit4 fw_version
+ *   27 battery_percent      28 uptime_sec u32      32 max_silence_10s
+ *   33 hw_profile_id u16    35 fw_version_id u16
+ *   37 last_rx_rssi i8      38 snr_last i8         39 node_name length
+ *   40 node_name (kNodeTableNodeNameMaxLen bytes, zero-padded)
+ */
+size_t pack_ble_record(const domain::NodeEntry& e,
+                       uint32_t snapshot_time_ms,
+                       const domain::NodeTable& table,
+                       uint8_t* out);
+
 class BleNodeTableBridge {
  public:
   /** S04 #464: canon BLE record format (all product-facing fields, exclusions applied). */
@@ -60,6 +86,18 @@ class BleNodeTableBridge {
                                  domain::NodeTable& table,
                                  IBleTransport& transport);
 
+  /**
+   * Per-peer link stats export (single-read characteristic). Payload: format_ver(1), count(1),
+   * then count × 16-byte entries, most recently heard peers first (max kMaxLinkStatsEntries):
+   * node_id48 LE(6), rssi_ewma_dbm i8(1), pdr_pct(1), ia_mean_10ms u16, ia_jitter_10ms u16,
+   * dup_count u16, lost_count u16. Self and never-heard peers are skipped.
+   */
+  void update_link_stats(const domain::NodeTable& table, IBleTransport& transport) const;
+
+  static constexpr uint8_t kLinkStatsFormatVer = 1;
+  static constexpr size_t kLinkStatsEntryBytes = 16;
+  static constexpr size_t kMaxLinkStatsEntries = 31;
+
   static constexpr uint32_t kCoalescingWindowMs = 2000U;
   /** Cap per notify to stay under typical BLE MTU (1 + 5*72 = 361 bytes). */
   static constexpr size_t kMaxBatchRecords = 5;
@@ -0,0 +1,97 @@
+#include "bundle_codec.h"
+
+#include <cstring>
+
+namespace naviga {
+namespace protocol {
+
+bool bundle_begin(uint64_t node_id, uint8_t* out, size_t out_cap, size_t* out_len) {
+  if (!out || !out_len || out_cap < kBundleMinFrameSize) {
+    return false;
+  }
+  PacketHeader hdr;
+  hdr.msg_type = MsgType::BeaconBundle;
+  hdr.reserved = 0;
+  hdr.payload_len = static_cast<uint8_t>(kBundlePrefixSize);
+  if (!encode_header(hdr, out, out_cap)) {
+    return false;
+  }
+  out[kHeaderSize] = kBundlePayloadVersion;
+  wire::write_nodeid48_le(out + kHeaderSize + 1, node_id);
+  *out_len = kBundleMinFrameSize;
+  return true;
+}
+
+bool bundle_append_frame(const uint8_t* frame, size_t frame_len,
+                         uint8_t* out, size_t out_cap, size_t* out_len) {
+  if (!frame || !out || !out_len || *out_len < kBundleMinFrameSize) {
+    return false;
+  }
+  PacketHeader sub_hdr;
+  if (!decode_header(frame, frame_len, &sub_hdr) || sub_hdr.msg_type == MsgType::BeaconBundle ||
+      !validate_header(sub_hdr, frame_len - kHeaderSize)) {
+    return false;
+  }
+  const uint8_t* sub_payload = frame + kHeaderSize;
+  const size_t sub_payload_len = frame_len - kHeaderSize;
+  if (sub_payload_len <= kBundlePrefixSize || sub_payload[0] != 0x00 ||
+      std::memcmp(sub_payload + 1, out + kHeaderSize + 1, 6) != 0) {
+    return false;
+  }
+  const size_t body_len = sub_payload_len - kBundlePrefixSize;
+  const size_t new_len = *out_len + kBundleSubHeaderSize + body_len;
+  if (new_len > out_cap || new_len - kHeaderSize > kMaxPayloadLen) {
+    return false;
+  }
+  uint8_t* p = out + *out_len;
+  p[0] = static_cast<uint8_t>(sub_hdr.msg_type);
+  p[1] = static_cast<uint8_t>(body_len);
+  std::memcpy(p + kBundleSubHeaderSize, sub_payload + kBundlePrefixSize, body_len);
+
+  PacketHeader hdr;
+  hdr.msg_type = MsgType::BeaconBundle;
+  hdr.reserved = 0;
+  hdr.payload_len = static_cast<uint8_t>(new_len - kHeaderSize);
+  encode_header(hdr, out, out_cap);
+  *out_len = new_len;
+  return true;
+}
+
+size_t bundle_unpack(const uint8_t* payload, size_t payload_len, size_t index,
+                     uint8_t* out, size_t out_cap) {
+  if (!payload || !out || payload_len < kBundlePrefixSize || payload[0] != kBundlePayloadVersion) {
+    return 0;
+  }
+  size_t pos = kBundlePrefixSize;
+  for (size_t i = 0; pos + kBundleSubHeaderSize <= payload_len; ++i) {
+    const uint8_t sub_type = payload[pos];
+    const size_t body_len = payload[pos + 1];
+    const size_t body_pos = pos + kBundleSubHeaderSize;
+    if (body_len == 0 || body_pos + body_len > payload_len) {
+      return 0;  // malformed
+    }
+    if (i == index) {
+      const size_t frame_len = kHeaderSize + kBundlePrefixSize + body_len;
+      if (sub_type == static_cast<uint8_t>(MsgType::BeaconBundle) || frame_len > out_cap ||
+          frame_len - kHeaderSize > kMaxPayloadLen) {
+        return 0;
+      }
+      PacketHeader hdr;
+      hdr.msg_type = static_cast<MsgType>(sub_type & 0x7Fu);
+      hdr.reserved = 0;
+      hdr.payload_len = static_cast<uint8_t>(kBundlePrefixSize + body_len);
+      if (!encode_header(hdr, out, out_cap)) {
+        return 0;
+      }
+      std::memcpy(out + kHeaderSize, payload, kBundlePrefixSize);
+      out[kHeaderSize] = 0x00;  // sub-message payloadVersion
+      std::memcpy(out + kHeaderSize + kBundlePrefixSize, payload + body_pos, body_len);
+      return frame_len;
+    }
+    pos = body_pos + body_len;
+  }
+  return 0;
+}
+
+} // namespace protocol
+} // namespace naviga
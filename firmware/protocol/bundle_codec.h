@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "packet_header.h"
+#include "wire_helpers.h"
+
+namespace naviga {
+namespace protocol {
+
+/**
+ * Node_Bundle (0x08) — several v0.2 sub-messages from one node in one frame.
+ *
+ * Payload: payloadVersion (1 B) + nodeId48 (6 B), then N sub-records:
+ *   sub_msg_type (1 B) | sub_len (1 B) | body (sub_len B)
+ * body is the sub-message's own payload without its 7-byte payloadVersion + nodeId48 prefix,
+ * i.e. it starts at seq16. Sub-messages are v0.2 single-frame types (0x02, 0x06, 0x07);
+ * bundles do not nest.
+ *
+ * Pos_Full + Status: 2 + 7 + (2 + 10) + (2 + 12) = 35 B on air instead of 19 + 21 = 40 B in
+ * two frames, and one PHY preamble/sync/CRC instead of two.
+ */
+constexpr uint8_t kBundlePayloadVersion = 0x00;
+constexpr size_t kBundlePrefixSize = 7;     ///< payloadVersion + nodeId48 (shared by all v0.2 payloads).
+constexpr size_t kBundleSubHeaderSize = 2;  ///< sub_msg_type + sub_len.
+constexpr size_t kBundleMinFrameSize = kHeaderSize + kBundlePrefixSize;
+
+/** Bytes a single v0.2 frame of frame_len bytes adds to a bundle (0 if it cannot be bundled). */
+inline size_t bundle_sub_cost(size_t frame_len) {
+  if (frame_len <= kHeaderSize + kBundlePrefixSize) {
+    return 0;
+  }
+  return frame_len - kHeaderSize - kBundlePrefixSize + kBundleSubHeaderSize;
+}
+
+/**
+ * Start an empty bundle for node_id in out. Sets *out_len to kBundleMinFrameSize.
+ * @return false if out/out_len is null or out_cap is too small.
+ */
+bool bundle_begin(uint64_t node_id, uint8_t* out, size_t out_cap, size_t* out_len);
+
+/**
+ * Append one complete v0.2 frame (2-byte header + payload) to the bundle in out.
+ * The frame's payloadVersion must be 0 and its nodeId48 must match the bundle's.
+ * The bundle header's payload_len is kept up to date.
+ * @return false (bundle unchanged) if the frame is not bundleable or does not fit out_cap /
+ *         kMaxPayloadLen.
+ */
+bool bundle_append_frame(const uint8_t* frame, size_t frame_len,
+                         uint8_t* out, size_t out_cap, size_t* out_len);
+
+/**
+ * Rebuild sub-message index (0-based) of a bundle payload (without header) as a standalone
+ * frame (header + payload) in out.
+ * @return frame length, or 0 if there is no such sub-message, the bundle is malformed, or
+ *         out_cap is too small.
+ */
+size_t bundle_unpack(const uint8_t* payload, size_t payload_len, size_t index,
+                     uint8_t* out, size_t out_cap);
+
+} // namespace protocol
+} // namespace naviga
@@ -0,0 +1,302 @@
+#include "fec_codec.h"
+
+#include <cstring>
+
+namespace naviga {
+namespace protocol {
+
+namespace {
+
+// GF(2^8), field polynomial x^8 + x^4 + x^3 + x^2 + 1 (0x11D), a = 2. kGfExp[i] = a^i;
+// kGfLog[kGfExp[i]] = i (kGfLog[0] unused).
+const uint8_t kGfExp[255] = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1D, 0x3A, 0x74, 0xE8, 0xCD, 0x87, 0x13, 0x26,
+    0x4C, 0x98, 0x2D, 0x5A, 0xB4, 0x75, 0xEA, 0xC9, 0x8F, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xC0,
+    0x9D, 0x27, 0x4E, 0x9C, 0x25, 0x4A, 0x94, 0x35, 0x6A, 0xD4, 0xB5, 0x77, 0xEE, 0xC1, 0x9F, 0x23,
+    0x46, 0x8C, 0x05, 0x0A, 0x14, 0x28, 0x50, 0xA0, 0x5D, 0xBA, 0x69, 0xD2, 0xB9, 0x6F, 0xDE, 0xA1,
+    0x5F, 0xBE, 0x61, 0xC2, 0x99, 0x2F, 0x5E, 0xBC, 0x65, 0xCA, 0x89, 0x0F, 0x1E, 0x3C, 0x78, 0xF0,
+    0xFD, 0xE7, 0xD3, 0xBB, 0x6B, 0xD6, 0xB1, 0x7F, 0xFE, 0xE1, 0xDF, 0xA3, 0x5B, 0xB6, 0x71, 0xE2,
+    0xD9, 0xAF, 0x43, 0x86, 0x11, 0x22, 0x44, 0x88, 0x0D, 0x1A, 0x34, 0x68, 0xD0, 0xBD, 0x67, 0xCE,
+    0x81, 0x1F, 0x3E, 0x7C, 0xF8, 0xED, 0xC7, 0x93, 0x3B, 0x76, 0xEC, 0xC5, 0x97, 0x33, 0x66, 0xCC,
+    0x85, 0x17, 0x2E, 0x5C, 0xB8, 0x6D, 0xDA, 0xA9, 0x4F, 0x9E, 0x21, 0x42, 0x84, 0x15, 0x2A, 0x54,
+    0xA8, 0x4D, 0x9A, 0x29, 0x52, 0xA4, 0x55, 0xAA, 0x49, 0x92, 0x39, 0x72, 0xE4, 0xD5, 0xB7, 0x73,
+    0xE6, 0xD1, 0xBF, 0x63, 0xC6, 0x91, 0x3F, 0x7E, 0xFC, 0xE5, 0xD7, 0xB3, 0x7B, 0xF6, 0xF1, 0xFF,
+    0xE3, 0xDB, 0xAB, 0x4B, 0x96, 0x31, 0x62, 0xC4, 0x95, 0x37, 0x6E, 0xDC, 0xA5, 0x57, 0xAE, 0x41,
+    0x82, 0x19, 0x32, 0x64, 0xC8, 0x8D, 0x07, 0x0E, 0x1C, 0x38, 0x70, 0xE0, 0xDD, 0xA7, 0x53, 0xA6,
+    0x51, 0xA2, 0x59, 0xB2, 0x79, 0xF2, 0xF9, 0xEF, 0xC3, 0x9B, 0x2B, 0x56, 0xAC, 0x45, 0x8A, 0x09,
+    0x12, 0x24, 0x48, 0x90, 0x3D, 0x7A, 0xF4, 0xF5, 0xF7, 0xF3, 0xFB, 0xEB, 0xCB, 0x8B, 0x0B, 0x16,
+    0x2C, 0x58, 0xB0, 0x7D, 0xFA, 0xE9, 0xCF, 0x83, 0x1B, 0x36, 0x6C, 0xD8, 0xAD, 0x47, 0x8E,
+};
+
+const uint8_t kGfLog[256] = {
+    0x00, 0x00, 0x01, 0x19, 0x02, 0x32, 0x1A, 0xC6, 0x03, 0xDF, 0x33, 0xEE, 0x1B, 0x68, 0xC7, 0x4B,
+    0x04, 0x64, 0xE0, 0x0E, 0x34, 0x8D, 0xEF, 0x81, 0x1C, 0xC1, 0x69, 0xF8, 0xC8, 0x08, 0x4C, 0x71,
+    0x05, 0x8A, 0x65, 0x2F, 0xE1, 0x24, 0x0F, 0x21, 0x35, 0x93, 0x8E, 0xDA, 0xF0, 0x12, 0x82, 0x45,
+    0x1D, 0xB5, 0xC2, 0x7D, 0x6A, 0x27, 0xF9, 0xB9, 0xC9, 0x9A, 0x09, 0x78, 0x4D, 0xE4, 0x72, 0xA6,
+    0x06, 0xBF, 0x8B, 0x62, 0x66, 0xDD, 0x30, 0xFD, 0xE2, 0x98, 0x25, 0xB3, 0x10, 0x91, 0x22, 0x88,
+    0x36, 0xD0, 0x94, 0xCE, 0x8F, 0x96, 0xDB, 0xBD, 0xF1, 0xD2, 0x13, 0x5C, 0x83, 0x38, 0x46, 0x40,
+    0x1E, 0x42, 0xB6, 0xA3, 0xC3, 0x48, 0x7E, 0x6E, 0x6B, 0x3A, 0x28, 0x54, 0xFA, 0x85, 0xBA, 0x3D,
+    0xCA, 0x5E, 0x9B, 0x9F, 0x0A, 0x15, 0x79, 0x2B, 0x4E, 0xD4, 0xE5, 0xAC, 0x73, 0xF3, 0xA7, 0x57,
+    0x07, 0x70, 0xC0, 0xF7, 0x8C, 0x80, 0x63, 0x0D, 0x67, 0x4A, 0xDE, 0xED, 0x31, 0xC5, 0xFE, 0x18,
+    0xE3, 0xA5, 0x99, 0x77, 0x26, 0xB8, 0xB4, 0x7C, 0x11, 0x44, 0x92, 0xD9, 0x23, 0x20, 0x89, 0x2E,
+    0x37, 0x3F, 0xD1, 0x5B, 0x95, 0xBC, 0xCF, 0xCD, 0x90, 0x87, 0x97, 0xB2, 0xDC, 0xFC, 0xBE, 0x61,
+    0xF2, 0x56, 0xD3, 0xAB, 0x14, 0x2A, 0x5D, 0x9E, 0x84, 0x3C, 0x39, 0x53, 0x47, 0x6D, 0x41, 0xA2,
+    0x1F, 0x2D, 0x43, 0xD8, 0xB7, 0x7B, 0xA4, 0x76, 0xC4, 0x17, 0x49, 0xEC, 0x7F, 0x0C, 0x6F, 0xF6,
+    0x6C, 0xA1, 0x3B, 0x52, 0x29, 0x9D, 0x55, 0xAA, 0xFB, 0x60, 0x86, 0xB1, 0xBB, 0xCC, 0x3E, 0x5A,
+    0xCB, 0x59, 0x5F, 0xB0, 0x9C, 0xA9, 0xA0, 0x51, 0x0B, 0xF5, 0x16, 0xEB, 0x7A, 0x75, 0x2C, 0xD7,
+    0x4F, 0xAE, 0xD5, 0xE9, 0xE6, 0xE7, 0xAD, 0xE8, 0x74, 0xD6, 0xF4, 0xEA, 0xA8, 0x50, 0x58, 0xAF,
+};
+
+// Generator polynomials (x - a^0)..(x - a^(n-1)) for n = 2, 4, .., 16, as logs of the
+// coefficients of x^(n-1)..x^0 (the leading 1 is implied). Row n starts at gen_offset(n).
+const uint8_t kGenLog[72] = {
+    // 2 parity bytes
+    0x19, 0x01,
+    // 4 parity bytes
+    0x4B, 0xF9, 0x4E, 0x06,
+    // 6 parity bytes
+    0xA6, 0x00, 0x86, 0x05, 0xB0, 0x0F,
+    // 8 parity bytes
+    0xAF, 0xEE, 0xD0, 0xF9, 0xD7, 0xFC, 0xC4, 0x1C,
+    // 10 parity bytes
+    0xFB, 0x43, 0x2E, 0x3D, 0x76, 0x46, 0x40, 0x5E, 0x20, 0x2D,
+    // 12 parity bytes
+    0x66, 0x2B, 0x62, 0x79, 0xBB, 0x71, 0xC6, 0x8F, 0x83, 0x57, 0x9D, 0x42,
+    // 14 parity bytes
+    0xC7, 0xF9, 0x9B, 0x30, 0xBE, 0x7C, 0xDA, 0x89, 0xD8, 0x57, 0xCF, 0x3B, 0x16, 0x5B,
+    // 16 parity bytes
+    0x78, 0x68, 0x6B, 0x6D, 0x66, 0xA1, 0x4C, 0x03, 0x5B, 0xBF, 0x93, 0xA9, 0xB6, 0xC2, 0xE1, 0x78,
+};
+
+inline size_t gen_offset(uint8_t parity_len) {
+  const size_t k = parity_len / 2u;
+  return k * (k - 1u);
+}
+
+/** a^e for 0 <= e < 510 (sum of two logs). */
+inline uint8_t gf_exp2(unsigned e) {
+  return kGfExp[e >= 255u ? e - 255u : e];
+}
+
+inline uint8_t gf_mul(uint8_t a, uint8_t b) {
+  return (a == 0 || b == 0) ? 0 : gf_exp2(static_cast<unsigned>(kGfLog[a]) + kGfLog[b]);
+}
+
+/** a / b, b != 0. */
+inline uint8_t gf_div(uint8_t a, uint8_t b) {
+  return a == 0 ? 0 : gf_exp2(static_cast<unsigned>(kGfLog[a]) + 255u - kGfLog[b]);
+}
+
+/** Value of poly[0..n) (lowest degree first) at a^e. */
+inline uint8_t gf_eval_at(const uint8_t* poly, size_t n, unsigned e) {
+  uint8_t v = 0;
+  for (size_t i = n; i-- > 0;) {
+    v = static_cast<uint8_t>(gf_mul(v, kGfExp[e]) ^ poly[i]);
+  }
+  return v;
+}
+
+/** S_j = codeword(a^j), j < parity_len. Returns true if any syndrome is non-zero. */
+bool syndromes(const uint8_t* cw, size_t len, uint8_t parity_len, uint8_t* synd) {
+  bool dirty = false;
+  for (uint8_t j = 0; j < parity_len; ++j) {
+    uint8_t s = 0;
+    for (size_t i = 0; i < len; ++i) {
+      s = static_cast<uint8_t>(gf_mul(s, kGfExp[j]) ^ cw[i]);
+    }
+    synd[j] = s;
+    dirty = dirty || s != 0;
+  }
+  return dirty;
+}
+
+} // namespace
+
+bool rs_encode(const uint8_t* data, size_t len, uint8_t parity_len, uint8_t* parity) {
+  if (!data || !parity || !fec_parity_valid(parity_len) || len + parity_len > 255u) {
+    return false;
+  }
+  const uint8_t* gen = kGenLog + gen_offset(parity_len);
+  std::memset(parity, 0, parity_len);
+  for (size_t i = 0; i < len; ++i) {
+    const uint8_t feedback = static_cast<uint8_t>(data[i] ^ parity[0]);
+    std::memmove(parity, parity + 1, parity_len - 1u);
+    parity[parity_len - 1u] = 0;
+    if (feedback != 0) {
+      const unsigned lf = kGfLog[feedback];
+      for (uint8_t j = 0; j < parity_len; ++j) {
+        parity[j] ^= gf_exp2(lf + gen[j]);
+      }
+    }
+  }
+  return true;
+}
+
+int rs_correct(uint8_t* codeword, size_t len, uint8_t parity_len) {
+  if (!codeword || !fec_parity_valid(parity_len) || len <= parity_len || len > 255u) {
+    return -1;
+  }
+  uint8_t synd[kFecParityMax] = {};
+  if (!syndromes(codeword, len, parity_len, synd)) {
+    return 0;
+  }
+
+  // Berlekamp-Massey: error locator lambda(x), lowest degree first, errs = its degree.
+  uint8_t lambda[kFecParityMax + 1] = {1};
+  uint8_t prev[kFecParityMax + 1] = {1};
+  uint8_t errs = 0;
+  uint8_t shift = 1;
+  uint8_t prev_d = 1;
+  for (uint8_t k = 0; k < parity_len; ++k) {
+    uint8_t d = synd[k];
+    for (uint8_t i = 1; i <= errs; ++i) {
+      d ^= gf_mul(lambda[i], synd[k - i]);
+    }
+    if (d == 0) {
+      shift++;
+      continue;
+    }
+    const uint8_t coef = gf_div(d, prev_d);
+    uint8_t saved[kFecParityMax + 1];
+    const bool grow = 2u * errs <= k;
+    if (grow) {
+      std::memcpy(saved, lambda, sizeof(saved));
+    }
+    for (size_t i = 0; i + shift <= parity_len; ++i) {
+      lambda[i + shift] ^= gf_mul(coef, prev[i]);
+    }
+    if (grow) {
+      errs = static_cast<uint8_t>(k + 1u - errs);
+      std::memcpy(prev, saved, sizeof(prev));
+      prev_d = d;
+      shift = 1;
+    } else {
+      shift++;
+    }
+  }
+  if (errs == 0 || 2u * errs > parity_len) {
+    return -1;
+  }
+
+  // Chien search: byte i has power p = len - 1 - i; it is in error if lambda(a^-p) == 0.
+  uint8_t where[kFecParityMax / 2] = {};
+  uint8_t found = 0;
+  for (size_t i = 0; i < len; ++i) {
+    const unsigned inv = (255u - static_cast<unsigned>(len - 1u - i)) % 255u;
+    if (gf_eval_at(lambda, errs + 1u, inv) == 0) {
+      if (found == errs) {
+        return -1;
+      }
+      where[found++] = static_cast<uint8_t>(i);
+    }
+  }
+  if (found != errs) {
+    return -1;
+  }
+
+  // Forney (first root a^0): e = X * omega(X^-1) / lambda'(X^-1), omega = S * lambda mod x^n.
+  uint8_t omega[kFecParityMax] = {};
+  for (uint8_t i = 0; i < parity_len; ++i) {
+    for (uint8_t j = 0; j <= errs && j <= i; ++j) {
+      omega[i] ^= gf_mul(synd[i - j], lambda[j]);
+    }
+  }
+  uint8_t deriv[kFecParityMax / 2] = {};  // lambda' in characteristic 2: odd terms only.
+  for (uint8_t j = 1; j <= errs; j += 2) {
+    deriv[j - 1u] = lambda[j];
+  }
+  uint8_t magnitude[kFecParityMax / 2] = {};
+  for (uint8_t k = 0; k < errs; ++k) {
+    const unsigned p = static_cast<unsigned>(len - 1u - where[k]);
+    const unsigned inv = (255u - p) % 255u;
+    const uint8_t den = gf_eval_at(deriv, errs, inv);
+    if (den == 0) {
+      return -1;
+    }
+    magnitude[k] = gf_mul(kGfExp[p], gf_div(gf_eval_at(omega, parity_len, inv), den));
+  }
+
+  for (uint8_t k = 0; k < errs; ++k) {
+    codeword[where[k]] ^= magnitude[k];
+  }
+  if (syndromes(codeword, len, parity_len, synd)) {
+    for (uint8_t k = 0; k < errs; ++k) {
+      codeword[where[k]] ^= magnitude[k];
+    }
+    return -1;
+  }
+  return errs;
+}
+
+size_t fec_wrap(const uint8_t* frame, size_t frame_len, uint8_t parity_len,
+                uint8_t* out, size_t out_cap) {
+  if (!frame || !out || !fec_parity_valid(parity_len)) {
+    return 0;
+  }
+  PacketHeader inner;
+  if (!decode_header(frame, frame_len, &inner) || inner.msg_type == MsgType::BeaconFec ||
+      !validate_header(inner, frame_len - kHeaderSize)) {
+    return 0;
+  }
+  const size_t total = fec_frame_size(frame_len, parity_len);
+  if (total - kHeaderSize > kMaxPayloadLen || total > out_cap) {
+    return 0;
+  }
+  // Inner frame first: frame may be out itself.
+  std::memmove(out + kHeaderSize + kFecPrefixSize, frame, frame_len);
+  PacketHeader hdr;
+  hdr.msg_type = MsgType::BeaconFec;
+  hdr.reserved = 0;
+  hdr.payload_len = static_cast<uint8_t>(total - kHeaderSize);
+  encode_header(hdr, out, out_cap);
+  out[kHeaderSize] = parity_len;
+  rs_encode(out, total - parity_len, parity_len, out + total - parity_len);
+  return total;
+}
+
+size_t fec_unwrap(const uint8_t* frame, size_t frame_len, uint8_t* out, size_t out_cap,
+                  uint8_t* out_corrected) {
+  if (!frame || !out || frame_len > kMaxFrameSize) {
+    return 0;
+  }
+  const uint8_t stated = frame_len > kHeaderSize ? frame[kHeaderSize] : 0;
+  uint8_t cw[kMaxFrameSize];
+  // The stated parity_len first; if that fails it may be the corrupted byte, so try the other
+  // allowed lengths, largest (least likely to miscorrect) first.
+  for (uint8_t attempt = 0; attempt <= kFecParityMax / 2u; ++attempt) {
+    const uint8_t parity_len = attempt == 0
+        ? stated
+        : static_cast<uint8_t>(kFecParityMax + 2u - 2u * attempt);
+    if (!fec_parity_valid(parity_len) || (attempt > 0 && parity_len == stated) ||
+        frame_len < kHeaderSize + kFecPrefixSize + kHeaderSize + parity_len) {
+      continue;
+    }
+    std::memcpy(cw, frame, frame_len);
+    const int fixed = rs_correct(cw, frame_len, parity_len);
+    if (fixed < 0 || cw[kHeaderSize] != parity_len) {
+      continue;
+    }
+    PacketHeader outer;
+    PacketHeader inner;
+    const uint8_t* inner_frame = cw + kHeaderSize + kFecPrefixSize;
+    const size_t inner_len = frame_len - kHeaderSize - kFecPrefixSize - parity_len;
+    if (!decode_header(cw, frame_len, &outer) || outer.msg_type != MsgType::BeaconFec ||
+        !validate_header(outer, frame_len - kHeaderSize) ||
+        !decode_header(inner_frame, inner_len, &inner) || inner.msg_type == MsgType::BeaconFec ||
+        !validate_header(inner, inner_len - kHeaderSize)) {
+      continue;
+    }
+    if (inner_len > out_cap) {
+      return 0;
+    }
+    std::memcpy(out, inner_frame, inner_len);
+    if (out_corrected) {
+      *out_corrected = static_cast<uint8_t>(fixed);
+    }
+    return inner_len;
+  }
+  return 0;
+}
+
+} // namespace protocol
+} // namespace naviga
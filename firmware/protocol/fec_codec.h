@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "packet_header.h"
+
+namespace naviga {
+namespace protocol {
+
+/**
+ * Node_Fec (0x0A) — a complete frame inside a Reed-Solomon envelope.
+ *
+ * Payload: parity_len (1 B) | inner frame (2-byte header + payload) | parity (parity_len B)
+ *
+ * The code is a shortened RS(255, 255 - parity_len) over GF(2^8) (field polynomial 0x11D,
+ * generator roots a^0..a^(parity_len-1)), systematic over the whole frame: the outer 2-byte
+ * header, parity_len and the inner frame. Up to parity_len / 2 corrupted bytes anywhere in the
+ * frame are corrected, the outer header included as long as its msg_type still reads 0x0A.
+ * A corrupted parity_len byte is recovered by trying the other allowed lengths.
+ *
+ * The outer header's reserved bits are always 0: relays forward the unwrapped inner frame,
+ * not the envelope. The envelope costs 1 + parity_len bytes (Pos_Full 19 B → 28 B at 8).
+ */
+constexpr size_t kFecPrefixSize = 1;   ///< parity_len.
+constexpr uint8_t kFecParityMin = 2;   ///< Corrects 1 byte.
+constexpr uint8_t kFecParityMax = 16;  ///< Corrects 8 bytes.
+
+/** True if parity_len is an allowed envelope overhead: even, kFecParityMin..kFecParityMax. */
+inline bool fec_parity_valid(uint8_t parity_len) {
+  return parity_len >= kFecParityMin && parity_len <= kFecParityMax && (parity_len & 1u) == 0;
+}
+
+/** Size on air of a frame_len-byte frame wrapped with parity_len parity bytes. */
+inline size_t fec_frame_size(size_t frame_len, uint8_t parity_len) {
+  return kHeaderSize + kFecPrefixSize + frame_len + parity_len;
+}
+
+/**
+ * Systematic RS parity of data[0..len) into parity[0..parity_len). Table-driven LFSR, one
+ * generator row per allowed parity_len; no allocation.
+ * @return false if parity_len is not fec_parity_valid or len + parity_len > 255.
+ */
+bool rs_encode(const uint8_t* data, size_t len, uint8_t parity_len, uint8_t* parity);
+
+/**
+ * Correct codeword[0..len) (data followed by parity_len parity bytes) in place.
+ * Syndromes, Berlekamp-Massey, Chien search and Forney; the result is re-checked.
+ * @return number of corrected bytes (0 = clean), or -1 if uncorrectable (codeword unchanged).
+ */
+int rs_correct(uint8_t* codeword, size_t len, uint8_t parity_len);
+
+/**
+ * Wrap one complete frame (header + payload) in a Node_Fec envelope in out. frame may be out
+ * (wrapped in place).
+ * @return envelope length, or 0 if parity_len is invalid, the frame is malformed, or the result
+ *         does not fit kMaxPayloadLen / out_cap.
+ */
+size_t fec_wrap(const uint8_t* frame, size_t frame_len, uint8_t parity_len,
+                uint8_t* out, size_t out_cap);
+
+/**
+ * Decode a received Node_Fec frame (as received, header included) and copy the corrected inner
+ * frame to out. frame is not modified; the outer payload_len is not trusted (it is part of the
+ * codeword). *out_corrected (optional) gets the number of bytes corrected.
+ * @return inner frame length, or 0 if the frame is uncorrectable or out_cap is too small.
+ */
+size_t fec_unwrap(const uint8_t* frame, size_t frame_len, uint8_t* out, size_t out_cap,
+                  uint8_t* out_corrected = nullptr);
+
+} // namespace protocol
+} // namespace naviga
@@ -3,7 +3,9 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "geo_u24.h"
 #include "packet_header.h"
+#include "wire_schema.h"
 
 namespace naviga {
 namespace protocol {
@@ -28,6 +30,7 @@ namespace protocol {
  *                  lon_u24 = round((lon_deg + 180.0) / 360.0 * 16777215)
  * Decode formula:  lat_deg = lat_u24 / 16777215.0 * 180.0 - 90.0
  *                  lon_deg = lon_u24 / 16777215.0 * 360.0 - 180.0
+ * evaluated in integers on e7 degrees (geo_u24.h); decode yields the nearest e7.
  *
  * Precision: ~1.1 m (lat), ~2.4 m (lon at equator).
  *
@@ -36,8 +39,8 @@ namespace protocol {
 struct GeoBeaconFields {
   uint64_t node_id  = 0;
   uint8_t  pos_valid = 0;  ///< 1 = valid fix; 0 = no fix (send Alive instead of Core).
-  double   lat_deg  = 0.0; ///< Latitude in degrees [-90, +90]. Clamped on encode.
-  double   lon_deg  = 0.0; ///< Longitude in degrees [-180, +180]. Clamped on encode.
+  int32_t  lat_e7   = 0;   ///< Latitude, 1e-7 degrees [-90, +90]. Clamped on encode.
+  int32_t  lon_e7   = 0;   ///< Longitude, 1e-7 degrees [-180, +180]. Clamped on encode.
   uint16_t seq      = 0;
 };
 
@@ -45,7 +48,7 @@ enum class DecodeError {
   Ok = 0,
   ShortBuffer,
   BadPayloadVersion,
-  InvalidRange,
+  InvalidRange,     ///< Not produced: any 24-bit lat/lon is in range.
   BadMsgType,       ///< Header present but msg_type is not BeaconCore.
   PayloadLenMismatch, ///< Header payload_len != actual payload bytes.
 };
@@ -60,14 +63,25 @@ struct ConstByteSpan {
   size_t         size;
 };
 
+/** payloadVersion byte value for BeaconCore v0. */
+constexpr uint8_t kGeoBeaconPayloadVersion = 0x00;
+
+/** BeaconCore payload schema (wire_schema.h); pos_valid is not on air. */
+typedef wire::Layout<0,
+    wire::Const<8, kGeoBeaconPayloadVersion>,
+    wire::Field<GeoBeaconFields, uint64_t, &GeoBeaconFields::node_id, 48>,
+    wire::Field<GeoBeaconFields, uint16_t, &GeoBeaconFields::seq, 16>,
+    wire::Field<GeoBeaconFields, int32_t, &GeoBeaconFields::lat_e7, 24, LatE7AsU24>,
+    wire::Field<GeoBeaconFields, int32_t, &GeoBeaconFields::lon_e7, 24, LonE7AsU24>>
+    GeoBeaconWire;
+
 /** BeaconCore payload size in bytes (no frame header). */
-constexpr size_t kGeoBeaconSize = 15;
+constexpr size_t kGeoBeaconSize = GeoBeaconWire::kSize;
 
 /** BeaconCore on-air frame size (2-byte header + 15-byte payload). */
 constexpr size_t kGeoBeaconFrameSize = kHeaderSize + kGeoBeaconSize;
 
-/** payloadVersion byte value for BeaconCore v0. */
-constexpr uint8_t kGeoBeaconPayloadVersion = 0x00;
+static_assert(kGeoBeaconSize == 15, "BeaconCore payload is 15 bytes");
 
 /** msg_type value for BeaconCore (ootb_radio_v0.md §3.2). */
 constexpr uint8_t kGeoBeaconMsgType = static_cast<uint8_t>(MsgType::BeaconCore);
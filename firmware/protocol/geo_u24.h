@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+
+namespace naviga {
+namespace protocol {
+
+/**
+ * packed24 lat/lon (beacon_payload_encoding_v0) <-> 1e-7 degree integers, integer-only.
+ *
+ *   lat_u24 = round((lat_deg + 90)  / 180 * 16777215)   lat_deg = lat_u24 / 16777215 * 180 - 90
+ *   lon_u24 = round((lon_deg + 180) / 360 * 16777215)   lon_deg = lon_u24 / 16777215 * 360 - 180
+ *
+ * evaluated exactly in 64-bit integers with degrees as e7 (the GNSS and NodeTable unit):
+ * (e7 + 90e7) * 16777215 < 2^55. Encode rounds halves up, decode rounds half away from zero
+ * (decode has no exact halves: 16777215 is odd). Both give the same result as the former
+ * double path (std::round / std::llround over e7 * 1e-7) for every e7 in range; see
+ * test_geo_beacon_codec. Out-of-range e7 is clamped on encode.
+ */
+constexpr uint32_t kGeoU24Max = 16777215u;  ///< 2^24 - 1
+constexpr int32_t kLatE7Max = 900000000;
+constexpr int32_t kLonE7Max = 1800000000;
+
+namespace geo_u24_detail {
+
+inline uint32_t e7_to_u24(int32_t e7, int32_t max_e7) {
+  const int32_t clamped = e7 < -max_e7 ? -max_e7 : (e7 > max_e7 ? max_e7 : e7);
+  const uint64_t span = 2u * static_cast<uint64_t>(max_e7);
+  const uint64_t n = static_cast<uint64_t>(static_cast<int64_t>(clamped) + max_e7) * kGeoU24Max;
+  return static_cast<uint32_t>((n + span / 2u) / span);
+}
+
+inline int32_t u24_to_e7(uint32_t v, int32_t max_e7) {
+  const uint64_t span = 2u * static_cast<uint64_t>(max_e7);
+  const uint64_t twice = static_cast<uint64_t>(v) * span * 2u;
+  const int64_t shifted = static_cast<int64_t>((twice + kGeoU24Max) / (2u * kGeoU24Max));
+  return static_cast<int32_t>(shifted - max_e7);
+}
+
+} // namespace geo_u24_detail
+
+inline uint32_t lat_e7_to_u24(int32_t lat_e7) {
+  return geo_u24_detail::e7_to_u24(lat_e7, kLatE7Max);
+}
+inline uint32_t lon_e7_to_u24(int32_t lon_e7) {
+  return geo_u24_detail::e7_to_u24(lon_e7, kLonE7Max);
+}
+/** v must be <= kGeoU24Max; every 24-bit wire value is, so decoders need no range check. */
+inline int32_t u24_to_lat_e7(uint32_t v) {
+  return geo_u24_detail::u24_to_e7(v, kLatE7Max);
+}
+inline int32_t u24_to_lon_e7(uint32_t v) {
+  return geo_u24_detail::u24_to_e7(v, kLonE7Max);
+}
+
+/** wire::Field conversions (wire_schema.h) for e7 members sent as 24-bit packed24. */
+struct LatE7AsU24 {
+  static uint64_t to_wire(int32_t lat_e7) { return lat_e7_to_u24(lat_e7); }
+  static int32_t from_wire(uint64_t v) { return u24_to_lat_e7(static_cast<uint32_t>(v)); }
+};
+struct LonE7AsU24 {
+  static uint64_t to_wire(int32_t lon_e7) { return lon_e7_to_u24(lon_e7); }
+  static int32_t from_wire(uint64_t v) { return u24_to_lon_e7(static_cast<uint32_t>(v)); }
+};
+
+} // namespace protocol
+} // namespace naviga
@@ -4,7 +4,7 @@
 #include <cstdint>
 
 #include "packet_header.h"
-#include "wire_helpers.h"
+#include "wire_schema.h"
 
 namespace naviga {
 namespace protocol {
@@ -45,11 +45,27 @@ struct InfoFields {
 /** Info (Informative) payload version byte. */
 constexpr uint8_t kInfoPayloadVersion = 0x00;
 
+/** Info payload schema (wire_schema.h), and its optional fields in wire order. */
+typedef wire::Layout<0,
+    wire::Const<8, kInfoPayloadVersion>,
+    wire::Field<InfoFields, uint64_t, &InfoFields::node_id, 48>,
+    wire::Field<InfoFields, uint16_t, &InfoFields::seq16, 16>>
+    InfoWire;
+typedef wire::Layout<InfoWire::kEnd,
+    wire::Field<InfoFields, uint8_t, &InfoFields::max_silence_10s, 8>>
+    InfoMaxSilenceWire;
+typedef wire::Layout<InfoMaxSilenceWire::kEnd,
+    wire::Field<InfoFields, uint16_t, &InfoFields::hw_profile_id, 16>>
+    InfoHwProfileWire;
+typedef wire::Layout<InfoHwProfileWire::kEnd,
+    wire::Field<InfoFields, uint16_t, &InfoFields::fw_version_id, 16>>
+    InfoFwVersionWire;
+
 /** Minimum Info payload size (Common 9 B only). */
-constexpr size_t kInfoPayloadMin = 9;
+constexpr size_t kInfoPayloadMin = InfoWire::kSize;
 
 /** Maximum Info payload size (all optional fields present). */
-constexpr size_t kInfoPayloadMax = 14;
+constexpr size_t kInfoPayloadMax = InfoFwVersionWire::kEnd;
 
 /** Minimum on-air Info frame size (header + min payload). */
 constexpr size_t kInfoFrameMin = kHeaderSize + kInfoPayloadMin;
@@ -59,13 +75,17 @@ constexpr size_t kInfoFrameMax = kHeaderSize + kInfoPayloadMax;
 
 /** Payload offsets for optional fields (relative to start of payload). */
 constexpr size_t kInfoOffsetSeq16      = 7;   ///< Common: global seq16.
-constexpr size_t kInfoOffsetMaxSilence = 9;   ///< maxSilence10s.
-constexpr size_t kInfoOffsetHwProfile  = 10;  ///< hwProfileId (2 B LE).
-constexpr size_t kInfoOffsetFwVersion  = 12;  ///< fwVersionId (2 B LE).
+constexpr size_t kInfoOffsetMaxSilence = InfoMaxSilenceWire::kOffset;  ///< maxSilence10s.
+constexpr size_t kInfoOffsetHwProfile  = InfoHwProfileWire::kOffset;   ///< hwProfileId (2 B LE).
+constexpr size_t kInfoOffsetFwVersion  = InfoFwVersionWire::kOffset;   ///< fwVersionId (2 B LE).
+
+constexpr size_t kInfoSizeWithMaxSilence = InfoMaxSilenceWire::kEnd;
+constexpr size_t kInfoSizeWithHwProfile  = InfoHwProfileWire::kEnd;
+constexpr size_t kInfoSizeWithFwVersion  = InfoFwVersionWire::kEnd;
 
-constexpr size_t kInfoSizeWithMaxSilence = 10;
-constexpr size_t kInfoSizeWithHwProfile  = 12;
-constexpr size_t kInfoSizeWithFwVersion  = 14;
+static_assert(kInfoPayloadMin == 9 && kInfoSizeWithMaxSilence == 10 &&
+              kInfoSizeWithHwProfile == 12 && kInfoPayloadMax == 14,
+              "Info payload is 9, 10, 12 or 14 bytes");
 
 enum class InfoDecodeError {
   Ok = 0,
@@ -104,18 +124,15 @@ inline size_t encode_info_frame(const InfoFields& fields, uint8_t* out, size_t o
   }
 
   uint8_t* p = out + kHeaderSize;
-  p[0] = kInfoPayloadVersion;
-  wire::write_nodeid48_le(p + 1, fields.node_id);
-  wire::write_u16_le(p + kInfoOffsetSeq16, fields.seq16);
-
+  InfoWire::encode(fields, p);
   if (payload_len >= kInfoSizeWithMaxSilence) {
-    p[kInfoOffsetMaxSilence] = fields.max_silence_10s;
+    InfoMaxSilenceWire::encode(fields, p);
   }
   if (payload_len >= kInfoSizeWithHwProfile) {
-    wire::write_u16_le(p + kInfoOffsetHwProfile, fields.hw_profile_id);
+    InfoHwProfileWire::encode(fields, p);
   }
   if (payload_len >= kInfoSizeWithFwVersion) {
-    wire::write_u16_le(p + kInfoOffsetFwVersion, fields.fw_version_id);
+    InfoFwVersionWire::encode(fields, p);
   }
 
   return frame_size;
@@ -142,25 +159,32 @@ inline InfoDecodeError decode_info_payload(const uint8_t* payload, size_t payloa
   if (payload_len > kInfoPayloadMax) {
     return InfoDecodeError::BadPayloadLen;
   }
-  if (payload[0] != kInfoPayloadVersion) {
+  if (!InfoWire::valid(payload)) {
     return InfoDecodeError::BadPayloadVersion;
   }
 
-  out->node_id = wire::read_nodeid48_le(payload + 1);
-  out->seq16   = wire::read_u16_le(payload + kInfoOffsetSeq16);
+  InfoWire::decode(payload, out);
 
   out->has_max_silence = (payload_len >= kInfoSizeWithMaxSilence);
-  out->max_silence_10s = out->has_max_silence ? payload[kInfoOffsetMaxSilence] : 0u;
+  if (out->has_max_silence) {
+    InfoMaxSilenceWire::decode(payload, out);
+  } else {
+    out->max_silence_10s = 0u;
+  }
 
-  out->has_hw_profile  = (payload_len >= kInfoSizeWithHwProfile);
-  out->hw_profile_id   = out->has_hw_profile
-                           ? wire::read_u16_le(payload + kInfoOffsetHwProfile)
-                           : 0xFFFFu;
+  out->has_hw_profile = (payload_len >= kInfoSizeWithHwProfile);
+  if (out->has_hw_profile) {
+    InfoHwProfileWire::decode(payload, out);
+  } else {
+    out->hw_profile_id = 0xFFFFu;
+  }
 
-  out->has_fw_version  = (payload_len >= kInfoSizeWithFwVersion);
-  out->fw_version_id   = out->has_fw_version
-                           ? wire::read_u16_le(payload + kInfoOffsetFwVersion)
-                           : 0xFFFFu;
+  out->has_fw_version = (payload_len >= kInfoSizeWithFwVersion);
+  if (out->has_fw_version) {
+    InfoFwVersionWire::decode(payload, out);
+  } else {
+    out->fw_version_id = 0xFFFFu;
+  }
 
   return InfoDecodeError::Ok;
 }
@@ -11,14 +11,16 @@ namespace protocol {
  *
  * Wire layout — 16-bit little-endian word H = byte0 | (byte1 << 8):
  *   Bits [15:9]  msg_type    7 bits  (0x00–0x7F)
- *   Bits [8:6]   reserved    3 bits  (MUST be 0 on send; ignored on receive)
+ *   Bits [8:6]   hops        3 bits  (relay hop count: 0 when sent by the originator, +1 per
+ *                                      relay, see frame_hops(); any value accepted on receive.
+ *                                      Reserved in v0; field name `reserved` kept in PacketHeader)
  *   Bits [5:0]   payload_len 6 bits  (0–63; count of payload bytes after header)
  *
  * Encode:
- *   byte0 = ((reserved & 0x3) << 6) | payload_len   // H & 0xFF
- *   byte1 = (msg_type << 1) | (reserved >> 2)        // (H >> 8) & 0xFF
+ *   byte0 = ((hops & 0x3) << 6) | payload_len   // H & 0xFF
+ *   byte1 = (msg_type << 1) | (hops >> 2)        // (H >> 8) & 0xFF
  *
- * Golden example: msg_type=0x01, reserved=0, payload_len=15
+ * Golden example: msg_type=0x01, hops=0, payload_len=15
  *   H = 0x020F  →  wire [0x0F, 0x02]
  *
  * Spec: docs/protocols/ootb_radio_v0.md §3, issue #304.
@@ -35,7 +37,8 @@ constexpr size_t kMaxFrameSize = kHeaderSize + kMaxPayloadLen;
 
 /** msg_type registry v0 (ootb_radio_v0.md §3.2) + v0.2 (#435).
  *
- * v0.2 canonical (#438): RX accepts only 0x02 (BeaconAlive), 0x06 (BeaconPosFull), 0x07 (BeaconStatus).
+ * v0.2 canonical (#438): RX accepts only 0x02 (BeaconAlive), 0x06 (BeaconPosFull), 0x07 (BeaconStatus),
+ * 0x09 (BeaconPosDelta), plus 0x08 (BeaconBundle) carrying those and 0x0A (BeaconFec) wrapping one.
  * v0.1 types 0x01, 0x03, 0x04, 0x05 are no longer accepted on RX (log and drop).
  */
 enum class MsgType : uint8_t {
@@ -47,19 +50,48 @@ enum class MsgType : uint8_t {
   BeaconInfo   = 0x05,  ///< Node_OOTB_Informative (v0.1); no longer accepted on RX (#438).
   BeaconPosFull = 0x06,  ///< v0.2 Node_Pos_Full; 17 B payload (#435).
   BeaconStatus  = 0x07,  ///< v0.2 Node_Status; 19 B payload (#435).
+  BeaconBundle  = 0x08,  ///< Node_Bundle: several v0.2 sub-messages of one node (bundle_codec.h).
+  BeaconPosDelta = 0x09, ///< Node_Pos_Delta: low bits of the position within a Pos_Full run; 13 B payload.
+  BeaconFec     = 0x0A,  ///< Node_Fec: one frame in a Reed-Solomon envelope (fec_codec.h).
 };
 
+/** Number of msg_type values (7-bit field): size of tables indexed by msg_type. */
+constexpr size_t kMsgTypeCount = 128;
+
+namespace header_detail {
+constexpr uint64_t msg_type_bit(MsgType t) { return 1ull << static_cast<uint8_t>(t); }
+} // namespace header_detail
+
+/**
+ * msg_types accepted on RX, one bit per value (v0.2-only, #438). Registering a type here lets
+ * decode_header pass it; domain::BeaconLogic dispatches it through its msg_type route table.
+ */
+constexpr uint64_t kRxMsgTypes = header_detail::msg_type_bit(MsgType::BeaconAlive) |
+                                 header_detail::msg_type_bit(MsgType::BeaconPosFull) |
+                                 header_detail::msg_type_bit(MsgType::BeaconStatus) |
+                                 header_detail::msg_type_bit(MsgType::BeaconBundle) |
+                                 header_detail::msg_type_bit(MsgType::BeaconPosDelta) |
+                                 header_detail::msg_type_bit(MsgType::BeaconFec);
+
+/** True if raw 7-bit msg_type \a mt is in kRxMsgTypes. */
+inline bool msg_type_rx_accepted(uint8_t mt) {
+  return mt < 64 && ((kRxMsgTypes >> mt) & 1u) != 0;
+}
+
 /** Decoded header fields (in-memory representation). */
 struct PacketHeader {
   MsgType  msg_type    = MsgType::Reserved;
-  uint8_t  reserved    = 0;
+  uint8_t  reserved    = 0;  ///< Bits [8:6]: relay hop count (frame_hops); 0 from the originator.
   uint8_t  payload_len = 0;
 };
 
 /**
- * Encode a PacketHeader into the first 2 bytes of \a out.
+ * Encode a PacketHeader into the first 2 bytes of \a out, as the originator sends it.
  *
- * @param hdr     Header to encode. reserved MUST be 0; payload_len MUST be ≤ 63.
+ * Originator frames carry hop count 0, so hdr.reserved MUST be 0. A relay does not re-encode:
+ * it copies the received frame and raises the count with set_frame_hops().
+ *
+ * @param hdr     Header to encode. reserved (hop count) MUST be 0; payload_len MUST be ≤ 63.
  * @param out     Destination buffer; MUST have at least kHeaderSize bytes.
  * @param out_cap Capacity of \a out.
  * @return true on success; false if out is null, too small, payload_len > 63, or reserved != 0.
@@ -84,9 +116,11 @@ inline bool encode_header(const PacketHeader& hdr, uint8_t* out, size_t out_cap)
 /**
  * Decode the first 2 bytes of \a in into \a hdr.
  *
- * v0.2-only RX (#438): accepts only 0x02 (BeaconAlive), 0x06 (BeaconPosFull), 0x07 (BeaconStatus).
- * Returns false for Reserved (0x00), v0.1 types (0x01, 0x03, 0x04, 0x05), or unknown (> 0x07).
- * reserved bits are stored as-is (non-zero reserved accepted per forward-compat rule).
+ * v0.2-only RX (#438): accepts only the msg_types in kRxMsgTypes: 0x02 (BeaconAlive),
+ * 0x06 (BeaconPosFull), 0x07 (BeaconStatus), 0x08 (BeaconBundle), 0x09 (BeaconPosDelta),
+ * 0x0A (BeaconFec).
+ * Returns false for Reserved (0x00), v0.1 types (0x01, 0x03, 0x04, 0x05), or unknown (> 0x0A).
+ * Bits [8:6] are stored as-is in hdr->reserved: the relay hop count, any value accepted.
  *
  * @return true if msg_type is accepted for RX; false otherwise.
  */
@@ -100,15 +134,7 @@ inline bool decode_header(const uint8_t* in, size_t in_size, PacketHeader* hdr)
   const uint8_t res = static_cast<uint8_t>((H >> 6) & 0x07u);
   const uint8_t pl  = static_cast<uint8_t>(H & 0x3Fu);
 
-  if (mt == static_cast<uint8_t>(MsgType::Reserved) ||
-      mt > static_cast<uint8_t>(MsgType::BeaconStatus)) {
-    return false;
-  }
-  // v0.2-only: reject v0.1 packet types (0x01 Core, 0x03 Tail1, 0x04 Tail2, 0x05 Info).
-  if (mt == static_cast<uint8_t>(MsgType::BeaconCore) ||
-      mt == static_cast<uint8_t>(MsgType::BeaconTail1) ||
-      mt == static_cast<uint8_t>(MsgType::BeaconTail2) ||
-      mt == static_cast<uint8_t>(MsgType::BeaconInfo)) {
+  if (!msg_type_rx_accepted(mt)) {
     return false;
   }
   hdr->msg_type    = static_cast<MsgType>(mt);
@@ -117,6 +143,25 @@ inline bool decode_header(const uint8_t* in, size_t in_size, PacketHeader* hdr)
   return true;
 }
 
+/** Highest relay hop count the 3 hop bits can carry. */
+constexpr uint8_t kMaxRelayHops = 7;
+
+/**
+ * Relay hop count of a frame: header bits [8:6], 0 on frames from their originator.
+ * A relay (domain::RelayPolicy) rebroadcasts an unchanged copy with the count incremented;
+ * v0 receivers, which ignored these bits, decode it as the original.
+ * \a frame MUST have at least kHeaderSize bytes.
+ */
+inline uint8_t frame_hops(const uint8_t* frame) {
+  return static_cast<uint8_t>(((frame[1] & 0x1u) << 2) | (frame[0] >> 6));
+}
+
+/** Rewrite the hop count (bits [8:6]) of an encoded header in place with \a hops (0–kMaxRelayHops). */
+inline void set_frame_hops(uint8_t* frame, uint8_t hops) {
+  frame[0] = static_cast<uint8_t>((frame[0] & 0x3Fu) | ((hops & 0x3u) << 6));
+  frame[1] = static_cast<uint8_t>((frame[1] & 0xFEu) | ((hops >> 2) & 0x1u));
+}
+
 /**
  * Validate that the header's payload_len matches the actual payload bytes available.
  *
@@ -0,0 +1,46 @@
+#include "pos_delta_codec.h"
+
+namespace naviga {
+namespace protocol {
+
+size_t encode_pos_delta_frame(const PosDeltaFields& fields, uint8_t* out, size_t out_cap) {
+  const size_t frame_size = fields.has_velocity ? kPosDeltaMaxFrameSize : kPosDeltaFrameSize;
+  if (!out || out_cap < frame_size) {
+    return 0;
+  }
+  PacketHeader hdr;
+  hdr.msg_type = MsgType::BeaconPosDelta;
+  hdr.reserved = 0;
+  hdr.payload_len = static_cast<uint8_t>(frame_size - kHeaderSize);
+  if (!encode_header(hdr, out, out_cap)) {
+    return 0;
+  }
+  uint8_t* p = out + kHeaderSize;
+  PosDeltaWire::encode(fields, p);
+  if (fields.has_velocity) {
+    PosDeltaVelocityWire::encode(fields, p);
+  }
+  return frame_size;
+}
+
+PosDeltaDecodeError decode_pos_delta_payload(const uint8_t* payload, size_t payload_len,
+                                             PosDeltaFields* out) {
+  if (!payload || !out || payload_len < kPosDeltaPayloadSize) {
+    return PosDeltaDecodeError::ShortBuffer;
+  }
+  if (!PosDeltaWire::valid(payload)) {
+    return PosDeltaDecodeError::BadPayloadVersion;
+  }
+  PosDeltaWire::decode(payload, out);
+  out->has_velocity = payload_len >= PosDeltaVelocityWire::kEnd;
+  if (out->has_velocity) {
+    PosDeltaVelocityWire::decode(payload, out);
+  } else {
+    out->vel_lat = 0;
+    out->vel_lon = 0;
+  }
+  return PosDeltaDecodeError::Ok;
+}
+
+} // namespace protocol
+} // namespace naviga
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "packet_header.h"
+#include "pos_predict.h"
+#include "wire_schema.h"
+
+namespace naviga {
+namespace protocol {
+
+/**
+ * Node_Pos_Delta (0x09) — compact position: low bits of the Pos_Full u24 lat/lon.
+ *
+ * Payload: 9 B common (payloadVersion, nodeId48, seq16) + ref_seq8 (1 B) + 3 B packed LE:
+ *   lat_lsb [11:0] | lon_lsb [23:12]
+ * ref_seq8 is the low byte of the seq16 of the Node_Pos_Full the delta belongs to (its run).
+ * The sender keeps every delta of a run within kPosDeltaHalfRange / 2 of the run's Pos_Full,
+ * so any two frames of a run are less than kPosDeltaHalfRange apart. The receiver turns the low
+ * bits into a signed offset from the position it holds (pos_delta_resolve): the nearest u24 with
+ * those low 12 bits, exact when that position belongs to the same run. It applies a delta only
+ * if it holds that Pos_Full (ref_seq8 and a seq gap check), so a lost delta does not invalidate
+ * the following ones of the run, and a lost Pos_Full invalidates the whole run.
+ * Total payload 13 B; on-air 15 B with 2-byte header (vs 19 B Node_Pos_Full).
+ *
+ * No Pos_Quality: the receiver keeps the quality from the last Pos_Full.
+ * Optional trailing Pos_Velocity (3 B, payload 16 B) as on Node_Pos_Full.
+ */
+struct PosDeltaFields {
+  uint64_t node_id = 0;
+  uint16_t seq16   = 0;
+  uint8_t  ref_seq8 = 0;  ///< Low byte of the seq16 of the run's Node_Pos_Full.
+  uint16_t lat_lsb = 0;  ///< Low 12 bits of Pos_Full lat_u24.
+  uint16_t lon_lsb = 0;  ///< Low 12 bits of Pos_Full lon_u24.
+  bool has_velocity = false;  ///< Pos_Velocity trailer present / to be sent.
+  int16_t vel_lat = 0;
+  int16_t vel_lon = 0;
+};
+
+constexpr uint8_t kPosDeltaPayloadVersion = 0x00;
+constexpr uint32_t kPosDeltaLsbMask = 0x0FFFu;
+
+/** Node_Pos_Delta payload schema (wire_schema.h). */
+typedef wire::Layout<0,
+    wire::Const<8, kPosDeltaPayloadVersion>,
+    wire::Field<PosDeltaFields, uint64_t, &PosDeltaFields::node_id, 48>,
+    wire::Field<PosDeltaFields, uint16_t, &PosDeltaFields::seq16, 16>,
+    wire::Field<PosDeltaFields, uint8_t, &PosDeltaFields::ref_seq8, 8>,
+    wire::Field<PosDeltaFields, uint16_t, &PosDeltaFields::lat_lsb, 12>,
+    wire::Field<PosDeltaFields, uint16_t, &PosDeltaFields::lon_lsb, 12>>
+    PosDeltaWire;
+typedef wire::Layout<PosDeltaWire::kEnd,
+    wire::Field<PosDeltaFields, int16_t, &PosDeltaFields::vel_lat, 12, VelocityAsS12>,
+    wire::Field<PosDeltaFields, int16_t, &PosDeltaFields::vel_lon, 12, VelocityAsS12>>
+    PosDeltaVelocityWire;
+
+constexpr size_t kPosDeltaPayloadSize = PosDeltaWire::kSize;
+constexpr size_t kPosDeltaFrameSize = kHeaderSize + kPosDeltaPayloadSize;
+constexpr size_t kPosDeltaMaxFrameSize = kHeaderSize + PosDeltaVelocityWire::kEnd;  ///< With velocity.
+static_assert(kPosDeltaPayloadSize == 13, "Node_Pos_Delta payload is 13 bytes");
+constexpr int32_t kPosDeltaHalfRange = 2048;  ///< Max |offset| (u24 units) a receiver can resolve.
+
+enum class PosDeltaDecodeError {
+  Ok = 0,
+  ShortBuffer,
+  BadPayloadVersion,
+};
+
+/**
+ * u24 closest to ref_u24 whose low 12 bits are lsb, i.e. ref_u24 plus a signed offset in
+ * [-2048, 2047]. @return false if that falls outside the u24 range.
+ */
+inline bool pos_delta_resolve(uint32_t ref_u24, uint16_t lsb, uint32_t* out_u24) {
+  int32_t d = static_cast<int32_t>((lsb - ref_u24) & kPosDeltaLsbMask);
+  if (d >= kPosDeltaHalfRange) {
+    d -= 2 * kPosDeltaHalfRange;
+  }
+  const int32_t v = static_cast<int32_t>(ref_u24) + d;
+  if (v < 0 || v > 0xFFFFFF) {
+    return false;
+  }
+  *out_u24 = static_cast<uint32_t>(v);
+  return true;
+}
+
+/** Encode a complete Node_Pos_Delta frame (2-byte header + 13-byte payload, 16 with has_velocity). */
+size_t encode_pos_delta_frame(const PosDeltaFields& fields, uint8_t* out, size_t out_cap);
+
+/**
+ * Decode Node_Pos_Delta payload (13 bytes, 16 with Pos_Velocity; without header).
+ * Caller must have verified msg_type == BeaconPosDelta.
+ */
+PosDeltaDecodeError decode_pos_delta_payload(const uint8_t* payload, size_t payload_len,
+                                             PosDeltaFields* out);
+
+} // namespace protocol
+} // namespace naviga
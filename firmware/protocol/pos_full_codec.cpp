@@ -1,60 +1,26 @@
 #include "pos_full_codec.h"
 
-#include <cmath>
-
 namespace naviga {
 namespace protocol {
 
-namespace pos_full_detail {
-
-constexpr double kMaxU24 = 16777215.0;
-
-double clamp_lat(double v) {
-  if (v < -90.0) return -90.0;
-  if (v > 90.0) return 90.0;
-  return v;
-}
-double clamp_lon(double v) {
-  if (v < -180.0) return -180.0;
-  if (v > 180.0) return 180.0;
-  return v;
-}
-uint32_t lat_to_u24(double lat_deg) {
-  return static_cast<uint32_t>(std::round((clamp_lat(lat_deg) + 90.0) / 180.0 * kMaxU24));
-}
-uint32_t lon_to_u24(double lon_deg) {
-  return static_cast<uint32_t>(std::round((clamp_lon(lon_deg) + 180.0) / 360.0 * kMaxU24));
-}
-double u24_to_lat(uint32_t v) {
-  return static_cast<double>(v) / kMaxU24 * 180.0 - 90.0;
-}
-double u24_to_lon(uint32_t v) {
-  return static_cast<double>(v) / kMaxU24 * 360.0 - 180.0;
-}
-
-} // namespace pos_full_detail
-
 size_t encode_pos_full_frame(const PosFullFields& fields, uint8_t* out, size_t out_cap) {
-  if (!out || out_cap < kPosFullFrameSize) {
+  const size_t frame_size = fields.has_velocity ? kPosFullMaxFrameSize : kPosFullFrameSize;
+  if (!out || out_cap < frame_size) {
     return 0;
   }
   PacketHeader hdr;
   hdr.msg_type = MsgType::BeaconPosFull;
   hdr.reserved = 0;
-  hdr.payload_len = static_cast<uint8_t>(kPosFullPayloadSize);
+  hdr.payload_len = static_cast<uint8_t>(frame_size - kHeaderSize);
   if (!encode_header(hdr, out, out_cap)) {
     return 0;
   }
   uint8_t* p = out + kHeaderSize;
-  p[0] = kPosFullPayloadVersion;
-  wire::write_nodeid48_le(p + 1, fields.node_id);
-  wire::write_u16_le(p + 7, fields.seq16);
-  wire::write_u24_le(p + 9, pos_full_detail::lat_to_u24(fields.lat_deg));
-  wire::write_u24_le(p + 12, pos_full_detail::lon_to_u24(fields.lon_deg));
-  pack_pos_quality_le(fields.fix_type, fields.pos_sats,
-                      fields.pos_accuracy_bucket, fields.pos_flags_small,
-                      p + 15);
-  return kPosFullFrameSize;
+  PosFullWire::encode(fields, p);
+  if (fields.has_velocity) {
+    PosFullVelocityWire::encode(fields, p);
+  }
+  return frame_size;
 }
 
 PosFullDecodeError decode_pos_full_payload(const uint8_t* payload, size_t payload_len,
@@ -62,23 +28,52 @@ PosFullDecodeError decode_pos_full_payload(const uint8_t* payload, size_t payloa
   if (!payload || !out || payload_len < kPosFullPayloadSize) {
     return PosFullDecodeError::ShortBuffer;
   }
-  if (payload[0] != kPosFullPayloadVersion) {
+  if (!PosFullWire::valid(payload)) {
     return PosFullDecodeError::BadPayloadVersion;
   }
-  out->node_id = wire::read_nodeid48_le(payload + 1);
-  out->seq16 = wire::read_u16_le(payload + 7);
-  const uint32_t lat_u24 = wire::read_u24_le(payload + 9);
-  const uint32_t lon_u24 = wire::read_u24_le(payload + 12);
-  if (lat_u24 > static_cast<uint32_t>(pos_full_detail::kMaxU24) || lon_u24 > static_cast<uint32_t>(pos_full_detail::kMaxU24)) {
-    return PosFullDecodeError::InvalidRange;
+  PosFullWire::decode(payload, out);
+  out->has_velocity = payload_len >= PosFullVelocityWire::kEnd;
+  if (out->has_velocity) {
+    PosFullVelocityWire::decode(payload, out);
+  } else {
+    out->vel_lat = 0;
+    out->vel_lon = 0;
   }
-  out->lat_deg = pos_full_detail::u24_to_lat(lat_u24);
-  out->lon_deg = pos_full_detail::u24_to_lon(lon_u24);
-  unpack_pos_quality_le(payload + 15,
-                       &out->fix_type, &out->pos_sats,
-                       &out->pos_accuracy_bucket, &out->pos_flags_small);
   return PosFullDecodeError::Ok;
 }
 
+uint8_t pos_accuracy_bucket_from_mm(uint32_t h_acc_mm) {
+  static const uint32_t kUpperMm[] = {1000, 2000, 5000, 10000, 20000, 50000};
+  if (h_acc_mm == 0) {
+    return 0;
+  }
+  uint8_t bucket = 7;
+  for (uint32_t upper : kUpperMm) {
+    if (h_acc_mm < upper) {
+      return bucket;
+    }
+    --bucket;
+  }
+  return 1;
+}
+
+PosQuality make_pos_quality(uint8_t fix_type, uint8_t num_sv, uint32_t h_acc_mm, uint32_t g_speed_mm_s) {
+  PosQuality q;
+  q.fix_type = fix_type & 0x07u;
+  q.pos_sats = num_sv > 63 ? 63 : num_sv;
+  q.pos_accuracy_bucket = pos_accuracy_bucket_from_mm(h_acc_mm);
+  if (fix_type == kPosFixNone) {
+    return q;
+  }
+  q.pos_flags_small = kPosFlagValid;
+  if (g_speed_mm_s > kPosMovingMinMmS) {
+    q.pos_flags_small |= kPosFlagMoving;
+  }
+  if (h_acc_mm != 0 && (q.pos_accuracy_bucket <= 3 || q.pos_sats < 5)) {
+    q.pos_flags_small |= kPosFlagDegraded;
+  }
+  return q;
+}
+
 } // namespace protocol
 } // namespace naviga
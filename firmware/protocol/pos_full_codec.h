@@ -3,8 +3,10 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "geo_u24.h"
 #include "packet_header.h"
-#include "wire_helpers.h"
+#include "pos_predict.h"
+#include "wire_schema.h"
 
 namespace naviga {
 namespace protocol {
@@ -16,55 +18,58 @@ namespace protocol {
  * Total payload 17 B; on-air 19 B with 2-byte header (msg_type=0x06).
  *
  * Pos_Quality 2 B LE: fix_type [2:0], pos_sats [8:3], pos_accuracy_bucket [11:9], pos_flags_small [15:12].
+ *
+ * Optional trailing Pos_Velocity (3 B, payload 20 B, pos_predict.h) from predictive senders.
+ * Decoders read it when present and ignore further trailing bytes.
  */
 struct PosFullFields {
   uint64_t node_id  = 0;
   uint16_t seq16    = 0;
-  double   lat_deg  = 0.0;
-  double   lon_deg  = 0.0;
+  int32_t  lat_e7   = 0;             ///< 1e-7 degrees; clamped on encode.
+  int32_t  lon_e7   = 0;
   uint8_t  fix_type = 0;             ///< 3 bits (0=no_fix, 1=2d, 2=3d).
   uint8_t  pos_sats = 0;             ///< 6 bits (0–63).
   uint8_t  pos_accuracy_bucket = 0;   ///< 3 bits.
   uint8_t  pos_flags_small    = 0;   ///< 4 bits.
+  bool     has_velocity = false;     ///< Pos_Velocity trailer present / to be sent.
+  int16_t  vel_lat = 0;              ///< PosVelocity::lat.
+  int16_t  vel_lon = 0;              ///< PosVelocity::lon.
 };
 
 constexpr uint8_t kPosFullPayloadVersion = 0x00;
-constexpr size_t kPosFullPayloadSize = 17;
-constexpr size_t kPosFullFrameSize = kHeaderSize + kPosFullPayloadSize;
 
-/** Pack Pos_Quality into 2 bytes LE. */
-inline void pack_pos_quality_le(uint8_t fix_type, uint8_t pos_sats,
-                                uint8_t pos_accuracy_bucket, uint8_t pos_flags_small,
-                                uint8_t* out) {
-  const uint16_t w = (static_cast<uint16_t>(fix_type & 0x07u)) |
-                     (static_cast<uint16_t>(pos_sats & 0x3Fu) << 3) |
-                     (static_cast<uint16_t>(pos_accuracy_bucket & 0x07u) << 9) |
-                     (static_cast<uint16_t>(pos_flags_small & 0x0Fu) << 12);
-  out[0] = static_cast<uint8_t>(w & 0xFFu);
-  out[1] = static_cast<uint8_t>((w >> 8) & 0xFFu);
-}
-
-/** Unpack Pos_Quality from 2 bytes LE. */
-inline void unpack_pos_quality_le(const uint8_t* in,
-                                  uint8_t* fix_type, uint8_t* pos_sats,
-                                  uint8_t* pos_accuracy_bucket, uint8_t* pos_flags_small) {
-  const uint16_t w = static_cast<uint16_t>(in[0]) | (static_cast<uint16_t>(in[1]) << 8);
-  *fix_type = static_cast<uint8_t>(w & 0x07u);
-  *pos_sats = static_cast<uint8_t>((w >> 3) & 0x3Fu);
-  *pos_accuracy_bucket = static_cast<uint8_t>((w >> 9) & 0x07u);
-  *pos_flags_small = static_cast<uint8_t>((w >> 12) & 0x0Fu);
-}
+/** Node_Pos_Full payload schema (wire_schema.h): common prefix, lat/lon u24, Pos_Quality. */
+typedef wire::Layout<0,
+    wire::Const<8, kPosFullPayloadVersion>,
+    wire::Field<PosFullFields, uint64_t, &PosFullFields::node_id, 48>,
+    wire::Field<PosFullFields, uint16_t, &PosFullFields::seq16, 16>,
+    wire::Field<PosFullFields, int32_t, &PosFullFields::lat_e7, 24, LatE7AsU24>,
+    wire::Field<PosFullFields, int32_t, &PosFullFields::lon_e7, 24, LonE7AsU24>,
+    wire::Field<PosFullFields, uint8_t, &PosFullFields::fix_type, 3>,
+    wire::Field<PosFullFields, uint8_t, &PosFullFields::pos_sats, 6>,
+    wire::Field<PosFullFields, uint8_t, &PosFullFields::pos_accuracy_bucket, 3>,
+    wire::Field<PosFullFields, uint8_t, &PosFullFields::pos_flags_small, 4>>
+    PosFullWire;
+typedef wire::Layout<PosFullWire::kEnd,
+    wire::Field<PosFullFields, int16_t, &PosFullFields::vel_lat, 12, VelocityAsS12>,
+    wire::Field<PosFullFields, int16_t, &PosFullFields::vel_lon, 12, VelocityAsS12>>
+    PosFullVelocityWire;
+
+constexpr size_t kPosFullPayloadSize = PosFullWire::kSize;
+constexpr size_t kPosFullFrameSize = kHeaderSize + kPosFullPayloadSize;
+constexpr size_t kPosFullMaxFrameSize = kHeaderSize + PosFullVelocityWire::kEnd;  ///< With velocity.
+static_assert(kPosFullPayloadSize == 17, "Node_Pos_Full payload is 17 bytes");
 
 enum class PosFullDecodeError {
   Ok = 0,
   ShortBuffer,
   BadPayloadVersion,
-  InvalidRange,
+  InvalidRange,  ///< Not produced: any 24-bit lat/lon is in range.
 };
 
 /**
- * Encode a complete Node_Pos_Full frame (2-byte header + 17-byte payload).
- * Uses same lat/lon encoding as GeoBeacon (u24 from degrees).
+ * Encode a complete Node_Pos_Full frame (2-byte header + 17-byte payload, 20 with has_velocity).
+ * Uses same lat/lon encoding as GeoBeacon (u24 from e7 degrees, geo_u24.h).
  */
 size_t encode_pos_full_frame(const PosFullFields& fields, uint8_t* out, size_t out_cap);
 
@@ -75,5 +80,86 @@ size_t encode_pos_full_frame(const PosFullFields& fields, uint8_t* out, size_t o
 PosFullDecodeError decode_pos_full_payload(const uint8_t* payload, size_t payload_len,
                                            PosFullFields* out);
 
+/** Pos_Quality of a Node_Pos_Full (see PosFullFields). */
+struct PosQuality {
+  uint8_t fix_type = 0;
+  uint8_t pos_sats = 0;
+  uint8_t pos_accuracy_bucket = 0;
+  uint8_t pos_flags_small = 0;
+};
+
+/** Pos_Quality fix_type values (gnss_tail_completeness_and_budgets_s03 §1). */
+constexpr uint8_t kPosFixNone = 0;
+constexpr uint8_t kPosFix2D = 1;
+constexpr uint8_t kPosFix3D = 2;
+
+/** pos_flags_small bits (gnss_tail_completeness_and_budgets_s03 §4). */
+constexpr uint8_t kPosFlagValid = 0x01;
+constexpr uint8_t kPosFlagMoving = 0x02;     ///< Ground speed above kPosMovingMinMmS.
+constexpr uint8_t kPosFlagEstimated = 0x04;  ///< Not a pure GNSS fix (e.g. dead reckoning).
+constexpr uint8_t kPosFlagDegraded = 0x08;   ///< Accuracy bucket 1–3 or fewer than 5 sats.
+
+constexpr uint32_t kPosMovingMinMmS = 500;
+
+/**
+ * pos_accuracy_bucket for a horizontal accuracy estimate (§3): 0 unknown, 1 > 50 m, 2 20–50 m,
+ * 3 10–20 m, 4 5–10 m, 5 2–5 m, 6 1–2 m, 7 < 1 m. A bound belongs to the coarser bucket.
+ */
+uint8_t pos_accuracy_bucket_from_mm(uint32_t h_acc_mm);
+
+/**
+ * Pos_Quality of a GNSS solution. fix_type uses the wire values above; num_sv saturates at 63.
+ * h_acc_mm 0 = accuracy unknown: bucket 0, and neither it nor num_sv marks the fix degraded.
+ */
+PosQuality make_pos_quality(uint8_t fix_type, uint8_t num_sv, uint32_t h_acc_mm, uint32_t g_speed_mm_s);
+
+/**
+ * Read-only view of a received Node_Pos_Full payload: the zero-copy alternative to
+ * decode_pos_full_payload. Length and payloadVersion are checked once on construction; each
+ * accessor reads its field from the payload bytes when called, so a receiver that stops at
+ * node_id()/seq16() (duplicate, old seq) never converts lat/lon. The payload must outlive the
+ * view; accessors require error() == Ok.
+ */
+class PosFullView {
+ public:
+  PosFullView(const uint8_t* payload, size_t payload_len)
+      : payload_(payload),
+        has_velocity_(payload_len >= PosFullVelocityWire::kEnd),
+        error_(!payload || payload_len < kPosFullPayloadSize ? PosFullDecodeError::ShortBuffer
+               : !PosFullWire::valid(payload)              ? PosFullDecodeError::BadPayloadVersion
+                                                            : PosFullDecodeError::Ok) {}
+
+  PosFullDecodeError error() const { return error_; }
+  bool ok() const { return error_ == PosFullDecodeError::Ok; }
+
+  uint64_t node_id() const { return PosFullWire::read<1>(payload_); }
+  uint16_t seq16() const { return PosFullWire::read<2>(payload_); }
+  int32_t lat_e7() const { return PosFullWire::read<3>(payload_); }
+  int32_t lon_e7() const { return PosFullWire::read<4>(payload_); }
+  PosQuality quality() const {
+    PosQuality q;
+    q.fix_type = PosFullWire::read<5>(payload_);
+    q.pos_sats = PosFullWire::read<6>(payload_);
+    q.pos_accuracy_bucket = PosFullWire::read<7>(payload_);
+    q.pos_flags_small = PosFullWire::read<8>(payload_);
+    return q;
+  }
+  bool has_velocity() const { return has_velocity_; }
+  /** Zero velocity when !has_velocity(). */
+  PosVelocity velocity() const {
+    PosVelocity v;
+    if (has_velocity_) {
+      v.lat = PosFullVelocityWire::read<0>(payload_);
+      v.lon = PosFullVelocityWire::read<1>(payload_);
+    }
+    return v;
+  }
+
+ private:
+  const uint8_t* payload_;
+  bool has_velocity_;
+  PosFullDecodeError error_;
+};
+
 } // namespace protocol
 } // namespace naviga
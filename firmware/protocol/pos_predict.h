@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "geo_u24.h"
+
+namespace naviga {
+namespace protocol {
+
+/**
+ * Pos_Velocity and the constant-velocity predictor shared by sender and receivers (dead
+ * reckoning).
+ *
+ * Velocity is an optional 3-byte trailer on Node_Pos_Full and Node_Pos_Delta payloads:
+ *   vel_lat [11:0] | vel_lon [23:12], signed, in 1/16 packed24 units per second
+ * i.e. 0.075 m/s north/south and 0.15 m/s * cos(lat) east/west per step; ±2047 covers
+ * ±150 m/s. Decoders that predate it ignore trailing bytes, so frames with and without it
+ * interoperate.
+ *
+ * The prediction runs on the packed24 grid the position is sent on, in integers:
+ *   u24(t) = u24 + vel * min(t - t0, kPosPredictMaxMs) / 16000   (rounded, clamped to u24)
+ * so the sender computes exactly the position a receiver displays, and sends a new anchor
+ * only when that is off by more than its displacement threshold. t0 is the sender's anchor
+ * time and the receiver's reception time; they differ by the queueing delay only.
+ */
+struct PosVelocity {
+  int16_t lat = 0;  ///< 1/16 lat_u24 per second, north positive.
+  int16_t lon = 0;  ///< 1/16 lon_u24 per second, east positive.
+};
+
+constexpr size_t kPosVelocitySize = 3;
+constexpr int16_t kPosVelocityMax = 2047;
+constexpr int64_t kPosVelocityScale = 16;
+/** Horizon: a silent peer is extrapolated this far at most (past it, frames were lost). */
+constexpr uint32_t kPosPredictMaxMs = 120000;
+
+/** wire::Field conversion for a velocity component as signed 12 bits. */
+struct VelocityAsS12 {
+  static uint64_t to_wire(int16_t v) { return static_cast<uint64_t>(static_cast<uint16_t>(v)) & 0x0FFFu; }
+  static int16_t from_wire(uint64_t w) {
+    return static_cast<int16_t>((w & 0x0800u) ? static_cast<int32_t>(w & 0x0FFFu) - 0x1000
+                                              : static_cast<int32_t>(w & 0x0FFFu));
+  }
+};
+
+namespace pos_predict_detail {
+
+inline int16_t clamp_velocity(int64_t v) {
+  return static_cast<int16_t>(v < -kPosVelocityMax ? -kPosVelocityMax
+                              : v > kPosVelocityMax ? kPosVelocityMax : v);
+}
+
+/** Rounded (half away from zero) n / d, d > 0. */
+inline int64_t div_round(int64_t n, int64_t d) {
+  return n >= 0 ? (n + d / 2) / d : -((-n + d / 2) / d);
+}
+
+/** Velocity over dt_ms for a displacement of d_e7 on an axis spanning 2 * max_e7. */
+inline int16_t velocity_from_e7(int64_t d_e7, uint32_t dt_ms, int32_t max_e7) {
+  // |d_e7| <= 3 degrees keeps the product below 2^63; larger moves saturate at any usable dt.
+  const int64_t kMaxD = 30000000;
+  d_e7 = d_e7 < -kMaxD ? -kMaxD : d_e7 > kMaxD ? kMaxD : d_e7;
+  const int64_t den = 2 * static_cast<int64_t>(max_e7) * static_cast<int64_t>(dt_ms);
+  return clamp_velocity(div_round(d_e7 * kGeoU24Max * kPosVelocityScale * 1000, den));
+}
+
+} // namespace pos_predict_detail
+
+/** u24 advanced by vel for dt_ms (capped at kPosPredictMaxMs), clamped to the u24 range. */
+inline uint32_t pos_predict_u24(uint32_t u24, int16_t vel, uint32_t dt_ms) {
+  const uint32_t dt = dt_ms < kPosPredictMaxMs ? dt_ms : kPosPredictMaxMs;
+  const int64_t p = static_cast<int64_t>(u24) +
+                    pos_predict_detail::div_round(static_cast<int64_t>(vel) * dt, kPosVelocityScale * 1000);
+  return static_cast<uint32_t>(p < 0 ? 0 : p > kGeoU24Max ? kGeoU24Max : p);
+}
+
+/** Position (e7) at dt_ms after (lat_e7, lon_e7), on the packed24 grid receivers use. */
+inline void pos_predict_e7(int32_t lat_e7, int32_t lon_e7, const PosVelocity& vel, uint32_t dt_ms,
+                           int32_t* out_lat_e7, int32_t* out_lon_e7) {
+  *out_lat_e7 = u24_to_lat_e7(pos_predict_u24(lat_e7_to_u24(lat_e7), vel.lat, dt_ms));
+  *out_lon_e7 = u24_to_lon_e7(pos_predict_u24(lon_e7_to_u24(lon_e7), vel.lon, dt_ms));
+}
+
+/** Velocity of a move from (lat0, lon0) to (lat1, lon1) in dt_ms (> 0), clamped to ±kPosVelocityMax. */
+inline PosVelocity pos_velocity_from_e7(int32_t lat0_e7, int32_t lon0_e7,
+                                        int32_t lat1_e7, int32_t lon1_e7, uint32_t dt_ms) {
+  PosVelocity v;
+  if (dt_ms == 0) {
+    return v;
+  }
+  v.lat = pos_predict_detail::velocity_from_e7(static_cast<int64_t>(lat1_e7) - lat0_e7, dt_ms, kLatE7Max);
+  v.lon = pos_predict_detail::velocity_from_e7(static_cast<int64_t>(lon1_e7) - lon0_e7, dt_ms, kLonE7Max);
+  return v;
+}
+
+} // namespace protocol
+} // namespace naviga
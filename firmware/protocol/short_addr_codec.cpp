@@ -0,0 +1,72 @@
+#include "short_addr_codec.h"
+
+#include <cstring>
+
+namespace naviga {
+namespace protocol {
+
+size_t short_addr_compact(const uint8_t* frame, size_t frame_len, uint16_t short_id,
+                          uint8_t* out, size_t out_cap) {
+  PacketHeader hdr;
+  if (!frame || !out || !decode_header(frame, frame_len, &hdr) ||
+      !validate_header(hdr, frame_len - kHeaderSize) || hdr.payload_len < kFullAddrPrefixSize) {
+    return 0;
+  }
+  const uint8_t* payload = frame + kHeaderSize;
+  if (payload[0] != 0x00) {
+    return 0;  // already short-addressed, or a payloadVersion this layout does not know
+  }
+  const size_t rest = hdr.payload_len - kFullAddrPrefixSize;
+  const size_t len = kHeaderSize + kShortAddrPrefixSize + rest;
+  if (out_cap < len) {
+    return 0;
+  }
+  const uint64_t node_id = wire::read_nodeid48_le(payload + 1);
+  // Copy the tail first: out may alias frame.
+  std::memmove(out + kHeaderSize + kShortAddrPrefixSize, payload + kFullAddrPrefixSize, rest);
+  hdr.reserved = 0;
+  hdr.payload_len = static_cast<uint8_t>(kShortAddrPrefixSize + rest);
+  encode_header(hdr, out, out_cap);
+  out[kHeaderSize] = static_cast<uint8_t>(kShortAddrFlag | short_addr_tag(node_id));
+  wire::write_u16_le(out + kHeaderSize + 1, short_id);
+  return len;
+}
+
+bool short_addr_peek(const uint8_t* payload, size_t payload_len, uint16_t* out_short_id,
+                     uint8_t* out_tag) {
+  if (!is_short_addr_payload(payload, payload_len)) {
+    return false;
+  }
+  if (out_short_id) { *out_short_id = wire::read_u16_le(payload + 1); }
+  if (out_tag)      { *out_tag = static_cast<uint8_t>(payload[0] & kShortAddrTagMask); }
+  return true;
+}
+
+size_t short_addr_expand(const uint8_t* frame, size_t frame_len, uint64_t node_id,
+                         uint8_t* out, size_t out_cap) {
+  PacketHeader hdr;
+  if (!frame || !out || !decode_header(frame, frame_len, &hdr) ||
+      !validate_header(hdr, frame_len - kHeaderSize) ||
+      !is_short_addr_payload(frame + kHeaderSize, hdr.payload_len)) {
+    return 0;
+  }
+  const size_t rest = hdr.payload_len - kShortAddrPrefixSize;
+  if (kFullAddrPrefixSize + rest > kMaxPayloadLen) {
+    return 0;
+  }
+  const size_t len = kHeaderSize + kFullAddrPrefixSize + rest;
+  if (out_cap < len || out == frame) {
+    return 0;
+  }
+  hdr.reserved = 0;
+  hdr.payload_len = static_cast<uint8_t>(kFullAddrPrefixSize + rest);
+  encode_header(hdr, out, out_cap);
+  out[kHeaderSize] = 0x00;
+  wire::write_nodeid48_le(out + kHeaderSize + 1, node_id);
+  std::memcpy(out + kHeaderSize + kFullAddrPrefixSize,
+              frame + kHeaderSize + kShortAddrPrefixSize, rest);
+  return len;
+}
+
+} // namespace protocol
+} // namespace naviga
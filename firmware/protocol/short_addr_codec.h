@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "packet_header.h"
+#include "wire_helpers.h"
+
+namespace naviga {
+namespace protocol {
+
+/**
+ * Short-addressed v0.2 frames — any v0.2 payload (0x02, 0x06–0x09) with its 7-byte
+ * payloadVersion + nodeId48 prefix replaced by 3 bytes:
+ *   byte 0    0x80 | tag   tag = low 7 bits of nodeId48 (disambiguates short_id collisions)
+ *   bytes 1-2 short_id     CRC16 ShortId of nodeId48 (nodeid_policy_v0 §4), LE
+ * The rest of the payload (from seq16 on) is unchanged. Bit 7 of the first payload byte never
+ * occurs in a full-id payload (payloadVersion is 0x00), so receivers tell the two apart, and
+ * receivers without short-address support drop these frames as a bad payloadVersion.
+ *
+ * Saves 4 B per frame (Node_Pos_Full 19 → 15 B on air). The receiver needs the full id from an
+ * earlier full-id frame of the same node to resolve (short_id, tag); see NodeTable.
+ */
+constexpr uint8_t kShortAddrFlag = 0x80;
+constexpr uint8_t kShortAddrTagMask = 0x7F;
+constexpr size_t kFullAddrPrefixSize = 7;   ///< payloadVersion + nodeId48.
+constexpr size_t kShortAddrPrefixSize = 3;  ///< flag|tag + short_id.
+constexpr size_t kShortAddrSavedBytes = kFullAddrPrefixSize - kShortAddrPrefixSize;
+
+/** Disambiguator carried next to short_id: low 7 bits of the node id. */
+inline uint8_t short_addr_tag(uint64_t node_id) {
+  return static_cast<uint8_t>(node_id & kShortAddrTagMask);
+}
+
+/** True if payload (without header) is short-addressed. */
+inline bool is_short_addr_payload(const uint8_t* payload, size_t payload_len) {
+  return payload && payload_len >= kShortAddrPrefixSize && (payload[0] & kShortAddrFlag) != 0;
+}
+
+/**
+ * Rewrite a full-id v0.2 frame (header + payload, payloadVersion 0) as a short-addressed frame
+ * in out. short_id must be the sender's ShortId; the tag is taken from the frame's nodeId48.
+ * @return frame length, or 0 if the frame is not a full-id v0.2 frame or out_cap is too small.
+ */
+size_t short_addr_compact(const uint8_t* frame, size_t frame_len, uint16_t short_id,
+                          uint8_t* out, size_t out_cap);
+
+/**
+ * Read short_id and tag from a short-addressed payload (without header).
+ * @return false if the payload is not short-addressed.
+ */
+bool short_addr_peek(const uint8_t* payload, size_t payload_len, uint16_t* out_short_id,
+                     uint8_t* out_tag);
+
+/**
+ * Rebuild the full-id frame of a short-addressed frame (header + payload) for node_id, as the
+ * sender queued it.
+ * @return frame length, or 0 if the frame is not short-addressed, the result exceeds
+ *         kMaxPayloadLen, or out_cap is too small.
+ */
+size_t short_addr_expand(const uint8_t* frame, size_t frame_len, uint64_t node_id,
+                         uint8_t* out, size_t out_cap);
+
+} // namespace protocol
+} // namespace naviga
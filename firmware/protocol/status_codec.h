@@ -4,7 +4,7 @@
 #include <cstdint>
 
 #include "packet_header.h"
-#include "wire_helpers.h"
+#include "wire_schema.h"
 
 namespace naviga {
 namespace protocol {
@@ -17,6 +17,10 @@ namespace protocol {
  *   uptime10m (1), role_id (1), maxSilence10s (1), hwProfileId (2 LE), fwVersionId (2 LE).
  * Total payload 19 B; on-air 21 B (msg_type=0x07).
  * hw_profile_id / fw_version_id remain uint16 per canon.
+ *
+ * Optional trailing radioCaps (1 B, payload 20 B) for link-adaptive preset selection; sent
+ * only when non-zero. Decoders read it when present and ignore further trailing bytes, so
+ * 19-byte and 20-byte payloads interoperate.
  */
 struct StatusFields {
   uint64_t node_id = 0;
@@ -29,11 +33,57 @@ struct StatusFields {
   uint8_t  max_silence_10s = 0;
   uint16_t hw_profile_id = 0xFFFF;
   uint16_t fw_version_id = 0xFFFF;
+  uint8_t  radio_caps = 0;               ///< See radio_caps_*; 0 = not advertised (not sent).
 };
 
 constexpr uint8_t kStatusPayloadVersion = 0x00;
-constexpr size_t kStatusPayloadSize = 19;
+
+/** Node_Status payload schema (wire_schema.h), and the optional trailing radioCaps. */
+typedef wire::Layout<0,
+    wire::Const<8, kStatusPayloadVersion>,
+    wire::Field<StatusFields, uint64_t, &StatusFields::node_id, 48>,
+    wire::Field<StatusFields, uint16_t, &StatusFields::seq16, 16>,
+    wire::Field<StatusFields, uint8_t, &StatusFields::battery_percent, 8>,
+    wire::Field<StatusFields, uint8_t, &StatusFields::battery_est_rem_time, 8>,
+    wire::Field<StatusFields, uint8_t, &StatusFields::tx_power_ch_throttle, 8>,
+    wire::Field<StatusFields, uint8_t, &StatusFields::uptime10m, 8>,
+    wire::Field<StatusFields, uint8_t, &StatusFields::role_id, 8>,
+    wire::Field<StatusFields, uint8_t, &StatusFields::max_silence_10s, 8>,
+    wire::Field<StatusFields, uint16_t, &StatusFields::hw_profile_id, 16>,
+    wire::Field<StatusFields, uint16_t, &StatusFields::fw_version_id, 16>>
+    StatusWire;
+typedef wire::Layout<StatusWire::kEnd,
+    wire::Field<StatusFields, uint8_t, &StatusFields::radio_caps, 8>>
+    StatusRadioCapsWire;
+
+constexpr size_t kStatusPayloadSize = StatusWire::kSize;
 constexpr size_t kStatusFrameSize = kHeaderSize + kStatusPayloadSize;
+constexpr size_t kStatusMaxFrameSize = kHeaderSize + StatusRadioCapsWire::kEnd;  ///< With radioCaps.
+static_assert(kStatusPayloadSize == 19, "Node_Status payload is 19 bytes");
+
+/**
+ * radioCaps: bits 0-2 presets the node can switch to (bit n = RadioPresetId n; bit 0, Default,
+ * always set, so a present byte is never 0), bits 3-4 the active RadioPresetId, bit 5 the
+ * node votes for Fast (its links to every direct peer allow it), bits 6-7 reserved (0).
+ */
+constexpr uint8_t kRadioCapsPresetMask = 0x07;
+constexpr uint8_t kRadioCapsActiveShift = 3;
+constexpr uint8_t kRadioCapsWantsFast = 0x20;
+
+inline uint8_t radio_caps_make(uint8_t supported_mask, uint8_t active_preset, bool wants_fast) {
+  return static_cast<uint8_t>((supported_mask & kRadioCapsPresetMask) | 0x01 |
+                              ((active_preset & 0x03) << kRadioCapsActiveShift) |
+                              (wants_fast ? kRadioCapsWantsFast : 0));
+}
+inline bool radio_caps_supports(uint8_t caps, uint8_t preset) {
+  return preset < 3 && (caps & (1u << preset)) != 0;
+}
+inline uint8_t radio_caps_active(uint8_t caps) {
+  return static_cast<uint8_t>((caps >> kRadioCapsActiveShift) & 0x03);
+}
+inline bool radio_caps_wants_fast(uint8_t caps) {
+  return (caps & kRadioCapsWantsFast) != 0;
+}
 
 enum class StatusDecodeError {
   Ok = 0,
@@ -45,5 +95,41 @@ size_t encode_status_frame(const StatusFields& fields, uint8_t* out, size_t out_
 StatusDecodeError decode_status_payload(const uint8_t* payload, size_t payload_len,
                                         StatusFields* out);
 
+/**
+ * Read-only view of a received Node_Status payload, the zero-copy alternative to
+ * decode_status_payload: checked once on construction, fields read from the payload bytes on
+ * access (see PosFullView). The payload must outlive the view; accessors require error() == Ok.
+ */
+class StatusView {
+ public:
+  StatusView(const uint8_t* payload, size_t payload_len)
+      : payload_(payload),
+        has_radio_caps_(payload_len >= StatusRadioCapsWire::kEnd),
+        error_(!payload || payload_len < kStatusPayloadSize ? StatusDecodeError::ShortBuffer
+               : !StatusWire::valid(payload)               ? StatusDecodeError::BadPayloadVersion
+                                                            : StatusDecodeError::Ok) {}
+
+  StatusDecodeError error() const { return error_; }
+  bool ok() const { return error_ == StatusDecodeError::Ok; }
+
+  uint64_t node_id() const { return StatusWire::read<1>(payload_); }
+  uint16_t seq16() const { return StatusWire::read<2>(payload_); }
+  uint8_t battery_percent() const { return StatusWire::read<3>(payload_); }
+  uint8_t battery_est_rem_time() const { return StatusWire::read<4>(payload_); }
+  uint8_t tx_power_ch_throttle() const { return StatusWire::read<5>(payload_); }
+  uint8_t uptime10m() const { return StatusWire::read<6>(payload_); }
+  uint8_t role_id() const { return StatusWire::read<7>(payload_); }
+  uint8_t max_silence_10s() const { return StatusWire::read<8>(payload_); }
+  uint16_t hw_profile_id() const { return StatusWire::read<9>(payload_); }
+  uint16_t fw_version_id() const { return StatusWire::read<10>(payload_); }
+  /** 0 (not advertised) for a 19-byte payload. */
+  uint8_t radio_caps() const { return has_radio_caps_ ? StatusRadioCapsWire::read<0>(payload_) : 0; }
+
+ private:
+  const uint8_t* payload_;
+  bool has_radio_caps_;
+  StatusDecodeError error_;
+};
+
 } // namespace protocol
 } // namespace naviga
@@ -4,7 +4,7 @@
 #include <cstdint>
 
 #include "packet_header.h"
-#include "wire_helpers.h"
+#include "wire_schema.h"
 
 namespace naviga {
 namespace protocol {
@@ -47,11 +47,25 @@ struct Tail1Fields {
 /** Tail-1 payload version byte. */
 constexpr uint8_t kTail1PayloadVersion = 0x00;
 
+/** Tail-1 payload schema (wire_schema.h), and the optional posFlags + sats. */
+typedef wire::Layout<0,
+    wire::Const<8, kTail1PayloadVersion>,
+    wire::Field<Tail1Fields, uint64_t, &Tail1Fields::node_id, 48>,
+    wire::Field<Tail1Fields, uint16_t, &Tail1Fields::seq16, 16>,
+    wire::Field<Tail1Fields, uint16_t, &Tail1Fields::ref_core_seq16, 16>>
+    Tail1Wire;
+typedef wire::Layout<Tail1Wire::kEnd,
+    wire::Field<Tail1Fields, uint8_t, &Tail1Fields::pos_flags, 8>,
+    wire::Field<Tail1Fields, uint8_t, &Tail1Fields::sats, 8>>
+    Tail1OptionalWire;
+
 /** Minimum Tail-1 payload size (Common 9 B + ref_core_seq16 2 B). */
-constexpr size_t kTail1PayloadMin = 11;
+constexpr size_t kTail1PayloadMin = Tail1Wire::kSize;
 
 /** Maximum Tail-1 payload size (with posFlags + sats). */
-constexpr size_t kTail1PayloadMax = 13;
+constexpr size_t kTail1PayloadMax = Tail1OptionalWire::kEnd;
+
+static_assert(kTail1PayloadMin == 11 && kTail1PayloadMax == 13, "Tail-1 payload is 11 or 13 bytes");
 
 /** Minimum on-air Tail-1 frame size (header + min payload). */
 constexpr size_t kTail1FrameMin = kHeaderSize + kTail1PayloadMin;
@@ -98,13 +112,9 @@ inline size_t encode_tail1_frame(const Tail1Fields& fields, uint8_t* out, size_t
   }
 
   uint8_t* p = out + kHeaderSize;
-  p[0] = kTail1PayloadVersion;
-  wire::write_nodeid48_le(p + 1, fields.node_id);
-  wire::write_u16_le(p + kTail1OffsetSeq16, fields.seq16);
-  wire::write_u16_le(p + kTail1OffsetRefCoreSeq16, fields.ref_core_seq16);
+  Tail1Wire::encode(fields, p);
   if (with_optional) {
-    p[kTail1OffsetPosFlags] = fields.pos_flags;
-    p[kTail1OffsetSats]     = fields.sats;
+    Tail1OptionalWire::encode(fields, p);
   }
 
   return frame_size;
@@ -132,18 +142,19 @@ inline Tail1DecodeError decode_tail1_payload(const uint8_t* payload, size_t payl
   if (payload_len != kTail1PayloadMin && payload_len != kTail1PayloadMax) {
     return Tail1DecodeError::BadPayloadLen;
   }
-  if (payload[0] != kTail1PayloadVersion) {
+  if (!Tail1Wire::valid(payload)) {
     return Tail1DecodeError::BadPayloadVersion;
   }
 
-  out->node_id        = wire::read_nodeid48_le(payload + 1);
-  out->seq16          = wire::read_u16_le(payload + kTail1OffsetSeq16);
-  out->ref_core_seq16 = wire::read_u16_le(payload + kTail1OffsetRefCoreSeq16);
-
+  Tail1Wire::decode(payload, out);
   out->has_pos_flags = (payload_len >= kTail1PayloadMax);
-  out->pos_flags     = out->has_pos_flags ? payload[kTail1OffsetPosFlags] : 0x00u;
   out->has_sats      = (payload_len >= kTail1PayloadMax);
-  out->sats          = out->has_sats      ? payload[kTail1OffsetSats]     : 0x00u;
+  if (out->has_pos_flags) {
+    Tail1OptionalWire::decode(payload, out);
+  } else {
+    out->pos_flags = 0x00u;
+    out->sats      = 0x00u;
+  }
 
   return Tail1DecodeError::Ok;
 }
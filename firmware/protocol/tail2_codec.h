@@ -4,7 +4,7 @@
 #include <cstdint>
 
 #include "packet_header.h"
-#include "wire_helpers.h"
+#include "wire_schema.h"
 
 namespace naviga {
 namespace protocol {
@@ -42,11 +42,24 @@ struct Tail2Fields {
 /** Tail-2 (Operational) payload version byte. */
 constexpr uint8_t kTail2PayloadVersion = 0x00;
 
+/** Tail-2 payload schema (wire_schema.h), and its optional fields in wire order. */
+typedef wire::Layout<0,
+    wire::Const<8, kTail2PayloadVersion>,
+    wire::Field<Tail2Fields, uint64_t, &Tail2Fields::node_id, 48>,
+    wire::Field<Tail2Fields, uint16_t, &Tail2Fields::seq16, 16>>
+    Tail2Wire;
+typedef wire::Layout<Tail2Wire::kEnd,
+    wire::Field<Tail2Fields, uint8_t, &Tail2Fields::battery_percent, 8>>
+    Tail2BatteryWire;
+typedef wire::Layout<Tail2BatteryWire::kEnd,
+    wire::Field<Tail2Fields, uint32_t, &Tail2Fields::uptime_sec, 32>>
+    Tail2UptimeWire;
+
 /** Minimum Tail-2 payload size (Common 9 B only). */
-constexpr size_t kTail2PayloadMin = 9;
+constexpr size_t kTail2PayloadMin = Tail2Wire::kSize;
 
 /** Maximum Tail-2 payload size (all optional fields present). */
-constexpr size_t kTail2PayloadMax = 14;
+constexpr size_t kTail2PayloadMax = Tail2UptimeWire::kEnd;
 
 /** Minimum on-air Tail-2 frame size (header + min payload). */
 constexpr size_t kTail2FrameMin = kHeaderSize + kTail2PayloadMin;
@@ -56,11 +69,14 @@ constexpr size_t kTail2FrameMax = kHeaderSize + kTail2PayloadMax;
 
 /** Payload offsets for optional fields (relative to start of payload). */
 constexpr size_t kTail2OffsetSeq16   = 7;   ///< Common: global seq16.
-constexpr size_t kTail2OffsetBattery = 9;   ///< batteryPercent.
-constexpr size_t kTail2OffsetUptime  = 10;  ///< uptimeSec (4 B LE).
+constexpr size_t kTail2OffsetBattery = Tail2BatteryWire::kOffset;  ///< batteryPercent.
+constexpr size_t kTail2OffsetUptime  = Tail2UptimeWire::kOffset;   ///< uptimeSec (4 B LE).
+
+constexpr size_t kTail2SizeWithBattery = Tail2BatteryWire::kEnd;
+constexpr size_t kTail2SizeWithUptime  = Tail2UptimeWire::kEnd;
 
-constexpr size_t kTail2SizeWithBattery = 10;
-constexpr size_t kTail2SizeWithUptime  = 14;
+static_assert(kTail2PayloadMin == 9 && kTail2SizeWithBattery == 10 && kTail2PayloadMax == 14,
+              "Tail-2 payload is 9, 10 or 14 bytes");
 
 enum class Tail2DecodeError {
   Ok = 0,
@@ -98,18 +114,12 @@ inline size_t encode_tail2_frame(const Tail2Fields& fields, uint8_t* out, size_t
   }
 
   uint8_t* p = out + kHeaderSize;
-  p[0] = kTail2PayloadVersion;
-  wire::write_nodeid48_le(p + 1, fields.node_id);
-  wire::write_u16_le(p + kTail2OffsetSeq16, fields.seq16);
-
+  Tail2Wire::encode(fields, p);
   if (payload_len >= kTail2SizeWithBattery) {
-    p[kTail2OffsetBattery] = fields.battery_percent;
+    Tail2BatteryWire::encode(fields, p);
   }
   if (payload_len >= kTail2SizeWithUptime) {
-    p[kTail2OffsetUptime + 0] = static_cast<uint8_t>(fields.uptime_sec & 0xFFu);
-    p[kTail2OffsetUptime + 1] = static_cast<uint8_t>((fields.uptime_sec >> 8) & 0xFFu);
-    p[kTail2OffsetUptime + 2] = static_cast<uint8_t>((fields.uptime_sec >> 16) & 0xFFu);
-    p[kTail2OffsetUptime + 3] = static_cast<uint8_t>((fields.uptime_sec >> 24) & 0xFFu);
+    Tail2UptimeWire::encode(fields, p);
   }
 
   return frame_size;
@@ -136,23 +146,25 @@ inline Tail2DecodeError decode_tail2_payload(const uint8_t* payload, size_t payl
   if (payload_len > kTail2PayloadMax) {
     return Tail2DecodeError::BadPayloadLen;
   }
-  if (payload[0] != kTail2PayloadVersion) {
+  if (!Tail2Wire::valid(payload)) {
     return Tail2DecodeError::BadPayloadVersion;
   }
 
-  out->node_id = wire::read_nodeid48_le(payload + 1);
-  out->seq16   = wire::read_u16_le(payload + kTail2OffsetSeq16);
+  Tail2Wire::decode(payload, out);
 
-  out->has_battery     = (payload_len >= kTail2SizeWithBattery);
-  out->battery_percent = out->has_battery ? payload[kTail2OffsetBattery] : 0xFFu;
+  out->has_battery = (payload_len >= kTail2SizeWithBattery);
+  if (out->has_battery) {
+    Tail2BatteryWire::decode(payload, out);
+  } else {
+    out->battery_percent = 0xFFu;
+  }
 
-  out->has_uptime  = (payload_len >= kTail2SizeWithUptime);
-  out->uptime_sec  = out->has_uptime
-                       ? (static_cast<uint32_t>(payload[kTail2OffsetUptime + 0])        |
-                          (static_cast<uint32_t>(payload[kTail2OffsetUptime + 1]) << 8)  |
-                          (static_cast<uint32_t>(payload[kTail2OffsetUptime + 2]) << 16) |
-                          (static_cast<uint32_t>(payload[kTail2OffsetUptime + 3]) << 24))
-                       : 0xFFFFFFFFu;
+  out->has_uptime = (payload_len >= kTail2SizeWithUptime);
+  if (out->has_uptime) {
+    Tail2UptimeWire::decode(payload, out);
+  } else {
+    out->uptime_sec = 0xFFFFFFFFu;
+  }
 
   return Tail2DecodeError::Ok;
 }
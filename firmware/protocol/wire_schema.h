@@ -0,0 +1,214 @@
+#pragma once
+
+// Compile-time payload schemas shared by protocol codecs.
+//
+// A payload (or an optional trailing group of it) is declared as a Layout: a byte offset and a
+// list of fixed-width fields packed LSB-first into consecutive bytes. That is the layout every
+// on-air codec uses: multi-byte values are little-endian (nodeId48, seq16, u24 lat/lon) and
+// sub-byte fields fill a little-endian word from bit 0 up (Pos_Quality, Pos_Delta 12+12 bits).
+//
+// Offsets, shifts and masks are template constants, so encode/decode compile to the same
+// straight-line byte stores and loads as a handwritten codec, with no loops or per-field
+// branches. Size constants (kSize, kEnd) come from the field list, so they cannot drift from
+// the code that writes the bytes.
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace naviga {
+namespace protocol {
+namespace wire {
+
+/** Conversion for a member stored as its own low bits. */
+template <typename T>
+struct AsIs {
+  static uint64_t to_wire(T v) { return static_cast<uint64_t>(v); }
+  static T from_wire(uint64_t w) { return static_cast<T>(w); }
+};
+
+/**
+ * Field backed by struct member S::*M, Bits wide (1..64). Encode keeps the low Bits of
+ * Conv::to_wire(); decode stores Conv::from_wire() of the Bits read.
+ */
+template <typename S, typename T, T S::*M, unsigned Bits, typename Conv = AsIs<T>>
+struct Field {
+  static_assert(Bits >= 1 && Bits <= 64, "field width must be 1..64 bits");
+  typedef T ValueType;
+  static constexpr unsigned kBits = Bits;
+  static uint64_t get(const S& s) { return Conv::to_wire(s.*M); }
+  static T from_wire(uint64_t w) { return Conv::from_wire(w); }
+  static void set(S* s, uint64_t w) { s->*M = from_wire(w); }
+  static bool check(uint64_t) { return true; }
+};
+
+/** Constant field (payloadVersion): always encoded as Value; Layout::valid() requires it. */
+template <unsigned Bits, uint64_t Value>
+struct Const {
+  static_assert(Bits >= 1 && Bits <= 64, "field width must be 1..64 bits");
+  typedef uint64_t ValueType;
+  static constexpr unsigned kBits = Bits;
+  template <typename S>
+  static uint64_t get(const S&) { return Value; }
+  static uint64_t from_wire(uint64_t w) { return w; }
+  template <typename S>
+  static void set(S*, uint64_t) {}
+  static bool check(uint64_t w) { return w == Value; }
+};
+
+namespace schema_detail {
+
+/**
+ * Stores the low N bytes of w at p[First], little-endian (compilers fuse this into one store).
+ * W is 32-bit when that holds them, so 3-byte fields shift like a handwritten write_u24_le.
+ */
+template <size_t First, size_t N,
+          typename W = typename std::conditional<(N <= 4), uint32_t, uint64_t>::type>
+struct LeStore {
+  static void put(uint8_t* p, W w) {
+    p[First] = static_cast<uint8_t>(w);
+    LeStore<First + 1, N - 1, W>::put(p, static_cast<W>(w >> 8));
+  }
+};
+
+template <size_t First, typename W>
+struct LeStore<First, 0, W> {
+  static void put(uint8_t*, W) {}
+};
+
+/** N bytes from p[First] as a little-endian integer (compilers fuse this into one load). */
+template <size_t First, size_t N>
+struct LeWord {
+  static uint64_t get(const uint8_t* p) {
+    return static_cast<uint64_t>(p[First]) | (LeWord<First + 1, N - 1>::get(p) << 8);
+  }
+};
+
+template <size_t First>
+struct LeWord<First, 0> {
+  static uint64_t get(const uint8_t*) { return 0; }
+};
+
+/**
+ * A Bits-wide field starting at bit Bit, read as the little-endian word of the bytes it
+ * covers: fields sharing bytes read the same word, so the loads are shared too.
+ */
+template <size_t Bit, unsigned Bits>
+struct Read {
+  static_assert(Bit % 8 + Bits <= 64, "field must fit in a 64-bit word with its bit offset");
+  static uint64_t get(const uint8_t* p) {
+    return (LeWord<Bit / 8, (Bit % 8 + Bits + 7) / 8>::get(p) >> (Bit % 8)) &
+           (~0ull >> (64 - Bits));
+  }
+};
+
+/**
+ * Fields Fs laid out from bit Bit. Group is the first bit of the byte run being filled: fields
+ * sharing bytes accumulate into one word, stored whole by the field that ends on a byte
+ * boundary (a Layout fills whole bytes, so one always does).
+ */
+template <size_t Group, size_t Bit, typename... Fs>
+struct Seq;
+
+template <size_t Group, size_t Bit>
+struct Seq<Group, Bit> {
+  static constexpr size_t kEndBit = Bit;
+  template <typename S>
+  static void encode(const S&, uint8_t*, uint64_t) {}
+  template <typename S>
+  static void decode(const uint8_t*, S*) {}
+  static bool valid(const uint8_t*) { return true; }
+};
+
+template <size_t Group, size_t Bit, typename F, typename... Rest>
+struct Seq<Group, Bit, F, Rest...> {
+  static constexpr size_t kFieldEnd = Bit + F::kBits;
+  static constexpr bool kStore = kFieldEnd % 8 == 0;
+  static_assert(kFieldEnd - Group <= 64, "fields sharing bytes must fit in a 64-bit word");
+  // A field alone in its bytes is not masked: only those bytes are stored.
+  static constexpr uint64_t kMask = (Bit == Group && kStore) ? ~0ull : ~0ull >> (64 - F::kBits);
+  typedef Read<Bit, F::kBits> FieldRead;
+  typedef Seq<kStore ? kFieldEnd : Group, kFieldEnd, Rest...> Next;
+  static constexpr size_t kEndBit = Next::kEndBit;
+
+  template <typename S>
+  static void encode(const S& s, uint8_t* p, uint64_t word) {
+    word |= (F::get(s) & kMask) << (Bit - Group);
+    if (kStore) {
+      LeStore<Group / 8, (kFieldEnd - Group) / 8>::put(p, word);
+      word = 0;
+    }
+    Next::encode(s, p, word);
+  }
+  // Every field is read before any is stored: stores through S* may alias the payload bytes
+  // and would otherwise force reloads of the bytes shared by sub-byte fields.
+  template <typename S>
+  static void decode(const uint8_t* p, S* s) {
+    const uint64_t v = FieldRead::get(p);
+    Next::decode(p, s);
+    F::set(s, v);
+  }
+  static bool valid(const uint8_t* p) {
+    return F::check(FieldRead::get(p)) & Next::valid(p);
+  }
+};
+
+/** Field I of Fs and its first bit, for fields laid out from bit Bit. */
+template <size_t I, size_t Bit, typename... Fs>
+struct At;
+
+template <size_t Bit, typename F, typename... Rest>
+struct At<0, Bit, F, Rest...> {
+  typedef F Type;
+  static constexpr size_t kBit = Bit;
+};
+
+template <size_t I, size_t Bit, typename F, typename... Rest>
+struct At<I, Bit, F, Rest...> : At<I - 1, Bit + F::kBits, Rest...> {};
+
+} // namespace schema_detail
+
+/**
+ * Fields Fs packed from payload byte Offset. encode/decode take the payload start (after the
+ * frame header) and do no bounds checks: callers check the length against kEnd first.
+ */
+template <size_t Offset, typename... Fs>
+struct Layout {
+  typedef schema_detail::Seq<Offset * 8, Offset * 8, Fs...> Impl;
+  static_assert(Impl::kEndBit % 8 == 0, "layout fields must fill whole bytes");
+
+  static constexpr size_t kOffset = Offset;
+  static constexpr size_t kEnd = Impl::kEndBit / 8;  ///< Payload length up to and including it.
+  static constexpr size_t kSize = kEnd - Offset;
+
+  template <typename S>
+  static void encode(const S& fields, uint8_t* payload) {
+    Impl::encode(fields, payload, 0);
+  }
+  /** Stores every member field; Const fields are checked by valid(), not here. */
+  template <typename S>
+  static void decode(const uint8_t* payload, S* out) {
+    Impl::decode(payload, out);
+  }
+  /** All Const fields hold their value. */
+  static bool valid(const uint8_t* payload) { return Impl::valid(payload); }
+
+  /** Field I (0-based, in declaration order) alone, as its member type: for read-only views. */
+  template <size_t I>
+  static typename schema_detail::At<I, Offset * 8, Fs...>::Type::ValueType read(
+      const uint8_t* payload) {
+    typedef schema_detail::At<I, Offset * 8, Fs...> Where;
+    return Where::Type::from_wire(schema_detail::Read<Where::kBit, Where::Type::kBits>::get(payload));
+  }
+};
+
+template <size_t Offset, typename... Fs>
+constexpr size_t Layout<Offset, Fs...>::kOffset;
+template <size_t Offset, typename... Fs>
+constexpr size_t Layout<Offset, Fs...>::kEnd;
+template <size_t Offset, typename... Fs>
+constexpr size_t Layout<Offset, Fs...>::kSize;
+
+} // namespace wire
+} // namespace protocol
+} // namespace naviga
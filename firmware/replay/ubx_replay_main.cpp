@@ -0,0 +1,317 @@
+// UBX replay (host): a recorded GNSS UART stream through the firmware's NAV-PVT parser and
+// SelfUpdatePolicy, counting position commits per hour. pio run -e ubx_replay_native, then
+//   .pio/build/ubx_replay_native/program --ubx=stationary.ubx --role=person
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "services/self_update_policy.h"
+#include "services/ubx_nav_pvt_parser.h"
+
+using naviga::GnssSnapshot;
+using naviga::SelfUpdateDecision;
+using naviga::SelfUpdatePolicy;
+using naviga::SelfUpdateReason;
+using naviga::UbxFrameView;
+using naviga::UbxNavPvt;
+using naviga::UbxParseStatus;
+using naviga::UbxStreamParser;
+
+namespace {
+
+const char* arg_value(const char* arg, const char* name) {
+  const size_t n = std::strlen(name);
+  if (std::strncmp(arg, name, n) == 0 && arg[n] == '=') {
+    return arg + n + 1;
+  }
+  return nullptr;
+}
+
+void print_usage() {
+  std::printf(
+      "usage: program --ubx=FILE [--role=person|dog] [--min-distance=M]\n"
+      "       program --synth=FILE [--hours=H] [--seed=S] [--role=person|dog]\n");
+}
+
+struct ReplayConfig {
+  const char* ubx_path = nullptr;
+  const char* synth_path = nullptr;
+  double synth_hours = 3.0;
+  uint32_t seed = 1;
+  // OOTB role profile (role_profile_ootb.cpp): Person 22 s / 110 s / 30 m.
+  uint32_t min_interval_ms = 22000;
+  uint32_t max_silence_ms = 110000;
+  double min_distance_m = 30.0;
+};
+
+bool parse_args(int argc, char** argv, ReplayConfig* cfg) {
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    const char* v = nullptr;
+    if ((v = arg_value(a, "--ubx"))) {
+      cfg->ubx_path = v;
+    } else if ((v = arg_value(a, "--synth"))) {
+      cfg->synth_path = v;
+    } else if ((v = arg_value(a, "--hours"))) {
+      cfg->synth_hours = std::atof(v);
+    } else if ((v = arg_value(a, "--seed"))) {
+      cfg->seed = static_cast<uint32_t>(std::strtoul(v, nullptr, 10));
+    } else if ((v = arg_value(a, "--role"))) {
+      if (std::strcmp(v, "person") == 0) {
+        cfg->min_interval_ms = 22000;
+        cfg->max_silence_ms = 110000;
+        cfg->min_distance_m = 30.0;
+      } else if (std::strcmp(v, "dog") == 0) {
+        cfg->min_interval_ms = 11000;
+        cfg->max_silence_ms = 50000;
+        cfg->min_distance_m = 15.0;
+      } else {
+        return false;
+      }
+    } else if ((v = arg_value(a, "--min-distance"))) {
+      cfg->min_distance_m = std::atof(v);
+    } else {
+      return false;
+    }
+  }
+  return cfg->ubx_path || cfg->synth_path;
+}
+
+// ── Synthetic stationary recording ──────────────────────────────────────────
+
+void put_u32_le(uint8_t* p, uint32_t v) {
+  p[0] = static_cast<uint8_t>(v & 0xFF);
+  p[1] = static_cast<uint8_t>((v >> 8) & 0xFF);
+  p[2] = static_cast<uint8_t>((v >> 16) & 0xFF);
+  p[3] = static_cast<uint8_t>((v >> 24) & 0xFF);
+}
+
+void write_nav_pvt(std::FILE* f, const UbxNavPvt& pvt) {
+  uint8_t frame[6 + UbxStreamParser::kNavPvtPayloadLen + 2] = {};
+  frame[0] = UbxStreamParser::kSync1;
+  frame[1] = UbxStreamParser::kSync2;
+  frame[2] = UbxStreamParser::kClassNav;
+  frame[3] = UbxStreamParser::kIdNavPvt;
+  frame[4] = static_cast<uint8_t>(UbxStreamParser::kNavPvtPayloadLen & 0xFF);
+  frame[5] = static_cast<uint8_t>(UbxStreamParser::kNavPvtPayloadLen >> 8);
+  uint8_t* p = frame + 6;
+  put_u32_le(p, pvt.itow_ms);
+  p[11] = pvt.valid;
+  p[20] = pvt.fix_type;
+  p[21] = pvt.flags;
+  p[23] = pvt.num_sv;
+  put_u32_le(p + 24, static_cast<uint32_t>(pvt.lon_e7));
+  put_u32_le(p + 28, static_cast<uint32_t>(pvt.lat_e7));
+  put_u32_le(p + 40, pvt.h_acc_mm);
+  put_u32_le(p + 60, static_cast<uint32_t>(pvt.g_speed_mm_s));
+  uint8_t ck_a = 0;
+  uint8_t ck_b = 0;
+  for (size_t i = 2; i < 6 + UbxStreamParser::kNavPvtPayloadLen; ++i) {
+    ck_a = static_cast<uint8_t>(ck_a + frame[i]);
+    ck_b = static_cast<uint8_t>(ck_b + ck_a);
+  }
+  frame[sizeof(frame) - 2] = ck_a;
+  frame[sizeof(frame) - 1] = ck_b;
+  std::fwrite(frame, 1, sizeof(frame), f);
+}
+
+/**
+ * A receiver that does not move, at 1 Hz: per-axis error is a first-order Gauss-Markov process
+ * (60 s correlation) whose sigma follows the sky, 20 min each of open sky (1.5 m, 12 SV),
+ * tree canopy (5 m, 8 SV) and obstructed (12 m, 5 SV). hAcc reports the 68 % radius (1.5
+ * sigma), gSpeed is Doppler noise. A stand-in for a real recording, not a substitute.
+ */
+bool write_synthetic(const ReplayConfig& cfg) {
+  std::FILE* f = std::fopen(cfg.synth_path, "wb");
+  if (!f) {
+    return false;
+  }
+  struct Sky {
+    double sigma_m;
+    uint8_t num_sv;
+  };
+  const Sky kSky[] = {{1.5, 12}, {5.0, 8}, {12.0, 5}};
+  const uint32_t kSegmentS = 1200;
+  const double kTauS = 60.0;
+  const double a = std::exp(-1.0 / kTauS);
+  const double b = std::sqrt(1.0 - a * a);
+  const int32_t lat0_e7 = 557000000;
+  const int32_t lon0_e7 = 376000000;
+  const double m_per_e7_lat = 0.011132;
+  const double m_per_e7_lon = m_per_e7_lat * std::cos(55.7 * 3.14159265358979 / 180.0);
+
+  std::mt19937 rng(cfg.seed);
+  std::normal_distribution<double> unit(0.0, 1.0);
+  double north_m = 0.0;
+  double east_m = 0.0;
+  const uint32_t seconds = static_cast<uint32_t>(cfg.synth_hours * 3600.0);
+  for (uint32_t s = 0; s < seconds; ++s) {
+    const Sky& sky = kSky[(s / kSegmentS) % 3];
+    north_m = a * north_m + b * sky.sigma_m * unit(rng);
+    east_m = a * east_m + b * sky.sigma_m * unit(rng);
+    UbxNavPvt pvt;
+    pvt.itow_ms = 345600000u + s * 1000u;
+    pvt.valid = 0x07;
+    pvt.fix_type = 3;
+    pvt.flags = UbxNavPvt::kFlagGnssFixOk;
+    pvt.num_sv = sky.num_sv;
+    pvt.lat_e7 = lat0_e7 + static_cast<int32_t>(std::lround(north_m / m_per_e7_lat));
+    pvt.lon_e7 = lon0_e7 + static_cast<int32_t>(std::lround(east_m / m_per_e7_lon));
+    pvt.h_acc_mm = static_cast<uint32_t>(1500.0 * sky.sigma_m * (1.0 + 0.1 * std::fabs(unit(rng))));
+    pvt.g_speed_mm_s = static_cast<int32_t>(std::fabs(unit(rng)) * 20.0 * sky.sigma_m);
+    write_nav_pvt(f, pvt);
+  }
+  std::fclose(f);
+  return true;
+}
+
+// ── Replay ──────────────────────────────────────────────────────────────────
+
+/** One SelfUpdatePolicy configuration the recording is replayed through. */
+struct Variant {
+  const char* name;
+  bool predictive;
+  bool quality;  ///< NAV-PVT quality reaches the policy (accuracy gate, gSpeed); off = before.
+  SelfUpdatePolicy policy;
+  uint32_t commits[4];  ///< By SelfUpdateReason.
+};
+
+const char* reason_name(SelfUpdateReason r) {
+  switch (r) {
+    case SelfUpdateReason::DISTANCE:
+      return "distance";
+    case SelfUpdateReason::MAX_SILENCE:
+      return "max_silence";
+    case SelfUpdateReason::FIRST_FIX:
+      return "first_fix";
+    case SelfUpdateReason::NONE:
+    default:
+      return "none";
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  ReplayConfig cfg;
+  if (!parse_args(argc, argv, &cfg)) {
+    print_usage();
+    return 2;
+  }
+  if (cfg.synth_path) {
+    if (!write_synthetic(cfg)) {
+      std::fprintf(stderr, "cannot write %s\n", cfg.synth_path);
+      return 1;
+    }
+    std::printf("wrote %.1f h synthetic stationary NAV-PVT to %s\n", cfg.synth_hours, cfg.synth_path);
+    if (!cfg.ubx_path) {
+      cfg.ubx_path = cfg.synth_path;
+    }
+  }
+
+  std::FILE* f = std::fopen(cfg.ubx_path, "rb");
+  if (!f) {
+    std::fprintf(stderr, "cannot read %s\n", cfg.ubx_path);
+    return 1;
+  }
+
+  Variant variants[] = {
+      {"plain", false, false, SelfUpdatePolicy(), {}},
+      {"plain+quality", false, true, SelfUpdatePolicy(), {}},
+      {"predict", true, false, SelfUpdatePolicy(), {}},
+      {"predict+quality", true, true, SelfUpdatePolicy(), {}},
+  };
+  for (Variant& v : variants) {
+    v.policy.init();
+    v.policy.set_min_time_ms(cfg.min_interval_ms);
+    v.policy.set_max_silence_ms(cfg.max_silence_ms);
+    v.policy.set_min_distance_m(cfg.min_distance_m);
+    v.policy.set_predictive(v.predictive);
+    v.policy.set_accuracy_gate(v.quality);
+  }
+
+  UbxStreamParser parser;
+  GnssSnapshot snapshot{};
+  uint32_t now_ms = 0;
+  uint32_t last_itow_ms = 0;
+  bool have_itow = false;
+  uint32_t frames = 0;
+  uint32_t fixes = 0;
+  uint32_t bad_ck = 0;
+  std::vector<uint32_t> h_acc_mm;
+  uint8_t chunk[4096];
+  size_t n = 0;
+  while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) {
+    for (size_t i = 0; i < n; ++i) {
+      UbxFrameView frame{};
+      const UbxParseStatus st = parser.push_byte(chunk[i], &frame);
+      if (st == UbxParseStatus::FrameBadChecksum) {
+        ++bad_ck;
+      }
+      UbxNavPvt pvt;
+      if (st != UbxParseStatus::FrameOk || !naviga::parse_nav_pvt(frame, &pvt)) {
+        continue;
+      }
+      // Replay clock: iTOW steps (one GPS week wraps), 1 s when the time is not valid.
+      uint32_t step_ms = 1000;
+      if ((pvt.valid & UbxNavPvt::kValidTime) != 0) {
+        if (have_itow) {
+          const uint32_t d = (pvt.itow_ms + 604800000u - last_itow_ms) % 604800000u;
+          step_ms = d > 0 && d <= 60000 ? d : 1000;
+        }
+        last_itow_ms = pvt.itow_ms;
+        have_itow = true;
+      }
+      now_ms += frames == 0 ? 0 : step_ms;
+      ++frames;
+      naviga::apply_nav_pvt(pvt, now_ms, &snapshot);
+      if (!snapshot.pos_valid) {
+        continue;
+      }
+      ++fixes;
+      h_acc_mm.push_back(snapshot.h_acc_mm);
+      for (Variant& v : variants) {
+        GnssSnapshot seen = snapshot;
+        if (!v.quality) {
+          seen.quality_valid = false;
+          seen.num_sv = 0;
+          seen.h_acc_mm = 0;
+          seen.g_speed_mm_s = 0;
+        }
+        const SelfUpdateDecision d = v.policy.evaluate(now_ms, seen);
+        if (d.reason != SelfUpdateReason::NONE) {
+          v.policy.commit(now_ms, seen);
+          ++v.commits[static_cast<int>(d.reason)];
+        }
+      }
+    }
+  }
+  std::fclose(f);
+
+  const double hours = static_cast<double>(now_ms) / 3600000.0;
+  std::printf("replay %s: %u NAV-PVT (%u bad checksum), %u fixes, %.2f h, min_distance=%.0fm "
+              "min_interval=%us max_silence=%us\n",
+              cfg.ubx_path, frames, bad_ck, fixes, hours, cfg.min_distance_m,
+              cfg.min_interval_ms / 1000u, cfg.max_silence_ms / 1000u);
+  if (fixes == 0 || hours <= 0.0) {
+    std::printf("no fixes\n");
+    return 1;
+  }
+  std::sort(h_acc_mm.begin(), h_acc_mm.end());
+  std::printf("hAcc p50=%.1fm p95=%.1fm max=%.1fm\n", h_acc_mm[h_acc_mm.size() / 2] / 1000.0,
+              h_acc_mm[h_acc_mm.size() * 95 / 100] / 1000.0, h_acc_mm.back() / 1000.0);
+  std::printf("%-16s %12s %14s %12s\n", "policy", "commits/h",
+              reason_name(SelfUpdateReason::DISTANCE), reason_name(SelfUpdateReason::MAX_SILENCE));
+  for (const Variant& v : variants) {
+    const uint32_t total = v.commits[0] + v.commits[1] + v.commits[2] + v.commits[3];
+    std::printf("%-16s %12.1f %12.1f/h %10.1f/h\n", v.name, total / hours,
+                v.commits[static_cast<int>(SelfUpdateReason::DISTANCE)] / hours,
+                v.commits[static_cast<int>(SelfUpdateReason::MAX_SILENCE)] / hours);
+  }
+  return 0;
+}
@@ -0,0 +1,503 @@
+#include "mesh_sim.h"
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#include "../protocol/bundle_codec.h"
+#include "../protocol/fec_codec.h"
+#include "../protocol/packet_header.h"
+#include "../protocol/pos_delta_codec.h"
+#include "../protocol/short_addr_codec.h"
+
+namespace naviga {
+namespace sim {
+
+namespace {
+
+constexpr double kBaseLatDeg = 55.75;
+constexpr double kBaseLonDeg = 37.60;
+constexpr double kMetersPerDegLat = 111320.0;
+constexpr double kPi = 3.14159265358979323846;
+constexpr uint32_t kGnssPeriodMs = 1000;
+constexpr size_t kStaleHistBuckets = 3601;  // 1 s buckets up to 1 h, then overflow.
+constexpr size_t kPosErrHistBuckets = 2001;  // 1 m buckets up to 2 km, then overflow.
+constexpr uint64_t kNodeIdBase = 0x00005A0000000000ULL;
+
+/** Role cadence, mirroring role_profile_ootb.cpp (min interval, max silence, min displacement). */
+SimNodeConfig role_config(uint8_t role_id) {
+  SimNodeConfig c{};
+  c.role_id = role_id;
+  if (role_id == 1) {
+    c.min_interval_ms = 11000;
+    c.max_silence_ms = 50000;
+    c.min_displacement_m = 15.0;
+  } else if (role_id == 2) {
+    c.min_interval_ms = 360000;
+    c.max_silence_ms = 2550000;
+    c.min_displacement_m = 100.0;
+  } else {
+    c.min_interval_ms = 22000;
+    c.max_silence_ms = 110000;
+    c.min_displacement_m = 30.0;
+  }
+  return c;
+}
+
+/**
+ * True if frame carries a position the receiver can apply: any Pos_Full, or a Pos_Delta passing
+ * NodeTable's reference check against what the receiver holds (*no_ref set otherwise).
+ * *seq16 is the position's seq16.
+ */
+bool position_usable(const uint8_t* frame, size_t len, const domain::NodeTable& table, bool* no_ref,
+                     uint16_t* seq16) {
+  protocol::PacketHeader hdr{};
+  if (!protocol::decode_header(frame, len, &hdr)) {
+    return false;
+  }
+  if (hdr.msg_type == protocol::MsgType::BeaconPosFull) {
+    if (len < protocol::kHeaderSize + protocol::kBundlePrefixSize + 2) {
+      return false;
+    }
+    *seq16 = protocol::wire::read_u16_le(frame + protocol::kHeaderSize + protocol::kBundlePrefixSize);
+    return true;
+  }
+  protocol::PosDeltaFields delta{};
+  if (hdr.msg_type != protocol::MsgType::BeaconPosDelta ||
+      protocol::decode_pos_delta_payload(frame + protocol::kHeaderSize, len - protocol::kHeaderSize,
+                                         &delta) != protocol::PosDeltaDecodeError::Ok) {
+    return false;
+  }
+  *seq16 = delta.seq16;
+  domain::NodeEntry entry{};
+  if (!table.find_entry_by_node_id(delta.node_id, &entry)) {
+    *no_ref = true;
+    return false;
+  }
+  const uint16_t gap = static_cast<uint16_t>(delta.seq16 - entry.pos_full_seq16);
+  if (entry.pos_valid && entry.has_pos_full_seq16 &&
+      static_cast<uint8_t>(entry.pos_full_seq16) == delta.ref_seq8 && gap != 0 &&
+      gap <= domain::NodeTable::kPosDeltaMaxSeqGap) {
+    return true;
+  }
+  *no_ref = true;
+  return false;
+}
+
+/** Distance (m) between two positions near the simulated area, on the local plane. */
+double distance_m(int32_t lat0_e7, int32_t lon0_e7, int32_t lat1_e7, int32_t lon1_e7) {
+  const double dy = (lat1_e7 - lat0_e7) * 1e-7 * kMetersPerDegLat;
+  const double dx = (lon1_e7 - lon0_e7) * 1e-7 * kMetersPerDegLat * std::cos(kBaseLatDeg * kPi / 180.0);
+  return std::sqrt(dx * dx + dy * dy);
+}
+
+double hist_percentile(const std::vector<uint32_t>& hist, uint64_t total, double q) {
+  if (total == 0) {
+    return 0.0;
+  }
+  const uint64_t target = static_cast<uint64_t>(std::ceil(q * static_cast<double>(total)));
+  uint64_t acc = 0;
+  for (size_t i = 0; i < hist.size(); ++i) {
+    acc += hist[i];
+    if (acc >= target) {
+      return static_cast<double>(i);
+    }
+  }
+  return static_cast<double>(hist.size() - 1);
+}
+
+} // namespace
+
+void MeshSim::init(const MeshSimConfig& config) {
+  config_ = config;
+  const size_t n = config.node_count + config.relays;
+  rng_.seed(config.seed);
+  medium_.init(config.radio, n, config.seed * 2654435761u + 1u);
+  medium_.set_delivery_hook(&MeshSim::on_delivery, this);
+
+  nodes_.assign(n, SimNode{});
+  mobility_.assign(n, Mobility{});
+  next_tick_us_.assign(n, 0);
+  next_gnss_ms_.assign(n, 0);
+  cpu_ns_.assign(n, 0);
+  last_pos_rx_ms_.assign(n * n, 0);
+  stale_hist_.assign(kStaleHistBuckets, 0);
+  stale_sum_s_ = 0.0;
+  stale_max_s_ = 0.0;
+  pos_err_hist_.assign(kPosErrHistBuckets, 0);
+  pos_err_sum_m_ = 0.0;
+  report_ = MeshSimReport{};
+
+  std::uniform_real_distribution<double> pos(0.0, config.area_m);
+  std::uniform_int_distribution<uint32_t> boot(0, config.boot_spread_ms);
+  std::uniform_int_distribution<uint32_t> phase(0, config.tick_ms * 1000U);
+  for (size_t i = 0; i < n; ++i) {
+    const bool relay = i >= config.node_count;
+    uint8_t role_id = 0;
+    if (relay) {
+      role_id = 2;
+    } else if (config.roles == SimRoleMix::kDog || (config.roles == SimRoleMix::kMixed && i % 5 == 4)) {
+      role_id = 1;
+    }
+    SimNodeConfig node_config = role_config(role_id);
+    node_config.adaptive_cadence = config.adaptive_cadence;
+    node_config.bundling = config.bundling;
+    node_config.pos_delta = config.pos_delta;
+    node_config.short_addr = config.short_addr;
+    node_config.slotted = config.slotted;
+    node_config.channel_sense = config.channel_sense;
+    node_config.relay = relay;
+    node_config.fec_parity = config.fec_parity;
+    node_config.status_suppress = config.status_suppress;
+    node_config.predictive = config.predictive;
+    node_config.node_id = kNodeIdBase | static_cast<uint64_t>(i + 1);
+    nodes_[i].init(i, node_config, &medium_, 0);
+
+    Mobility& m = mobility_[i];
+    m.x_m = pos(rng_);
+    m.y_m = pos(rng_);
+    m.dest_x_m = pos(rng_);
+    m.dest_y_m = pos(rng_);
+    m.speed_mps = role_id == 1 ? config.dog_speed_mps : 1.4;
+    medium_.set_position(i, m.x_m, m.y_m);
+
+    const uint32_t boot_ms = boot(rng_);
+    next_tick_us_[i] = static_cast<uint64_t>(boot_ms) * 1000U + phase(rng_);
+    next_gnss_ms_[i] = boot_ms;
+  }
+
+  // Relays (Infra) are fixed: centres of a k x k grid over the area, row by row.
+  size_t k = 1;
+  while (k * k < config.relays) {
+    k++;
+  }
+  const double cell_m = config.area_m / static_cast<double>(k);
+  for (size_t j = 0; j < config.relays; ++j) {
+    pin_node(config.node_count + j, (static_cast<double>(j % k) + 0.5) * cell_m,
+             (static_cast<double>(j / k) + 0.5) * cell_m);
+  }
+}
+
+void MeshSim::pin_node(size_t i, double x_m, double y_m) {
+  Mobility& m = mobility_[i];
+  m.x_m = x_m;
+  m.y_m = y_m;
+  m.pinned = true;
+  medium_.set_position(i, x_m, y_m);
+}
+
+void MeshSim::on_delivery(void* ctx, size_t sender, size_t receiver,
+                          const uint8_t* frame, size_t len, uint64_t now_us) {
+  MeshSim* self = static_cast<MeshSim*>(ctx);
+  protocol::PacketHeader hdr{};
+  if (!protocol::decode_header(frame, len, &hdr)) {
+    return;
+  }
+  uint8_t unwrapped[protocol::kMaxFrameSize] = {};
+  if (hdr.msg_type == protocol::MsgType::BeaconFec) {
+    // The medium only delivers envelopes the receiver can correct.
+    const size_t n = protocol::fec_unwrap(frame, len, unwrapped, sizeof(unwrapped));
+    if (n == 0 || !protocol::decode_header(unwrapped, n, &hdr)) {
+      return;
+    }
+    frame = unwrapped;
+    len = n;
+  }
+  const bool relayed = protocol::frame_hops(frame) > 0;
+  const domain::NodeTable& table = self->nodes_[receiver].node_table();
+  uint8_t expanded[protocol::kMaxFrameSize] = {};
+  if (protocol::is_short_addr_payload(frame + protocol::kHeaderSize, len - protocol::kHeaderSize)) {
+    // Same resolution as BeaconLogic::on_rx, against what the receiver holds.
+    uint16_t short_id = 0;
+    uint8_t tag = 0;
+    uint64_t node_id = 0;
+    protocol::short_addr_peek(frame + protocol::kHeaderSize, len - protocol::kHeaderSize, &short_id, &tag);
+    const size_t n = table.resolve_short_id(short_id, tag, &node_id)
+        ? protocol::short_addr_expand(frame, len, node_id, expanded, sizeof(expanded))
+        : 0;
+    if (n == 0 || !protocol::decode_header(expanded, n, &hdr)) {
+      self->report_.short_addr_unresolved++;
+      return;
+    }
+    frame = expanded;
+    len = n;
+  }
+  // Positions are attributed to their originator (a relay copy carries the originator's id).
+  const uint64_t node_id = protocol::wire::read_nodeid48_le(frame + protocol::kHeaderSize + 1);
+  const size_t origin = node_id > kNodeIdBase && node_id - kNodeIdBase <= self->nodes_.size()
+      ? static_cast<size_t>(node_id - kNodeIdBase - 1U)
+      : sender;
+  if (origin == receiver) {
+    return;  // own frame relayed back
+  }
+  bool has_pos = false;
+  bool no_ref = false;
+  uint16_t seq16 = 0;
+  if (hdr.msg_type == protocol::MsgType::BeaconBundle) {
+    uint8_t sub[protocol::kMaxFrameSize] = {};
+    for (size_t i = 0; !has_pos; ++i) {
+      const size_t sub_len = protocol::bundle_unpack(frame + protocol::kHeaderSize,
+                                                     len - protocol::kHeaderSize, i, sub, sizeof(sub));
+      if (sub_len == 0) {
+        break;
+      }
+      has_pos = position_usable(sub, sub_len, table, &no_ref, &seq16);
+    }
+  } else {
+    has_pos = position_usable(frame, len, table, &no_ref, &seq16);
+  }
+  if (no_ref && !has_pos) {
+    self->report_.pos_delta_no_ref++;
+  }
+  if (!has_pos) {
+    return;
+  }
+  if (relayed) {
+    // A relay copy of a position the receiver already holds (heard directly or via another
+    // relay) is duplicate airtime, not a delivery.
+    domain::NodeEntry entry{};
+    if (table.find_entry_by_node_id(node_id, &entry) && entry.has_core_seq16 &&
+        static_cast<int16_t>(seq16 - entry.last_core_seq16) <= 0) {
+      self->report_.pos_relayed_dup++;
+      return;
+    }
+    self->report_.pos_relayed_new++;
+  }
+  self->report_.pos_delivered++;
+  self->last_pos_rx_ms_[receiver * self->nodes_.size() + origin] =
+      static_cast<uint32_t>(now_us / 1000U) + 1U;
+}
+
+void MeshSim::move_node(size_t i, uint32_t now_ms) {
+  Mobility& m = mobility_[i];
+  if (m.pinned || now_ms < m.pause_until_ms) {
+    return;
+  }
+  const double dx = m.dest_x_m - m.x_m;
+  const double dy = m.dest_y_m - m.y_m;
+  const double dist = std::sqrt(dx * dx + dy * dy);
+  const double step = m.speed_mps * (kGnssPeriodMs / 1000.0);
+  if (dist <= step) {
+    m.x_m = m.dest_x_m;
+    m.y_m = m.dest_y_m;
+    std::uniform_real_distribution<double> pos(0.0, config_.area_m);
+    std::uniform_int_distribution<uint32_t> pause(0, config_.max_pause_ms);
+    m.dest_x_m = pos(rng_);
+    m.dest_y_m = pos(rng_);
+    m.pause_until_ms = now_ms + pause(rng_);
+  } else {
+    m.x_m += dx / dist * step;
+    m.y_m += dy / dist * step;
+  }
+  medium_.set_position(i, m.x_m, m.y_m);
+}
+
+void MeshSim::true_position_e7(size_t i, int32_t* lat_e7, int32_t* lon_e7) const {
+  const Mobility& m = mobility_[i];
+  const double lat_deg = kBaseLatDeg + m.y_m / kMetersPerDegLat;
+  const double lon_deg = kBaseLonDeg + m.x_m / (kMetersPerDegLat * std::cos(kBaseLatDeg * kPi / 180.0));
+  *lat_e7 = static_cast<int32_t>(std::llround(lat_deg * 1e7));
+  *lon_e7 = static_cast<int32_t>(std::llround(lon_deg * 1e7));
+}
+
+void MeshSim::gnss_update(size_t i, uint32_t now_ms) {
+  int32_t lat_e7 = 0;
+  int32_t lon_e7 = 0;
+  true_position_e7(i, &lat_e7, &lon_e7);
+  nodes_[i].on_gnss_fix(lat_e7, lon_e7, now_ms);
+}
+
+void MeshSim::sample_staleness(uint32_t now_ms) {
+  // Mobile population only; relays are infrastructure.
+  const size_t n = nodes_.size();
+  const size_t m = config_.node_count;
+  for (size_t r = 0; r < m; ++r) {
+    for (size_t s = 0; s < m; ++s) {
+      if (r == s) {
+        continue;
+      }
+      const uint32_t v = last_pos_rx_ms_[r * n + s];
+      const bool fresh = v != 0 && static_cast<double>(now_ms - (v - 1U)) <= config_.reach_fresh_s * 1000.0;
+      report_.reach_samples++;
+      reach_fresh_ += fresh ? 1U : 0U;
+      if (!medium_.in_range(s, r)) {
+        report_.reach_oor_samples++;
+        reach_oor_fresh_ += fresh ? 1U : 0U;
+        continue;
+      }
+      if (v == 0) {
+        report_.stale_never++;
+        continue;
+      }
+      const double age_s = static_cast<double>(now_ms - (v - 1U)) / 1000.0;
+      const size_t bucket = static_cast<size_t>(age_s);
+      stale_hist_[bucket < stale_hist_.size() ? bucket : stale_hist_.size() - 1]++;
+      stale_sum_s_ += age_s;
+      if (age_s > stale_max_s_) {
+        stale_max_s_ = age_s;
+      }
+      report_.stale_samples++;
+      sample_position_error(r, s, now_ms);
+    }
+  }
+}
+
+void MeshSim::sample_position_error(size_t receiver, size_t sender, uint32_t now_ms) {
+  domain::NodeEntry entry{};
+  if (!nodes_[receiver].node_table().find_entry_by_node_id(nodes_[sender].config().node_id, &entry) ||
+      !entry.pos_valid) {
+    return;
+  }
+  int32_t shown_lat = 0;
+  int32_t shown_lon = 0;
+  domain::NodeTable::predicted_position(entry, now_ms, &shown_lat, &shown_lon);
+  int32_t lat_e7 = 0;
+  int32_t lon_e7 = 0;
+  true_position_e7(sender, &lat_e7, &lon_e7);
+  const double err_m = distance_m(shown_lat, shown_lon, lat_e7, lon_e7);
+  const size_t bucket = static_cast<size_t>(err_m);
+  pos_err_hist_[bucket < pos_err_hist_.size() ? bucket : pos_err_hist_.size() - 1]++;
+  pos_err_sum_m_ += err_m;
+  if (err_m > report_.pos_err_max_m) {
+    report_.pos_err_max_m = err_m;
+  }
+  report_.pos_err_samples++;
+}
+
+void MeshSim::run() {
+  typedef std::pair<uint64_t, size_t> TickEvent;
+  std::priority_queue<TickEvent, std::vector<TickEvent>, std::greater<TickEvent> > ticks;
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    ticks.push(TickEvent(next_tick_us_[i], i));
+  }
+  const uint64_t end_us = static_cast<uint64_t>(config_.duration_s * 1e6);
+  const uint64_t tick_us = static_cast<uint64_t>(config_.tick_ms) * 1000U;
+  const uint64_t sample_us = static_cast<uint64_t>(config_.sample_interval_s * 1e6);
+  uint64_t next_sample_us = static_cast<uint64_t>(config_.warmup_s * 1e6);
+
+  const std::chrono::steady_clock::time_point wall_start = std::chrono::steady_clock::now();
+  while (!ticks.empty()) {
+    const uint64_t t_frame = medium_.next_end_us();
+    const uint64_t t_tick = ticks.top().first;
+    uint64_t t = t_frame < t_tick ? t_frame : t_tick;
+    if (next_sample_us < t) {
+      t = next_sample_us;
+    }
+    if (t >= end_us) {
+      break;
+    }
+    // Frame ends first, so a frame ending at t is visible to a node ticking at t.
+    if (t == t_frame) {
+      medium_.complete_next();
+      continue;
+    }
+    if (t == next_sample_us) {
+      sample_staleness(static_cast<uint32_t>(t / 1000U));
+      next_sample_us += sample_us;
+      continue;
+    }
+
+    const size_t i = ticks.top().second;
+    ticks.pop();
+    const uint32_t now_ms = static_cast<uint32_t>(t / 1000U);
+    const std::chrono::steady_clock::time_point c0 = std::chrono::steady_clock::now();
+    if (now_ms >= next_gnss_ms_[i]) {
+      move_node(i, now_ms);
+      gnss_update(i, now_ms);
+      next_gnss_ms_[i] += kGnssPeriodMs;
+    }
+    nodes_[i].tick(t);
+    const std::chrono::steady_clock::time_point c1 = std::chrono::steady_clock::now();
+    cpu_ns_[i] += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(c1 - c0).count());
+    ticks.push(TickEvent(t + tick_us, i));
+  }
+  const std::chrono::steady_clock::time_point wall_end = std::chrono::steady_clock::now();
+  finish(std::chrono::duration<double>(wall_end - wall_start).count());
+}
+
+void MeshSim::finish(double wall_s) {
+  MeshSimReport& r = report_;
+  const MediumStats& ms = medium_.stats();
+  const size_t n = nodes_.size();
+  r.nodes = n;
+  r.sim_s = config_.duration_s;
+  r.wall_s = wall_s;
+  r.tx_frames = ms.tx_frames;
+
+  for (size_t i = 0; i < n; ++i) {
+    const domain::TrafficCounters& c = nodes_[i].traffic_counters();
+    r.tx_pos_full += c.tx_sent_pos_full;
+    r.tx_alive += c.tx_sent_alive;
+    r.tx_status += c.tx_sent_status;
+    r.tx_pos_delta += c.tx_sent_pos_delta;
+    r.tx_send_fail += c.tx_drop_send_fail;
+    r.tx_channel_busy += c.tx_drop_channel_busy;
+    r.tx_slot_replaced += c.tx_slot_replaced;
+    r.tx_deferred_budget += c.tx_deferred_budget;
+    r.tx_status_suppressed += c.tx_status_suppressed;
+    r.tx_status_airtime_saved_ms += c.tx_status_airtime_saved_ms;
+    r.tx_bundles += c.tx_bundles;
+    r.tx_airtime_saved_ms += c.tx_airtime_saved_ms;
+    r.tx_short_addr += c.tx_short_addr;
+    r.tx_fec += c.tx_fec;
+    r.tx_relay += c.tx_sent_relay;
+    r.tx_relay_cancelled += c.tx_relay_cancelled;
+    r.rx_relay_dup += c.rx_relay_dup;
+  }
+
+  uint64_t total = 0;
+  for (size_t k = 0; k < kRxOutcomeCount; ++k) {
+    r.rx_outcome[k] = ms.outcome[k];
+    total += ms.outcome[k];
+  }
+  r.rx_out_of_range_ok = ms.rx_out_of_range_ok;
+  r.rx_fec_corrected = ms.fec_corrected;
+  r.pdr = total ? static_cast<double>(ms.outcome[static_cast<size_t>(RxOutcome::kOk)]) / total : 0.0;
+  r.goodput_pos_per_s = static_cast<double>(r.pos_delivered) / config_.duration_s;
+
+  const double sim_us = config_.duration_s * 1e6;
+  r.channel_busy_pct = 100.0 * static_cast<double>(ms.busy_us) / sim_us;
+  uint64_t relay_airtime_us = 0;
+  for (size_t i = 0; i < n; ++i) {
+    relay_airtime_us += nodes_[i].relay_airtime_us();
+  }
+  r.relay_airtime_pct = ms.airtime_us_total
+      ? 100.0 * static_cast<double>(relay_airtime_us) / static_cast<double>(ms.airtime_us_total)
+      : 0.0;
+  r.relay_mem_bytes = sizeof(domain::RelayPolicy) + sizeof(domain::TxSlot);
+  r.offered_load_pct = 100.0 * static_cast<double>(ms.airtime_us_total) / sim_us;
+  double cpu_sum = 0.0;
+  double interval_sum_s = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    if (i < config_.node_count) {
+      interval_sum_s += nodes_[i].effective_min_interval_ms() / 1000.0;
+    }
+    const double duty = 100.0 * static_cast<double>(medium_.node_airtime_us(i)) / sim_us;
+    if (duty > r.max_node_duty_pct) {
+      r.max_node_duty_pct = duty;
+    }
+    const double cpu = static_cast<double>(cpu_ns_[i]) / 1000.0 / config_.duration_s;
+    cpu_sum += cpu;
+    if (cpu > r.cpu_us_per_node_s_max) {
+      r.cpu_us_per_node_s_max = cpu;
+    }
+  }
+  r.cpu_us_per_node_s_mean = n ? cpu_sum / n : 0.0;
+  r.mean_interval_s = config_.node_count ? interval_sum_s / config_.node_count : 0.0;
+
+  r.stale_mean_s = r.stale_samples ? stale_sum_s_ / r.stale_samples : 0.0;
+  r.stale_p50_s = hist_percentile(stale_hist_, r.stale_samples, 0.50);
+  r.stale_p95_s = hist_percentile(stale_hist_, r.stale_samples, 0.95);
+  r.stale_max_s = stale_max_s_;
+  r.pos_err_mean_m = r.pos_err_samples ? pos_err_sum_m_ / r.pos_err_samples : 0.0;
+  r.pos_err_p95_m = hist_percentile(pos_err_hist_, r.pos_err_samples, 0.95);
+  r.reach_pct = r.reach_samples ? 100.0 * static_cast<double>(reach_fresh_) / r.reach_samples : 0.0;
+  r.reach_oor_pct = r.reach_oor_samples
+      ? 100.0 * static_cast<double>(reach_oor_fresh_) / r.reach_oor_samples
+      : 0.0;
+}
+
+} // namespace sim
+} // namespace naviga
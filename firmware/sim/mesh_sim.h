@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "sim_medium.h"
+#include "sim_node.h"
+
+namespace naviga {
+namespace sim {
+
+/** Role assignment across the simulated population. */
+enum class SimRoleMix : uint8_t {
+  kPerson = 0,
+  kDog = 1,
+  kMixed = 2,  ///< 1 dog per 4 persons.
+};
+
+struct MeshSimConfig {
+  size_t node_count = 50;
+  double duration_s = 3600.0;
+  double area_m = 3000.0;           ///< Square side; nodes random-waypoint inside it.
+  uint32_t tick_ms = 20;            ///< Main-loop period per node (phases are randomised).
+  uint32_t boot_spread_ms = 30000;  ///< Nodes boot uniformly within this window.
+  uint32_t max_pause_ms = 60000;    ///< Random-waypoint pause at each destination, uniform up to this.
+  double sample_interval_s = 5.0;   ///< Staleness sampling period.
+  double warmup_s = 120.0;          ///< No staleness samples before this (boot + first fixes).
+  SimRoleMix roles = SimRoleMix::kPerson;
+  bool adaptive_cadence = true;     ///< Congestion-adaptive interval (ChannelLoad) on every node.
+  bool bundling = false;            ///< Node_Bundle aggregation on every node (firmware RADIO_BUNDLING).
+  bool pos_delta = false;           ///< Node_Pos_Delta compact positions on every node (RADIO_POS_DELTA).
+  bool short_addr = false;          ///< Short-addressed frames on every node (RADIO_SHORT_ADDR).
+  bool slotted = false;             ///< Slotted TX on GNSS time on every node (RADIO_SLOTTED_TX).
+  bool channel_sense = true;        ///< Listen-before-talk (ambient RSSI) on every node.
+  size_t relays = 0;                ///< Extra Infra nodes that relay, pinned on a grid over the area.
+  uint8_t fec_parity = 0;           ///< Node_Fec parity bytes on position frames; 0 = off.
+  bool status_suppress = true;      ///< Content-aware Status on every node.
+  bool predictive = false;          ///< Dead-reckoning position updates (firmware RADIO_PREDICTIVE).
+  double dog_speed_mps = 3.0;       ///< Dog walking speed (persons 1.4 m/s).
+  double reach_fresh_s = 120.0;     ///< Reach: a peer counts as reached while its position is this fresh.
+  uint32_t seed = 1;
+  SimRadioParams radio{};
+};
+
+struct MeshSimReport {
+  size_t nodes = 0;
+  double sim_s = 0.0;
+  double wall_s = 0.0;
+
+  uint64_t tx_frames = 0;
+  uint64_t tx_pos_full = 0;
+  uint64_t tx_pos_delta = 0;
+  uint64_t tx_alive = 0;
+  uint64_t tx_status = 0;
+  uint64_t tx_send_fail = 0;  ///< Own previous frame still on air.
+  uint64_t tx_channel_busy = 0;  ///< Attempts deferred by listen-before-talk.
+  uint64_t tx_slot_replaced = 0;
+  uint64_t tx_deferred_budget = 0;  ///< Slots held back by the per-node airtime budget.
+  uint64_t tx_status_suppressed = 0;      ///< Unchanged Status not sent.
+  uint64_t tx_status_airtime_saved_ms = 0;  ///< Their standalone-frame airtime (all nodes).
+  uint64_t tx_bundles = 0;
+  uint64_t tx_airtime_saved_ms = 0;  ///< Bundle airtime saving vs separate frames (all nodes).
+  uint64_t tx_short_addr = 0;        ///< Frames sent short-addressed.
+  uint64_t tx_fec = 0;               ///< Frames sent in a Node_Fec envelope.
+  uint64_t tx_relay = 0;             ///< Relay copies sent.
+  uint64_t tx_relay_cancelled = 0;   ///< Queued relay copies dropped (another relay was first).
+  uint64_t rx_relay_dup = 0;         ///< Copies the relays' duplicate caches suppressed.
+  double relay_airtime_pct = 0.0;    ///< Relay copies' share of all airtime.
+  size_t relay_mem_bytes = 0;        ///< Per relay node: RelayPolicy + the relay TX slot.
+
+  /** Per (sender, in-range receiver) outcomes; pdr = ok / sum. */
+  uint64_t rx_outcome[kRxOutcomeCount] = {};
+  uint64_t rx_out_of_range_ok = 0;
+  uint64_t rx_fec_corrected = 0;  ///< Node_Fec frames delivered with bit errors, corrected.
+  double pdr = 0.0;
+  uint64_t pos_delivered = 0;      ///< Position frames delivered and usable (any receiver).
+  uint64_t pos_delta_no_ref = 0;   ///< Pos_Delta delivered to a receiver without its reference.
+  uint64_t short_addr_unresolved = 0;  ///< Short-addressed frame delivered to a receiver that cannot resolve it.
+  double goodput_pos_per_s = 0.0;  ///< pos_delivered per simulated second.
+  uint64_t pos_relayed_new = 0;    ///< Relay copies delivering a position the receiver lacked.
+  uint64_t pos_relayed_dup = 0;    ///< Relay copies delivering a position the receiver held.
+
+  double channel_busy_pct = 0.0;   ///< Fraction of time >= 1 frame on air.
+  double offered_load_pct = 0.0;   ///< Sum of airtime / time (can exceed 100).
+  double max_node_duty_pct = 0.0;
+  double mean_interval_s = 0.0;    ///< Mean effective min interval across mobile nodes at end of run.
+
+  /** Age of the newest usable position each node holds from each in-range peer, sampled periodically. */
+  uint64_t stale_samples = 0;
+  uint64_t stale_never = 0;  ///< In-range pairs with no position delivered yet.
+  double stale_mean_s = 0.0;
+  double stale_p50_s = 0.0;
+  double stale_p95_s = 0.0;
+  double stale_max_s = 0.0;
+
+  /** Reach: sampled (receiver, sender) pairs holding a position fresher than reach_fresh_s. */
+  uint64_t reach_samples = 0;
+  double reach_pct = 0.0;          ///< All pairs.
+  uint64_t reach_oor_samples = 0;  ///< Pairs out of direct range at sample time.
+  double reach_oor_pct = 0.0;
+
+  /**
+   * Position error: distance between where each in-range receiver shows a peer at sample time
+   * (NodeTable::predicted_position) and where the peer is. Pairs with a position held only.
+   */
+  uint64_t pos_err_samples = 0;
+  double pos_err_mean_m = 0.0;
+  double pos_err_p95_m = 0.0;
+  double pos_err_max_m = 0.0;
+
+  /** Host CPU in node code (tick + GNSS), per node per simulated second. Host, not ESP32, time. */
+  double cpu_us_per_node_s_mean = 0.0;
+  double cpu_us_per_node_s_max = 0.0;
+};
+
+/**
+ * Discrete-event multi-node simulator: node loop ticks and frame ends are processed in time
+ * order on a virtual microsecond clock. Deterministic for a given config (including seed).
+ */
+class MeshSim {
+ public:
+  void init(const MeshSimConfig& config);
+  void run();
+  const MeshSimReport& report() const { return report_; }
+
+  size_t node_count() const { return nodes_.size(); }
+  const SimNode& node(size_t i) const { return nodes_[i]; }
+  /** Place a node and pin it there (no random waypoint). For scripted scenarios/tests. */
+  void pin_node(size_t i, double x_m, double y_m);
+
+ private:
+  struct Mobility {
+    double x_m = 0.0;
+    double y_m = 0.0;
+    double dest_x_m = 0.0;
+    double dest_y_m = 0.0;
+    double speed_mps = 1.4;
+    uint32_t pause_until_ms = 0;
+    bool pinned = false;
+  };
+
+  static void on_delivery(void* ctx, size_t sender, size_t receiver,
+                          const uint8_t* frame, size_t len, uint64_t now_us);
+  void move_node(size_t i, uint32_t now_ms);
+  void gnss_update(size_t i, uint32_t now_ms);
+  void true_position_e7(size_t i, int32_t* lat_e7, int32_t* lon_e7) const;
+  void sample_staleness(uint32_t now_ms);
+  void sample_position_error(size_t receiver, size_t sender, uint32_t now_ms);
+  void finish(double wall_s);
+
+  MeshSimConfig config_{};
+  SimMedium medium_{};
+  std::vector<SimNode> nodes_;
+  std::vector<Mobility> mobility_;
+  std::vector<uint64_t> next_tick_us_;
+  std::vector<uint32_t> next_gnss_ms_;
+  std::vector<uint64_t> cpu_ns_;
+  /** last_pos_rx_ms_[receiver * N + sender]: delivery time + 1 of newest usable position; 0 = never. */
+  std::vector<uint32_t> last_pos_rx_ms_;
+  std::vector<uint32_t> stale_hist_;  ///< 1 s buckets; last bucket is overflow.
+  double stale_sum_s_ = 0.0;
+  double stale_max_s_ = 0.0;
+  uint64_t reach_fresh_ = 0;
+  uint64_t reach_oor_fresh_ = 0;
+  std::vector<uint32_t> pos_err_hist_;  ///< 1 m buckets; last bucket is overflow.
+  double pos_err_sum_m_ = 0.0;
+  std::mt19937 rng_;
+  MeshSimReport report_{};
+};
+
+} // namespace sim
+} // namespace naviga
@@ -0,0 +1,185 @@
+// Native mesh simulator entry point: pio run -e sim_native, then
+//   .pio/build/sim_native/program --nodes=100 --hours=2 --area=3000 --roles=mixed
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "mesh_sim.h"
+#include "../protocol/fec_codec.h"
+
+using naviga::protocol::fec_parity_valid;
+using naviga::sim::MeshSim;
+using naviga::sim::MeshSimConfig;
+using naviga::sim::MeshSimReport;
+using naviga::sim::RxOutcome;
+using naviga::sim::SimRoleMix;
+
+namespace {
+
+const char* arg_value(const char* arg, const char* name) {
+  const size_t n = std::strlen(name);
+  if (std::strncmp(arg, name, n) == 0 && arg[n] == '=') {
+    return arg + n + 1;
+  }
+  return nullptr;
+}
+
+void print_usage() {
+  std::printf(
+      "usage: program [--nodes=N] [--hours=H] [--area=M] [--roles=person|dog|mixed]\n"
+      "               [--rate=CODE] [--power=DBM] [--ple=EXP] [--shadow=DB] [--sens=DBM]\n"
+      "               [--capture=DB] [--tick-ms=MS] [--seed=S] [--adaptive=0|1]\n"
+      "               [--bundle=0|1] [--delta=0|1] [--short=0|1]\n"
+      "               [--slotted=0|1] [--sense=0|1] [--relays=N]\n"
+      "               [--ber=0|1] [--ber-ref=DB] [--fec=PARITY] [--status-skip=0|1]\n"
+      "               [--pause=S] [--predict=0|1] [--dog-speed=MPS]\n");
+}
+
+bool parse_args(int argc, char** argv, MeshSimConfig* cfg) {
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    const char* v = nullptr;
+    if ((v = arg_value(a, "--nodes"))) {
+      cfg->node_count = static_cast<size_t>(std::strtoul(v, nullptr, 10));
+    } else if ((v = arg_value(a, "--hours"))) {
+      cfg->duration_s = std::atof(v) * 3600.0;
+    } else if ((v = arg_value(a, "--area"))) {
+      cfg->area_m = std::atof(v);
+    } else if ((v = arg_value(a, "--roles"))) {
+      if (std::strcmp(v, "person") == 0) {
+        cfg->roles = SimRoleMix::kPerson;
+      } else if (std::strcmp(v, "dog") == 0) {
+        cfg->roles = SimRoleMix::kDog;
+      } else if (std::strcmp(v, "mixed") == 0) {
+        cfg->roles = SimRoleMix::kMixed;
+      } else {
+        return false;
+      }
+    } else if ((v = arg_value(a, "--rate"))) {
+      cfg->radio.air_rate = static_cast<uint8_t>(std::strtoul(v, nullptr, 10));
+    } else if ((v = arg_value(a, "--power"))) {
+      cfg->radio.tx_power_dbm = static_cast<float>(std::atof(v));
+    } else if ((v = arg_value(a, "--ple"))) {
+      cfg->radio.pl_exponent = static_cast<float>(std::atof(v));
+    } else if ((v = arg_value(a, "--shadow"))) {
+      cfg->radio.shadow_sigma_db = static_cast<float>(std::atof(v));
+    } else if ((v = arg_value(a, "--sens"))) {
+      cfg->radio.sensitivity_dbm = static_cast<float>(std::atof(v));
+    } else if ((v = arg_value(a, "--capture"))) {
+      cfg->radio.capture_db = static_cast<float>(std::atof(v));
+    } else if ((v = arg_value(a, "--tick-ms"))) {
+      cfg->tick_ms = static_cast<uint32_t>(std::strtoul(v, nullptr, 10));
+    } else if ((v = arg_value(a, "--seed"))) {
+      cfg->seed = static_cast<uint32_t>(std::strtoul(v, nullptr, 10));
+    } else if ((v = arg_value(a, "--adaptive"))) {
+      cfg->adaptive_cadence = std::strtoul(v, nullptr, 10) != 0;
+    } else if ((v = arg_value(a, "--bundle"))) {
+      cfg->bundling = std::strtoul(v, nullptr, 10) != 0;
+    } else if ((v = arg_value(a, "--delta"))) {
+      cfg->pos_delta = std::strtoul(v, nullptr, 10) != 0;
+    } else if ((v = arg_value(a, "--short"))) {
+      cfg->short_addr = std::strtoul(v, nullptr, 10) != 0;
+    } else if ((v = arg_value(a, "--slotted"))) {
+      cfg->slotted = std::strtoul(v, nullptr, 10) != 0;
+    } else if ((v = arg_value(a, "--sense"))) {
+      cfg->channel_sense = std::strtoul(v, nullptr, 10) != 0;
+    } else if ((v = arg_value(a, "--relays"))) {
+      cfg->relays = static_cast<size_t>(std::strtoul(v, nullptr, 10));
+    } else if ((v = arg_value(a, "--pause"))) {
+      cfg->max_pause_ms = static_cast<uint32_t>(std::atof(v) * 1000.0);
+    } else if ((v = arg_value(a, "--predict"))) {
+      cfg->predictive = std::strtoul(v, nullptr, 10) != 0;
+    } else if ((v = arg_value(a, "--dog-speed"))) {
+      cfg->dog_speed_mps = std::atof(v);
+    } else if ((v = arg_value(a, "--status-skip"))) {
+      cfg->status_suppress = std::strtoul(v, nullptr, 10) != 0;
+    } else if ((v = arg_value(a, "--ber"))) {
+      cfg->radio.bit_errors = std::strtoul(v, nullptr, 10) != 0;
+    } else if ((v = arg_value(a, "--ber-ref"))) {
+      cfg->radio.ber_ref_db = static_cast<float>(std::atof(v));
+    } else if ((v = arg_value(a, "--fec"))) {
+      cfg->fec_parity = static_cast<uint8_t>(std::strtoul(v, nullptr, 10));
+      if (cfg->fec_parity != 0 && !fec_parity_valid(cfg->fec_parity)) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  return cfg->node_count >= 2 && cfg->duration_s > 0.0 && cfg->tick_ms > 0;
+}
+
+void print_report(const MeshSimReport& r) {
+  std::printf("nodes=%u sim=%.0fs wall=%.2fs (x%.0f)\n", static_cast<unsigned>(r.nodes), r.sim_s, r.wall_s,
+              r.wall_s > 0.0 ? r.sim_s / r.wall_s : 0.0);
+  std::printf("tx frames=%llu pos_full=%llu pos_delta=%llu alive=%llu status=%llu send_fail=%llu channel_busy=%llu slot_replaced=%llu "
+              "deferred_budget=%llu\n",
+              static_cast<unsigned long long>(r.tx_frames), static_cast<unsigned long long>(r.tx_pos_full),
+              static_cast<unsigned long long>(r.tx_pos_delta),
+              static_cast<unsigned long long>(r.tx_alive), static_cast<unsigned long long>(r.tx_status),
+              static_cast<unsigned long long>(r.tx_send_fail),
+              static_cast<unsigned long long>(r.tx_channel_busy),
+              static_cast<unsigned long long>(r.tx_slot_replaced),
+              static_cast<unsigned long long>(r.tx_deferred_budget));
+  std::printf("rx pdr=%.1f%% ok=%llu fade=%llu half_duplex=%llu collision=%llu queue_full=%llu bit_error=%llu "
+              "(beyond range ok=%llu)\n",
+              r.pdr * 100.0,
+              static_cast<unsigned long long>(r.rx_outcome[static_cast<size_t>(RxOutcome::kOk)]),
+              static_cast<unsigned long long>(r.rx_outcome[static_cast<size_t>(RxOutcome::kFade)]),
+              static_cast<unsigned long long>(r.rx_outcome[static_cast<size_t>(RxOutcome::kHalfDuplex)]),
+              static_cast<unsigned long long>(r.rx_outcome[static_cast<size_t>(RxOutcome::kCollision)]),
+              static_cast<unsigned long long>(r.rx_outcome[static_cast<size_t>(RxOutcome::kQueueFull)]),
+              static_cast<unsigned long long>(r.rx_outcome[static_cast<size_t>(RxOutcome::kBitError)]),
+              static_cast<unsigned long long>(r.rx_out_of_range_ok));
+  std::printf("goodput pos=%.2f/s (delivered=%llu delta_no_ref=%llu short_unresolved=%llu) mean_interval=%.1fs\n",
+              r.goodput_pos_per_s, static_cast<unsigned long long>(r.pos_delivered),
+              static_cast<unsigned long long>(r.pos_delta_no_ref),
+              static_cast<unsigned long long>(r.short_addr_unresolved), r.mean_interval_s);
+  std::printf("airtime busy=%.2f%% offered=%.2f%% max_node_duty=%.3f%%\n", r.channel_busy_pct,
+              r.offered_load_pct, r.max_node_duty_pct);
+  std::printf("bundles=%llu airtime_saved=%.1f s/h (%.2f s/h per node) short_addr=%llu\n",
+              static_cast<unsigned long long>(r.tx_bundles),
+              r.tx_airtime_saved_ms / 1000.0 / (r.sim_s / 3600.0),
+              r.nodes ? r.tx_airtime_saved_ms / 1000.0 / (r.sim_s / 3600.0) / r.nodes : 0.0,
+              static_cast<unsigned long long>(r.tx_short_addr));
+  std::printf("status sent=%llu suppressed=%llu airtime_saved=%.2f s/h per node\n",
+              static_cast<unsigned long long>(r.tx_status),
+              static_cast<unsigned long long>(r.tx_status_suppressed),
+              r.nodes ? r.tx_status_airtime_saved_ms / 1000.0 / (r.sim_s / 3600.0) / r.nodes : 0.0);
+  std::printf("fec tx=%llu corrected=%llu\n", static_cast<unsigned long long>(r.tx_fec),
+              static_cast<unsigned long long>(r.rx_fec_corrected));
+  std::printf("staleness mean=%.1fs p50=%.0fs p95=%.0fs max=%.1fs samples=%llu never=%llu\n", r.stale_mean_s,
+              r.stale_p50_s, r.stale_p95_s, r.stale_max_s, static_cast<unsigned long long>(r.stale_samples),
+              static_cast<unsigned long long>(r.stale_never));
+  std::printf("position frames=%.1f/h per node error mean=%.1fm p95=%.0fm max=%.1fm (samples=%llu)\n",
+              r.nodes ? (r.tx_pos_full + r.tx_pos_delta) / (r.sim_s / 3600.0) / r.nodes : 0.0,
+              r.pos_err_mean_m, r.pos_err_p95_m, r.pos_err_max_m,
+              static_cast<unsigned long long>(r.pos_err_samples));
+  std::printf("reach (pos <= 120 s old) all=%.1f%% out_of_range=%.1f%% (samples=%llu)\n", r.reach_pct,
+              r.reach_oor_pct, static_cast<unsigned long long>(r.reach_oor_samples));
+  std::printf("relay tx=%llu cancelled=%llu cache_dup=%llu airtime=%.1f%% pos new=%llu dup=%llu mem=%u B/relay\n",
+              static_cast<unsigned long long>(r.tx_relay),
+              static_cast<unsigned long long>(r.tx_relay_cancelled),
+              static_cast<unsigned long long>(r.rx_relay_dup), r.relay_airtime_pct,
+              static_cast<unsigned long long>(r.pos_relayed_new),
+              static_cast<unsigned long long>(r.pos_relayed_dup),
+              static_cast<unsigned>(r.relay_mem_bytes));
+  std::printf("cpu (host) per node: mean=%.1f us/s max=%.1f us/s\n", r.cpu_us_per_node_s_mean,
+              r.cpu_us_per_node_s_max);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  MeshSimConfig cfg{};
+  if (!parse_args(argc, argv, &cfg)) {
+    print_usage();
+    return 2;
+  }
+  MeshSim sim;
+  sim.init(cfg);
+  sim.run();
+  print_report(sim.report());
+  return 0;
+}
@@ -0,0 +1,269 @@
+#include "sim_medium.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "domain/airtime_model.h"
+#include "../protocol/fec_codec.h"
+
+namespace naviga {
+namespace sim {
+
+namespace {
+
+double dbm_to_mw(double dbm) {
+  return std::pow(10.0, dbm / 10.0);
+}
+
+} // namespace
+
+void SimMedium::init(const SimRadioParams& params, size_t node_count, uint32_t seed) {
+  params_ = params;
+  nodes_.assign(node_count, NodeState{});
+  active_.clear();
+  stats_ = MediumStats{};
+  next_tx_id_ = 1;
+  busy_since_us_ = 0;
+  // Noise floor sits capture_db below sensitivity so a lone frame at sensitivity just decodes.
+  noise_mw_ = dbm_to_mw(params_.sensitivity_dbm - params_.capture_db);
+  lock_floor_dbm_ = params_.bit_errors ? params_.sensitivity_dbm - params_.ber_floor_db
+                                       : params_.sensitivity_dbm;
+  decode_noise_mw_ = dbm_to_mw(lock_floor_dbm_ - params_.capture_db);
+  rng_.seed(seed);
+  fade_ = std::normal_distribution<float>(0.0f, params_.shadow_sigma_db);
+}
+
+void SimMedium::set_delivery_hook(DeliveryHook hook, void* ctx) {
+  hook_ = hook;
+  hook_ctx_ = ctx;
+}
+
+void SimMedium::set_position(size_t node, double x_m, double y_m) {
+  nodes_[node].x_m = x_m;
+  nodes_[node].y_m = y_m;
+}
+
+float SimMedium::mean_rssi_dbm(size_t sender, size_t receiver) const {
+  const double dx = nodes_[sender].x_m - nodes_[receiver].x_m;
+  const double dy = nodes_[sender].y_m - nodes_[receiver].y_m;
+  const double d = std::sqrt(dx * dx + dy * dy);
+  const double pl = params_.pl_d0_db + 10.0 * params_.pl_exponent * std::log10(d < 1.0 ? 1.0 : d);
+  return static_cast<float>(params_.tx_power_dbm - pl);
+}
+
+bool SimMedium::in_range(size_t sender, size_t receiver) const {
+  return mean_rssi_dbm(sender, receiver) >= params_.sensitivity_dbm;
+}
+
+bool SimMedium::transmitting(size_t node, uint64_t now_us) const {
+  return nodes_[node].tx_end_us > now_us;
+}
+
+float SimMedium::ambient_dbm(size_t node) const {
+  double power_mw = noise_mw_;
+  for (size_t i = 0; i < active_.size(); ++i) {
+    if (active_[i].sender != node) {
+      power_mw += dbm_to_mw(active_[i].rssi_dbm[node]);
+    }
+  }
+  return static_cast<float>(10.0 * std::log10(power_mw));
+}
+
+uint32_t SimMedium::airtime_us(size_t frame_len) const {
+  return domain::e220_airtime_us(params_.air_rate, frame_len);
+}
+
+void SimMedium::record(size_t sender, size_t receiver, RxOutcome outcome) {
+  if (in_range(sender, receiver)) {
+    stats_.outcome[static_cast<size_t>(outcome)]++;
+  } else if (outcome == RxOutcome::kOk) {
+    stats_.rx_out_of_range_ok++;
+  }
+}
+
+bool SimMedium::sinr_ok(size_t receiver, uint32_t lock_tx_id, float lock_rssi_dbm) const {
+  double interference_mw = decode_noise_mw_;
+  for (size_t i = 0; i < active_.size(); ++i) {
+    const ActiveTx& a = active_[i];
+    if (a.id == lock_tx_id || a.sender == receiver) {
+      continue;
+    }
+    interference_mw += dbm_to_mw(a.rssi_dbm[receiver]);
+  }
+  return lock_rssi_dbm - 10.0 * std::log10(interference_mw) >= params_.capture_db;
+}
+
+uint64_t SimMedium::begin_tx(size_t sender, const uint8_t* frame, size_t len, uint64_t now_us) {
+  const uint32_t airtime = airtime_us(len);
+  const uint64_t end_us = now_us + airtime;
+  stats_.tx_frames++;
+  stats_.airtime_us_total += airtime;
+  if (active_.empty()) {
+    busy_since_us_ = now_us;
+  }
+
+  NodeState& self = nodes_[sender];
+  self.airtime_us += airtime;
+  self.tx_end_us = end_us;
+  if (self.locked) {
+    record(self.lock_sender, sender, RxOutcome::kHalfDuplex);
+    self.locked = false;
+  }
+
+  active_.push_back(ActiveTx{});
+  ActiveTx& tx = active_.back();
+  tx.id = next_tx_id_++;
+  tx.sender = sender;
+  tx.end_us = end_us;
+  tx.len = len < sizeof(tx.frame) ? len : sizeof(tx.frame);
+  std::memcpy(tx.frame, frame, tx.len);
+  tx.rssi_dbm.assign(nodes_.size(), -std::numeric_limits<float>::infinity());
+
+  for (size_t r = 0; r < nodes_.size(); ++r) {
+    if (r == sender) {
+      continue;
+    }
+    const float rssi = mean_rssi_dbm(sender, r) + fade_(rng_);
+    tx.rssi_dbm[r] = rssi;
+    NodeState& rx = nodes_[r];
+    if (transmitting(r, now_us)) {
+      record(sender, r, RxOutcome::kHalfDuplex);
+      continue;
+    }
+    const bool decodable = rssi >= lock_floor_dbm_;
+    if (rx.locked && decodable && rssi - rx.lock_rssi_dbm >= params_.capture_db) {
+      // Capture: the stronger newcomer resynchronises the demodulator; the old frame is lost.
+      record(rx.lock_sender, r, RxOutcome::kCollision);
+      rx.locked = false;
+    }
+    if (rx.locked) {
+      record(sender, r, decodable ? RxOutcome::kCollision : RxOutcome::kFade);
+      if (rx.lock_ok && !sinr_ok(r, rx.lock_tx_id, rx.lock_rssi_dbm)) {
+        rx.lock_ok = false;
+      }
+      continue;
+    }
+    if (!decodable) {
+      record(sender, r, RxOutcome::kFade);
+      continue;
+    }
+    rx.locked = true;
+    rx.lock_tx_id = tx.id;
+    rx.lock_sender = sender;
+    rx.lock_rssi_dbm = rssi;
+    rx.lock_ok = sinr_ok(r, tx.id, rssi);
+  }
+  return end_us;
+}
+
+uint64_t SimMedium::next_end_us() const {
+  uint64_t best = std::numeric_limits<uint64_t>::max();
+  for (size_t i = 0; i < active_.size(); ++i) {
+    if (active_[i].end_us < best) {
+      best = active_[i].end_us;
+    }
+  }
+  return best;
+}
+
+void SimMedium::complete_next() {
+  if (active_.empty()) {
+    return;
+  }
+  size_t idx = 0;
+  for (size_t i = 1; i < active_.size(); ++i) {
+    if (active_[i].end_us < active_[idx].end_us) {
+      idx = i;
+    }
+  }
+  const ActiveTx& tx = active_[idx];
+  for (size_t r = 0; r < nodes_.size(); ++r) {
+    NodeState& rx = nodes_[r];
+    if (!rx.locked || rx.lock_tx_id != tx.id) {
+      continue;
+    }
+    rx.locked = false;
+    if (!rx.lock_ok) {
+      record(tx.sender, r, RxOutcome::kCollision);
+      continue;
+    }
+    if (rx.rx_queue.size() >= params_.rx_queue_cap) {
+      record(tx.sender, r, RxOutcome::kQueueFull);
+      continue;
+    }
+    RxFrame f{};
+    std::memcpy(f.frame, tx.frame, tx.len);
+    f.len = tx.len;
+    const float rssi = tx.rssi_dbm[r];
+    if (params_.bit_errors && !corrupt(f, rssi)) {
+      record(tx.sender, r, RxOutcome::kBitError);
+      continue;
+    }
+    f.rssi_dbm = static_cast<int8_t>(rssi < -128.0f ? -128.0f : (rssi > 127.0f ? 127.0f : rssi));
+    rx.rx_queue.push_back(f);
+    record(tx.sender, r, RxOutcome::kOk);
+    if (hook_) {
+      hook_(hook_ctx_, tx.sender, r, f.frame, f.len, tx.end_us);
+    }
+  }
+  const uint64_t end_us = tx.end_us;
+  if (idx + 1 != active_.size()) {
+    active_[idx] = std::move(active_.back());
+  }
+  active_.pop_back();
+  if (active_.empty()) {
+    stats_.busy_us += end_us - busy_since_us_;
+  }
+}
+
+bool SimMedium::corrupt(RxFrame& f, float rssi_dbm) {
+  const double ebn0 = dbm_to_mw(params_.ber_ref_db + rssi_dbm - params_.sensitivity_dbm);
+  const double ber = 0.5 * std::erfc(std::sqrt(ebn0));
+  if (ber < 1e-12) {
+    return true;
+  }
+  // Geometric gaps between flipped bits: one draw per error instead of one per bit.
+  const double log_keep = std::log1p(-ber);
+  const size_t bits = f.len * 8u;
+  bool flipped = false;
+  for (size_t bit = 0;; ++bit) {
+    bit += static_cast<size_t>(std::log(1.0 - unit_(rng_)) / log_keep);
+    if (bit >= bits) {
+      break;
+    }
+    f.frame[bit / 8u] ^= static_cast<uint8_t>(1u << (bit % 8u));
+    flipped = true;
+  }
+  if (!flipped) {
+    return true;
+  }
+  protocol::PacketHeader hdr{};
+  uint8_t inner[protocol::kMaxFrameSize];
+  if (!protocol::decode_header(f.frame, f.len, &hdr) || hdr.msg_type != protocol::MsgType::BeaconFec ||
+      protocol::fec_unwrap(f.frame, f.len, inner, sizeof(inner)) == 0) {
+    return false;
+  }
+  stats_.fec_corrected++;
+  return true;
+}
+
+bool SimMedium::pop_rx(size_t node, uint8_t* out, size_t out_cap, size_t* out_len, int8_t* out_rssi) {
+  std::deque<RxFrame>& q = nodes_[node].rx_queue;
+  if (q.empty() || !out || !out_len) {
+    return false;
+  }
+  const RxFrame& f = q.front();
+  const size_t n = f.len < out_cap ? f.len : out_cap;
+  std::memcpy(out, f.frame, n);
+  *out_len = n;
+  if (out_rssi) {
+    *out_rssi = f.rssi_dbm;
+  }
+  q.pop_front();
+  return true;
+}
+
+} // namespace sim
+} // namespace naviga
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "../protocol/packet_header.h"
+
+namespace naviga {
+namespace sim {
+
+/**
+ * Shared-medium radio parameters (one channel, one preset for every node).
+ * Defaults model the OOTB Default preset: 2.4 kbps, 21 dBm (MIN), 433 MHz.
+ */
+struct SimRadioParams {
+  uint8_t air_rate = 2;             ///< RadioPreset air_rate code; airtime via domain::e220_airtime_us.
+  float tx_power_dbm = 21.0f;
+  float pl_d0_db = 25.2f;           ///< Free-space loss at 1 m, 433 MHz.
+  float pl_exponent = 2.9f;         ///< Log-distance exponent (2 = free space; 2.7–3.5 ground level).
+  float shadow_sigma_db = 4.0f;     ///< Per-frame log-normal fading, applied per receiver.
+  float sensitivity_dbm = -124.0f;  ///< Datasheet claims -131 dBm at 2.4 kbps; derated for margin.
+  float capture_db = 6.0f;          ///< Min SINR to decode; a newcomer this much stronger steals the lock.
+  size_t rx_queue_cap = 8;          ///< Frames buffered between the module and the host loop.
+  /**
+   * Bit-error model: frames down to ber_floor_db below sensitivity are locked too, and each
+   * bit is flipped with BER 0.5 * erfc(sqrt(Eb/N0)), Eb/N0 = ber_ref_db + (rssi - sensitivity)
+   * (BPSK curve on the faded received power, shifted to the preset's sensitivity). A plain
+   * frame with any bit error is dropped (PHY CRC); a Node_Fec frame reaches the host if its
+   * Reed-Solomon parity can correct it. Off: hard sensitivity threshold, no corruption.
+   */
+  bool bit_errors = false;
+  float ber_ref_db = 7.0f;          ///< BER ~8e-4 at sensitivity: ~10% of 19-byte frames lost.
+  float ber_floor_db = 4.0f;
+};
+
+/** Per (sender, receiver) frame outcome. Only counted for pairs in range on mean path loss. */
+enum class RxOutcome : uint8_t {
+  kOk = 0,
+  kFade,        ///< Received power below sensitivity (fading at range edge).
+  kHalfDuplex,  ///< Receiver was transmitting for part of the frame.
+  kCollision,   ///< Lost to interference, a stronger capture, or receiver locked on another frame.
+  kQueueFull,   ///< Decoded but host RX queue was full.
+  kBitError,    ///< Bit errors (bit_errors model): dropped by the PHY CRC or beyond FEC correction.
+};
+constexpr size_t kRxOutcomeCount = 6;
+
+struct MediumStats {
+  uint64_t tx_frames = 0;
+  uint64_t airtime_us_total = 0;  ///< Sum of all frame airtimes (offered load).
+  uint64_t busy_us = 0;           ///< Time with at least one frame on air.
+  uint64_t outcome[kRxOutcomeCount] = {};
+  uint64_t rx_out_of_range_ok = 0;  ///< Lucky receptions beyond mean range (not in PDR).
+  uint64_t fec_corrected = 0;       ///< Node_Fec frames delivered with bit errors the receiver corrects.
+};
+
+/**
+ * Discrete-event shared medium: frames occupy the channel for their airtime, receivers lock
+ * onto the first decodable frame, overlapping frames add interference (power sum), a later
+ * frame >= capture_db stronger steals the lock, and a transmitting node hears nothing.
+ * The scheduler calls complete_next() whenever next_end_us() is the earliest pending event.
+ */
+class SimMedium {
+ public:
+  using DeliveryHook = void (*)(void* ctx, size_t sender, size_t receiver,
+                                const uint8_t* frame, size_t len, uint64_t now_us);
+
+  void init(const SimRadioParams& params, size_t node_count, uint32_t seed);
+  void set_delivery_hook(DeliveryHook hook, void* ctx);
+  void set_position(size_t node, double x_m, double y_m);
+
+  /** Mean received power (no fading). */
+  float mean_rssi_dbm(size_t sender, size_t receiver) const;
+  bool in_range(size_t sender, size_t receiver) const;
+  bool transmitting(size_t node, uint64_t now_us) const;
+  /** Channel power at node: noise plus every frame on air from other nodes (energy detect). */
+  float ambient_dbm(size_t node) const;
+
+  /** Put a frame on air; returns its end time. Caller must check transmitting() first. */
+  uint64_t begin_tx(size_t sender, const uint8_t* frame, size_t len, uint64_t now_us);
+  /** Earliest end time of an active frame; UINT64_MAX when the channel is idle. */
+  uint64_t next_end_us() const;
+  /** Finish the earliest active frame: deliver to receivers still locked on it. */
+  void complete_next();
+
+  bool pop_rx(size_t node, uint8_t* out, size_t out_cap, size_t* out_len, int8_t* out_rssi);
+
+  uint32_t airtime_us(size_t frame_len) const;
+  const MediumStats& stats() const { return stats_; }
+  uint64_t node_airtime_us(size_t node) const { return nodes_[node].airtime_us; }
+  const SimRadioParams& params() const { return params_; }
+
+ private:
+  struct RxFrame {
+    uint8_t frame[protocol::kMaxFrameSize];
+    size_t len;
+    int8_t rssi_dbm;
+  };
+  struct NodeState {
+    double x_m = 0.0;
+    double y_m = 0.0;
+    uint64_t tx_end_us = 0;
+    uint64_t airtime_us = 0;
+    bool locked = false;
+    bool lock_ok = false;
+    uint32_t lock_tx_id = 0;
+    size_t lock_sender = 0;
+    float lock_rssi_dbm = 0.0f;
+    std::deque<RxFrame> rx_queue;
+  };
+  struct ActiveTx {
+    uint32_t id = 0;
+    size_t sender = 0;
+    uint64_t end_us = 0;
+    uint8_t frame[protocol::kMaxFrameSize] = {};
+    size_t len = 0;
+    std::vector<float> rssi_dbm;  ///< Faded received power per node.
+  };
+
+  void record(size_t sender, size_t receiver, RxOutcome outcome);
+  /** Apply the bit-error model to f (received at rssi_dbm); false if f is lost to it. */
+  bool corrupt(RxFrame& f, float rssi_dbm);
+  bool sinr_ok(size_t receiver, uint32_t lock_tx_id, float lock_rssi_dbm) const;
+
+  SimRadioParams params_{};
+  std::vector<NodeState> nodes_;
+  std::vector<ActiveTx> active_;
+  MediumStats stats_{};
+  uint32_t next_tx_id_ = 1;
+  uint64_t busy_since_us_ = 0;
+  double noise_mw_ = 0.0;
+  double decode_noise_mw_ = 0.0;  ///< Noise in the SINR test; lower with bit_errors (weaker locks).
+  float lock_floor_dbm_ = 0.0f;   ///< Weakest frame a receiver locks onto.
+  std::mt19937 rng_;
+  std::normal_distribution<float> fade_{0.0f, 1.0f};
+  std::uniform_real_distribution<double> unit_{0.0, 1.0};
+  DeliveryHook hook_ = nullptr;
+  void* hook_ctx_ = nullptr;
+};
+
+} // namespace sim
+} // namespace naviga
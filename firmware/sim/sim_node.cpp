@@ -0,0 +1,236 @@
+#include "sim_node.h"
+
+#include "domain/airtime_model.h"
+#include "../protocol/pos_full_codec.h"
+
+namespace naviga {
+namespace sim {
+
+namespace {
+
+constexpr size_t kMaxRxPerTick = 4;  // As M1Runtime.
+constexpr uint32_t kSenseTimeoutMs = 20;  // As M1Runtime.
+
+} // namespace
+
+bool SimRadio::send(const uint8_t* data, size_t len) {
+  if (!medium_ || !data || len == 0 || medium_->transmitting(index_, now_us_)) {
+    return false;
+  }
+  medium_->begin_tx(index_, data, len, now_us_);
+  return true;
+}
+
+bool SimRadio::send_async(const uint8_t* data, size_t len) {
+  if (async_in_flight_ || !send(data, len)) {
+    return false;
+  }
+  async_in_flight_ = true;
+  return true;
+}
+
+RadioTxStatus SimRadio::poll_tx_done() {
+  if (!async_in_flight_) {
+    return RadioTxStatus::IDLE;
+  }
+  if (medium_->transmitting(index_, now_us_)) {
+    return RadioTxStatus::IN_FLIGHT;
+  }
+  async_in_flight_ = false;
+  return RadioTxStatus::DONE;
+}
+
+bool SimRadio::recv(uint8_t* out, size_t max_len, size_t* out_len) {
+  return medium_ && medium_->pop_rx(index_, out, max_len, out_len, &last_rssi_dbm_);
+}
+
+ChannelSenseResult SimChannelSense::sense(uint32_t /*timeout_ms*/) {
+  if (!medium_) {
+    return {ChannelSenseState::UNSUPPORTED, 0};
+  }
+  const float ambient = medium_->ambient_dbm(index_);
+  const int16_t noise_dbm = static_cast<int16_t>(ambient < -255.0f ? -255.0f : ambient);
+  return {floor_.classify(noise_dbm), noise_dbm};
+}
+
+void SimNode::init(size_t index, const SimNodeConfig& config, SimMedium* medium, uint32_t now_ms) {
+  config_ = config;
+  radio_.bind(medium, index);
+  channel_sense_.bind(config.channel_sense ? medium : nullptr, index);
+
+  node_table_.set_expected_interval_s(static_cast<uint16_t>(config.min_interval_ms / 1000U));
+  node_table_.init_self(config.node_id, now_ms);
+
+  // Same settings as M1Runtime::init.
+  beacon_logic_.set_min_interval_ms(config.min_interval_ms);
+  beacon_logic_.set_max_silence_ms(config.max_silence_ms);
+  beacon_logic_.set_min_status_interval_ms(30000);
+  beacon_logic_.set_T_status_max_ms(300000);
+  beacon_logic_.set_traffic_counters(&traffic_counters_);
+  airtime_budget_.configure(domain::AirtimeBudget::kDefaultWindowMs,
+                            domain::AirtimeBudget::kDefaultDutyPermille);
+  beacon_logic_.set_airtime_budget(&airtime_budget_);
+  if (medium) {
+    air_rate_ = medium->params().air_rate;
+    beacon_logic_.set_air_rate(air_rate_);
+  }
+  channel_load_ = domain::ChannelLoad{};
+  channel_load_.seed(static_cast<uint32_t>(config.node_id));
+  beacon_logic_.set_channel_load(config.adaptive_cadence ? &channel_load_ : nullptr);
+  beacon_logic_.set_bundling(config.bundling);
+  beacon_logic_.set_status_suppress_unchanged(config.status_suppress);
+  beacon_logic_.set_fec_parity(config.fec_parity);
+  // As M1Runtime::set_relay.
+  if (config.relay) {
+    relay_policy_.configure(config.node_id, domain::RelayPolicy::kDefaultMaxHops,
+                            domain::RelayPolicy::kDefaultRebroadcastPct,
+                            domain::RelayPolicy::kDefaultDutyPermille);
+    beacon_logic_.set_relay(&relay_policy_);
+  }
+
+  send_policy_.init(static_cast<uint32_t>(config.node_id));
+  send_policy_.set_jitter_ms(250);
+  send_policy_.set_backoff_ms(200, 2000);
+  send_policy_.enable_sense(config.channel_sense);
+  if (config.slotted && medium) {
+    send_policy_.set_slotting(config.node_id, domain::BeaconSendPolicy::slot_ms_for(
+                                                  medium->params().air_rate, protocol::kPosFullFrameSize));
+  }
+
+  self_policy_.init();
+  self_policy_.set_max_silence_ms(config.max_silence_ms);
+  self_policy_.set_min_time_ms(config.min_interval_ms);
+  self_policy_.set_min_distance_m(config.min_displacement_m);
+  self_policy_.set_predictive(config.predictive);
+
+  self_fields_ = {};
+  self_fields_.node_id = config.node_id;
+
+  self_telemetry_ = {};
+  self_telemetry_.role_id = config.role_id;
+  self_telemetry_.has_max_silence = true;
+  self_telemetry_.max_silence_10s = static_cast<uint8_t>(config.max_silence_ms / 10000U);
+  self_telemetry_.has_battery = true;
+  self_telemetry_.battery_percent = 100;
+}
+
+void SimNode::on_gnss_fix(int32_t lat_e7, int32_t lon_e7, uint32_t now_ms) {
+  // Simulated GNSS time is the simulation clock, identical on every node.
+  send_policy_.set_gnss_time(now_ms, now_ms);
+  GnssSnapshot snapshot{};  // no NAV-PVT quality: quality_valid stays false
+  snapshot.fix_state = GNSSFixState::FIX_3D;
+  snapshot.pos_valid = true;
+  snapshot.lat_e7 = lat_e7;
+  snapshot.lon_e7 = lon_e7;
+  snapshot.last_fix_ms = now_ms;
+  snapshot.time_valid = true;
+  snapshot.tow_ms = now_ms;
+  snapshot.tow_at_ms = now_ms;
+  const SelfUpdateDecision decision = self_policy_.evaluate(now_ms, snapshot);
+  if (decision.reason == SelfUpdateReason::NONE) {
+    return;
+  }
+  self_policy_.commit(now_ms, snapshot);
+  node_table_.update_self_position(lat_e7, lon_e7, 0, now_ms);
+  self_fields_.pos_valid = 1;
+  self_fields_.lat_e7 = lat_e7;
+  self_fields_.lon_e7 = lon_e7;
+  beacon_logic_.set_self_pos_quality(SelfUpdatePolicy::pos_quality(snapshot));
+  if (self_policy_.predictive()) {
+    beacon_logic_.set_self_velocity(self_policy_.velocity(), now_ms);
+  }
+  allow_core_send_ = true;
+}
+
+void SimNode::tick(uint64_t now_us) {
+  const uint32_t now_ms = static_cast<uint32_t>(now_us / 1000U);
+  radio_.set_now_us(now_us);
+  self_telemetry_.has_uptime = true;
+  self_telemetry_.uptime_sec = now_ms / 1000U;
+  handle_rx(now_ms);
+  handle_tx(now_ms);
+}
+
+void SimNode::handle_rx(uint32_t now_ms) {
+  for (size_t i = 0; i < kMaxRxPerTick; ++i) {
+    uint8_t frame[protocol::kMaxFrameSize] = {};
+    size_t out_len = 0;
+    if (!radio_.recv(frame, sizeof(frame), &out_len)) {
+      return;
+    }
+    domain::PacketLogType rx_type = domain::PacketLogType::CORE;
+    if (beacon_logic_.on_rx(now_ms, frame, out_len, radio_.last_rssi_dbm(), node_table_,
+                            nullptr, nullptr, nullptr, &rx_type)) {
+      domain::count_rx_ok(traffic_counters_, rx_type);
+    } else {
+      traffic_counters_.rx_reject++;
+    }
+  }
+}
+
+void SimNode::handle_tx(uint32_t now_ms) {
+  if (tx_in_flight_) {
+    const RadioTxStatus status = radio_.poll_tx_done();
+    if (status != RadioTxStatus::IN_FLIGHT) {
+      tx_in_flight_ = false;
+      finish_tx(now_ms, status != RadioTxStatus::FAILED);
+    }
+    return;
+  }
+  if (!send_policy_.has_pending()) {
+    channel_load_.set_active_peers(
+        static_cast<uint16_t>(node_table_.peers_heard_within(now_ms, config_.max_silence_ms)));
+    const bool table_headroom = node_table_.size() <= domain::NodeTable::kMaxNodes / 2;
+    const bool relayed_heard = beacon_logic_.heard_relayed_within(now_ms, config_.max_silence_ms);
+    beacon_logic_.set_pos_delta(config_.pos_delta && table_headroom && !relayed_heard);
+    beacon_logic_.set_short_addr(config_.short_addr && table_headroom &&
+                                 !node_table_.self_short_id_collision());
+    beacon_logic_.update_tx_queue(now_ms, self_fields_, self_telemetry_, allow_core_send_);
+    allow_core_send_ = false;
+    size_t out_len = 0;
+    if (!beacon_logic_.dequeue_tx(now_ms, pending_payload_, sizeof(pending_payload_), &out_len, &last_tx_type_)) {
+      return;
+    }
+    pending_len_ = out_len;
+    last_tx_has_status_ = beacon_logic_.last_dequeue_has_status();
+    send_policy_.on_payload_built(now_ms);
+  }
+  if (!send_policy_.ready_to_attempt(now_ms)) {
+    return;
+  }
+  if (send_policy_.should_sense(&channel_sense_)) {
+    const ChannelSenseResult result = channel_sense_.sense(kSenseTimeoutMs);
+    if (result.state == ChannelSenseState::BUSY || result.state == ChannelSenseState::ERROR) {
+      send_policy_.on_channel_busy(now_ms);
+      traffic_counters_.tx_drop_channel_busy++;
+      return;
+    }
+  }
+  if (!radio_.send_async(pending_payload_, pending_len_)) {
+    finish_tx(now_ms, false);
+    return;
+  }
+  tx_in_flight_ = true;
+}
+
+void SimNode::finish_tx(uint32_t now_ms, bool ok) {
+  send_policy_.on_send_result(ok, now_ms);
+  if (ok) {
+    domain::count_tx_sent(traffic_counters_, last_tx_type_);
+    if (last_tx_type_ == domain::PacketLogType::RELAY) {
+      relay_airtime_us_ += domain::e220_airtime_us(air_rate_, pending_len_);
+    }
+    if (last_tx_has_status_ && last_tx_type_ != domain::PacketLogType::STATUS) {
+      traffic_counters_.tx_sent_status++;
+    }
+    if (last_tx_has_status_) {
+      beacon_logic_.on_status_sent(now_ms);
+    }
+    pending_len_ = 0;
+  } else {
+    traffic_counters_.tx_drop_send_fail++;
+  }
+}
+
+} // namespace sim
+} // namespace naviga
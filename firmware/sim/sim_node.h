@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "domain/airtime_budget.h"
+#include "domain/beacon_logic.h"
+#include "domain/beacon_send_policy.h"
+#include "domain/channel_load.h"
+#include "domain/node_table.h"
+#include "domain/noise_floor.h"
+#include "domain/relay_policy.h"
+#include "domain/traffic_counters.h"
+#include "naviga/hal/interfaces.h"
+#include "services/self_update_policy.h"
+#include "sim_medium.h"
+
+namespace naviga {
+namespace sim {
+
+/**
+ * IRadio backed by SimMedium. send() fails while the node's previous frame is still on air;
+ * send_async() frames stay IN_FLIGHT until their airtime has passed.
+ */
+class SimRadio : public IRadio {
+ public:
+  void bind(SimMedium* medium, size_t index) {
+    medium_ = medium;
+    index_ = index;
+  }
+  void set_now_us(uint64_t now_us) { now_us_ = now_us; }
+
+  bool send(const uint8_t* data, size_t len) override;
+  bool send_async(const uint8_t* data, size_t len) override;
+  RadioTxStatus poll_tx_done() override;
+  bool recv(uint8_t* out, size_t max_len, size_t* out_len) override;
+  int8_t last_rssi_dbm() const override { return last_rssi_dbm_; }
+  bool rssi_available() const override { return true; }
+  RadioBootConfigResult boot_config_result() const override { return RadioBootConfigResult::Ok; }
+  const char* boot_config_message() const override { return ""; }
+
+ private:
+  SimMedium* medium_ = nullptr;
+  size_t index_ = 0;
+  uint64_t now_us_ = 0;
+  int8_t last_rssi_dbm_ = 0;
+  bool async_in_flight_ = false;
+};
+
+/**
+ * IChannelSense backed by SimMedium: the module's ambient-noise reading (whole dBm) classified
+ * by domain::NoiseFloor, as AmbientRssiSense on hardware. Instantaneous; no UART round trip.
+ */
+class SimChannelSense : public IChannelSense {
+ public:
+  void bind(SimMedium* medium, size_t index) {
+    medium_ = medium;
+    index_ = index;
+    floor_.reset();
+  }
+
+  bool can_sense() const override { return medium_ != nullptr; }
+  ChannelSenseResult sense(uint32_t timeout_ms) override;
+
+ private:
+  SimMedium* medium_ = nullptr;
+  size_t index_ = 0;
+  domain::NoiseFloor floor_{};
+};
+
+/** Role cadence for one simulated node (values as in role_profile_ootb.cpp). */
+struct SimNodeConfig {
+  uint64_t node_id = 0;
+  uint8_t role_id = 0;
+  uint32_t min_interval_ms = 22000;
+  uint32_t max_silence_ms = 110000;
+  double min_displacement_m = 30.0;
+  bool adaptive_cadence = true;  ///< ChannelLoad stretch, as M1Runtime.
+  bool bundling = false;         ///< Node_Bundle aggregation (firmware: RADIO_BUNDLING, default off).
+  bool pos_delta = false;        ///< Node_Pos_Delta compact positions (firmware: RADIO_POS_DELTA, default off).
+  bool short_addr = false;       ///< Short-addressed frames (firmware: RADIO_SHORT_ADDR, default off).
+  bool slotted = false;          ///< Slotted TX on GNSS time (firmware: RADIO_SLOTTED_TX, default off).
+  bool channel_sense = true;     ///< Listen-before-talk on ambient RSSI, as M1Runtime.
+  bool relay = false;            ///< Mesh relay (M1Runtime::set_relay; Infra role on hardware).
+  bool status_suppress = true;   ///< Unchanged Status only at T_status_max, as M1Runtime.
+  uint8_t fec_parity = 0;        ///< BeaconLogic::set_fec_parity; 0 = off (M1Runtime default).
+  bool predictive = true;        ///< Dead-reckoning SelfUpdatePolicy + velocity in position frames, as AppServices.
+};
+
+/**
+ * One simulated device: the same domain objects M1Runtime owns (BeaconLogic, NodeTable,
+ * BeaconSendPolicy) plus AppServices' SelfUpdatePolicy gate, driven in the same order.
+ * M1Runtime itself is not instantiated: it pulls in the BLE bridges and NVS-backed profile
+ * storage, which have no native build and would dominate per-node CPU cost.
+ */
+class SimNode {
+ public:
+  void init(size_t index, const SimNodeConfig& config, SimMedium* medium, uint32_t now_ms);
+
+  /** GNSS fix at 1 Hz (AppServices::tick order: SelfUpdatePolicy, then runtime position). */
+  void on_gnss_fix(int32_t lat_e7, int32_t lon_e7, uint32_t now_ms);
+  /** One pass of the main loop: RX drain, then TX formation / send (M1Runtime::tick). */
+  void tick(uint64_t now_us);
+
+  const domain::TrafficCounters& traffic_counters() const { return traffic_counters_; }
+  const domain::NodeTable& node_table() const { return node_table_; }
+  const SimNodeConfig& config() const { return config_; }
+  uint32_t effective_min_interval_ms() const { return beacon_logic_.effective_min_interval_ms(); }
+  /** Airtime of relay copies this node sent. */
+  uint64_t relay_airtime_us() const { return relay_airtime_us_; }
+
+ private:
+  void handle_rx(uint32_t now_ms);
+  void handle_tx(uint32_t now_ms);
+  void finish_tx(uint32_t now_ms, bool ok);
+
+  SimNodeConfig config_{};
+  SimRadio radio_{};
+  SimChannelSense channel_sense_{};
+  domain::NodeTable node_table_{};
+  domain::BeaconLogic beacon_logic_{};
+  domain::BeaconSendPolicy send_policy_{};
+  domain::TrafficCounters traffic_counters_{};
+  domain::AirtimeBudget airtime_budget_{};
+  domain::ChannelLoad channel_load_{};
+  domain::RelayPolicy relay_policy_{};
+  domain::SelfTelemetry self_telemetry_{};
+  SelfUpdatePolicy self_policy_{};
+  protocol::GeoBeaconFields self_fields_{};
+  bool allow_core_send_ = false;
+  uint8_t pending_payload_[protocol::kMaxFrameSize] = {};
+  size_t pending_len_ = 0;
+  domain::PacketLogType last_tx_type_ = domain::PacketLogType::CORE;
+  bool last_tx_has_status_ = false;
+  bool tx_in_flight_ = false;
+  uint8_t air_rate_ = 2;
+  uint64_t relay_airtime_us_ = 0;
+};
+
+} // namespace sim
+} // namespace naviga
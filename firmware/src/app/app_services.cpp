@@ -11,11 +11,13 @@
 #include "platform/arduino_logger.h"
 #include "platform/device_id.h"
 #include "platform/device_id_provider.h"
+#include "platform/flash_partition_region.h"
 #include "platform/radio_factory.h"
 #include "platform/gnss_ubx_uart_io.h"
 #include "platform/log_export_uart.h"
 #include "platform/naviga_storage.h"
 #include "platform/timebase.h"
+#include "services/ambient_rssi_sense.h"
 #include "services/gnss_scenario_override.h"
 #include "services/gnss_stub_service.h"
 #include "services/gnss_ublox_service.h"
@@ -35,6 +37,32 @@ constexpr const char* kFirmwareVersion = "ootb-74-m1-runtime";
 #error "No GNSS provider selected. Define GNSS_PROVIDER_STUB or GNSS_PROVIDER_UBLOX"
 #endif
 
+// Fleet-wide radio options (build_flags, e.g. -DRADIO_BUNDLING=1). Frames they add are dropped
+// by nodes on older firmware, so every node of a fleet must be built with the same values.
+#ifndef RADIO_BUNDLING
+#define RADIO_BUNDLING 0
+#endif
+#ifndef RADIO_POS_DELTA
+#define RADIO_POS_DELTA 0
+#endif
+#ifndef RADIO_SHORT_ADDR
+#define RADIO_SHORT_ADDR 0
+#endif
+// Slotted TX on GNSS time (-DRADIO_SLOTTED_TX=1); nodes without it send on jitter, no wire change.
+#ifndef RADIO_SLOTTED_TX
+#define RADIO_SLOTTED_TX 0
+#endif
+// Link-adaptive Default/Fast preset (-DRADIO_RATE_ADAPT=1); a group only moves to Fast when every
+// peer advertises it, so nodes without it keep their neighbours on Default.
+#ifndef RADIO_RATE_ADAPT
+#define RADIO_RATE_ADAPT 0
+#endif
+// Dead reckoning (-DRADIO_PREDICTIVE=1): positions go out only when receivers' extrapolation
+// drifts. Nodes that do not extrapolate show the last one sent, so the whole fleet needs it.
+#ifndef RADIO_PREDICTIVE
+#define RADIO_PREDICTIVE 0
+#endif
+
 #if defined(GNSS_PROVIDER_STUB)
 GnssStubService gnss_provider_;
 constexpr const char* kGnssProviderName = "STUB";
@@ -55,8 +83,12 @@ IRadio* radio = nullptr;
 static uint8_t g_nodetable_snapshot_buf[kMaxNodeTableSnapshotBytes];
 
 platform::ArduinoClock clock_;
+// Listen-before-talk on the module's ambient-noise RSSI (E220/E22 RSSI_AMBIENT_NOISE_ENABLED).
+AmbientRssiSense channel_sense_;
 platform::ArduinoLogger logger_;
 platform::DefaultDeviceIdProvider device_id_provider_;
+// Persistent event log backing store ("navlog" data partition); absent on stock partition tables.
+platform::FlashPartitionRegion flash_log_region_;
 
 constexpr const char* kLogTag = "app";
 
@@ -180,6 +212,7 @@ void AppServices::init() {
 
   bool radio_ready = false;
   radio = create_radio(profile, &radio_ready);
+  channel_sense_.set_io(radio_cmd_io(), &clock_);
   const RadioBootConfigResult radio_result = radio->boot_config_result();
   {
     const char* radio_boot_msg = radio->boot_config_message();
@@ -298,6 +331,10 @@ void AppServices::init() {
   self_policy.set_max_silence_ms(max_silence_ms);
   self_policy.set_min_time_ms(min_interval_ms);
   self_policy.set_min_distance_m(effective_min_distance_m);
+  // Dead reckoning: beacon when receivers' extrapolation is off, not on every displacement.
+  self_policy.set_predictive(RADIO_PREDICTIVE != 0);
+  // NAV-PVT hAcc: jitter inside the receiver's own error estimate is not a move.
+  self_policy.set_accuracy_gate(true);
 
   // Active user profile → self telemetry (#443): role_id and max_silence from resolved profile.
   self_telemetry_.role_id = (effective_role_id <= 2) ? static_cast<uint8_t>(effective_role_id) : 0;
@@ -348,7 +385,24 @@ void AppServices::init() {
 
   runtime_.init(full_id, short_id_, uptime_ms(), device_info, radio, radio_ready,
                 radio ? radio->rssi_available() : false, effective_interval_s, min_interval_ms, max_silence_ms,
-                &event_logger_, nullptr);
+                &event_logger_, &channel_sense_);
+  {
+    // TX airtime budget follows the preset radio_factory applied in Phase A (V1-A: FACTORY only).
+    RadioProfileRecord radio_record{};
+    get_factory_default_radio_profile(&radio_record);
+    runtime_.set_air_rate(radio_record.rate_tier);
+  }
+  // Infra nodes (fixed, powered, well sited) relay other nodes' beacons to extend reach.
+  runtime_.set_relay(effective_role_id_ == 2);
+  // Node_Bundle (0x08): Status rides with the next position frame.
+  runtime_.set_bundling(RADIO_BUNDLING != 0);
+  // Node_Pos_Delta (0x09): 14 B offsets between Pos_Full frames.
+  runtime_.set_pos_delta(RADIO_POS_DELTA != 0);
+  // Short addressing: short_id + tag instead of nodeId48 in position frames.
+  runtime_.set_short_addr(RADIO_SHORT_ADDR != 0);
+  runtime_.set_slotting(RADIO_SLOTTED_TX != 0);
+  // Close-range groups move to the Fast preset together (Status radioCaps vote) and back.
+  runtime_.set_rate_adapt(RADIO_RATE_ADAPT != 0);
   // #417: restore seq16 so first TX after reboot uses restored + 1 (canon rx_semantics_v0 §5.3).
   {
     uint16_t restored_seq = 0;
@@ -364,7 +418,16 @@ void AppServices::init() {
     }
   }
   provisioning_->set_instrumentation_flag(&instrumentation_enabled_);
+  provisioning_->set_log_binary_flag(&log_export_binary_);
   provisioning_->set_gnss_override(&gnss_override_);
+  // Flash event log: mirror every event record into the persistent ring when the partition exists.
+  if (flash_log_region_.begin() && flash_log_.mount(&flash_log_region_)) {
+    event_logger_.set_sink(domain::FlashLog::sink, &flash_log_);
+    provisioning_->set_flash_log(&flash_log_);
+    log_line("flashlog: mounted");
+  } else {
+    log_line("flashlog: off (no navlog partition)");
+  }
   runtime_.set_instrumentation_logger(app_instrumentation_log, this);
 
   // Populate static self-telemetry fields known at boot (for 0x04/0x05/0x07 formation). role_id and max_silence set above from active profile.
@@ -387,6 +450,7 @@ void AppServices::log_instrumentation_line(const char* line) {
 
 void AppServices::tick(uint32_t now_ms) {
   provisioning_->tick(now_ms);
+  flash_log_.tick(now_ms);
 
 #if defined(GNSS_PROVIDER_UBLOX)
   GnssUbloxDiagEvents ubx_events{};
@@ -406,14 +470,16 @@ void AppServices::tick(uint32_t now_ms) {
     if (gnss_provider_.get_diag(&diag)) {
       char buffer[160] = {0};
       std::snprintf(buffer, sizeof(buffer),
-                    "GNSS_UBX rx=%lu ok=%lu bad=%lu last=%lu fix=%s lat=%ld lon=%ld",
+                    "GNSS_UBX rx=%lu ok=%lu bad=%lu last=%lu fix=%s lat=%ld lon=%ld sv=%u hacc=%lumm",
                     static_cast<unsigned long>(diag.bytes_rx),
                     static_cast<unsigned long>(diag.frames_ok),
                     static_cast<unsigned long>(diag.frames_bad_ck),
                     static_cast<unsigned long>(diag.last_frame_ms),
                     fix_state_to_cstr(diag.fix_state),
                     static_cast<long>(diag.lat_e7),
-                    static_cast<long>(diag.lon_e7));
+                    static_cast<long>(diag.lon_e7),
+                    static_cast<unsigned>(diag.num_sv),
+                    static_cast<unsigned long>(diag.h_acc_mm));
       log_line(buffer);
     }
     gnss_diag_next_ms = now_ms + kGnssDiagPeriodMs;
@@ -440,6 +506,7 @@ void AppServices::tick(uint32_t now_ms) {
   }
   if (have_snapshot) {
     last_fix_state_ = snapshot.fix_state;
+    runtime_.set_gnss_time(snapshot.time_valid, snapshot.tow_ms, snapshot.tow_at_ms);
     if (snapshot.pos_valid && !fix_logged_) {
       log_line("GNSS: FIX acquired");
       fix_logged_ = true;
@@ -457,6 +524,10 @@ void AppServices::tick(uint32_t now_ms) {
                                  pos_age_s,
                                  snapshot.fix_state,
                                  now_ms);
+      runtime_.set_self_pos_quality(SelfUpdatePolicy::pos_quality(snapshot));
+      if (self_policy.predictive()) {
+        runtime_.set_self_velocity(self_policy.velocity(), now_ms);
+      }
       runtime_.set_allow_core_send(true);  // minDisplacement: allow CORE at next TX
       uint8_t payload[8] = {};
       write_i32_le(payload, snapshot.lat_e7);
@@ -545,9 +616,9 @@ void AppServices::tick(uint32_t now_ms) {
   oled_data.min_interval_sec = effective_min_interval_sec_;
   oled_data.min_distance_m = effective_min_distance_m_;
   oled_data.max_silence_10s = effective_max_silence_10s_;
-  oled_data.pos_tx = tc.tx_sent_pos_full;
+  oled_data.pos_tx = tc.tx_sent_pos_full + tc.tx_sent_pos_delta;
   oled_data.st_tx = tc.tx_sent_status;
-  oled_data.pos_rx = tc.rx_ok_pos_full;
+  oled_data.pos_rx = tc.rx_ok_pos_full + tc.rx_ok_pos_delta;
   oled_data.st_rx = tc.rx_ok_status;
   oled_.update(now_ms, oled_data);
 
@@ -567,7 +638,15 @@ void AppServices::tick(uint32_t now_ms) {
       last_peer_dump_ms_ = now_ms;
       runtime_.log_peer_dump(now_ms);
     }
-    platform::drain_logs_uart(event_logger_);
+    platform::drain_logs_uart(event_logger_, log_export_binary_ ? platform::LogExportFormat::kBinary
+                                                                : platform::LogExportFormat::kText);
+    const uint32_t truncated = platform::log_export_truncated_count();
+    if (truncated != log_truncated_reported_) {
+      log_truncated_reported_ = truncated;
+      std::snprintf(buffer, sizeof(buffer), "log_export: truncated=%lu",
+                    static_cast<unsigned long>(truncated));
+      log_line(buffer);
+    }
   }
 }
 
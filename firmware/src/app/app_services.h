@@ -4,6 +4,7 @@
 
 #include "app/m1_runtime.h"
 #include "domain/beacon_logic.h"
+#include "domain/flash_log.h"
 #include "domain/logger.h"
 #include "naviga/hal/interfaces.h"
 #include "services/gnss_scenario_override.h"
@@ -31,12 +32,15 @@ class AppServices {
   uint32_t last_gnss_override_log_ms_ = 0;
   bool fix_logged_ = false;
   bool instrumentation_enabled_ = false;
+  bool log_export_binary_ = false;
+  uint32_t log_truncated_reported_ = 0;  ///< platform::log_export_truncated_count() last logged.
   RadioRole role_ = RadioRole::RESP;
   uint16_t short_id_ = 0;
   char short_id_hex_[5] = {0};
   char mac_hex_[18] = {0};
   char bt_short_[5] = {0};
   domain::Logger event_logger_;
+  domain::FlashLog flash_log_;
   M1Runtime runtime_;
   OledStatus oled_;
   ProvisioningAdapter* provisioning_ = nullptr;
@@ -6,6 +6,8 @@
 
 #include "platform/ble_esp32_transport.h"
 #include "platform/timebase.h"
+#include "../../protocol/pos_full_codec.h"
+#include "../../protocol/status_codec.h"
 
 namespace naviga {
 
@@ -19,19 +21,7 @@ constexpr uint8_t kGeoBeaconMsgType = protocol::kGeoBeaconMsgType;
 constexpr size_t kRxBufSize = protocol::kMaxFrameSize;
 constexpr uint32_t kSenseTimeoutMs = 20U;
 constexpr size_t kMaxRxPerTick = 4;
-
-const char* packet_log_type_str(domain::PacketLogType t) {
-  switch (t) {
-    case domain::PacketLogType::CORE:     return "CORE";
-    case domain::PacketLogType::TAIL1:   return "TAIL1";
-    case domain::PacketLogType::TAIL2:   return "TAIL2";
-    case domain::PacketLogType::ALIVE:   return "ALIVE";
-    case domain::PacketLogType::INFO:    return "INFO";
-    case domain::PacketLogType::POS_FULL: return "POS_FULL";
-    case domain::PacketLogType::STATUS:   return "STATUS";
-  }
-  return "?";
-}
+constexpr uint32_t kPresetEvalPeriodMs = 10000U;
 
 bool is_tail_type(domain::PacketLogType t) {
   return t == domain::PacketLogType::TAIL1 ||
@@ -39,24 +29,6 @@ bool is_tail_type(domain::PacketLogType t) {
          t == domain::PacketLogType::INFO;
 }
 
-static void increment_tx_sent_by_type(domain::TrafficCounters& c, domain::PacketLogType t) {
-  switch (t) {
-    case domain::PacketLogType::POS_FULL: c.tx_sent_pos_full++; break;
-    case domain::PacketLogType::ALIVE:   c.tx_sent_alive++;   break;
-    case domain::PacketLogType::STATUS:  c.tx_sent_status++;  break;
-    default: break;
-  }
-}
-
-static void increment_rx_ok_by_type(domain::TrafficCounters& c, domain::PacketLogType t) {
-  switch (t) {
-    case domain::PacketLogType::POS_FULL: c.rx_ok_pos_full++; break;
-    case domain::PacketLogType::ALIVE:   c.rx_ok_alive++;   break;
-    case domain::PacketLogType::STATUS:  c.rx_ok_status++;  break;
-    default: break;
-  }
-}
-
 } // namespace
 
 void M1Runtime::init(uint64_t self_id,
@@ -91,12 +63,26 @@ void M1Runtime::init(uint64_t self_id,
   beacon_logic_.set_min_status_interval_ms(30000);   // 30s anti-burst
   beacon_logic_.set_T_status_max_ms(300000);         // 300s = 10 min bounded refresh
   beacon_logic_.set_traffic_counters(&traffic_counters_);
+  // Own-TX duty budget: 1% over a sliding 10 min window; P3 (Status) backs off first.
+  airtime_budget_.configure(domain::AirtimeBudget::kDefaultWindowMs,
+                            domain::AirtimeBudget::kDefaultDutyPermille);
+  beacon_logic_.set_airtime_budget(&airtime_budget_);
+  // Congestion adaptation: stretch min interval toward max silence as the channel fills.
+  channel_load_ = domain::ChannelLoad{};
+  channel_load_.seed(static_cast<uint32_t>(self_id));
+  beacon_logic_.set_channel_load(&channel_load_);
+  // Unchanged Status only at the T_status_max refresh (battery/role/ids rarely move).
+  beacon_logic_.set_status_suppress_unchanged(true);
+  max_silence_ms_ = max_silence_ms;
+  min_interval_ms_ = min_interval_ms;
+  preset_selector_.disable();
+  preset_evaluated_ = false;
 
   self_fields_ = {};
   self_fields_.node_id = self_id;
   self_fields_.pos_valid = 0;
-  self_fields_.lat_deg = 0.0;
-  self_fields_.lon_deg = 0.0;
+  self_fields_.lat_e7 = 0;
+  self_fields_.lon_e7 = 0;
   self_fields_.seq = 0;
 
   device_info_ = device_info;
@@ -106,7 +92,12 @@ void M1Runtime::init(uint64_t self_id,
   send_policy_.init(static_cast<uint32_t>(self_id));
   send_policy_.set_jitter_ms(250);
   send_policy_.set_backoff_ms(200, 2000);
-  send_policy_.enable_sense(false);
+  // LBT when a channel sense is wired; the policy still skips it while !can_sense().
+  send_policy_.enable_sense(channel_sense != nullptr);
+  // Jitter until set_slotting(true); slot length follows set_air_rate.
+  slotting_enabled_ = false;
+  air_rate_ = 2;
+  send_policy_.set_slotting(self_id, 0);
 
   ble_transport_.init();
   ble_transport_.set_request_handler(this);
@@ -121,8 +112,8 @@ void M1Runtime::set_self_position(bool pos_valid,
   if (pos_valid) {
     node_table_.update_self_position(lat_e7, lon_e7, pos_age_s, now_ms);
     self_fields_.pos_valid = 1;
-    self_fields_.lat_deg = static_cast<double>(lat_e7) * 1e-7;
-    self_fields_.lon_deg = static_cast<double>(lon_e7) * 1e-7;
+    self_fields_.lat_e7 = lat_e7;
+    self_fields_.lon_e7 = lon_e7;
 
     gnss_snapshot_.fix_state = fix_state;
     gnss_snapshot_.pos_valid = true;
@@ -133,8 +124,8 @@ void M1Runtime::set_self_position(bool pos_valid,
   } else {
     node_table_.touch_self(now_ms);
     self_fields_.pos_valid = 0;
-    self_fields_.lat_deg = 0.0;
-    self_fields_.lon_deg = 0.0;
+    self_fields_.lat_e7 = 0;
+    self_fields_.lon_e7 = 0;
 
     gnss_snapshot_.fix_state = GNSSFixState::NO_FIX;
     gnss_snapshot_.pos_valid = false;
@@ -149,6 +140,14 @@ void M1Runtime::set_allow_core_send(bool allow) {
   allow_core_send_ = allow;
 }
 
+void M1Runtime::set_self_velocity(const protocol::PosVelocity& velocity, uint32_t now_ms) {
+  beacon_logic_.set_self_velocity(velocity, now_ms);
+}
+
+void M1Runtime::set_self_pos_quality(const protocol::PosQuality& quality) {
+  beacon_logic_.set_self_pos_quality(quality);
+}
+
 void M1Runtime::set_self_telemetry(const domain::SelfTelemetry& telemetry) {
   self_telemetry_ = telemetry;
 }
@@ -160,6 +159,7 @@ void M1Runtime::tick(uint32_t now_ms) {
   }
 
   handle_rx(now_ms);
+  update_preset(now_ms);
   handle_tx(now_ms);
   update_ble(now_ms);
 }
@@ -172,6 +172,106 @@ void M1Runtime::reset_traffic_counters() {
   traffic_counters_ = domain::TrafficCounters{};
 }
 
+void M1Runtime::set_air_rate(uint8_t air_rate) {
+  beacon_logic_.set_air_rate(air_rate);
+  air_rate_ = air_rate;
+  set_slotting(slotting_enabled_);
+}
+
+void M1Runtime::set_slotting(bool enabled) {
+  slotting_enabled_ = enabled;
+  send_policy_.set_slotting(
+      self_fields_.node_id,
+      enabled ? domain::BeaconSendPolicy::slot_ms_for(air_rate_, protocol::kPosFullFrameSize) : 0);
+}
+
+void M1Runtime::set_relay(bool enabled) {
+  if (!enabled) {
+    relay_policy_.disable();
+    beacon_logic_.set_relay(nullptr);
+    return;
+  }
+  relay_policy_.configure(self_fields_.node_id, domain::RelayPolicy::kDefaultMaxHops,
+                          domain::RelayPolicy::kDefaultRebroadcastPct,
+                          domain::RelayPolicy::kDefaultDutyPermille);
+  beacon_logic_.set_relay(&relay_policy_);
+}
+
+void M1Runtime::set_bundling(bool enabled) {
+  beacon_logic_.set_bundling(enabled);
+}
+
+void M1Runtime::set_pos_delta(bool enabled) {
+  pos_delta_enabled_ = enabled;
+}
+
+void M1Runtime::set_short_addr(bool enabled) {
+  short_addr_enabled_ = enabled;
+}
+
+void M1Runtime::set_rate_adapt(bool enabled) {
+  if (!enabled) {
+    preset_selector_.disable();
+    return;
+  }
+  preset_selector_.configure(protocol::kRadioCapsPresetMask, protocol::kPosFullFrameSize,
+                             min_interval_ms_);
+  preset_evaluated_ = false;
+}
+
+void M1Runtime::update_preset(uint32_t now_ms) {
+  // Reconfiguring blocks the radio: never with a send in flight, at most every 10 s.
+  if (!preset_selector_.enabled() || tx_in_flight_ ||
+      (preset_evaluated_ && now_ms - last_preset_eval_ms_ < kPresetEvalPeriodMs)) {
+    return;
+  }
+  preset_evaluated_ = true;
+  last_preset_eval_ms_ = now_ms;
+
+  domain::PresetPeerSummary summary{};
+  node_table_.for_each_used_entry([this, now_ms, &summary](const domain::NodeEntry& e) {
+    if (e.is_self || e.link.rx_count == 0) {
+      return;  // direct links only: a peer heard via relays only says nothing about ours
+    }
+    domain::PresetPeerView view{};
+    view.rssi_dbm = domain::link_stats_rssi_dbm(e.link);
+    view.pdr_pct = domain::link_stats_pdr_pct(e.link);
+    view.radio_caps = e.radio_caps;
+    view.last_rx_ms = e.link.last_rx_ms;
+    preset_selector_.add_peer(now_ms, view, &summary);
+  });
+
+  const RadioPresetId target = preset_selector_.update(now_ms, summary);
+  if (target == preset_selector_.active()) {
+    return;
+  }
+  const RadioPreset preset = get_radio_preset(target);
+  const bool ok = radio_->apply_preset(preset);
+  preset_selector_.on_applied(now_ms, ok);
+  if (ok) {
+    set_air_rate(preset.air_rate);
+    traffic_counters_.radio_preset_switch++;
+  } else {
+    traffic_counters_.radio_preset_fail++;
+  }
+  if (instrumentation_log_fn_ && instrumentation_ctx_) {
+    char line[80];
+    std::snprintf(line, sizeof(line), "radio preset t_ms=%lu to=%u air_rate=%u ok=%u peers=%u",
+                  static_cast<unsigned long>(now_ms), static_cast<unsigned>(target),
+                  static_cast<unsigned>(preset.air_rate), ok ? 1u : 0u,
+                  static_cast<unsigned>(summary.peers));
+    instrumentation_log_fn_(line, instrumentation_ctx_);
+  }
+}
+
+void M1Runtime::set_gnss_time(bool time_valid, uint32_t tow_ms, uint32_t tow_at_ms) {
+  if (time_valid) {
+    send_policy_.set_gnss_time(tow_ms, tow_at_ms);
+  } else {
+    send_policy_.clear_gnss_time();
+  }
+}
+
 size_t M1Runtime::node_count() const {
   return node_table_.size();
 }
@@ -206,7 +306,7 @@ void M1Runtime::log_peer_dump(uint32_t now_ms) {
     return;
   }
   constexpr size_t kMaxPeers = 3;
-  constexpr size_t kLineCap = 80;
+  constexpr size_t kLineCap = 144;
   char line[kLineCap];
   for (size_t i = 0; i < kMaxPeers; ++i) {
     const size_t len = node_table_.get_peer_dump_line(now_ms, i, line, sizeof(line));
@@ -253,8 +353,29 @@ void M1Runtime::get_self_node_name(char* out, size_t len) const {
 }
 
 void M1Runtime::handle_tx(uint32_t now_ms) {
+  // Async send on air: tick() keeps draining RX and serving BLE; no new frame until it ends.
+  if (tx_in_flight_) {
+    poll_tx(now_ms);
+    return;
+  }
+
   if (!send_policy_.has_pending()) {
     // Formation pass: update the TX queue with current self state and telemetry.
+    channel_load_.set_active_peers(
+        static_cast<uint16_t>(node_table_.peers_heard_within(now_ms, max_silence_ms_)));
+    // Node_Pos_Delta (0x09, opt-in): small moves go as 14 B offsets, Pos_Full every kPosDeltaRun + 1.
+    // Short addressing (opt-in): 4 B less per frame, full id every kShortAddrRun + 1 frames.
+    // Both need receivers to keep us in their NodeTable: only while the neighbourhood fits in
+    // half of it (past that, peers get evicted and lose the reference / short_id mapping).
+    // Short addressing also pauses while our short_id collides with a peer's. Deltas also pause
+    // while relayed frames are heard: peers out of direct range only get relayed copies and
+    // would miss the Pos_Full a delta is resolved against.
+    const bool table_headroom = node_table_.size() <= domain::NodeTable::kMaxNodes / 2;
+    const bool relayed_heard = beacon_logic_.heard_relayed_within(now_ms, max_silence_ms_);
+    beacon_logic_.set_pos_delta(pos_delta_enabled_ && table_headroom && !relayed_heard);
+    beacon_logic_.set_short_addr(short_addr_enabled_ && table_headroom &&
+                                 !node_table_.self_short_id_collision());
+    self_telemetry_.radio_caps = preset_selector_.radio_caps();
     beacon_logic_.update_tx_queue(now_ms, self_fields_, self_telemetry_, allow_core_send_);
     if (allow_core_send_) {
       allow_core_send_ = false;  // consumed; next CORE only after next position update
@@ -264,13 +385,15 @@ void M1Runtime::handle_tx(uint32_t now_ms) {
     size_t out_len = 0;
     domain::PacketLogType tx_type = domain::PacketLogType::CORE;
     uint16_t tx_core_seq = 0;
-    if (!beacon_logic_.dequeue_tx(pending_payload_, sizeof(pending_payload_),
+    if (!beacon_logic_.dequeue_tx(now_ms, pending_payload_, sizeof(pending_payload_),
                                   &out_len, &tx_type, &tx_core_seq)) {
       return;
     }
     pending_len_ = out_len;
     last_tx_type_ = tx_type;
     last_tx_core_seq_ = tx_core_seq;
+    last_tx_has_status_ = beacon_logic_.last_dequeue_has_status();
+    pending_seq16_ = beacon_logic_.last_dequeue_seq16();
     send_policy_.on_payload_built(now_ms);
   }
 
@@ -287,11 +410,11 @@ void M1Runtime::handle_tx(uint32_t now_ms) {
         char line[96];
         if (is_tail_type(last_tx_type_)) {
           std::snprintf(line, sizeof(line), "pkt drop t_ms=%lu type=%s reason=CHANNEL_BUSY core_seq=%u",
-                        static_cast<unsigned long>(now_ms), packet_log_type_str(last_tx_type_),
+                        static_cast<unsigned long>(now_ms), domain::packet_log_type_str(last_tx_type_),
                         static_cast<unsigned>(last_tx_core_seq_));
         } else {
           std::snprintf(line, sizeof(line), "pkt drop t_ms=%lu type=%s reason=CHANNEL_BUSY",
-                        static_cast<unsigned long>(now_ms), packet_log_type_str(last_tx_type_));
+                        static_cast<unsigned long>(now_ms), domain::packet_log_type_str(last_tx_type_));
         }
         instrumentation_log_fn_(line, instrumentation_ctx_);
       }
@@ -302,34 +425,55 @@ void M1Runtime::handle_tx(uint32_t now_ms) {
   }
 
   // tx_event_seq is an instrumentation TX event counter (uint32); not the on-air seq16 (uint16) from BeaconCore/Alive.
-  const uint32_t next_seq = stats_.tx_event_seq + 1;
-  const bool ok = radio_->send(pending_payload_, pending_len_);
+  stats_.tx_event_seq++;
+  if (!radio_->send_async(pending_payload_, pending_len_)) {
+    finish_tx(now_ms, false);
+    return;
+  }
+  tx_in_flight_ = true;
+  poll_tx(now_ms);  // modules (and mocks) that finish at once
+}
+
+void M1Runtime::poll_tx(uint32_t now_ms) {
+  const RadioTxStatus status = radio_->poll_tx_done();
+  if (status == RadioTxStatus::IN_FLIGHT) {
+    return;
+  }
+  tx_in_flight_ = false;
+  // IDLE: the radio has nothing in flight any more; count the send as done.
+  finish_tx(now_ms, status != RadioTxStatus::FAILED);
+}
+
+void M1Runtime::finish_tx(uint32_t now_ms, bool ok) {
   send_policy_.on_send_result(ok, now_ms);
-  stats_.tx_event_seq = next_seq;
   if (ok) {
     stats_.tx_count++;
     stats_.last_tx_ms = now_ms;
-    increment_tx_sent_by_type(traffic_counters_, last_tx_type_);
+    domain::count_tx_sent(traffic_counters_, last_tx_type_);
+    if (last_tx_has_status_ && last_tx_type_ != domain::PacketLogType::STATUS) {
+      traffic_counters_.tx_sent_status++;  // carried in a Node_Bundle
+    }
     // #422: Notify BeaconLogic when Node_Status was sent (status lifecycle: min_status_interval, T_status_max, bootstrap).
-    if (last_tx_type_ == domain::PacketLogType::STATUS) {
+    if (last_tx_has_status_) {
       beacon_logic_.on_status_sent(now_ms);
     }
-    // Persist the seq16 that was actually sent (#417): Common prefix at payload offset 7-8, frame = header(2) + payload.
+    // Persist the seq16 that was actually sent (#417); the frame itself may be short-addressed or
+    // a Node_Bundle, so BeaconLogic reports it at dequeue (newest sub-message of a bundle).
     // Store value and validity separately so seq16 0 (wraparound) is persisted.
-    if (pending_len_ >= 11) {
-      last_sent_seq16_ = static_cast<uint16_t>(pending_payload_[9])
-          | (static_cast<uint16_t>(pending_payload_[10]) << 8);
+    // A relay copy carries another node's seq16: not ours to persist.
+    if (last_tx_type_ != domain::PacketLogType::RELAY) {
+      last_sent_seq16_ = pending_seq16_;
       has_last_sent_seq16_ = true;
     }
     if (instrumentation_log_fn_ && instrumentation_ctx_) {
       char line[96];
       if (is_tail_type(last_tx_type_)) {
         std::snprintf(line, sizeof(line), "pkt tx t_ms=%lu type=%s seq=%u core_seq=%u",
-                      static_cast<unsigned long>(now_ms), packet_log_type_str(last_tx_type_),
+                      static_cast<unsigned long>(now_ms), domain::packet_log_type_str(last_tx_type_),
                       static_cast<unsigned>(stats_.tx_event_seq), static_cast<unsigned>(last_tx_core_seq_));
       } else {
         std::snprintf(line, sizeof(line), "pkt tx t_ms=%lu type=%s seq=%u",
-                      static_cast<unsigned long>(now_ms), packet_log_type_str(last_tx_type_),
+                      static_cast<unsigned long>(now_ms), domain::packet_log_type_str(last_tx_type_),
                       static_cast<unsigned>(stats_.tx_event_seq));
       }
       instrumentation_log_fn_(line, instrumentation_ctx_);
@@ -342,11 +486,11 @@ void M1Runtime::handle_tx(uint32_t now_ms) {
       char line[96];
       if (is_tail_type(last_tx_type_)) {
         std::snprintf(line, sizeof(line), "pkt drop t_ms=%lu type=%s reason=SEND_FAIL core_seq=%u",
-                      static_cast<unsigned long>(now_ms), packet_log_type_str(last_tx_type_),
+                      static_cast<unsigned long>(now_ms), domain::packet_log_type_str(last_tx_type_),
                       static_cast<unsigned>(last_tx_core_seq_));
       } else {
         std::snprintf(line, sizeof(line), "pkt drop t_ms=%lu type=%s reason=SEND_FAIL",
-                      static_cast<unsigned long>(now_ms), packet_log_type_str(last_tx_type_));
+                      static_cast<unsigned long>(now_ms), domain::packet_log_type_str(last_tx_type_));
       }
       instrumentation_log_fn_(line, instrumentation_ctx_);
     }
@@ -380,7 +524,7 @@ void M1Runtime::handle_rx(uint32_t now_ms) {
                                              node_table_, &rx_node_id, &rx_seq, &rx_pos_valid,
                                              &rx_type, &rx_core_seq);
     if (updated) {
-      increment_rx_ok_by_type(traffic_counters_, rx_type);
+      domain::count_rx_ok(traffic_counters_, rx_type);
     } else {
       traffic_counters_.rx_reject++;
     }
@@ -389,12 +533,12 @@ void M1Runtime::handle_rx(uint32_t now_ms) {
       char line[100];
       if (is_tail_type(rx_type)) {
         std::snprintf(line, sizeof(line), "pkt rx t_ms=%lu type=%s seq=%u core_seq=%u from=%u rssi=%d",
-                      static_cast<unsigned long>(now_ms), packet_log_type_str(rx_type),
+                      static_cast<unsigned long>(now_ms), domain::packet_log_type_str(rx_type),
                       static_cast<unsigned>(rx_seq), static_cast<unsigned>(rx_core_seq),
                       static_cast<unsigned>(from_short), static_cast<int>(stats_.last_rssi_dbm));
       } else {
         std::snprintf(line, sizeof(line), "pkt rx t_ms=%lu type=%s seq=%u from=%u rssi=%d",
-                      static_cast<unsigned long>(now_ms), packet_log_type_str(rx_type),
+                      static_cast<unsigned long>(now_ms), domain::packet_log_type_str(rx_type),
                       static_cast<unsigned>(rx_seq), static_cast<unsigned>(from_short),
                       static_cast<int>(stats_.last_rssi_dbm));
       }
@@ -436,6 +580,7 @@ void M1Runtime::update_ble(uint32_t now_ms) {
     ble_bridge_.update_subscription_batch(now_ms, node_table_, ble_transport_);
   }
   ble_status_bridge_.update_status(now_ms, gnss_snapshot_, ble_transport_);
+  ble_bridge_.update_link_stats(node_table_, ble_transport_);
 
   // S04 #467: Profiles list and profile read (radio [0], user [0,1,2]; read by type+id).
   ble_profiles_bridge_.update_profiles_list(ble_transport_);
@@ -3,11 +3,15 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "domain/airtime_budget.h"
 #include "domain/beacon_logic.h"
 #include "domain/beacon_send_policy.h"
+#include "domain/channel_load.h"
 #include "domain/logger.h"
 #include "domain/node_table.h"
 #include "domain/nodetable_snapshot.h"
+#include "domain/preset_selector.h"
+#include "domain/relay_policy.h"
 #include "domain/traffic_counters.h"
 #include "naviga/hal/interfaces.h"
 #include "platform/ble_esp32_transport.h"
@@ -43,6 +47,14 @@ class M1Runtime : public IBleRequestHandler {
 
   /** Set true when SelfUpdatePolicy committed (position update); used for minDisplacement gating. */
   void set_allow_core_send(bool allow);
+  /**
+   * Dead reckoning: velocity a predictive SelfUpdatePolicy committed with the position, at
+   * now_ms. Position frames then carry it and the position extrapolated to their send time
+   * (BeaconLogic::set_self_velocity).
+   */
+  void set_self_velocity(const protocol::PosVelocity& velocity, uint32_t now_ms);
+  /** Pos_Quality of the committed self position, sent in Pos_Full (BeaconLogic::set_self_pos_quality). */
+  void set_self_pos_quality(const protocol::PosQuality& quality);
 
   /** Update self telemetry used for 0x04/0x05 formation. Call before tick() each cycle. */
   void set_self_telemetry(const domain::SelfTelemetry& telemetry);
@@ -53,6 +65,41 @@ class M1Runtime : public IBleRequestHandler {
   /** #425: traffic validation counters (enqueue/sent/drop by type, RX accept/reject). */
   const domain::TrafficCounters& traffic_counters() const { return traffic_counters_; }
   void reset_traffic_counters();
+  /** Air rate code of the active radio preset; used for TX airtime budgeting. Default 2 (2.4 kbps). */
+  void set_air_rate(uint8_t air_rate);
+  /**
+   * Mesh relay of other nodes' Pos_Full / Status (bounded flood: RelayPolicy defaults for hops,
+   * probability and a 0.5 % relay airtime cap). Opt-in per role (Infra); default off.
+   */
+  void set_relay(bool enabled);
+  /**
+   * Node_Bundle (0x08): a due Status rides with the next PosFull/Alive instead of its own frame
+   * (BeaconLogic::set_bundling). Receivers on older firmware drop 0x08: fleet-wide; default off.
+   */
+  void set_bundling(bool enabled);
+  /**
+   * Node_Pos_Delta (0x09) between Pos_Full frames while the NodeTable has headroom
+   * (BeaconLogic::set_pos_delta). Older firmware drops 0x09: fleet-wide; default off.
+   */
+  void set_pos_delta(bool enabled);
+  /**
+   * Short-addressed frames (short_id + tag instead of nodeId48) while the NodeTable has headroom
+   * and our short_id is unique (BeaconLogic::set_short_addr). Older firmware drops them:
+   * fleet-wide; default off.
+   */
+  void set_short_addr(bool enabled);
+  /**
+   * Link-adaptive radio preset (PresetSelector): advertise radioCaps in Node_Status and move the
+   * radio between Default and Fast with the group. Needs IRadio::apply_preset; default off.
+   */
+  void set_rate_adapt(bool enabled);
+  /**
+   * Slotted TX (BeaconSendPolicy::set_slotting): while GNSS time is known, one Node_Pos_Full per
+   * slot of GPS time, sized for the air rate; jitter otherwise. Default off.
+   */
+  void set_slotting(bool enabled);
+  /** GNSS time (NAV-PVT iTOW at uptime tow_at_ms) for slotted TX; time_valid=false = jitter. */
+  void set_gnss_time(bool time_valid, uint32_t tow_ms, uint32_t tow_at_ms);
 
   size_t node_count() const;
   uint16_t geo_seq() const;
@@ -87,7 +134,10 @@ class M1Runtime : public IBleRequestHandler {
 
  private:
   void handle_tx(uint32_t now_ms);
+  void poll_tx(uint32_t now_ms);
+  void finish_tx(uint32_t now_ms, bool ok);
   void handle_rx(uint32_t now_ms);
+  void update_preset(uint32_t now_ms);
   void update_ble(uint32_t now_ms);
   void log_event(uint32_t now_ms, domain::LogEventId event_id, domain::LogLevel level);
   void log_event(uint32_t now_ms,
@@ -104,7 +154,7 @@ class M1Runtime : public IBleRequestHandler {
   BleEsp32Transport ble_transport_{};
   protocol::DeviceInfoModel device_info_{};
   protocol::GeoBeaconFields self_fields_{};
-  GnssSnapshot gnss_snapshot_{GNSSFixState::NO_FIX, false, 0, 0, 0};
+  GnssSnapshot gnss_snapshot_{};  // value-initialised: NO_FIX, no position / time / quality
   domain::BeaconSendPolicy send_policy_{};
 
   IRadio* radio_ = nullptr;
@@ -116,12 +166,27 @@ class M1Runtime : public IBleRequestHandler {
 
   RadioSmokeStats stats_{};
   domain::TrafficCounters traffic_counters_{};
+  domain::AirtimeBudget airtime_budget_{};
+  domain::ChannelLoad channel_load_{};
+  domain::RelayPolicy relay_policy_{};
+  domain::PresetSelector preset_selector_{};
+  uint32_t last_preset_eval_ms_ = 0;
+  bool preset_evaluated_ = false;
+  uint32_t min_interval_ms_ = 0;  ///< Own beacon interval; PresetSelector payback estimate.
+  uint32_t max_silence_ms_ = 0;  ///< Role max silence; peers heard within it count toward channel load.
+  bool pos_delta_enabled_ = false;  ///< set_pos_delta; still gated on NodeTable headroom per pass.
+  bool slotting_enabled_ = false;  ///< set_slotting; slot length from air_rate_.
+  uint8_t air_rate_ = 2;  ///< set_air_rate (default 2.4 kbps).
+  bool short_addr_enabled_ = false;  ///< set_short_addr; also gated on headroom and short_id collision.
 
   // TX frame buffer: sized for the largest possible on-air frame.
   uint8_t pending_payload_[protocol::kMaxFrameSize] = {};
   size_t pending_len_ = 0;
+  bool tx_in_flight_ = false;  ///< pending_payload_ handed to radio_->send_async, not finished yet.
   domain::PacketLogType last_tx_type_ = domain::PacketLogType::CORE;
+  bool last_tx_has_status_ = false;  ///< Pending frame carries Node_Status (alone or bundled).
   uint16_t last_tx_core_seq_ = 0;
+  uint16_t pending_seq16_ = 0;  ///< seq16 of the pending frame (newest sub-message of a bundle).
   uint16_t last_sent_seq16_ = 0;   ///< Seq16 of last successfully sent frame (#417); valid iff has_last_sent_seq16_.
   bool has_last_sent_seq16_ = false;  ///< True after at least one successful TX (so seq16 0 after wrap is valid).
   bool allow_core_send_ = false;
@@ -0,0 +1,58 @@
+#include "domain/airtime_budget.h"
+
+namespace naviga {
+namespace domain {
+
+constexpr size_t AirtimeBudget::kBuckets;
+constexpr uint32_t AirtimeBudget::kDefaultWindowMs;
+constexpr uint16_t AirtimeBudget::kDefaultDutyPermille;
+constexpr uint32_t AirtimeBudget::kMaxWindowMs;
+
+void AirtimeBudget::configure(uint32_t window_ms, uint16_t duty_permille) {
+  if (window_ms < kBuckets) {
+    window_ms = kBuckets;
+  }
+  if (window_ms > kMaxWindowMs) {
+    window_ms = kMaxWindowMs;
+  }
+  if (duty_permille > 1000) {
+    duty_permille = 1000;
+  }
+  bucket_ms_ = window_ms / kBuckets;
+  // window_ms * 1000 µs/ms * duty / 1000.
+  budget_us_ = static_cast<uint32_t>(static_cast<uint64_t>(bucket_ms_) * kBuckets * duty_permille);
+  for (size_t i = 0; i < kBuckets; ++i) {
+    buckets_[i] = Bucket{};
+  }
+}
+
+void AirtimeBudget::record_tx(uint32_t now_ms, uint32_t airtime_us) {
+  const uint32_t epoch = now_ms / bucket_ms_;
+  Bucket& b = buckets_[epoch % kBuckets];
+  if (b.epoch != epoch) {
+    b.epoch = epoch;
+    b.used_us = 0;
+  }
+  const uint32_t sum = b.used_us + airtime_us;
+  b.used_us = sum < b.used_us ? UINT32_MAX : sum;
+}
+
+uint32_t AirtimeBudget::used_us(uint32_t now_ms) const {
+  const uint32_t epoch = now_ms / bucket_ms_;
+  uint64_t total = 0;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    const Bucket& b = buckets_[i];
+    if (b.epoch <= epoch && epoch - b.epoch < kBuckets) {
+      total += b.used_us;
+    }
+  }
+  return total > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(total);
+}
+
+bool AirtimeBudget::fits(uint32_t now_ms, uint32_t airtime_us, uint8_t pct) const {
+  const uint64_t limit = static_cast<uint64_t>(budget_us_) * pct / 100u;
+  return static_cast<uint64_t>(used_us(now_ms)) + airtime_us <= limit;
+}
+
+} // namespace domain
+} // namespace naviga
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace naviga {
+namespace domain {
+
+/**
+ * Sliding-window TX airtime (duty-cycle) budget for this node.
+ *
+ * The window is split into kBuckets fixed buckets; used_us() sums the buckets still inside
+ * the window, so the window slides in bucket-sized steps with O(kBuckets) memory and time.
+ * Budget = window * duty_permille / 1000. Priority policy is the caller's (BeaconLogic):
+ * fits() only answers "would this frame stay within pct% of the budget".
+ */
+class AirtimeBudget {
+ public:
+  static constexpr size_t kBuckets = 12;
+  static constexpr uint32_t kDefaultWindowMs = 600000;   ///< 10 min.
+  static constexpr uint16_t kDefaultDutyPermille = 10;   ///< 1 %.
+  static constexpr uint32_t kMaxWindowMs = 3600000;      ///< Keeps used_us() within uint32.
+
+  /** Reset and set window / duty. window_ms is clamped to [kBuckets, kMaxWindowMs]. */
+  void configure(uint32_t window_ms, uint16_t duty_permille);
+
+  /** Charge airtime_us of own TX at now_ms. */
+  void record_tx(uint32_t now_ms, uint32_t airtime_us);
+
+  /** Own airtime within the window ending at now_ms. */
+  uint32_t used_us(uint32_t now_ms) const;
+
+  /** Total budget per window (µs). */
+  uint32_t budget_us() const { return budget_us_; }
+
+  /** True if used + airtime_us stays within pct% of the budget. */
+  bool fits(uint32_t now_ms, uint32_t airtime_us, uint8_t pct) const;
+
+ private:
+  struct Bucket {
+    uint32_t epoch = 0;    ///< now_ms / bucket_ms_ when the bucket was last written.
+    uint32_t used_us = 0;
+  };
+
+  uint32_t bucket_ms_ = kDefaultWindowMs / kBuckets;
+  uint32_t budget_us_ = static_cast<uint32_t>(
+      static_cast<uint64_t>(kDefaultWindowMs) * kDefaultDutyPermille);
+  Bucket buckets_[kBuckets] = {};
+};
+
+} // namespace domain
+} // namespace naviga
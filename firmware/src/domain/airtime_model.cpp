@@ -0,0 +1,31 @@
+#include "domain/airtime_model.h"
+
+namespace naviga {
+namespace domain {
+
+namespace {
+
+constexpr uint32_t kAirRateBps[8] = {300, 1200, 2400, 4800, 9600, 19200, 38400, 62500};
+
+} // namespace
+
+uint32_t e220_air_rate_bps(uint8_t air_rate) {
+  return air_rate < 8 ? kAirRateBps[air_rate] : 2400u;
+}
+
+uint32_t e220_airtime_us(uint8_t air_rate, size_t frame_len) {
+  const uint64_t bytes = static_cast<uint64_t>(frame_len) + kE220PhyOverheadBytes;
+  const uint64_t bps = e220_air_rate_bps(air_rate);
+  return static_cast<uint32_t>((bytes * kE220UsPerByteAt2400 * 2400u + bps / 2u) / bps);
+}
+
+uint32_t e220_reconfig_blind_ms() {
+  // Two reads (command + reply header + registers) and one write, which echoes the registers.
+  const uint32_t read_bytes = 3u + 3u + kE220ConfigRegBytes;
+  const uint32_t uart_bytes = 2u * read_bytes + read_bytes + kE220ConfigRegBytes;
+  const uint32_t uart_ms = (uart_bytes * 10u * 1000u + kE220ConfigUartBps - 1u) / kE220ConfigUartBps;
+  return kE220ModeSettleMs + uart_ms + kE220ConfigApplyMs + kE220ModeReturnMs;
+}
+
+} // namespace domain
+} // namespace naviga
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace naviga {
+namespace domain {
+
+/**
+ * On-air time estimate for one E220 (UART-mode FSK) frame.
+ *
+ * Derived from the AUX bench (#332, _working/research/e220_airtime_profile_2400_4800.md):
+ * at air_rate code 2 (2.4 kbps) airtime grows ~20.3 ms per ~4.5-byte block, i.e. ~4.51 ms
+ * per byte. Other rate codes scale that slope by bit rate (the 4.8 kbps bench run was
+ * UART-limited and is not used). The AUX method cannot see preamble/sync/length/CRC,
+ * so a fixed kE220PhyOverheadBytes is charged per frame at the same per-byte cost.
+ *
+ * air_rate uses the RadioPreset encoding (0 = 0.3 kbps ... 7 = 62.5 kbps); out-of-range
+ * codes are treated as 2.4 kbps.
+ */
+constexpr uint32_t kE220UsPerByteAt2400 = 4511;
+constexpr size_t kE220PhyOverheadBytes = 8;
+
+/** Air bit rate (bps) for a RadioPreset air_rate code. */
+uint32_t e220_air_rate_bps(uint8_t air_rate);
+
+/** Estimated airtime (µs) of a frame of frame_len bytes (header + payload). */
+uint32_t e220_airtime_us(uint8_t air_rate, size_t frame_len);
+
+/**
+ * Cost of changing the E220 air rate at runtime (E220Radio::begin with the new preset): the
+ * module neither sends nor receives from entering config mode until it is back in normal mode.
+ *  - mode settle: M0/M1 held HIGH kE220ModeSettleMs before the first config command (#326);
+ *  - UART: read config, write config, re-read to verify, each a 3 B command and 3 B reply
+ *    header plus kE220ConfigRegBytes registers (twice for the write: sent and echoed), at
+ *    9600 8N1 (10 bits per byte);
+ *  - kE220ConfigApplyMs for the module to store and apply the registers and
+ *    kE220ModeReturnMs to settle back in normal mode (estimates; not benched).
+ */
+constexpr uint32_t kE220ModeSettleMs = 200;
+constexpr uint32_t kE220ConfigRegBytes = 8;
+constexpr uint32_t kE220ConfigUartBps = 9600;
+constexpr uint32_t kE220ConfigApplyMs = 40;
+constexpr uint32_t kE220ModeReturnMs = 40;
+
+/** Blind time (ms) of one E220 air-rate change. */
+uint32_t e220_reconfig_blind_ms();
+
+} // namespace domain
+} // namespace naviga
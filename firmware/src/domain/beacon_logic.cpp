@@ -1,18 +1,102 @@
 #include "domain/beacon_logic.h"
 
-#include <cmath>
 #include <cstring>
 
+#include "domain/airtime_model.h"
+#include "../../protocol/bundle_codec.h"
+#include "../../protocol/geo_u24.h"
+#include "../../protocol/pos_delta_codec.h"
 #include "../../protocol/pos_full_codec.h"
+#include "../../protocol/short_addr_codec.h"
 #include "../../protocol/status_codec.h"
 
 namespace naviga {
 namespace domain {
 
+namespace {
+
+/**
+ * FNV-1a over the Status fields receivers act on. uptime is left out: it only moves every
+ * 10 min and receivers can add the time since the last Status themselves.
+ */
+uint32_t status_content_hash(const SelfTelemetry& t) {
+  const uint8_t bytes[] = {
+      static_cast<uint8_t>((t.has_battery ? 1u : 0u) | (t.has_uptime ? 2u : 0u) |
+                           (t.has_max_silence ? 4u : 0u) | (t.has_hw_profile ? 8u : 0u) |
+                           (t.has_fw_version ? 16u : 0u)),
+      t.battery_percent, t.role_id, t.max_silence_10s,
+      static_cast<uint8_t>(t.hw_profile_id), static_cast<uint8_t>(t.hw_profile_id >> 8),
+      static_cast<uint8_t>(t.fw_version_id), static_cast<uint8_t>(t.fw_version_id >> 8),
+      t.radio_caps};
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < sizeof(bytes); ++i) {
+    h = (h ^ bytes[i]) * 16777619u;
+  }
+  return h;
+}
+
+/** seq16 of a queued v0.2 frame (after header, payloadVersion and nodeId48). */
+uint16_t frame_seq16(const uint8_t* frame) {
+  return protocol::wire::read_u16_le(frame + protocol::kHeaderSize + protocol::kBundlePrefixSize);
+}
+
+const PacketLogTypeInfo kPacketLogTypes[] = {
+  {"CORE", nullptr, nullptr},
+  {"TAIL1", nullptr, nullptr},
+  {"TAIL2", nullptr, nullptr},
+  {"ALIVE", &TrafficCounters::tx_sent_alive, &TrafficCounters::rx_ok_alive},
+  {"INFO", nullptr, nullptr},
+  {"POS_FULL", &TrafficCounters::tx_sent_pos_full, &TrafficCounters::rx_ok_pos_full},
+  {"STATUS", &TrafficCounters::tx_sent_status, &TrafficCounters::rx_ok_status},
+  {"POS_DELTA", &TrafficCounters::tx_sent_pos_delta, &TrafficCounters::rx_ok_pos_delta},
+  {"RELAY", &TrafficCounters::tx_sent_relay, nullptr},
+};
+static_assert(sizeof(kPacketLogTypes) / sizeof(kPacketLogTypes[0]) ==
+                  static_cast<size_t>(PacketLogType::RELAY) + 1,
+              "one kPacketLogTypes entry per PacketLogType, in enum order");
+
+} // namespace
+
+const PacketLogTypeInfo& packet_log_type_info(PacketLogType t) {
+  return kPacketLogTypes[static_cast<size_t>(t)];
+}
+
+void count_tx_sent(TrafficCounters& c, PacketLogType t) {
+  uint32_t TrafficCounters::*slot = packet_log_type_info(t).tx_sent;
+  if (slot) { (c.*slot)++; }
+}
+
+void count_rx_ok(TrafficCounters& c, PacketLogType t) {
+  uint32_t TrafficCounters::*slot = packet_log_type_info(t).rx_ok;
+  if (slot) { (c.*slot)++; }
+}
+
+// Registering a msg_type: add it to protocol::kRxMsgTypes and give it a route here.
+const BeaconLogic::RxRoute BeaconLogic::kRxRoutes[protocol::kMsgTypeCount] = {
+  /* 0x00 Reserved  */ {nullptr, 0},
+  /* 0x01 Core v0.1 */ {nullptr, 0},
+  /* 0x02 Alive     */ {&BeaconLogic::rx_alive, protocol::kAlivePayloadMin},
+  /* 0x03 Tail1 v0.1*/ {nullptr, 0},
+  /* 0x04 Tail2 v0.1*/ {nullptr, 0},
+  /* 0x05 Info v0.1 */ {nullptr, 0},
+  /* 0x06 PosFull   */ {&BeaconLogic::rx_pos_full, protocol::kPosFullPayloadSize},
+  /* 0x07 Status    */ {&BeaconLogic::rx_status, protocol::kStatusPayloadSize},
+  /* 0x08 Bundle    */ {&BeaconLogic::rx_bundle, protocol::kBundlePrefixSize},
+  /* 0x09 PosDelta  */ {&BeaconLogic::rx_pos_delta, protocol::kPosDeltaPayloadSize},
+  /* 0x0A Fec       */ {nullptr, 0},  // unwrapped by on_rx before routing
+  // 0x0B..0x7F: unassigned, zero-initialized (not handled).
+};
+
+constexpr uint8_t BeaconLogic::kP3BudgetPct;
+constexpr uint8_t BeaconLogic::kPosDeltaRun;
+constexpr int32_t BeaconLogic::kPosDeltaMaxStep;
+constexpr uint8_t BeaconLogic::kShortAddrRun;
+
 BeaconLogic::BeaconLogic() = default;
 
 void BeaconLogic::set_min_interval_ms(uint32_t min_interval_ms) {
   min_interval_ms_ = min_interval_ms;
+  effective_min_interval_ms_ = min_interval_ms;
 }
 
 void BeaconLogic::set_max_silence_ms(uint32_t max_silence_ms) {
@@ -29,6 +113,8 @@ void BeaconLogic::set_T_status_max_ms(uint32_t ms) {
 
 void BeaconLogic::on_status_sent(uint32_t now_ms) {
   last_status_tx_ms_ = now_ms;
+  status_hash_sent_ = status_hash_queued_;
+  status_hash_sent_valid_ = true;
   if (status_bootstrap_count_ < 2) {
     status_bootstrap_count_++;
   }
@@ -43,6 +129,17 @@ uint16_t BeaconLogic::next_seq16() {
   return seq_;
 }
 
+protocol::PosQuality BeaconLogic::self_frame_quality(uint32_t now_ms) const {
+  protocol::PosQuality q = self_pos_quality_;
+  if (self_velocity_valid_ && (self_velocity_.lat != 0 || self_velocity_.lon != 0)) {
+    q.pos_flags_small |= protocol::kPosFlagMoving;
+    if (now_ms != self_velocity_anchor_ms_) {
+      q.pos_flags_small |= protocol::kPosFlagEstimated;
+    }
+  }
+  return q;
+}
+
 void BeaconLogic::enqueue_slot(size_t slot_idx,
                                TxPriority priority,
                                TxBestEffortClass be_rank,
@@ -106,12 +203,12 @@ bool BeaconLogic::build_tx(uint32_t now_ms,
     protocol::PosFullFields pos{};
     pos.node_id = self_fields.node_id;
     pos.seq16 = seq;
-    pos.lat_deg = self_fields.lat_deg;
-    pos.lon_deg = self_fields.lon_deg;
-    pos.fix_type = 1;
-    pos.pos_sats = 0;
-    pos.pos_accuracy_bucket = 0;
-    pos.pos_flags_small = 0;
+    pos.lat_e7 = self_fields.lat_e7;
+    pos.lon_e7 = self_fields.lon_e7;
+    pos.fix_type = self_pos_quality_.fix_type;
+    pos.pos_sats = self_pos_quality_.pos_sats;
+    pos.pos_accuracy_bucket = self_pos_quality_.pos_accuracy_bucket;
+    pos.pos_flags_small = self_pos_quality_.pos_flags_small;
     const size_t written = protocol::encode_pos_full_frame(pos, out, out_cap);
     if (written == 0) {
       seq_ = static_cast<uint16_t>(seq_ - 1u);
@@ -150,7 +247,7 @@ bool BeaconLogic::build_tx(uint32_t now_ms,
 
 // ── Slot-based TX queue API (#435 v0.2) ───────────────────────────────────────
 //
-// TX sends v0.2 only: Node_Pos_Full (0x06), Node_Status (0x07), Alive (0x02).
+// TX sends v0.2 only: Node_Pos_Full (0x06) or Node_Pos_Delta (0x09), Node_Status (0x07), Alive (0x02).
 // Formation: PosFull when pos_valid and (time_for_min+allow_core) or time_for_silence;
 // Alive when !pos_valid and time_for_silence; Status per lifecycle (min_status_interval_ms,
 // T_status_max, bootstrap, no hitchhiking). See packet_truth_table_v02.md, packet_migration_v01_v02.md.
@@ -159,33 +256,96 @@ void BeaconLogic::update_tx_queue(uint32_t now_ms,
                                   const protocol::GeoBeaconFields& self_fields,
                                   const SelfTelemetry& telemetry,
                                   bool allow_core) {
+  effective_min_interval_ms_ = min_interval_ms_;
+  if (channel_load_) {
+    const uint32_t max_interval_ms = max_silence_ms_ > min_interval_ms_ ? max_silence_ms_ : min_interval_ms_;
+    channel_load_->update(now_ms, e220_airtime_us(air_rate_, protocol::kPosFullFrameSize),
+                          min_interval_ms_, max_interval_ms);
+    effective_min_interval_ms_ = channel_load_->stretch(min_interval_ms_);
+  }
+
   const uint32_t elapsed = (last_tx_ms_ == 0) ? now_ms : (now_ms - last_tx_ms_);
-  const bool time_for_min     = elapsed >= min_interval_ms_;
+  const bool time_for_min     = elapsed >= effective_min_interval_ms_;
   const bool time_for_silence = max_silence_ms_ > 0 && elapsed >= max_silence_ms_;
 
   bool pos_or_alive_enqueued = false;
 
   // ── Node_Pos_Full (0x06) / Alive (0x02) formation ──────────────────────────
+  // While stretched, a position update that arrives before the interval ends is kept until it
+  // can be sent, so stretching delays PosFull instead of dropping it. Unstretched cadence
+  // keeps the original consume-on-pass behaviour.
+  const bool stretched = effective_min_interval_ms_ > min_interval_ms_;
+  core_update_pending_ = (stretched && core_update_pending_) || allow_core;
+
   if (self_fields.pos_valid != 0) {
-    const bool should_pos = (time_for_min && allow_core) || time_for_silence;
+    const bool should_pos = (time_for_min && core_update_pending_) || time_for_silence;
     if (should_pos) {
       const uint16_t seq = next_seq16();
-      protocol::PosFullFields pos{};
-      pos.node_id = self_fields.node_id;
-      pos.seq16 = seq;
-      pos.lat_deg = self_fields.lat_deg;
-      pos.lon_deg = self_fields.lon_deg;
-      pos.fix_type = 1;
-      pos.pos_sats = 0;
-      pos.pos_accuracy_bucket = 0;
-      pos.pos_flags_small = 0;
-      uint8_t pos_frame[protocol::kPosFullFrameSize] = {};
-      const size_t pos_len = protocol::encode_pos_full_frame(pos, pos_frame, sizeof(pos_frame));
+      // Dead reckoning: send where receivers should place us now, with the velocity.
+      uint32_t lat_u24 = protocol::lat_e7_to_u24(self_fields.lat_e7);
+      uint32_t lon_u24 = protocol::lon_e7_to_u24(self_fields.lon_e7);
+      if (self_velocity_valid_) {
+        const uint32_t dt_ms = now_ms - self_velocity_anchor_ms_;
+        lat_u24 = protocol::pos_predict_u24(lat_u24, self_velocity_.lat, dt_ms);
+        lon_u24 = protocol::pos_predict_u24(lon_u24, self_velocity_.lon, dt_ms);
+      }
+      uint8_t pos_frame[protocol::kPosFullMaxFrameSize] = {};
+      size_t pos_len = 0;
+      // Delta once a Pos_Full has gone out, and only while the position stays within
+      // kPosDeltaMaxStep of it: receivers holding any frame of the run still resolve the
+      // 12-bit wrap, however many of the run's deltas they missed.
+      if (pos_delta_ && pos_ref_valid_ && pos_delta_run_ < kPosDeltaRun &&
+          static_cast<uint16_t>(seq - pos_ref_.seq16) <= NodeTable::kPosDeltaMaxSeqGap) {
+        const int32_t dlat = static_cast<int32_t>(lat_u24) - static_cast<int32_t>(pos_ref_.lat_u24);
+        const int32_t dlon = static_cast<int32_t>(lon_u24) - static_cast<int32_t>(pos_ref_.lon_u24);
+        if (dlat >= -kPosDeltaMaxStep && dlat <= kPosDeltaMaxStep &&
+            dlon >= -kPosDeltaMaxStep && dlon <= kPosDeltaMaxStep) {
+          protocol::PosDeltaFields delta{};
+          delta.node_id = self_fields.node_id;
+          delta.seq16 = seq;
+          delta.ref_seq8 = static_cast<uint8_t>(pos_ref_.seq16);
+          delta.lat_lsb = static_cast<uint16_t>(lat_u24 & protocol::kPosDeltaLsbMask);
+          delta.lon_lsb = static_cast<uint16_t>(lon_u24 & protocol::kPosDeltaLsbMask);
+          delta.has_velocity = self_velocity_valid_;
+          delta.vel_lat = self_velocity_.lat;
+          delta.vel_lon = self_velocity_.lon;
+          pos_len = protocol::encode_pos_delta_frame(delta, pos_frame, sizeof(pos_frame));
+        }
+      }
+      const bool is_delta = pos_len > 0;
+      if (!is_delta) {
+        protocol::PosFullFields pos{};
+        pos.node_id = self_fields.node_id;
+        pos.seq16 = seq;
+        pos.lat_e7 = protocol::u24_to_lat_e7(lat_u24);
+        pos.lon_e7 = protocol::u24_to_lon_e7(lon_u24);
+        const protocol::PosQuality q = self_frame_quality(now_ms);
+        pos.fix_type = q.fix_type;
+        pos.pos_sats = q.pos_sats;
+        pos.pos_accuracy_bucket = q.pos_accuracy_bucket;
+        pos.pos_flags_small = q.pos_flags_small;
+        pos.has_velocity = self_velocity_valid_;
+        pos.vel_lat = self_velocity_.lat;
+        pos.vel_lon = self_velocity_.lon;
+        pos_len = protocol::encode_pos_full_frame(pos, pos_frame, sizeof(pos_frame));
+      }
       if (pos_len > 0) {
         enqueue_slot(kSlotPosFull, TxPriority::P0_MUST_PERIODIC, TxBestEffortClass::BE_LOW,
-                     PacketLogType::POS_FULL, pos_frame, pos_len, now_ms, 0);
-        if (traffic_counters_) { traffic_counters_->tx_enqueue_pos_full++; }
+                     is_delta ? PacketLogType::POS_DELTA : PacketLogType::POS_FULL,
+                     pos_frame, pos_len, now_ms, 0);
+        if (traffic_counters_) {
+          if (is_delta) {
+            traffic_counters_->tx_enqueue_pos_delta++;
+          } else {
+            traffic_counters_->tx_enqueue_pos_full++;
+          }
+        }
+        pos_queued_.lat_u24 = lat_u24;
+        pos_queued_.lon_u24 = lon_u24;
+        pos_queued_.is_delta = is_delta;
+        pos_queued_.seq16 = seq;
         last_tx_ms_ = now_ms;
+        core_update_pending_ = false;
         pos_or_alive_enqueued = true;
       }
     }
@@ -212,12 +372,40 @@ void BeaconLogic::update_tx_queue(uint32_t now_ms,
   const bool status_interval_ok = (last_status_tx_ms_ == 0) || (now_ms - last_status_tx_ms_ >= min_status_interval_ms_);
   const bool status_T_max_force = (last_status_enqueue_ms_ != 0) && (now_ms - last_status_enqueue_ms_ >= T_status_max_ms_);
   const bool status_bootstrap_ok = status_bootstrap_count_ < 2;
-  const bool status_throttle_ok = status_bootstrap_ok || status_interval_ok || status_T_max_force;
-  const bool status_eligible = !pos_or_alive_enqueued && (time_for_min || time_for_silence) && status_throttle_ok;
+  // Content-aware: an unchanged snapshot waits for the T_status_max refresh.
+  const uint32_t status_hash = status_content_hash(telemetry);
+  const bool status_unchanged = status_suppress_unchanged_ && !status_bootstrap_ok &&
+                                status_hash_sent_valid_ && status_hash == status_hash_sent_;
+  const bool status_throttle_ok =
+      status_bootstrap_ok || (status_interval_ok && !status_unchanged) || status_T_max_force;
+  // A Status held for bundling keeps its snapshot: re-forming it every pass would burn seq16s.
+  const bool status_held = bundling_ && slots_[kSlotStatus].present;
+  const bool status_slot_open = !pos_or_alive_enqueued && !status_held && (time_for_min || time_for_silence);
+  const bool status_eligible = status_slot_open && status_throttle_ok;
 
   const bool has_status = telemetry.has_battery || telemetry.has_uptime ||
                           telemetry.has_max_silence || telemetry.has_hw_profile || telemetry.has_fw_version;
 
+  // Count each Status not sent where one would have gone: at most once per min_status_interval
+  // and, when bundling, once per P0 frame (a formed Status would have been held for it).
+  status_skip_held_ = status_skip_held_ && !(bundling_ && pos_or_alive_enqueued);
+  if (status_slot_open && has_status && !status_eligible && status_unchanged && status_interval_ok &&
+      !status_skip_held_ &&
+      (last_status_skip_ms_ == 0 || now_ms - last_status_skip_ms_ >= min_status_interval_ms_)) {
+    last_status_skip_ms_ = now_ms;
+    status_skip_held_ = bundling_;
+    if (traffic_counters_) {
+      // Bundled, the Status would only have lengthened the position frame carrying it.
+      const uint32_t saved_us = bundling_
+          ? e220_airtime_us(air_rate_, protocol::kPosFullFrameSize +
+                                           protocol::bundle_sub_cost(protocol::kStatusMaxFrameSize)) -
+                e220_airtime_us(air_rate_, protocol::kPosFullFrameSize)
+          : e220_airtime_us(air_rate_, protocol::kStatusMaxFrameSize);
+      traffic_counters_->tx_status_suppressed++;
+      traffic_counters_->tx_status_airtime_saved_ms += (saved_us + 500u) / 1000u;
+    }
+  }
+
   if (status_eligible && has_status) {
     const uint16_t status_seq = next_seq16();
     protocol::StatusFields st{};
@@ -231,37 +419,51 @@ void BeaconLogic::update_tx_queue(uint32_t now_ms,
     st.max_silence_10s = telemetry.max_silence_10s;
     st.hw_profile_id = telemetry.hw_profile_id;
     st.fw_version_id = telemetry.fw_version_id;
-    uint8_t status_frame[protocol::kStatusFrameSize] = {};
+    st.radio_caps = telemetry.radio_caps;
+    uint8_t status_frame[protocol::kStatusMaxFrameSize] = {};
     const size_t status_len = protocol::encode_status_frame(st, status_frame, sizeof(status_frame));
     if (status_len > 0) {
       enqueue_slot(kSlotStatus, TxPriority::P3_THROTTLED, TxBestEffortClass::BE_LOW,
                    PacketLogType::STATUS, status_frame, status_len, now_ms, 0);
       if (traffic_counters_) { traffic_counters_->tx_enqueue_status++; }
       last_status_enqueue_ms_ = now_ms;
+      status_hash_queued_ = status_hash;
     }
   }
 }
 
-bool BeaconLogic::dequeue_tx(uint8_t* out,
-                             size_t out_cap,
-                             size_t* out_len,
-                             PacketLogType* out_type,
-                             uint16_t* out_core_seq) {
-  if (!out || !out_len) {
-    return false;
-  }
-  *out_len = 0;
-
+int BeaconLogic::select_slot(uint32_t now_ms, bool timed) {
   // Selection order (lower value = higher priority in each dimension):
   //   1. TxPriority (primary): P0 > P1 > P2 > P3
   //   2. TxBestEffortClass be_rank (within P2 only; P3 slots use BE_LOW)
   //   3. replaced_count descending (most-starved first)
   //   4. created_at_ms ascending (oldest first)
+  const bool gated = timed && airtime_budget_ != nullptr;
+  bool p0_present = false;
+  for (size_t i = 0; i < kTxSlotCount; ++i) {
+    p0_present = p0_present || (slots_[i].present && slots_[i].priority == TxPriority::P0_MUST_PERIODIC);
+  }
   int best = -1;
   for (size_t i = 0; i < kTxSlotCount; ++i) {
     if (!slots_[i].present) {
       continue;
     }
+    // Bundling: P3 waits to ride with the next P0 (due within max silence at the latest).
+    if (timed && bundling_ && !p0_present && slots_[i].priority == TxPriority::P3_THROTTLED &&
+        now_ms - slots_[i].created_at_ms < max_silence_ms_) {
+      continue;
+    }
+    if (gated && slots_[i].priority != TxPriority::P0_MUST_PERIODIC) {
+      const uint8_t pct = slots_[i].priority == TxPriority::P3_THROTTLED ? kP3BudgetPct : 100u;
+      const uint32_t airtime_us = e220_airtime_us(air_rate_, slots_[i].frame_len);
+      if (!airtime_budget_->fits(now_ms, airtime_us, pct)) {
+        if (!slots_[i].budget_deferred) {
+          slots_[i].budget_deferred = true;
+          if (traffic_counters_) { traffic_counters_->tx_deferred_budget++; }
+        }
+        continue;
+      }
+    }
     if (best < 0) {
       best = static_cast<int>(i);
       continue;
@@ -290,7 +492,15 @@ bool BeaconLogic::dequeue_tx(uint8_t* out,
       }
     }
   }
+  return best;
+}
 
+bool BeaconLogic::take_slot(int best,
+                            uint8_t* out,
+                            size_t out_cap,
+                            size_t* out_len,
+                            PacketLogType* out_type,
+                            uint16_t* out_core_seq) {
   if (best < 0) {
     return false;
   }
@@ -302,6 +512,9 @@ bool BeaconLogic::dequeue_tx(uint8_t* out,
 
   std::memcpy(out, slot.frame, slot.frame_len);
   *out_len = slot.frame_len;
+  if (slot.pkt_type != PacketLogType::RELAY) {
+    last_dequeue_seq16_ = frame_seq16(slot.frame);  // relay copies carry another node's seq16
+  }
   if (out_type)     { *out_type     = slot.pkt_type; }
   if (out_core_seq) { *out_core_seq = slot.ref_core_seq16; }
 
@@ -316,10 +529,212 @@ bool BeaconLogic::dequeue_tx(uint8_t* out,
 
   // Clear the selected slot (reset on send).
   slot = TxSlot{};
+  if (best_u == kSlotPosFull) {
+    on_pos_dequeued();
+  }
 
   return true;
 }
 
+void BeaconLogic::on_pos_dequeued() {
+  if (pos_queued_.is_delta) {
+    pos_delta_run_++;
+  } else {
+    pos_ref_ = pos_queued_;
+    pos_ref_valid_ = true;
+    pos_delta_run_ = 0;
+  }
+}
+
+bool BeaconLogic::take_bundle(int best,
+                              uint32_t now_ms,
+                              uint8_t* out,
+                              size_t out_cap,
+                              size_t* out_len,
+                              PacketLogType* out_type,
+                              uint16_t* out_core_seq) {
+  const TxSlot& primary = slots_[static_cast<size_t>(best)];
+  if (primary.frame_len < protocol::kBundleMinFrameSize) {
+    return false;
+  }
+  // Ride-alongs in priority order; budget-gated classes only if they would be allowed alone.
+  bool included[kTxSlotCount] = {};
+  included[static_cast<size_t>(best)] = true;
+  size_t subs = 1;
+  size_t payload_len = protocol::kBundlePrefixSize + protocol::bundle_sub_cost(primary.frame_len);
+  uint32_t separate_us = e220_airtime_us(air_rate_, primary.frame_len);
+  for (uint8_t prio = 0; prio <= static_cast<uint8_t>(TxPriority::P3_THROTTLED); ++prio) {
+    for (size_t i = 0; i < kTxSlotCount; ++i) {
+      const TxSlot& s = slots_[i];
+      if (included[i] || !s.present || static_cast<uint8_t>(s.priority) != prio ||
+          i == kSlotRelay) {
+        continue;
+      }
+      const size_t cost = protocol::bundle_sub_cost(s.frame_len);
+      if (cost == 0 || payload_len + cost > protocol::kMaxPayloadLen) {
+        continue;
+      }
+      const uint32_t alone_us = e220_airtime_us(air_rate_, s.frame_len);
+      if (airtime_budget_ && s.priority != TxPriority::P0_MUST_PERIODIC) {
+        const uint8_t pct = s.priority == TxPriority::P3_THROTTLED ? kP3BudgetPct : 100u;
+        if (!airtime_budget_->fits(now_ms, alone_us, pct)) {
+          continue;
+        }
+      }
+      included[i] = true;
+      subs++;
+      payload_len += cost;
+      separate_us += alone_us;
+    }
+  }
+  if (subs < 2) {
+    return false;  // nothing to ride along: send the primary as a plain frame
+  }
+
+  // Sub-messages go on air in seq16 order: receivers drop a seq older than the last one applied.
+  uint8_t frame[protocol::kMaxFrameSize] = {};
+  size_t len = 0;
+  const uint64_t node_id = protocol::wire::read_nodeid48_le(primary.frame + protocol::kHeaderSize + 1);
+  if (!protocol::bundle_begin(node_id, frame, sizeof(frame), &len)) {
+    return false;
+  }
+  bool appended[kTxSlotCount] = {};
+  for (size_t n = 0; n < subs; ++n) {
+    int next = -1;
+    for (size_t i = 0; i < kTxSlotCount; ++i) {
+      if (!included[i] || appended[i]) {
+        continue;
+      }
+      if (next < 0 || static_cast<int16_t>(frame_seq16(slots_[i].frame) -
+                                           frame_seq16(slots_[static_cast<size_t>(next)].frame)) < 0) {
+        next = static_cast<int>(i);
+      }
+    }
+    const TxSlot& s = slots_[static_cast<size_t>(next)];
+    if (!protocol::bundle_append_frame(s.frame, s.frame_len, frame, sizeof(frame), &len)) {
+      return false;  // mixed node ids or a non-v0.2 frame; nothing consumed
+    }
+    appended[next] = true;
+    last_dequeue_seq16_ = frame_seq16(s.frame);
+  }
+  if (len > out_cap) {
+    return false;
+  }
+
+  std::memcpy(out, frame, len);
+  *out_len = len;
+  if (out_type)     { *out_type     = primary.pkt_type; }
+  if (out_core_seq) { *out_core_seq = primary.ref_core_seq16; }
+
+  for (size_t i = 0; i < kTxSlotCount; ++i) {
+    if (!slots_[i].present) {
+      continue;
+    }
+    if (!included[i]) {
+      slots_[i].replaced_count++;
+      if (traffic_counters_) { traffic_counters_->tx_starved++; }
+      continue;
+    }
+    if (slots_[i].pkt_type == PacketLogType::STATUS) {
+      last_dequeue_has_status_ = true;
+    }
+    slots_[i] = TxSlot{};
+    if (i == kSlotPosFull) {
+      on_pos_dequeued();
+    }
+  }
+  if (traffic_counters_) {
+    const uint32_t bundle_us = e220_airtime_us(air_rate_, len);
+    traffic_counters_->tx_bundles++;
+    traffic_counters_->tx_bundled_subs += static_cast<uint32_t>(subs);
+    if (separate_us > bundle_us) {
+      traffic_counters_->tx_airtime_saved_ms += (separate_us - bundle_us + 500u) / 1000u;
+    }
+  }
+  return true;
+}
+
+void BeaconLogic::short_address(PacketLogType type, uint8_t* frame, size_t* frame_len) {
+  // Receivers learn the short_id → node_id mapping from frames that can create their NodeTable
+  // entry: Status and Alive always carry the full id, Pos_Full after kShortAddrRun short ones.
+  // Pos_Delta is only applied on top of an existing entry, so it never needs the full id.
+  if (type == PacketLogType::ALIVE || last_dequeue_has_status_) {
+    short_addr_run_ = 0;
+    return;
+  }
+  if (type != PacketLogType::POS_DELTA) {
+    if (short_addr_run_ >= kShortAddrRun) {
+      short_addr_run_ = 0;
+      return;
+    }
+    short_addr_run_++;
+  }
+  const uint64_t node_id = protocol::wire::read_nodeid48_le(frame + protocol::kHeaderSize + 1);
+  const size_t len = protocol::short_addr_compact(frame, *frame_len,
+                                                  NodeTable::compute_short_id(node_id),
+                                                  frame, *frame_len);
+  if (len == 0) {
+    return;
+  }
+  *frame_len = len;
+  if (traffic_counters_) { traffic_counters_->tx_short_addr++; }
+}
+
+bool BeaconLogic::dequeue_tx(uint8_t* out,
+                             size_t out_cap,
+                             size_t* out_len,
+                             PacketLogType* out_type,
+                             uint16_t* out_core_seq) {
+  if (!out || !out_len) {
+    return false;
+  }
+  *out_len = 0;
+  return take_slot(select_slot(0, false), out, out_cap, out_len, out_type, out_core_seq);
+}
+
+bool BeaconLogic::dequeue_tx(uint32_t now_ms,
+                             uint8_t* out,
+                             size_t out_cap,
+                             size_t* out_len,
+                             PacketLogType* out_type,
+                             uint16_t* out_core_seq) {
+  if (!out || !out_len) {
+    return false;
+  }
+  *out_len = 0;
+  last_dequeue_has_status_ = false;
+  const int best = select_slot(now_ms, true);
+  if (best < 0) {
+    return false;
+  }
+  const PacketLogType type = slots_[static_cast<size_t>(best)].pkt_type;
+  const bool relay = type == PacketLogType::RELAY;
+  if (!(bundling_ && !relay &&
+        take_bundle(best, now_ms, out, out_cap, out_len, out_type, out_core_seq))) {
+    if (!take_slot(best, out, out_cap, out_len, out_type, out_core_seq)) {
+      return false;
+    }
+    last_dequeue_has_status_ = type == PacketLogType::STATUS;
+  }
+  if (short_addr_ && !relay) {
+    short_address(type, out, out_len);
+  }
+  if (fec_parity_ && (type == PacketLogType::POS_FULL || type == PacketLogType::POS_DELTA)) {
+    const size_t len = protocol::fec_wrap(out, *out_len, fec_parity_, out, out_cap);
+    if (len != 0) {
+      *out_len = len;
+      if (traffic_counters_) { traffic_counters_->tx_fec++; }
+    }
+  }
+  // Charged at dequeue (before the send attempt): conservative if the send later fails.
+  const uint32_t airtime_us = e220_airtime_us(air_rate_, *out_len);
+  if (airtime_budget_) { airtime_budget_->record_tx(now_ms, airtime_us); }
+  if (channel_load_) { channel_load_->on_airtime(now_ms, airtime_us); }
+  if (traffic_counters_) { traffic_counters_->tx_airtime_ms += (airtime_us + 500u) / 1000u; }
+  if (relay && relay_) { relay_->on_relayed(now_ms, airtime_us); }
+  return true;
+}
+
 bool BeaconLogic::has_pending_tx() const {
   for (size_t i = 0; i < kTxSlotCount; ++i) {
     if (slots_[i].present) {
@@ -344,89 +759,218 @@ bool BeaconLogic::on_rx(uint32_t now_ms,
   if (!frame || len < protocol::kHeaderSize) {
     return false;
   }
+  // Any received frame occupied the channel, decodable by us or not.
+  if (channel_load_) { channel_load_->on_airtime(now_ms, e220_airtime_us(air_rate_, len)); }
 
-  // Dispatch on msg_type from the 2-byte frame header.
+  // Dispatch on msg_type from the 2-byte frame header (kRxRoutes).
   protocol::PacketHeader hdr;
   if (!protocol::decode_header(frame, len, &hdr)) {
     return false;  // unknown or reserved msg_type → drop
   }
+  // Node_Fec: correct and unwrap first; the rest of on_rx only sees the inner frame.
+  uint8_t unwrapped[protocol::kMaxFrameSize] = {};
+  if (hdr.msg_type == protocol::MsgType::BeaconFec) {
+    uint8_t corrected = 0;
+    const size_t n = protocol::fec_unwrap(frame, len, unwrapped, sizeof(unwrapped), &corrected);
+    if (n == 0 || !protocol::decode_header(unwrapped, n, &hdr)) {
+      if (traffic_counters_) { traffic_counters_->rx_fec_fail++; }
+      return false;  // more corrupted bytes than the parity can correct
+    }
+    if (traffic_counters_ && corrected) { traffic_counters_->rx_fec_corrected++; }
+    frame = unwrapped;
+    len = n;
+  }
   if (!protocol::validate_header(hdr, len - protocol::kHeaderSize)) {
     return false;  // payload_len mismatch → drop
   }
-
-  const uint8_t* payload     = frame + protocol::kHeaderSize;
-  const size_t   payload_len = len - protocol::kHeaderSize;
-
-  if (hdr.msg_type == protocol::MsgType::BeaconAlive) {
-    protocol::AliveFields alive{};
-    const protocol::AliveDecodeError err =
-        protocol::decode_alive_payload(payload, payload_len, &alive);
-    if (err != protocol::AliveDecodeError::Ok) {
+  const bool relayed = protocol::frame_hops(frame) > 0;
+  if (relayed) {
+    if (traffic_counters_) { traffic_counters_->rx_relayed++; }
+    // Our own frame relayed back: the self entry is not a peer.
+    uint64_t node_id = 0;
+    NodeEntry origin{};
+    if (RelayPolicy::frame_key(frame, len, &node_id, nullptr) &&
+        table.find_entry_by_node_id(node_id, &origin) && origin.is_self) {
       return false;
     }
-    if (out_node_id)  { *out_node_id  = alive.node_id; }
-    if (out_seq)      { *out_seq      = alive.seq; }
-    if (out_pos_valid){ *out_pos_valid = false; }
-    if (out_type)     { *out_type     = PacketLogType::ALIVE; }
-    if (out_core_seq) { *out_core_seq = 0; }
-
-    // Alive updates liveness (lastRxAt, seq) but does not carry position.
-    return table.upsert_remote(alive.node_id,
-                               false,
-                               0,
-                               0,
-                               0,
-                               rssi_dbm,
-                               alive.seq,
-                               now_ms);
+    heard_relayed_ = true;
+    last_relayed_rx_ms_ = now_ms;
   }
 
-  // v0.2 Node_Pos_Full (0x06) — single-packet position + Pos_Quality (#435).
-  if (hdr.msg_type == protocol::MsgType::BeaconPosFull) {
-    protocol::PosFullFields pos{};
-    const protocol::PosFullDecodeError err =
-        protocol::decode_pos_full_payload(payload, payload_len, &pos);
-    if (err != protocol::PosFullDecodeError::Ok) {
-      return false;
+  // Short-addressed: rebuild the full-id frame from the sender's NodeTable entry.
+  uint8_t expanded[protocol::kMaxFrameSize] = {};
+  if (protocol::is_short_addr_payload(frame + protocol::kHeaderSize, len - protocol::kHeaderSize)) {
+    uint16_t short_id = 0;
+    uint8_t tag = 0;
+    uint64_t node_id = 0;
+    protocol::short_addr_peek(frame + protocol::kHeaderSize, len - protocol::kHeaderSize,
+                              &short_id, &tag);
+    const size_t n = table.resolve_short_id(short_id, tag, &node_id)
+        ? protocol::short_addr_expand(frame, len, node_id, expanded, sizeof(expanded))
+        : 0;
+    if (n == 0 || !protocol::decode_header(expanded, n, &hdr)) {
+      if (traffic_counters_) { traffic_counters_->rx_short_addr_unresolved++; }
+      return false;  // sender not (uniquely) known yet: wait for a full-id frame
     }
-    if (out_node_id)  { *out_node_id  = pos.node_id; }
-    if (out_seq)      { *out_seq      = pos.seq16; }
-    if (out_pos_valid){ *out_pos_valid = true; }
-    if (out_type)     { *out_type     = PacketLogType::POS_FULL; }
-    if (out_core_seq) { *out_core_seq = 0; }
+    frame = expanded;
+    len = n;
+  }
 
-    const int32_t lat_e7 = static_cast<int32_t>(std::llround(pos.lat_deg * 1e7));
-    const int32_t lon_e7 = static_cast<int32_t>(std::llround(pos.lon_deg * 1e7));
-    return table.apply_pos_full(pos.node_id, pos.seq16,
-                                lat_e7, lon_e7,
-                                pos.fix_type, pos.pos_sats,
-                                pos.pos_accuracy_bucket, pos.pos_flags_small,
-                                rssi_dbm, now_ms);
+  const RxPayload rx = {now_ms, frame + protocol::kHeaderSize, len - protocol::kHeaderSize,
+                        rssi_dbm, relayed};
+  const RxOut out = {out_node_id, out_seq, out_pos_valid, out_type, out_core_seq};
+  const bool applied = apply_rx(hdr.msg_type, rx, table, out);
+  if (applied) {
+    offer_relay(now_ms, frame, len);
   }
+  return applied;
+}
 
-  // v0.2 Node_Status (0x07) — full status snapshot (#435).
-  if (hdr.msg_type == protocol::MsgType::BeaconStatus) {
-    protocol::StatusFields st{};
-    const protocol::StatusDecodeError err =
-        protocol::decode_status_payload(payload, payload_len, &st);
-    if (err != protocol::StatusDecodeError::Ok) {
-      return false;
+void BeaconLogic::offer_relay(uint32_t now_ms, const uint8_t* frame, size_t len) {
+  if (!relay_) {
+    return;
+  }
+  uint32_t key = 0;
+  const RelayDecision decision =
+      relay_->offer(now_ms, frame, len, e220_airtime_us(air_rate_, len), &key);
+  TxSlot& queued = slots_[kSlotRelay];
+  if (decision == RelayDecision::DUPLICATE) {
+    if (traffic_counters_) { traffic_counters_->rx_relay_dup++; }
+    // Another relay already sent what we hold at the same or a later hop: ours adds nothing.
+    if (queued.present && queued.relay_key == key &&
+        protocol::frame_hops(frame) >= protocol::frame_hops(queued.frame)) {
+      queued = TxSlot{};
+      if (traffic_counters_) { traffic_counters_->tx_relay_cancelled++; }
     }
-    if (out_node_id)  { *out_node_id  = st.node_id; }
-    if (out_seq)      { *out_seq      = st.seq16; }
-    if (out_pos_valid){ *out_pos_valid = false; }
-    if (out_type)     { *out_type     = PacketLogType::STATUS; }
-    if (out_core_seq) { *out_core_seq = 0; }
+    return;
+  }
+  if (decision != RelayDecision::RELAY) {
+    return;
+  }
+  uint8_t copy[protocol::kMaxFrameSize] = {};
+  std::memcpy(copy, frame, len);
+  protocol::set_frame_hops(copy, static_cast<uint8_t>(protocol::frame_hops(frame) + 1u));
+  enqueue_slot(kSlotRelay, TxPriority::P1_SESSION_MESH, TxBestEffortClass::BE_LOW,
+               PacketLogType::RELAY, copy, len, now_ms);
+  queued.relay_key = key;
+  if (traffic_counters_) { traffic_counters_->tx_enqueue_relay++; }
+}
 
-    return table.apply_status(st.node_id, st.seq16,
-                              st.battery_percent, st.battery_est_rem_time,
-                              st.tx_power_ch_throttle, st.uptime10m,
-                              st.role_id, st.max_silence_10s,
-                              st.hw_profile_id, st.fw_version_id,
-                              rssi_dbm, now_ms);
+bool BeaconLogic::apply_rx(protocol::MsgType msg_type, const RxPayload& rx, NodeTable& table,
+                           const RxOut& out) {
+  const RxRoute& route = kRxRoutes[static_cast<uint8_t>(msg_type) & (protocol::kMsgTypeCount - 1)];
+  if (!route.apply || rx.len < route.min_payload_len) {
+    return false;
   }
+  return (this->*route.apply)(rx, table, out);
+}
 
-  return false;
+void BeaconLogic::report_rx(const RxOut& out, PacketLogType type, bool pos_valid,
+                            uint64_t node_id, uint16_t seq) {
+  if (out.node_id)   { *out.node_id   = node_id; }
+  if (out.seq)       { *out.seq       = seq; }
+  if (out.pos_valid) { *out.pos_valid = pos_valid; }
+  if (out.type)      { *out.type      = type; }
+  if (out.core_seq)  { *out.core_seq  = 0; }
+}
+
+bool BeaconLogic::rx_alive(const RxPayload& rx, NodeTable& table, const RxOut& out) {
+  protocol::AliveFields alive{};
+  if (protocol::decode_alive_payload(rx.data, rx.len, &alive) != protocol::AliveDecodeError::Ok) {
+    return false;
+  }
+  report_rx(out, PacketLogType::ALIVE, false, alive.node_id, alive.seq);
+
+  // Alive updates liveness (lastRxAt, seq) but does not carry position.
+  return table.upsert_remote(alive.node_id,
+                             false,
+                             0,
+                             0,
+                             0,
+                             rx.rssi_dbm,
+                             alive.seq,
+                             rx.now_ms);
+}
+
+// v0.2 Node_Pos_Full (0x06) — single-packet position + Pos_Quality (#435).
+// Read in place: NodeTable drops a duplicate before the position is converted.
+bool BeaconLogic::rx_pos_full(const RxPayload& rx, NodeTable& table, const RxOut& out) {
+  const protocol::PosFullView pos(rx.data, rx.len);
+  if (!pos.ok()) {
+    return false;
+  }
+  report_rx(out, PacketLogType::POS_FULL, true, pos.node_id(), pos.seq16());
+  return table.apply_pos_full(pos, rx.rssi_dbm, rx.now_ms, rx.relayed);
+}
+
+// v0.2 Node_Status (0x07) — full status snapshot (#435).
+bool BeaconLogic::rx_status(const RxPayload& rx, NodeTable& table, const RxOut& out) {
+  const protocol::StatusView st(rx.data, rx.len);
+  if (!st.ok()) {
+    return false;
+  }
+  report_rx(out, PacketLogType::STATUS, false, st.node_id(), st.seq16());
+  return table.apply_status(st, rx.rssi_dbm, rx.now_ms, rx.relayed);
+}
+
+// Node_Bundle (0x08): each sub-message goes through the single-frame path; outputs describe
+// the last one (subs are in seq16 order, so the newest).
+bool BeaconLogic::rx_bundle(const RxPayload& rx, NodeTable& table, const RxOut& out) {
+  bool any = false;
+  for (size_t i = 0;; ++i) {
+    uint8_t sub[protocol::kMaxFrameSize] = {};
+    const size_t sub_len = protocol::bundle_unpack(rx.data, rx.len, i, sub, sizeof(sub));
+    if (sub_len == 0) {
+      break;
+    }
+    protocol::PacketHeader sub_hdr;
+    if (!protocol::decode_header(sub, sub_len, &sub_hdr) ||
+        sub_hdr.msg_type == protocol::MsgType::BeaconBundle) {
+      continue;
+    }
+    const RxPayload sub_rx = {rx.now_ms, sub + protocol::kHeaderSize,
+                              sub_len - protocol::kHeaderSize, rx.rssi_dbm, rx.relayed};
+    if (apply_rx(sub_hdr.msg_type, sub_rx, table, out)) {
+      any = true;
+      if (traffic_counters_) { traffic_counters_->rx_bundled_subs++; }
+    }
+  }
+  return any;
+}
+
+// Node_Pos_Delta (0x09) — low bits of the position, resolved against the position held.
+bool BeaconLogic::rx_pos_delta(const RxPayload& rx, NodeTable& table, const RxOut& out) {
+  protocol::PosDeltaFields delta{};
+  if (protocol::decode_pos_delta_payload(rx.data, rx.len, &delta) !=
+      protocol::PosDeltaDecodeError::Ok) {
+    return false;
+  }
+  report_rx(out, PacketLogType::POS_DELTA, true, delta.node_id, delta.seq16);
+
+  // Resolve the low bits against the position held, in Pos_Full u24 units, so the result
+  // matches what a Pos_Full of the same fix would give. NodeTable checks that the position held
+  // belongs to the delta's run; only then is the resolved value used.
+  int32_t lat_e7 = 0;
+  int32_t lon_e7 = 0;
+  NodeEntry ref{};
+  if (table.find_entry_by_node_id(delta.node_id, &ref) && ref.pos_valid) {
+    uint32_t lat_u24 = 0;
+    uint32_t lon_u24 = 0;
+    if (!protocol::pos_delta_resolve(protocol::lat_e7_to_u24(ref.lat_e7), delta.lat_lsb, &lat_u24) ||
+        !protocol::pos_delta_resolve(protocol::lon_e7_to_u24(ref.lon_e7), delta.lon_lsb, &lon_u24)) {
+      return false;
+    }
+    lat_e7 = protocol::u24_to_lat_e7(lat_u24);
+    lon_e7 = protocol::u24_to_lon_e7(lon_u24);
+  }
+  protocol::PosVelocity vel;
+  vel.lat = delta.vel_lat;
+  vel.lon = delta.vel_lon;
+  const bool applied = table.apply_pos_delta(delta.node_id, delta.seq16, delta.ref_seq8, lat_e7, lon_e7,
+                                             rx.rssi_dbm, rx.now_ms, rx.relayed,
+                                             delta.has_velocity ? &vel : nullptr);
+  if (!applied && traffic_counters_) { traffic_counters_->rx_pos_delta_no_ref++; }
+  return applied;
 }
 
 } // namespace domain
@@ -3,11 +3,18 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "domain/airtime_budget.h"
+#include "domain/channel_load.h"
 #include "domain/node_table.h"
+#include "domain/relay_policy.h"
 #include "domain/traffic_counters.h"
 #include "../../protocol/geo_beacon_codec.h"
 #include "../../protocol/alive_codec.h"
+#include "../../protocol/fec_codec.h"
+#include "../../protocol/pos_delta_codec.h"
+#include "../../protocol/pos_full_codec.h"
 #include "../../protocol/packet_header.h"
+#include "../../protocol/pos_predict.h"
 
 namespace naviga {
 namespace domain {
@@ -21,8 +28,24 @@ enum class PacketLogType {
   INFO,
   POS_FULL,  ///< v0.2 Node_Pos_Full (#435).
   STATUS,    ///< v0.2 Node_Status (#435).
+  POS_DELTA, ///< Node_Pos_Delta (0x09).
+  RELAY,     ///< Another node's frame rebroadcast by the mesh relay (RelayPolicy).
 };
 
+/** Log name and TrafficCounters slots of a PacketLogType; one table entry per enumerator. */
+struct PacketLogTypeInfo {
+  const char* name;
+  uint32_t TrafficCounters::*tx_sent;  ///< Sent-frame counter; nullptr = not counted.
+  uint32_t TrafficCounters::*rx_ok;    ///< Accepted-frame counter; nullptr = not counted.
+};
+
+const PacketLogTypeInfo& packet_log_type_info(PacketLogType t);
+/** Instrumentation log name ("POS_FULL", ...). */
+inline const char* packet_log_type_str(PacketLogType t) { return packet_log_type_info(t).name; }
+/** Count one frame of type t in its tx_sent / rx_ok slot, if the type has one. */
+void count_tx_sent(TrafficCounters& c, PacketLogType t);
+void count_rx_ok(TrafficCounters& c, PacketLogType t);
+
 /**
  * TX slot priority levels (lower value = higher priority).
  *
@@ -31,9 +54,9 @@ enum class PacketLogType {
  *   P0_MUST_PERIODIC  — Mandatory periodic packets; must not be starved.
  *                       Current users: Node_OOTB_Core_Pos (0x01), Node_OOTB_I_Am_Alive (0x02).
  *
- *   P1_SESSION_MESH   — Reserved for future Session/Mesh control packets
- *                       (e.g. Node_Session_*, Mesh_P0 relay control).
- *                       NOT used by any current OOTB packet type.
+ *   P1_SESSION_MESH   — Session/Mesh packets. Current user: mesh relay copies of other
+ *                       nodes' Pos_Full / Status (RelayPolicy, kSlotRelay); future
+ *                       Node_Session_* control.
  *
  *   P2_BEST_EFFORT    — Best-effort delivery. Ordering within P2 by replaced_count (desc),
  *                       then created_at_ms (asc). Current user: Node_OOTB_Core_Tail (0x03).
@@ -44,7 +67,7 @@ enum class PacketLogType {
  */
 enum class TxPriority : uint8_t {
   P0_MUST_PERIODIC = 0,  ///< Mandatory periodic; Core_Pos + I_Am_Alive.
-  P1_SESSION_MESH  = 1,  ///< Reserved: future Session/Mesh control. NOT used today.
+  P1_SESSION_MESH  = 1,  ///< Mesh relay copies; future Session/Mesh control.
   P2_BEST_EFFORT   = 2,  ///< Best-effort; sub-ordered by TxBestEffortClass.
   P3_THROTTLED     = 3,  ///< Opportunistic; Operational (0x04), Informative (0x05).
 };
@@ -74,17 +97,20 @@ struct TxSlot {
   uint32_t created_at_ms  = 0;   ///< Set when slot first becomes present; preserved on replace.
   uint32_t replaced_count = 0;   ///< expired_counter: +1 replace, +1 starved, reset on send.
   uint16_t ref_core_seq16 = 0;   ///< For TAIL1 only: the Core_Pos seq16 this tail supplements.
+  bool     budget_deferred = false;  ///< Held back by the airtime budget (counted once per episode).
+  uint32_t relay_key      = 0;   ///< For RELAY only: RelayPolicy fingerprint of the relayed frame.
   uint8_t  frame[protocol::kMaxFrameSize] = {};
   size_t   frame_len = 0;
 };
 
-/** Number of TX slot types (v0.2: three slots only; #435). */
-constexpr size_t kTxSlotCount = 3;
+/** Number of TX slot types (v0.2: three own-frame slots (#435) + the mesh relay slot). */
+constexpr size_t kTxSlotCount = 4;
 
 /** Index into the TX slot array for each packet type (v0.2 canonical). */
-constexpr size_t kSlotPosFull = 0;  ///< Node_Pos_Full (0x06)
+constexpr size_t kSlotPosFull = 0;  ///< Node_Pos_Full (0x06) or Node_Pos_Delta (0x09)
 constexpr size_t kSlotAlive   = 1;  ///< Node_OOTB_I_Am_Alive (0x02)
 constexpr size_t kSlotStatus  = 2;  ///< Node_Status (0x07)
+constexpr size_t kSlotRelay   = 3;  ///< Relayed copy of another node's frame (never bundled)
 
 /**
  * Self-state fields used for Operational and Informative packet formation.
@@ -105,6 +131,7 @@ struct SelfTelemetry {
   uint16_t hw_profile_id    = 0xFFFF;
   bool     has_fw_version   = false;
   uint16_t fw_version_id    = 0xFFFF;
+  uint8_t  radio_caps       = 0;   ///< Status radioCaps (PresetSelector); 0 = not sent.
 };
 
 class BeaconLogic {
@@ -122,6 +149,15 @@ class BeaconLogic {
   /** #422: Notify when a P3 (Operational or Informative) frame was handed to TX / sent. Updates last_status_tx_ms and bootstrap count. */
   void on_status_sent(uint32_t now_ms);
 
+  /**
+   * Optional content-aware Status: after bootstrap, a snapshot whose semantic fields (battery,
+   * role, maxSilence, hw/fw ids, radioCaps; not uptime, which receivers can age themselves)
+   * hash the same as the last Status sent is not re-sent at min_status_interval, only at the
+   * T_status_max refresh. Receivers keep the last Status fields and judge liveness by the
+   * sender's maxSilence (NodeTable), so the longer gaps need no RX change. Default off.
+   */
+  void set_status_suppress_unchanged(bool enabled) { status_suppress_unchanged_ = enabled; }
+
   /** Set initial seq so next next_seq16() returns value + 1. Call only before any formation (#417). */
   void set_initial_seq16(uint16_t value);
 
@@ -184,6 +220,129 @@ class BeaconLogic {
                   PacketLogType* out_type = nullptr,
                   uint16_t* out_core_seq = nullptr);
 
+  /**
+   * Budget-aware dequeue. Same selection as above, but when an AirtimeBudget is set a slot is
+   * skipped (left queued) unless its estimated airtime fits: P0 always goes (never starved by
+   * the budget); P1/P2 while it fits the whole budget; P3 while it fits kP3BudgetPct of it, so
+   * throttled traffic backs off before the budget is tight. The dequeued frame's airtime is
+   * charged to the budget and to TrafficCounters::tx_airtime_ms.
+   *
+   * @return true if a frame was dequeued; false if the queue is empty or all present slots
+   *         are deferred.
+   */
+  bool dequeue_tx(uint32_t now_ms,
+                  uint8_t* out,
+                  size_t out_cap,
+                  size_t* out_len,
+                  PacketLogType* out_type = nullptr,
+                  uint16_t* out_core_seq = nullptr);
+
+  /** P3 slots go only while used + frame stays within this share (%) of the airtime budget. */
+  static constexpr uint8_t kP3BudgetPct = 75;
+
+  /** Optional airtime budget for the now_ms dequeue_tx overload; nullptr = no gating. */
+  void set_airtime_budget(AirtimeBudget* budget) { airtime_budget_ = budget; }
+  /** Air rate code (RadioPreset encoding) used for airtime estimates; default 2 (2.4 kbps). */
+  void set_air_rate(uint8_t air_rate) { air_rate_ = air_rate; }
+
+  /**
+   * Optional congestion adaptation: when set, received frames and own (budgeted) TX feed the
+   * load estimate, and the min interval used by update_tx_queue is stretched by it, up to
+   * max_silence_ms. nullptr = fixed role cadence.
+   */
+  void set_channel_load(ChannelLoad* load) { channel_load_ = load; }
+  /** Min interval in effect at the last update_tx_queue (role min interval when not adapting). */
+  uint32_t effective_min_interval_ms() const { return effective_min_interval_ms_; }
+
+  /**
+   * Optional Node_Bundle (0x08) aggregation for the now_ms dequeue_tx overload: the chosen slot
+   * carries every other present slot that fits one frame (and its budget class), and a P3 slot
+   * is held until a P0 slot can carry it (at most max_silence_ms after it was enqueued).
+   * Receivers without 0x08 support drop bundles, so enable only fleet-wide. Default off.
+   */
+  void set_bundling(bool enabled) { bundling_ = enabled; }
+  /** True if the last now_ms dequeue_tx returned Node_Status, alone or inside a bundle. */
+  bool last_dequeue_has_status() const { return last_dequeue_has_status_; }
+
+  /**
+   * Optional Node_Pos_Delta (0x09): after a Node_Pos_Full has gone out, position updates are
+   * sent as 15 B deltas (low 12 bits of lat/lon) while the node stays within kPosDeltaMaxStep of
+   * that Pos_Full, at most kPosDeltaRun in a row; then a Node_Pos_Full starts the next run.
+   * Each delta names its run's Pos_Full (ref_seq8), and receivers that missed it drop the run's
+   * deltas. Receivers without 0x09 support drop deltas, so enable only
+   * fleet-wide. Default off. Callers turn it off while heard_relayed_within(max_silence).
+   */
+  void set_pos_delta(bool enabled) { pos_delta_ = enabled; }
+  /** Node_Pos_Delta frames allowed between two Node_Pos_Full. */
+  static constexpr uint8_t kPosDeltaRun = 3;
+  /**
+   * Max move (Pos_Full u24 units, ~1.2 km lat) from the run's Pos_Full for a delta; any two
+   * frames of a run are then less than protocol::kPosDeltaHalfRange apart.
+   */
+  static constexpr int32_t kPosDeltaMaxStep = protocol::kPosDeltaHalfRange / 2 - 1;
+
+  /**
+   * Optional short addressing for the now_ms dequeue_tx overload: frames go out with short_id +
+   * a 7-bit tag instead of payloadVersion + nodeId48 (4 B less, protocol/short_addr_codec.h).
+   * Pos_Delta always; Pos_Full at most kShortAddrRun in a row; Status and Alive never, so
+   * receivers keep learning the full id. Receivers without support drop short-addressed
+   * frames, so enable only fleet-wide. Default off.
+   */
+  void set_short_addr(bool enabled) { short_addr_ = enabled; }
+  /** Short-addressed Pos_Full allowed between two full-id ones. */
+  static constexpr uint8_t kShortAddrRun = 1;
+  /**
+   * Optional forward error correction for the now_ms dequeue_tx overload: Pos_Full / Pos_Delta
+   * frames (and bundles led by one) go out in a Node_Fec envelope with parity_len Reed-Solomon
+   * parity bytes, correcting up to parity_len / 2 corrupted bytes (protocol/fec_codec.h).
+   * Costs 1 + parity_len bytes of airtime per frame; only useful where corrupted frames reach
+   * the MCU (LoRa CRC off). Relay copies are not wrapped. RX always unwraps Node_Fec.
+   * 0 or an invalid parity_len = off (default).
+   */
+  void set_fec_parity(uint8_t parity_len) {
+    fec_parity_ = protocol::fec_parity_valid(parity_len) ? parity_len : 0;
+  }
+  /**
+   * Dead reckoning (protocol/pos_predict.h): position frames carry vel in a Pos_Velocity
+   * trailer, and the self_fields position (taken at anchor_ms) moved along vel to the time the
+   * frame is formed. Receivers then extrapolate the track SelfUpdatePolicy measures its error
+   * against, also from frames sent at max silence without a new commit. Call on every
+   * predictive commit; clear_self_velocity() goes back to plain frames (default).
+   */
+  void set_self_velocity(const protocol::PosVelocity& vel, uint32_t anchor_ms) {
+    self_velocity_ = vel;
+    self_velocity_anchor_ms_ = anchor_ms;
+    self_velocity_valid_ = true;
+  }
+  void clear_self_velocity() { self_velocity_valid_ = false; }
+  /**
+   * Pos_Quality sent in self Pos_Full frames (protocol::make_pos_quality from the committed
+   * GNSS solution). Frames carrying an extrapolated position add kPosFlagEstimated, and
+   * kPosFlagMoving while the velocity is non-zero. Default: fix_type 2D, nothing else known.
+   */
+  void set_self_pos_quality(const protocol::PosQuality& quality) { self_pos_quality_ = quality; }
+
+  /** seq16 of the last dequeued frame (newest sub-message for a bundle). */
+  uint16_t last_dequeue_seq16() const { return last_dequeue_seq16_; }
+
+  /**
+   * Optional mesh relay: received Pos_Full / Pos_Delta / Status / Bundle frames (short-addressed
+   * ones after expansion, so relayed copies always carry the full id) are offered to the policy, and a
+   * RELAY copy replaces whatever waits in kSlotRelay (P1: after own P0 beacons, before Status).
+   * A queued copy is dropped when another relay's copy of the same frame is heard first.
+   * Relay copies are sent as received (never bundled or short-addressed) with hops + 1, and
+   * are charged to both the node's and the relay's airtime budget. nullptr = no relaying.
+   * Relayed copies are applied to the NodeTable whether or not this node relays.
+   */
+  void set_relay(RelayPolicy* relay) { relay_ = relay; }
+  /**
+   * True if a relayed frame (hops > 0) was received within window_ms before now_ms: some peers
+   * are out of direct range and may only see relayed copies of our frames.
+   */
+  bool heard_relayed_within(uint32_t now_ms, uint32_t window_ms) const {
+    return heard_relayed_ && (now_ms - last_relayed_rx_ms_) <= window_ms;
+  }
+
   /** Returns true if any TX slot is present (queue non-empty). */
   bool has_pending_tx() const;
 
@@ -222,11 +381,112 @@ class BeaconLogic {
   uint32_t last_status_tx_ms_ = 0;             ///< When we last sent a P3 (Op or Info); 0 = never.
   uint32_t last_status_enqueue_ms_ = 0;        ///< When we last enqueued a P3; 0 = never.
   uint8_t  status_bootstrap_count_ = 0;        ///< Bootstrap sends so far (max 2 per §2a).
+  bool     status_suppress_unchanged_ = false;
+  uint32_t status_hash_queued_ = 0;            ///< Content hash of the Status last enqueued.
+  uint32_t status_hash_sent_ = 0;              ///< Content hash of the Status last sent.
+  bool     status_hash_sent_valid_ = false;
+  uint32_t last_status_skip_ms_ = 0;           ///< Last unchanged Status not sent; 0 = none.
+  bool     status_skip_held_ = false;          ///< Bundling: that Status would still be held.
 
   // Slot-based TX queue.
   TxSlot slots_[kTxSlotCount] = {};
 
   TrafficCounters* traffic_counters_ = nullptr;
+  AirtimeBudget* airtime_budget_ = nullptr;
+  RelayPolicy* relay_ = nullptr;
+  bool heard_relayed_ = false;
+  uint32_t last_relayed_rx_ms_ = 0;
+  uint8_t air_rate_ = 2;
+  ChannelLoad* channel_load_ = nullptr;
+  uint32_t effective_min_interval_ms_ = 5000;
+  bool core_update_pending_ = false;  ///< allow_core seen since the last PosFull enqueue.
+  bool bundling_ = false;
+  bool last_dequeue_has_status_ = false;
+  uint16_t last_dequeue_seq16_ = 0;
+  bool short_addr_ = false;
+  uint8_t short_addr_run_ = kShortAddrRun;  ///< Short Pos_Full since the last full-id frame; first is full.
+  uint8_t fec_parity_ = 0;
+  bool self_velocity_valid_ = false;
+  protocol::PosVelocity self_velocity_{};
+  uint32_t self_velocity_anchor_ms_ = 0;
+  protocol::PosQuality self_pos_quality_ = default_self_pos_quality();
+
+  static protocol::PosQuality default_self_pos_quality() {
+    protocol::PosQuality q;
+    q.fix_type = protocol::kPosFix2D;
+    return q;
+  }
+  /** self_pos_quality_ for a self position frame formed at now_ms (dead-reckoning flags). */
+  protocol::PosQuality self_frame_quality(uint32_t now_ms) const;
+
+  // Node_Pos_Delta: last Pos_Full that left the queue (the run's reference), and the queued frame.
+  struct PosRef {
+    uint32_t lat_u24 = 0;
+    uint32_t lon_u24 = 0;
+    uint16_t seq16 = 0;
+    bool is_delta = false;
+  };
+  bool pos_delta_ = false;
+  bool pos_ref_valid_ = false;  ///< A Pos_Full has left the queue.
+  uint8_t pos_delta_run_ = 0;  ///< Deltas sent since the last Pos_Full.
+  PosRef pos_ref_{};
+  PosRef pos_queued_{};
+
+  // ── RX dispatch: kRxRoutes maps each msg_type to its decode+apply handler ─────
+  // One received payload (whole frame, or a Node_Bundle sub-message). relayed: received as a
+  // mesh relay copy (link metrics untouched).
+  struct RxPayload {
+    uint32_t now_ms;
+    const uint8_t* data;
+    size_t len;
+    int8_t rssi_dbm;
+    bool relayed;
+  };
+  // on_rx outputs; each may be nullptr.
+  struct RxOut {
+    uint64_t* node_id;
+    uint16_t* seq;
+    bool* pos_valid;
+    PacketLogType* type;
+    uint16_t* core_seq;
+  };
+  // Decode rx, report it (report_rx) once decoded, apply it to table. True if applied.
+  typedef bool (BeaconLogic::*RxHandler)(const RxPayload& rx, NodeTable& table, const RxOut& out);
+  struct RxRoute {
+    RxHandler apply;          // nullptr: msg_type not handled.
+    uint8_t min_payload_len;  // Shorter payloads are dropped before the handler runs.
+  };
+  // Indexed by raw msg_type; one entry per protocol::kRxMsgTypes bit.
+  static const RxRoute kRxRoutes[protocol::kMsgTypeCount];
+
+  // Route one payload of msg_type through kRxRoutes (on_rx; also each Node_Bundle sub-message).
+  bool apply_rx(protocol::MsgType msg_type, const RxPayload& rx, NodeTable& table,
+                const RxOut& out);
+  static void report_rx(const RxOut& out, PacketLogType type, bool pos_valid,
+                        uint64_t node_id, uint16_t seq);
+  bool rx_alive(const RxPayload& rx, NodeTable& table, const RxOut& out);
+  bool rx_pos_full(const RxPayload& rx, NodeTable& table, const RxOut& out);
+  bool rx_status(const RxPayload& rx, NodeTable& table, const RxOut& out);
+  bool rx_bundle(const RxPayload& rx, NodeTable& table, const RxOut& out);
+  bool rx_pos_delta(const RxPayload& rx, NodeTable& table, const RxOut& out);
+  // Offer an applied full-id frame to the relay policy; queue or cancel the relay copy.
+  void offer_relay(uint32_t now_ms, const uint8_t* frame, size_t len);
+  // Pick the slot to send: priority, be_rank, replaced_count desc, created_at_ms asc.
+  // When gated, slots the airtime budget does not allow are skipped. -1 if none.
+  // When timed (now_ms overload), applies airtime-budget deferral and bundling P3 hold.
+  int select_slot(uint32_t now_ms, bool timed);
+  // Copy the chosen slot out, apply starvation increments, clear it.
+  bool take_slot(int best, uint8_t* out, size_t out_cap, size_t* out_len,
+                 PacketLogType* out_type, uint16_t* out_core_seq);
+  // Bundle the chosen slot with other present slots (Node_Bundle 0x08). False (nothing taken)
+  // if no other slot can ride along.
+  bool take_bundle(int best, uint32_t now_ms, uint8_t* out, size_t out_cap, size_t* out_len,
+                   PacketLogType* out_type, uint16_t* out_core_seq);
+  // Rewrite a dequeued full-id frame in place as short-addressed, unless it is due to carry the
+  // full id.
+  void short_address(PacketLogType type, uint8_t* frame, size_t* frame_len);
+  // Position slot left the queue: its frame is the reference for the next Node_Pos_Delta.
+  void on_pos_dequeued();
 
   // Allocate the next global seq16 and advance the counter.
   uint16_t next_seq16();
@@ -1,5 +1,7 @@
 #include "domain/beacon_send_policy.h"
 
+#include "domain/airtime_model.h"
+
 namespace naviga {
 namespace domain {
 
@@ -10,8 +12,23 @@ uint32_t lcg_next(uint32_t& state) {
   return state;
 }
 
+constexpr uint32_t kWeekMs = 7u * 24u * 3600u * 1000u;
+
+uint32_t mix32(uint32_t x) {
+  x ^= x >> 16;
+  x *= 0x7FEB352Du;
+  x ^= x >> 15;
+  x *= 0x846CA68Bu;
+  x ^= x >> 16;
+  return x;
+}
+
 } // namespace
 
+constexpr uint32_t BeaconSendPolicy::kMaxGnssTimeAgeMs;
+constexpr uint32_t BeaconSendPolicy::kSlotGuardMs;
+constexpr uint32_t BeaconSendPolicy::kSuperframeMs;
+
 void BeaconSendPolicy::init(uint32_t seed) {
   rng_state_ = seed == 0 ? 1u : seed;
   backoff_ms_ = 0;
@@ -32,6 +49,31 @@ void BeaconSendPolicy::enable_sense(bool enabled) {
   sense_enabled_ = enabled;
 }
 
+void BeaconSendPolicy::set_slotting(uint64_t node_id, uint32_t slot_ms) {
+  slot_node_hash_ = mix32(static_cast<uint32_t>(node_id) ^ mix32(static_cast<uint32_t>(node_id >> 32)));
+  slot_ms_ = slot_ms;
+  const uint32_t count = slot_ms == 0 ? 0 : kSuperframeMs / slot_ms;
+  slot_count_ = static_cast<uint16_t>(count == 0 && slot_ms != 0 ? 1 : (count > 0xFFFFu ? 0xFFFFu : count));
+}
+
+uint32_t BeaconSendPolicy::slot_ms_for(uint8_t air_rate, size_t frame_len) {
+  return (e220_airtime_us(air_rate, frame_len) + 999u) / 1000u + kSlotGuardMs;
+}
+
+void BeaconSendPolicy::set_gnss_time(uint32_t tow_ms, uint32_t now_ms) {
+  gnss_time_valid_ = true;
+  gnss_tow_ms_ = tow_ms;
+  gnss_tow_at_ms_ = now_ms;
+}
+
+void BeaconSendPolicy::clear_gnss_time() {
+  gnss_time_valid_ = false;
+}
+
+bool BeaconSendPolicy::slotted(uint32_t now_ms) const {
+  return slot_count_ > 0 && gnss_time_valid_ && now_ms - gnss_tow_at_ms_ <= kMaxGnssTimeAgeMs;
+}
+
 bool BeaconSendPolicy::has_pending() const {
   return pending_;
 }
@@ -46,7 +88,7 @@ bool BeaconSendPolicy::should_sense(const IChannelSense* sense) const {
 
 void BeaconSendPolicy::on_payload_built(uint32_t now_ms) {
   pending_ = true;
-  schedule_after(now_ms, next_jitter_ms());
+  schedule_after(now_ms, slotted(now_ms) ? next_slot_delay_ms(now_ms) : next_jitter_ms());
 }
 
 void BeaconSendPolicy::on_channel_busy(uint32_t now_ms) {
@@ -71,6 +113,21 @@ uint32_t BeaconSendPolicy::next_jitter_ms() {
   return lcg_next(rng_state_) % (jitter_ms_ + 1);
 }
 
+uint32_t BeaconSendPolicy::next_slot_delay_ms(uint32_t now_ms) const {
+  const uint32_t superframe_ms = slot_ms_ * slot_count_;
+  const uint32_t tow_ms = (gnss_tow_ms_ + (now_ms - gnss_tow_at_ms_)) % kWeekMs;
+  uint32_t superframe = tow_ms / superframe_ms;
+  const uint32_t offset_ms = tow_ms % superframe_ms;
+  uint32_t slot_start_ms = (mix32(slot_node_hash_ ^ superframe) % slot_count_) * slot_ms_;
+  if (slot_start_ms >= offset_ms) {
+    return slot_start_ms - offset_ms;
+  }
+  // Own slot already passed in this superframe: next superframe's slot.
+  superframe++;
+  slot_start_ms = (mix32(slot_node_hash_ ^ superframe) % slot_count_) * slot_ms_;
+  return superframe_ms - offset_ms + slot_start_ms;
+}
+
 void BeaconSendPolicy::schedule_after(uint32_t now_ms, uint32_t delay_ms) {
   next_attempt_ms_ = now_ms + delay_ms;
 }
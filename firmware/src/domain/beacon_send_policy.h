@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include "naviga/hal/interfaces.h"
@@ -14,6 +15,35 @@ class BeaconSendPolicy {
   void set_backoff_ms(uint32_t base_ms, uint32_t max_ms);
   void enable_sense(bool enabled);
 
+  /**
+   * Optional slotted access: while GNSS time is known, on_payload_built schedules the attempt at
+   * the start of this node's slot instead of after a random jitter. Superframes of
+   * kSuperframeMs / slot_ms slots are aligned to GPS time of week; the slot is a hash of node_id
+   * and the superframe number, so nodes sharing a slot in one superframe are apart in the next.
+   * slot_ms should fit a Node_Pos_Full (slot_ms_for); longer frames run into the next slot.
+   * Backoff after busy / failed sends is unchanged. slot_ms 0 = off (default).
+   */
+  void set_slotting(uint64_t node_id, uint32_t slot_ms);
+  /** GNSS time reference: time of week tow_ms was current at now_ms (NAV-PVT iTOW). */
+  void set_gnss_time(uint32_t tow_ms, uint32_t now_ms);
+  /** Drop the GNSS time reference (no fix / time invalid): back to jitter. */
+  void clear_gnss_time();
+  /** True if the next on_payload_built(now_ms) would use a slot. */
+  bool slotted(uint32_t now_ms) const;
+
+  /** Slot length for frames of frame_len bytes at air_rate: airtime model plus kSlotGuardMs. */
+  static uint32_t slot_ms_for(uint8_t air_rate, size_t frame_len);
+
+  /** A GNSS time reference older than this is not used (local clock drift, ~50 ppm). */
+  static constexpr uint32_t kMaxGnssTimeAgeMs = 60000;
+  /**
+   * Added to the frame airtime for slot_ms: what is left of the GNSS time error once providers
+   * take their output latency off (GnssSnapshot::tow_at_ms), i.e. loop tick and per-module spread.
+   */
+  static constexpr uint32_t kSlotGuardMs = 30;
+  /** Superframe length target: the longest a ready frame waits for its slot. */
+  static constexpr uint32_t kSuperframeMs = 10000;
+
   bool has_pending() const;
   bool ready_to_attempt(uint32_t now_ms) const;
   bool should_sense(const IChannelSense* sense) const;
@@ -31,8 +61,15 @@ class BeaconSendPolicy {
   uint32_t rng_state_ = 1;
   bool pending_ = false;
   bool sense_enabled_ = false;
+  uint32_t slot_node_hash_ = 0;
+  uint32_t slot_ms_ = 0;
+  uint16_t slot_count_ = 0;
+  bool gnss_time_valid_ = false;
+  uint32_t gnss_tow_ms_ = 0;
+  uint32_t gnss_tow_at_ms_ = 0;
 
   uint32_t next_jitter_ms();
+  uint32_t next_slot_delay_ms(uint32_t now_ms) const;
   void schedule_after(uint32_t now_ms, uint32_t delay_ms);
   void increase_backoff();
 };
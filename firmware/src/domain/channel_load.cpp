@@ -0,0 +1,110 @@
+#include "domain/channel_load.h"
+
+namespace naviga {
+namespace domain {
+
+constexpr size_t ChannelLoad::kBuckets;
+constexpr uint32_t ChannelLoad::kBucketMs;
+constexpr uint32_t ChannelLoad::kUpdatePeriodMs;
+constexpr uint16_t ChannelLoad::kDefaultTargetPermille;
+constexpr uint32_t ChannelLoad::kScaleOne;
+
+void ChannelLoad::seed(uint32_t seed) {
+  rng_ = seed == 0 ? 0x9E3779B9u : seed;
+}
+
+void ChannelLoad::set_target_permille(uint16_t target_permille) {
+  target_permille_ = target_permille == 0 ? 1 : target_permille;
+}
+
+void ChannelLoad::on_airtime(uint32_t now_ms, uint32_t airtime_us) {
+  const uint32_t epoch = now_ms / kBucketMs;
+  Bucket& b = buckets_[epoch % kBuckets];
+  if (b.epoch != epoch) {
+    b.epoch = epoch;
+    b.airtime_us = 0;
+  }
+  const uint32_t sum = b.airtime_us + airtime_us;
+  b.airtime_us = sum < b.airtime_us ? UINT32_MAX : sum;
+}
+
+uint32_t ChannelLoad::utilisation_permille(uint32_t now_ms) const {
+  const uint32_t epoch = now_ms / kBucketMs;
+  uint64_t busy_us = 0;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    const Bucket& b = buckets_[i];
+    if (b.epoch <= epoch && epoch - b.epoch < kBuckets) {
+      busy_us += b.airtime_us;
+    }
+  }
+  // Window covered so far: full past buckets plus the elapsed part of the current one.
+  uint64_t span_ms = static_cast<uint64_t>(kBuckets - 1) * kBucketMs + now_ms % kBucketMs;
+  if (span_ms > now_ms) {
+    span_ms = now_ms;
+  }
+  if (span_ms < kBucketMs) {
+    span_ms = kBucketMs;
+  }
+  const uint64_t permille = busy_us / span_ms;  // µs per ms of span = permille
+  return permille > 1000 ? 1000 : static_cast<uint32_t>(permille);
+}
+
+void ChannelLoad::update(uint32_t now_ms, uint32_t beacon_airtime_us, uint32_t min_interval_ms,
+                         uint32_t max_interval_ms) {
+  if (updated_ && now_ms - last_update_ms_ < kUpdatePeriodMs) {
+    return;
+  }
+  updated_ = true;
+  last_update_ms_ = now_ms;
+  if (min_interval_ms == 0) {
+    return;
+  }
+
+  // Heard load was produced at the current scale: wanted = scale * heard / target.
+  const uint64_t heard_q8 =
+      static_cast<uint64_t>(scale_q8_) * utilisation_permille(now_ms) / target_permille_;
+  // Offered load at the unstretched cadence: wanted = offered / target.
+  const uint64_t offered_permille = static_cast<uint64_t>(active_peers_ + 1u) * beacon_airtime_us /
+                                    min_interval_ms;  // µs per ms = permille
+  const uint64_t offered_q8 = offered_permille * kScaleOne / target_permille_;
+  uint64_t wanted = heard_q8 > offered_q8 ? heard_q8 : offered_q8;
+
+  uint64_t max_q8 = kScaleOne;
+  if (max_interval_ms > min_interval_ms) {
+    max_q8 = static_cast<uint64_t>(max_interval_ms) * kScaleOne / min_interval_ms;
+  }
+  if (wanted < kScaleOne) {
+    wanted = kScaleOne;
+  }
+  if (wanted > max_q8) {
+    wanted = max_q8;
+  }
+
+  // EWMA 1/4 toward the wanted scale (smooth; no step changes from one busy window).
+  const int64_t delta = static_cast<int64_t>(wanted) - static_cast<int64_t>(scale_q8_);
+  int64_t next = static_cast<int64_t>(scale_q8_) + delta / 4;
+  if (delta != 0 && delta / 4 == 0) {
+    next = static_cast<int64_t>(wanted);
+  }
+  scale_q8_ = static_cast<uint32_t>(next);
+
+  // xorshift32; dither in [192, 256] / 256.
+  rng_ ^= rng_ << 13;
+  rng_ ^= rng_ >> 17;
+  rng_ ^= rng_ << 5;
+  dither_q8_ = kScaleOne - (rng_ % (kScaleOne / 4 + 1));
+}
+
+uint32_t ChannelLoad::stretch(uint32_t min_interval_ms) const {
+  if (scale_q8_ <= kScaleOne) {
+    return min_interval_ms;
+  }
+  uint64_t v = static_cast<uint64_t>(min_interval_ms) * scale_q8_ * dither_q8_ / (kScaleOne * kScaleOne);
+  if (v < min_interval_ms) {
+    v = min_interval_ms;
+  }
+  return v > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(v);
+}
+
+} // namespace domain
+} // namespace naviga
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace naviga {
+namespace domain {
+
+/**
+ * Channel-load estimate and congestion-adaptive cadence stretch.
+ *
+ * Two load signals, the larger wins:
+ *  - heard: airtime of frames received or sent in the last kBuckets * kBucketMs (channel
+ *    utilisation, as Meshtastic's channel_utilization). Misses collided frames, so it
+ *    under-reads near saturation.
+ *  - offered: (active peers + self) * beacon airtime / min interval, i.e. what the
+ *    neighbourhood offers if every peer beacons at this role's cadence.
+ *
+ * Every kUpdatePeriodMs the interval scale moves a quarter of the way toward the scale that
+ * would bring load to the target (heard is measured at the current scale, so it is rescaled
+ * multiplicatively), clamped to [1, max_interval / min_interval]. The role's max silence is
+ * the upper bound, so stretching never delays the forced max-silence beacon.
+ *
+ * When stretched, each evaluation also draws a dither in [3/4, 1] of the stretched interval
+ * (Trickle-style, never below min interval): a fixed stretched period would phase-lock
+ * nodes whose beacons once collided.
+ */
+class ChannelLoad {
+ public:
+  static constexpr size_t kBuckets = 6;
+  static constexpr uint32_t kBucketMs = 10000;           ///< 60 s utilisation window.
+  static constexpr uint32_t kUpdatePeriodMs = 10000;
+  static constexpr uint16_t kDefaultTargetPermille = 200;
+  static constexpr uint32_t kScaleOne = 256;             ///< Q8 fixed point.
+
+  /** Seed for the interval dither (e.g. low bits of node_id); 0 is replaced by a constant. */
+  void seed(uint32_t seed);
+  void set_target_permille(uint16_t target_permille);
+  void set_active_peers(uint16_t active_peers) { active_peers_ = active_peers; }
+
+  /** Channel occupied for airtime_us at now_ms (a received frame, or own TX). */
+  void on_airtime(uint32_t now_ms, uint32_t airtime_us);
+
+  /** Re-evaluate the scale (no-op until kUpdatePeriodMs since the last evaluation). */
+  void update(uint32_t now_ms, uint32_t beacon_airtime_us, uint32_t min_interval_ms,
+              uint32_t max_interval_ms);
+
+  /** Heard utilisation (permille of time) over the window ending at now_ms. */
+  uint32_t utilisation_permille(uint32_t now_ms) const;
+  /** Current interval scale, Q8 (kScaleOne = no stretch). */
+  uint32_t scale_q8() const { return scale_q8_; }
+  /** min_interval_ms stretched by the current scale and dither (min_interval_ms if unstretched). */
+  uint32_t stretch(uint32_t min_interval_ms) const;
+
+ private:
+  struct Bucket {
+    uint32_t epoch = 0;
+    uint32_t airtime_us = 0;
+  };
+
+  Bucket buckets_[kBuckets] = {};
+  uint16_t target_permille_ = kDefaultTargetPermille;
+  uint16_t active_peers_ = 0;
+  uint32_t scale_q8_ = kScaleOne;
+  uint32_t dither_q8_ = kScaleOne;
+  uint32_t rng_ = 0x9E3779B9u;
+  uint32_t last_update_ms_ = 0;
+  bool updated_ = false;
+};
+
+} // namespace domain
+} // namespace naviga
@@ -0,0 +1,261 @@
+#include "domain/flash_log.h"
+
+#include "domain/log_frame.h"
+
+namespace naviga {
+namespace domain {
+
+constexpr size_t FlashLog::kBatchBytes;
+constexpr uint32_t FlashLog::kFlushIntervalMs;
+constexpr uint32_t FlashLog::kMinFlushSpacingMs;
+constexpr size_t FlashLog::kSectorHeaderSize;
+constexpr size_t FlashLog::kRecordOverhead;
+
+namespace {
+
+constexpr uint32_t kSectorMagic = 0x31474C4E;  // "NLG1" LE
+constexpr uint8_t kRecordTag = 0x5A;
+constexpr uint8_t kFreeTag = 0xFF;
+
+void write_u32_le(uint8_t* out, uint32_t value) {
+  out[0] = static_cast<uint8_t>(value & 0xFF);
+  out[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+  out[2] = static_cast<uint8_t>((value >> 16) & 0xFF);
+  out[3] = static_cast<uint8_t>((value >> 24) & 0xFF);
+}
+
+uint32_t read_u32_le(const uint8_t* in) {
+  return static_cast<uint32_t>(in[0]) | static_cast<uint32_t>(in[1]) << 8 |
+         static_cast<uint32_t>(in[2]) << 16 | static_cast<uint32_t>(in[3]) << 24;
+}
+
+} // namespace
+
+bool FlashLog::mount(IFlashRegion* region) {
+  region_ = nullptr;
+  batch_len_ = 0;
+  if (!region || region->sector_count() < 2 ||
+      region->sector_size() < kSectorHeaderSize + kRecordOverhead + 255) {
+    return false;
+  }
+  region_ = region;
+  sector_size_ = region->sector_size();
+  sector_count_ = region->sector_count();
+
+  bool found = false;
+  uint32_t max_seq = 0;
+  for (size_t s = 0; s < sector_count_; ++s) {
+    uint32_t seq = 0;
+    if (read_sector_seq(s, &seq) && (!found || seq > max_seq)) {
+      found = true;
+      max_seq = seq;
+      head_sector_ = s;
+    }
+  }
+  if (!found) {
+    return format();
+  }
+  next_seq_ = max_seq + 1;
+  write_offset_ = scan_sector(head_sector_, nullptr, nullptr);
+  return true;
+}
+
+bool FlashLog::format() {
+  if (!region_) {
+    return false;
+  }
+  // Sector 0 is erased by open_sector(); skip already-blank sectors to keep format fast.
+  uint8_t probe[kSectorHeaderSize] = {};
+  for (size_t s = 1; s < sector_count_; ++s) {
+    if (!region_->read(s * sector_size_, probe, sizeof(probe))) {
+      return false;
+    }
+    bool blank = true;
+    for (size_t i = 0; i < sizeof(probe); ++i) {
+      blank = blank && probe[i] == 0xFF;
+    }
+    if (!blank) {
+      if (!region_->erase_sector(s)) {
+        return false;
+      }
+      stats_.sectors_erased++;
+    }
+  }
+  next_seq_ = 1;
+  batch_len_ = 0;
+  head_sector_ = 0;
+  return open_sector(0);
+}
+
+bool FlashLog::append(const LogRecordView& record) {
+  const uint8_t len = record.payload ? record.len : 0;
+  const size_t size = kRecordOverhead + len;
+  if (batch_len_ + size > kBatchBytes) {
+    stats_.records_dropped++;
+    return false;
+  }
+  uint8_t* out = batch_ + batch_len_;
+  out[0] = kRecordTag;
+  write_u32_le(out + 1, record.t_ms);
+  const uint16_t event = static_cast<uint16_t>(record.event_id);
+  out[5] = static_cast<uint8_t>(event & 0xFF);
+  out[6] = static_cast<uint8_t>((event >> 8) & 0xFF);
+  out[7] = static_cast<uint8_t>(record.level);
+  out[8] = len;
+  for (uint8_t i = 0; i < len; ++i) {
+    out[9 + i] = record.payload[i];
+  }
+  const uint16_t crc = log_frame_crc16(out + 1, 8 + len);
+  out[9 + len] = static_cast<uint8_t>(crc & 0xFF);
+  out[10 + len] = static_cast<uint8_t>((crc >> 8) & 0xFF);
+  batch_len_ += size;
+  stats_.records_appended++;
+  return true;
+}
+
+bool FlashLog::tick(uint32_t now_ms) {
+  if (!region_ || batch_len_ == 0) {
+    return false;
+  }
+  const uint32_t since = now_ms - last_flush_ms_;
+  const bool interval_due = since >= kFlushIntervalMs;
+  const bool pressure_due = (batch_len_ * 4 >= kBatchBytes * 3) && since >= kMinFlushSpacingMs;
+  if (!interval_due && !pressure_due) {
+    return false;
+  }
+  last_flush_ms_ = now_ms;
+  return flush();
+}
+
+bool FlashLog::flush() {
+  if (!region_ || batch_len_ == 0) {
+    return false;
+  }
+  size_t pos = 0;
+  while (pos < batch_len_) {
+    // Collect the run of whole records that fits in the current sector.
+    size_t run = 0;
+    while (pos + run < batch_len_) {
+      const size_t size = kRecordOverhead + batch_[pos + run + 8];
+      if (write_offset_ + run + size > sector_size_) {
+        break;
+      }
+      run += size;
+    }
+    if (run == 0) {
+      if (!open_sector((head_sector_ + 1) % sector_count_)) {
+        batch_len_ = 0;
+        return false;
+      }
+      continue;
+    }
+    if (!region_->write(head_sector_ * sector_size_ + write_offset_, batch_ + pos, run)) {
+      batch_len_ = 0;
+      return false;
+    }
+    write_offset_ += run;
+    pos += run;
+  }
+  batch_len_ = 0;
+  stats_.flushes++;
+  return true;
+}
+
+void FlashLog::for_each_record(RecordCallback cb, void* ctx) const {
+  if (!region_ || !cb) {
+    return;
+  }
+  // Oldest sector is the one after head (ring order); blank/foreign sectors are skipped.
+  for (size_t i = 1; i <= sector_count_; ++i) {
+    const size_t sector = (head_sector_ + i) % sector_count_;
+    uint32_t seq = 0;
+    if (read_sector_seq(sector, &seq)) {
+      scan_sector(sector, cb, ctx);
+    }
+  }
+}
+
+void FlashLog::sink(void* ctx, const LogRecordView& record) {
+  if (ctx) {
+    static_cast<FlashLog*>(ctx)->append(record);
+  }
+}
+
+size_t FlashLog::scan_sector(size_t sector, RecordCallback cb, void* ctx) const {
+  const size_t base = sector * sector_size_;
+  size_t offset = kSectorHeaderSize;
+  uint8_t rec[kRecordOverhead + 255];
+  while (offset + kRecordOverhead <= sector_size_) {
+    if (!region_->read(base + offset, rec, 9)) {
+      return sector_size_;
+    }
+    if (rec[0] == kFreeTag) {
+      return offset;
+    }
+    const uint8_t len = rec[8];
+    const size_t size = kRecordOverhead + len;
+    if (rec[0] != kRecordTag || offset + size > sector_size_ ||
+        !region_->read(base + offset + 9, rec + 9, len + 2)) {
+      return sector_size_;
+    }
+    const uint16_t crc = static_cast<uint16_t>(rec[9 + len]) |
+                         static_cast<uint16_t>(rec[10 + len] << 8);
+    if (crc != log_frame_crc16(rec + 1, 8 + len)) {
+      return sector_size_;  // torn write: nothing after it is trusted
+    }
+    if (cb) {
+      LogRecordView view{};
+      view.t_ms = read_u32_le(rec + 1);
+      view.event_id = static_cast<LogEventId>(static_cast<uint16_t>(rec[5]) |
+                                              static_cast<uint16_t>(rec[6] << 8));
+      view.level = static_cast<LogLevel>(rec[7]);
+      view.len = len;
+      view.payload = len > 0 ? rec + 9 : nullptr;
+      cb(ctx, view);
+    }
+    offset += size;
+  }
+  return sector_size_;
+}
+
+bool FlashLog::read_sector_seq(size_t sector, uint32_t* seq) const {
+  uint8_t header[kSectorHeaderSize] = {};
+  if (!region_->read(sector * sector_size_, header, sizeof(header))) {
+    return false;
+  }
+  if (read_u32_le(header) != kSectorMagic) {
+    return false;
+  }
+  const uint16_t crc = static_cast<uint16_t>(header[8]) | static_cast<uint16_t>(header[9] << 8);
+  if (crc != log_frame_crc16(header, 8)) {
+    return false;
+  }
+  *seq = read_u32_le(header + 4);
+  return true;
+}
+
+bool FlashLog::open_sector(size_t sector) {
+  if (!region_->erase_sector(sector)) {
+    return false;
+  }
+  stats_.sectors_erased++;
+  uint8_t header[kSectorHeaderSize];
+  for (size_t i = 0; i < sizeof(header); ++i) {
+    header[i] = 0xFF;
+  }
+  write_u32_le(header, kSectorMagic);
+  write_u32_le(header + 4, next_seq_);
+  const uint16_t crc = log_frame_crc16(header, 8);
+  header[8] = static_cast<uint8_t>(crc & 0xFF);
+  header[9] = static_cast<uint8_t>((crc >> 8) & 0xFF);
+  if (!region_->write(sector * sector_size_, header, sizeof(header))) {
+    return false;
+  }
+  next_seq_++;
+  head_sector_ = sector;
+  write_offset_ = kSectorHeaderSize;
+  return true;
+}
+
+} // namespace domain
+} // namespace naviga
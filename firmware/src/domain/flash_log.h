@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "domain/logger.h"
+#include "naviga/hal/interfaces.h"
+
+namespace naviga {
+namespace domain {
+
+struct FlashLogStats {
+  uint32_t records_appended = 0;  ///< Accepted into the RAM batch.
+  uint32_t records_dropped = 0;   ///< Batch full (flush spacing not yet elapsed) or oversize.
+  uint32_t flushes = 0;           ///< Batches written to flash.
+  uint32_t sectors_erased = 0;
+};
+
+/**
+ * Persistent circular event log on a raw flash region (logging_v0: post-mortem log).
+ *
+ * Layout: each sector starts with a 16-byte header (magic, monotonic sector seq, crc16);
+ * records follow back-to-back as tag(0x5A) | t_ms u32 | event_id u16 | level u8 | len u8 |
+ * payload | crc16 (LE, CRC16-CCITT over t_ms..payload). 0xFF tag = free space.
+ * Sectors are filled in order and the oldest one is erased when the log wraps, so every
+ * sector sees the same number of erase cycles (wear levelling by rotation).
+ *
+ * Writes are batched in RAM and flushed from tick() at most every kFlushIntervalMs, or
+ * earlier (never more often than kMinFlushSpacingMs) when the batch is 3/4 full.
+ * A torn record (reset mid-write) ends its sector; mount() resumes in the next one.
+ */
+class FlashLog {
+ public:
+  static constexpr size_t kBatchBytes = 512;
+  static constexpr uint32_t kFlushIntervalMs = 10000;
+  static constexpr uint32_t kMinFlushSpacingMs = 1000;
+  static constexpr size_t kSectorHeaderSize = 16;
+  static constexpr size_t kRecordOverhead = 11;  ///< tag + 8-byte header + crc16.
+
+  /** Scan sector headers and find the write position; formats an empty/foreign region. */
+  bool mount(IFlashRegion* region);
+  bool is_mounted() const { return region_ != nullptr; }
+  /** Erase all non-blank sectors and start a fresh log. */
+  bool format();
+
+  /** Queue one record in the RAM batch (no flash access). */
+  bool append(const LogRecordView& record);
+  /** Flush the batch if due; returns true if flash was written. */
+  bool tick(uint32_t now_ms);
+  /** Write the batch now regardless of timing. */
+  bool flush();
+
+  /** Visit persisted records oldest-first (unflushed batch excluded). */
+  void for_each_record(RecordCallback cb, void* ctx) const;
+  size_t pending_bytes() const { return batch_len_; }
+  const FlashLogStats& stats() const { return stats_; }
+
+  /** RecordCallback adapter for Logger::set_sink (ctx = FlashLog*). */
+  static void sink(void* ctx, const LogRecordView& record);
+
+ private:
+  /** Scan one sector's records from its header; returns first free offset (sector size if full/torn). */
+  size_t scan_sector(size_t sector, RecordCallback cb, void* ctx) const;
+  bool read_sector_seq(size_t sector, uint32_t* seq) const;
+  bool open_sector(size_t sector);
+
+  IFlashRegion* region_ = nullptr;
+  size_t sector_size_ = 0;
+  size_t sector_count_ = 0;
+  size_t head_sector_ = 0;
+  size_t write_offset_ = 0;
+  uint32_t next_seq_ = 1;
+  uint32_t last_flush_ms_ = 0;
+  uint8_t batch_[kBatchBytes] = {};
+  size_t batch_len_ = 0;
+  FlashLogStats stats_{};
+};
+
+} // namespace domain
+} // namespace naviga
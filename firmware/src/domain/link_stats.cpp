@@ -0,0 +1,75 @@
+#include "domain/link_stats.h"
+
+#include "domain/seq16_order.h"
+
+namespace naviga {
+namespace domain {
+
+namespace {
+
+constexpr uint32_t kIaMaxUnits = 0xFFFFu;
+
+uint16_t sat_add_u16(uint16_t a, uint32_t b) {
+  const uint32_t sum = static_cast<uint32_t>(a) + b;
+  return sum > 0xFFFFu ? 0xFFFFu : static_cast<uint16_t>(sum);
+}
+
+} // namespace
+
+void link_stats_on_rx(PeerLinkStats& stats, bool first, uint16_t seq16, uint16_t last_seq,
+                      int8_t rssi_dbm, uint32_t now_ms) {
+  const int16_t rssi_q4 = static_cast<int16_t>(rssi_dbm * 16);
+  if (first) {
+    stats = PeerLinkStats{};
+    stats.rssi_ewma_q4 = rssi_q4;
+    stats.rx_count = 1;
+    stats.last_rx_ms = now_ms;
+    return;
+  }
+
+  stats.rssi_ewma_q4 = static_cast<int16_t>(stats.rssi_ewma_q4 + (rssi_q4 - stats.rssi_ewma_q4) / 8);
+
+  if (seq16_order(seq16, last_seq) != Seq16Order::Newer) {
+    stats.dup_count = sat_add_u16(stats.dup_count, 1);
+    return;
+  }
+  const uint16_t seq_delta = static_cast<uint16_t>(seq16 - last_seq);
+
+  stats.rx_count = sat_add_u16(stats.rx_count, 1);
+  stats.lost_count = sat_add_u16(stats.lost_count, static_cast<uint32_t>(seq_delta - 1u));
+  if (static_cast<uint32_t>(stats.rx_count) + stats.lost_count >= kLinkStatsWindow) {
+    stats.rx_count = static_cast<uint16_t>((stats.rx_count + 1u) / 2u);
+    stats.lost_count = static_cast<uint16_t>(stats.lost_count / 2u);
+  }
+
+  uint32_t ia_units = (now_ms - stats.last_rx_ms) / 10u;
+  if (ia_units > kIaMaxUnits) {
+    ia_units = kIaMaxUnits;
+  }
+  stats.last_rx_ms = now_ms;
+  if (stats.ia_mean_10ms == 0) {
+    stats.ia_mean_10ms = static_cast<uint16_t>(ia_units);
+    return;
+  }
+  const int32_t dev = static_cast<int32_t>(ia_units) - static_cast<int32_t>(stats.ia_mean_10ms);
+  const int32_t abs_dev = dev < 0 ? -dev : dev;
+  stats.ia_mean_10ms = static_cast<uint16_t>(static_cast<int32_t>(stats.ia_mean_10ms) + dev / 8);
+  stats.ia_jitter_10ms = static_cast<uint16_t>(static_cast<int32_t>(stats.ia_jitter_10ms) +
+                                               (abs_dev - static_cast<int32_t>(stats.ia_jitter_10ms)) / 16);
+}
+
+uint8_t link_stats_pdr_pct(const PeerLinkStats& stats) {
+  const uint32_t total = static_cast<uint32_t>(stats.rx_count) + stats.lost_count;
+  if (total == 0) {
+    return 100;
+  }
+  return static_cast<uint8_t>((static_cast<uint32_t>(stats.rx_count) * 100u + total / 2u) / total);
+}
+
+int8_t link_stats_rssi_dbm(const PeerLinkStats& stats) {
+  const int16_t q = stats.rssi_ewma_q4;
+  return static_cast<int8_t>(q >= 0 ? (q + 8) / 16 : -((-q + 8) / 16));
+}
+
+} // namespace domain
+} // namespace naviga
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+namespace naviga {
+namespace domain {
+
+/**
+ * Per-peer link quality, updated on every received frame from that peer (O(1), integer only).
+ * Runtime-local: not persisted, not part of the canonical BLE node record (exported separately).
+ * 16 bytes per peer → NodeTable::kMaxNodes (100) peers cost 1.6 KB.
+ *
+ * PDR is estimated from seq16 gaps between accepted frames. The sender draws seq16 from one
+ * counter for all packet types, so a gap is a lost frame — or one replaced in the sender's TX
+ * queue before it went on air; the estimate is therefore a lower bound on channel PDR.
+ * rx/lost counts are halved together once their sum reaches kLinkStatsWindow, so PDR tracks
+ * roughly the last kLinkStatsWindow frames.
+ */
+struct PeerLinkStats {
+  int16_t  rssi_ewma_q4   = 0;  ///< RSSI EWMA, 1/16 dBm (alpha = 1/8).
+  uint16_t rx_count       = 0;  ///< Accepted (newer seq16) frames in window.
+  uint16_t lost_count     = 0;  ///< Frames missing from seq16 gaps in window.
+  uint16_t dup_count      = 0;  ///< Duplicate or out-of-order frames (saturating).
+  uint16_t ia_mean_10ms   = 0;  ///< Inter-arrival mean of accepted frames, 10 ms units (alpha = 1/8).
+  uint16_t ia_jitter_10ms = 0;  ///< Mean abs deviation of inter-arrival (RFC 3550 style, 1/16).
+  uint32_t last_rx_ms     = 0;  ///< Arrival time of last accepted frame.
+};
+
+static_assert(sizeof(PeerLinkStats) == 16, "PeerLinkStats must stay 16 bytes (2 KB budget for 100+ peers)");
+
+constexpr uint16_t kLinkStatsWindow = 256;
+
+/**
+ * Update stats for one received frame.
+ * first: first frame ever seen from this peer (no gap/inter-arrival yet).
+ * seq16 / last_seq: incoming and last accepted seq16; not newer (seq16_order) = duplicate or
+ * out of order, a forward gap counts the frames in between as lost.
+ */
+void link_stats_on_rx(PeerLinkStats& stats, bool first, uint16_t seq16, uint16_t last_seq,
+                      int8_t rssi_dbm, uint32_t now_ms);
+
+/** Delivery ratio 0..100 %; 100 when nothing is known yet. */
+uint8_t link_stats_pdr_pct(const PeerLinkStats& stats);
+
+/** RSSI EWMA rounded to dBm. */
+int8_t link_stats_rssi_dbm(const PeerLinkStats& stats);
+
+} // namespace domain
+} // namespace naviga
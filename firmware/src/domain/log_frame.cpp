@@ -0,0 +1,171 @@
+#include "domain/log_frame.h"
+
+namespace naviga {
+namespace domain {
+
+namespace {
+
+constexpr uint16_t kCrc16Init = 0xFFFF;
+constexpr uint16_t kCrc16Poly = 0x1021;
+
+size_t serialize_record(const LogRecordView& record, uint8_t* out) {
+  const uint16_t event = static_cast<uint16_t>(record.event_id);
+  out[0] = static_cast<uint8_t>(record.t_ms & 0xFF);
+  out[1] = static_cast<uint8_t>((record.t_ms >> 8) & 0xFF);
+  out[2] = static_cast<uint8_t>((record.t_ms >> 16) & 0xFF);
+  out[3] = static_cast<uint8_t>((record.t_ms >> 24) & 0xFF);
+  out[4] = static_cast<uint8_t>(event & 0xFF);
+  out[5] = static_cast<uint8_t>((event >> 8) & 0xFF);
+  out[6] = static_cast<uint8_t>(record.level);
+  const uint8_t len = record.payload ? record.len : 0;
+  out[7] = len;
+  for (uint8_t i = 0; i < len; ++i) {
+    out[kLogRecordHeaderSize + i] = record.payload[i];
+  }
+  size_t n = kLogRecordHeaderSize + len;
+  const uint16_t crc = log_frame_crc16(out, n);
+  out[n++] = static_cast<uint8_t>(crc & 0xFF);
+  out[n++] = static_cast<uint8_t>((crc >> 8) & 0xFF);
+  return n;
+}
+
+} // namespace
+
+uint16_t log_frame_crc16(const uint8_t* data, size_t len) {
+  uint16_t crc = kCrc16Init;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= static_cast<uint16_t>(data[i] << 8);
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ kCrc16Poly)
+                           : static_cast<uint16_t>(crc << 1);
+    }
+  }
+  return crc;
+}
+
+size_t cobs_encode(const uint8_t* in, size_t len, uint8_t* out, size_t out_cap) {
+  if (!out || (len > 0 && !in) || out_cap < cobs_max_encoded_len(len)) {
+    return 0;
+  }
+  size_t code_index = 0;
+  size_t write_index = 1;
+  uint8_t code = 1;
+  for (size_t i = 0; i < len; ++i) {
+    if (in[i] == 0) {
+      out[code_index] = code;
+      code_index = write_index++;
+      code = 1;
+      continue;
+    }
+    out[write_index++] = in[i];
+    ++code;
+    if (code == 0xFF) {
+      out[code_index] = code;
+      code_index = write_index++;
+      code = 1;
+    }
+  }
+  out[code_index] = code;
+  return write_index;
+}
+
+size_t cobs_decode(const uint8_t* in, size_t len, uint8_t* out, size_t out_cap) {
+  if (!in || !out) {
+    return 0;
+  }
+  size_t read_index = 0;
+  size_t write_index = 0;
+  while (read_index < len) {
+    const uint8_t code = in[read_index++];
+    if (code == 0) {
+      return 0;
+    }
+    for (uint8_t i = 1; i < code; ++i) {
+      if (read_index >= len || write_index >= out_cap || in[read_index] == 0) {
+        return 0;
+      }
+      out[write_index++] = in[read_index++];
+    }
+    if (code != 0xFF && read_index < len) {
+      if (write_index >= out_cap) {
+        return 0;
+      }
+      out[write_index++] = 0;
+    }
+  }
+  return write_index;
+}
+
+size_t log_frame_encoded_len(const LogRecordView& record) {
+  uint8_t raw[kLogRecordHeaderSize + 255 + kLogFrameCrcSize];
+  const size_t raw_len = serialize_record(record, raw);
+  // COBS adds one byte per zero-delimited run (max 254 data bytes per run).
+  size_t encoded = 1;
+  size_t run = 0;
+  for (size_t i = 0; i < raw_len; ++i) {
+    if (raw[i] == 0) {
+      ++encoded;
+      run = 0;
+      continue;
+    }
+    ++encoded;
+    if (++run == 254) {
+      ++encoded;
+      run = 0;
+    }
+  }
+  return encoded + 1;  // delimiter
+}
+
+size_t encode_log_frame(const LogRecordView& record, uint8_t* out, size_t out_cap) {
+  if (!out || out_cap == 0) {
+    return 0;
+  }
+  uint8_t raw[kLogRecordHeaderSize + 255 + kLogFrameCrcSize];
+  const size_t raw_len = serialize_record(record, raw);
+  const size_t encoded = cobs_encode(raw, raw_len, out, out_cap - 1);
+  if (encoded == 0) {
+    return 0;
+  }
+  out[encoded] = 0x00;
+  return encoded + 1;
+}
+
+bool decode_log_frame(const uint8_t* frame,
+                      size_t frame_len,
+                      LogRecordView* out,
+                      uint8_t* payload_buf) {
+  if (!frame || !out || !payload_buf) {
+    return false;
+  }
+  uint8_t raw[kLogRecordHeaderSize + 255 + kLogFrameCrcSize];
+  const size_t raw_len = cobs_decode(frame, frame_len, raw, sizeof(raw));
+  if (raw_len < kLogRecordHeaderSize + kLogFrameCrcSize) {
+    return false;
+  }
+  const uint8_t len = raw[7];
+  if (raw_len != kLogRecordHeaderSize + len + kLogFrameCrcSize) {
+    return false;
+  }
+  const size_t body_len = kLogRecordHeaderSize + len;
+  const uint16_t crc = static_cast<uint16_t>(raw[body_len]) |
+                       static_cast<uint16_t>(raw[body_len + 1] << 8);
+  if (crc != log_frame_crc16(raw, body_len)) {
+    return false;
+  }
+
+  out->t_ms = static_cast<uint32_t>(raw[0]) | static_cast<uint32_t>(raw[1]) << 8 |
+              static_cast<uint32_t>(raw[2]) << 16 | static_cast<uint32_t>(raw[3]) << 24;
+  out->event_id = static_cast<LogEventId>(static_cast<uint16_t>(raw[4]) |
+                                          static_cast<uint16_t>(raw[5] << 8));
+  out->level = static_cast<LogLevel>(raw[6]);
+  out->len = len;
+  for (uint8_t i = 0; i < len; ++i) {
+    payload_buf[i] = raw[kLogRecordHeaderSize + i];
+  }
+  out->payload = len > 0 ? payload_buf : nullptr;
+  return true;
+}
+
+} // namespace domain
+} // namespace naviga
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "domain/logger.h"
+
+namespace naviga {
+namespace domain {
+
+/**
+ * Compact binary framing for event log export (UART, flash dump).
+ * Frame = COBS( record header(8) | payload(len) | crc16 LE(2) ) | 0x00 delimiter.
+ * Record header is the Logger ring layout: t_ms u32 LE, event_id u16 LE, level u8, len u8.
+ * CRC16-CCITT-FALSE over header + payload. A host reader splits on 0x00, COBS-decodes, checks CRC.
+ */
+constexpr size_t kLogRecordHeaderSize = 8;
+constexpr size_t kLogFrameCrcSize = 2;
+
+/** Worst-case COBS output size for len input bytes (no delimiter). */
+constexpr size_t cobs_max_encoded_len(size_t len) {
+  return len + (len / 254) + 1;
+}
+
+/** Max encoded frame size (255-byte payload) including trailing 0x00. */
+constexpr size_t kMaxLogFrameSize =
+    cobs_max_encoded_len(kLogRecordHeaderSize + 255 + kLogFrameCrcSize) + 1;
+
+uint16_t log_frame_crc16(const uint8_t* data, size_t len);
+
+/** COBS encode; returns bytes written (no delimiter) or 0 if out_cap is too small. */
+size_t cobs_encode(const uint8_t* in, size_t len, uint8_t* out, size_t out_cap);
+/** COBS decode of one frame body (without delimiter); returns bytes written or 0 on malformed input. */
+size_t cobs_decode(const uint8_t* in, size_t len, uint8_t* out, size_t out_cap);
+
+/** Exact encoded frame size for record (incl. delimiter). */
+size_t log_frame_encoded_len(const LogRecordView& record);
+
+/** Encode one record as a delimited frame. Returns bytes written or 0 if out_cap is too small. */
+size_t encode_log_frame(const LogRecordView& record, uint8_t* out, size_t out_cap);
+
+/**
+ * Decode one frame body (delimiter stripped). payload_buf (>= 255 bytes) backs out->payload.
+ * Returns false on COBS error, length mismatch or CRC mismatch.
+ */
+bool decode_log_frame(const uint8_t* frame,
+                      size_t frame_len,
+                      LogRecordView* out,
+                      uint8_t* payload_buf);
+
+} // namespace domain
+} // namespace naviga
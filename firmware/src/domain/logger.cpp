@@ -43,9 +43,19 @@ bool Logger::log(uint32_t t_ms,
   }
 
   size_ += record_size;
+
+  if (sink_) {
+    const LogRecordView record{t_ms, event_id, level, len > 0 ? payload : nullptr, len};
+    sink_(sink_ctx_, record);
+  }
   return true;
 }
 
+void Logger::set_sink(RecordCallback cb, void* ctx) {
+  sink_ = cb;
+  sink_ctx_ = ctx;
+}
+
 size_t Logger::size() const {
   return size_;
 }
@@ -65,36 +75,19 @@ void Logger::for_each_record(RecordCallback cb, void* ctx) const {
     return;
   }
 
-  size_t offset = 0;
   size_t index = tail_;
   size_t remaining = size_;
+  uint8_t payload[255] = {};
 
   while (remaining >= kHeaderSize) {
-    uint8_t header[kHeaderSize] = {};
-    read_bytes(index, header, kHeaderSize);
-    const uint8_t len = header[7];
-    const size_t record_size = kHeaderSize + len;
-    if (record_size > remaining) {
-      return;
-    }
-
     LogRecordView record{};
-    record.t_ms = read_u32_le(header);
-    record.event_id = static_cast<LogEventId>(read_u16_le(header + 4));
-    record.level = static_cast<LogLevel>(header[6]);
-    record.len = len;
-
-    uint8_t payload[255] = {};
-    if (len > 0) {
-      read_bytes((index + kHeaderSize) % capacity_, payload, len);
-      record.payload = payload;
-    } else {
-      record.payload = nullptr;
+    const size_t record_size = read_record(index, remaining, &record, payload);
+    if (record_size == 0) {
+      return;
     }
 
     cb(ctx, record);
 
-    offset += record_size;
     index = (index + record_size) % capacity_;
     remaining -= record_size;
   }
@@ -105,6 +98,34 @@ void Logger::drain(RecordCallback cb, void* ctx) {
   clear();
 }
 
+size_t Logger::drain_while(RecordConsumer cb, void* ctx) {
+  if (!cb) {
+    return 0;
+  }
+
+  size_t consumed = 0;
+  uint8_t payload[255] = {};
+
+  while (size_ >= kHeaderSize) {
+    LogRecordView record{};
+    const size_t record_size = read_record(tail_, size_, &record, payload);
+    if (record_size == 0) {
+      clear();
+      break;
+    }
+    if (!cb(ctx, record)) {
+      break;
+    }
+    tail_ = (tail_ + record_size) % capacity_;
+    size_ -= record_size;
+    ++consumed;
+  }
+  if (size_ == 0) {
+    clear();
+  }
+  return consumed;
+}
+
 size_t Logger::copy_raw(uint8_t* out, size_t max_len) const {
   if (!out || max_len == 0 || size_ == 0) {
     return 0;
@@ -139,6 +160,31 @@ void Logger::drop_oldest() {
   size_ -= record_size;
 }
 
+size_t Logger::read_record(size_t index,
+                           size_t remaining,
+                           LogRecordView* out,
+                           uint8_t* payload_buf) const {
+  uint8_t header[kHeaderSize] = {};
+  read_bytes(index, header, kHeaderSize);
+  const uint8_t len = header[7];
+  const size_t record_size = kHeaderSize + len;
+  if (record_size > remaining) {
+    return 0;
+  }
+
+  out->t_ms = read_u32_le(header);
+  out->event_id = static_cast<LogEventId>(read_u16_le(header + 4));
+  out->level = static_cast<LogLevel>(header[6]);
+  out->len = len;
+  if (len > 0) {
+    read_bytes((index + kHeaderSize) % capacity_, payload_buf, len);
+    out->payload = payload_buf;
+  } else {
+    out->payload = nullptr;
+  }
+  return record_size;
+}
+
 uint8_t Logger::read_byte(size_t index) const {
   return buffer_[index % capacity_];
 }
@@ -24,6 +24,8 @@ struct LogRecordView {
 };
 
 using RecordCallback = void (*)(void* ctx, const LogRecordView& record);
+/** Incremental drain consumer: return true to consume the record, false to stop (record is kept). */
+using RecordConsumer = bool (*)(void* ctx, const LogRecordView& record);
 
 class Logger {
  public:
@@ -39,12 +41,21 @@ class Logger {
            const uint8_t* payload,
            uint8_t len);
 
+  /** Optional mirror: every accepted record is also passed to cb (e.g. FlashLog::sink). */
+  void set_sink(RecordCallback cb, void* ctx);
+
   size_t size() const;
   size_t capacity() const;
   void clear();
 
   void for_each_record(RecordCallback cb, void* ctx) const;
   void drain(RecordCallback cb, void* ctx);
+  /**
+   * Bounded drain: hands records oldest-first to cb and removes each one it accepts.
+   * Stops at the first record cb rejects, so a sink can take only what fits (e.g. UART TX space).
+   * Returns number of records consumed.
+   */
+  size_t drain_while(RecordConsumer cb, void* ctx);
   size_t copy_raw(uint8_t* out, size_t max_len) const;
 
  private:
@@ -52,6 +63,8 @@ class Logger {
 
   bool ensure_space(size_t record_size);
   void drop_oldest();
+  /** Decode record at ring index; payload copied to payload_buf (>= 255 bytes). Returns record size or 0. */
+  size_t read_record(size_t index, size_t remaining, LogRecordView* out, uint8_t* payload_buf) const;
 
   uint8_t read_byte(size_t index) const;
   void read_bytes(size_t index, uint8_t* out, size_t len) const;
@@ -67,6 +80,8 @@ class Logger {
   size_t head_ = 0;
   size_t tail_ = 0;
   size_t size_ = 0;
+  RecordCallback sink_ = nullptr;
+  void* sink_ctx_ = nullptr;
   uint8_t storage_[kDefaultRingSize] = {};
 };
 
@@ -0,0 +1,140 @@
+#include "domain/mp_logger.h"
+
+#include <cstring>
+
+namespace naviga {
+namespace domain {
+
+constexpr size_t MpLogger::kSlotCount;
+constexpr uint8_t MpLogger::kMaxPayload;
+
+static_assert((MpLogger::kSlotCount & (MpLogger::kSlotCount - 1)) == 0,
+              "MpLogger::kSlotCount must be a power of two");
+
+MpLogger::MpLogger() : enqueue_pos_(0), dequeue_pos_(0), dropped_full_(0), dropped_oversize_(0) {
+  for (size_t i = 0; i < kSlotCount; ++i) {
+    slots_[i].seq.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+    slots_[i].t_ms = 0;
+    slots_[i].event_id = 0;
+    slots_[i].level = 0;
+    slots_[i].len = 0;
+  }
+}
+
+bool MpLogger::log(uint32_t t_ms, LogEventId event_id, LogLevel level) {
+  return log(t_ms, event_id, level, nullptr, 0);
+}
+
+bool MpLogger::log(uint32_t t_ms,
+                   LogEventId event_id,
+                   LogLevel level,
+                   const uint8_t* payload,
+                   uint8_t len) {
+  if (len > 0 && !payload) {
+    return false;
+  }
+  if (len > kMaxPayload) {
+    dropped_oversize_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Reserve: a slot is free for position pos when its seq == pos.
+  uint32_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  Slot* slot = nullptr;
+  for (;;) {
+    slot = &slots_[pos & kMask];
+    const uint32_t seq = slot->seq.load(std::memory_order_acquire);
+    const int32_t diff = static_cast<int32_t>(seq - pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      dropped_full_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->t_ms = t_ms;
+  slot->event_id = static_cast<uint16_t>(event_id);
+  slot->level = static_cast<uint8_t>(level);
+  slot->len = len;
+  if (len > 0) {
+    std::memcpy(slot->payload, payload, len);
+  }
+  // Commit: publish the filled slot to the consumer.
+  slot->seq.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+size_t MpLogger::size() const {
+  size_t count = 0;
+  uint32_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  LogRecordView record{};
+  while (count < kSlotCount && peek(pos, &record)) {
+    ++count;
+    ++pos;
+  }
+  return count;
+}
+
+void MpLogger::for_each_record(RecordCallback cb, void* ctx) const {
+  if (!cb) {
+    return;
+  }
+  uint32_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  LogRecordView record{};
+  for (size_t i = 0; i < kSlotCount && peek(pos, &record); ++i, ++pos) {
+    cb(ctx, record);
+  }
+}
+
+void MpLogger::drain(RecordCallback cb, void* ctx) {
+  uint32_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  LogRecordView record{};
+  while (peek(pos, &record)) {
+    if (cb) {
+      cb(ctx, record);
+    }
+    release(pos);
+    ++pos;
+  }
+}
+
+size_t MpLogger::drain_while(RecordConsumer cb, void* ctx) {
+  if (!cb) {
+    return 0;
+  }
+  size_t consumed = 0;
+  uint32_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  LogRecordView record{};
+  while (peek(pos, &record) && cb(ctx, record)) {
+    release(pos);
+    ++pos;
+    ++consumed;
+  }
+  return consumed;
+}
+
+bool MpLogger::peek(uint32_t pos, LogRecordView* out) const {
+  const Slot& slot = slots_[pos & kMask];
+  if (slot.seq.load(std::memory_order_acquire) != pos + 1) {
+    return false;  // empty, or reserved but not yet committed
+  }
+  out->t_ms = slot.t_ms;
+  out->event_id = static_cast<LogEventId>(slot.event_id);
+  out->level = static_cast<LogLevel>(slot.level);
+  out->len = slot.len;
+  out->payload = slot.len > 0 ? slot.payload : nullptr;
+  return true;
+}
+
+void MpLogger::release(uint32_t pos) {
+  slots_[pos & kMask].seq.store(pos + static_cast<uint32_t>(kSlotCount), std::memory_order_release);
+  dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+}
+
+} // namespace domain
+} // namespace naviga
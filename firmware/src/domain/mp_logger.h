@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "domain/logger.h"
+
+namespace naviga {
+namespace domain {
+
+/**
+ * Multi-producer event log: fixed slots with per-slot sequence numbers (reserve → fill → commit).
+ * log() is lock-free and safe from several tasks/ISRs; for_each_record/drain/drain_while must be
+ * called from a single consumer (e.g. the main loop drain). Same record view as Logger.
+ *
+ * Overflow policy differs from Logger: producers cannot reclaim unread slots without a lock, so a
+ * full ring drops the new record (counted in dropped_full()). Payloads longer than kMaxPayload are
+ * rejected (dropped_oversize()).
+ */
+class MpLogger {
+ public:
+  static constexpr size_t kSlotCount = 64;  ///< Power of two.
+  static constexpr uint8_t kMaxPayload = 16;
+
+  MpLogger();
+
+  bool log(uint32_t t_ms, LogEventId event_id, LogLevel level);
+  bool log(uint32_t t_ms,
+           LogEventId event_id,
+           LogLevel level,
+           const uint8_t* payload,
+           uint8_t len);
+
+  /** Committed records not yet drained (consumer-side view). */
+  size_t size() const;
+  size_t capacity() const { return kSlotCount; }
+
+  void for_each_record(RecordCallback cb, void* ctx) const;
+  void drain(RecordCallback cb, void* ctx);
+  size_t drain_while(RecordConsumer cb, void* ctx);
+
+  uint32_t dropped_full() const { return dropped_full_.load(std::memory_order_relaxed); }
+  uint32_t dropped_oversize() const { return dropped_oversize_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Slot {
+    std::atomic<uint32_t> seq;
+    uint32_t t_ms;
+    uint16_t event_id;
+    uint8_t level;
+    uint8_t len;
+    uint8_t payload[kMaxPayload];
+  };
+
+  static constexpr uint32_t kMask = static_cast<uint32_t>(kSlotCount - 1);
+
+  /** True if the slot at consumer position pos is committed; fills view (payload points into slot). */
+  bool peek(uint32_t pos, LogRecordView* out) const;
+  void release(uint32_t pos);
+
+  Slot slots_[kSlotCount];
+  std::atomic<uint32_t> enqueue_pos_;
+  std::atomic<uint32_t> dequeue_pos_;
+  std::atomic<uint32_t> dropped_full_;
+  std::atomic<uint32_t> dropped_oversize_;
+};
+
+} // namespace domain
+} // namespace naviga
@@ -4,6 +4,10 @@
 #include <cstdio>
 #include <cstring>
 
+#include "../../protocol/pos_full_codec.h"
+#include "../../protocol/status_codec.h"
+#include "domain/seq16_order.h"
+
 namespace naviga {
 namespace domain {
 
@@ -12,18 +16,6 @@ namespace {
 constexpr uint16_t kCrc16Init = 0xFFFF;
 constexpr uint16_t kCrc16Poly = 0x1021;
 
-/** RX semantics v0: seq16 ordering with wrap. Per rx_semantics_v0 §1. */
-enum class Seq16Order { Same, Newer, Older };
-
-Seq16Order seq16_order(uint16_t incoming, uint16_t last) {
-  const uint16_t delta = static_cast<uint16_t>(incoming - last);
-  if (delta == 0) {
-    return Seq16Order::Same;
-  }
-  /* Forward in ring (0..32767) = newer; backward (32768..65535) = older. */
-  return (delta <= 32767u) ? Seq16Order::Newer : Seq16Order::Older;
-}
-
 void write_u16_le(uint8_t* out, uint16_t value) {
   out[0] = static_cast<uint8_t>(value & 0xFF);
   out[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
@@ -196,6 +188,7 @@ bool NodeTable::upsert_remote(uint64_t node_id,
   if (existing >= 0) {
     NodeEntry& entry = entries_[static_cast<size_t>(existing)];
     if (!entry.is_self) {
+      note_link_rx(entry, last_seq, last_rx_rssi, now_ms);
       const Seq16Order order = seq16_order(last_seq, entry.last_seq);
       switch (order) {
         case Seq16Order::Newer:
@@ -210,6 +203,8 @@ bool NodeTable::upsert_remote(uint64_t node_id,
             entry.pos_age_s = pos_age_s;
             entry.last_core_seq16 = last_seq;
             entry.has_core_seq16  = true;
+            entry.has_pos_full_seq16 = false;
+            entry.has_velocity = false;
           }
           /* else: Alive path — do not overwrite position (packet_truth_table_v02). */
           break;
@@ -253,6 +248,7 @@ bool NodeTable::upsert_remote(uint64_t node_id,
   entry.last_seq = last_seq;
   entry.last_seen_ms = now_ms;
   entry.in_use = true;
+  note_link_rx(entry, last_seq, last_rx_rssi, now_ms);
   // Track last Core seq16 for Tail-1 match check.
   if (pos_valid) {
     entry.last_core_seq16 = last_seq;
@@ -269,13 +265,12 @@ bool NodeTable::upsert_remote(uint64_t node_id,
 // land in existing storage per nodetable_master_field_table_v0 §2 (pos_fix_type/pos_accuracy_bucket
 // stubs; pos_sats→sats, pos_flags_small→pos_flags). Packing: pos_flags = [0:3] pos_flags_small,
 // [4:6] fix_type, [7] pos_accuracy_bucket bit0; sats = [0:5] pos_sats, [6:7] pos_accuracy_bucket bits 1–2.
-bool NodeTable::apply_pos_full(uint64_t node_id,
-                               uint16_t seq16,
-                               int32_t lat_e7, int32_t lon_e7,
-                               uint8_t fix_type, uint8_t pos_sats,
-                               uint8_t pos_accuracy_bucket, uint8_t pos_flags_small,
+bool NodeTable::apply_pos_full(const protocol::PosFullView& pos,
                                int8_t rssi_dbm,
-                               uint32_t now_ms) {
+                               uint32_t now_ms,
+                               bool relayed) {
+  const uint64_t node_id = pos.node_id();
+  const uint16_t seq16 = pos.seq16();
   int idx = find_entry_index(node_id);
   if (idx < 0) {
     int free_idx = find_free_index();
@@ -295,7 +290,7 @@ bool NodeTable::apply_pos_full(uint64_t node_id,
     new_entry.is_self = false;
     new_entry.in_use = true;
     new_entry.last_seen_ms = now_ms;
-    new_entry.last_rx_rssi = rssi_dbm;
+    new_entry.last_rx_rssi = relayed ? 0 : rssi_dbm;
     size_++;
     recompute_collisions();
     set_dirty();
@@ -303,6 +298,11 @@ bool NodeTable::apply_pos_full(uint64_t node_id,
   }
 
   NodeEntry& entry = entries_[static_cast<size_t>(idx)];
+  if (relayed) {
+    rssi_dbm = entry.last_rx_rssi;  // relay's RSSI, not this node's link
+  } else {
+    note_link_rx(entry, seq16, rssi_dbm, now_ms);
+  }
   const Seq16Order order = seq16_order(seq16, entry.last_seq);
   if (order == Seq16Order::Same || order == Seq16Order::Older) {
     entry.last_seen_ms = now_ms;
@@ -311,35 +311,91 @@ bool NodeTable::apply_pos_full(uint64_t node_id,
     return true;
   }
 
+  const protocol::PosQuality q = pos.quality();
   entry.pos_valid = true;
-  entry.lat_e7 = lat_e7;
-  entry.lon_e7 = lon_e7;
+  entry.lat_e7 = pos.lat_e7();
+  entry.lon_e7 = pos.lon_e7();
   entry.pos_age_s = 0;
   entry.last_seq = seq16;
   entry.last_core_seq16 = seq16;
   entry.has_core_seq16 = true;
+  entry.pos_full_seq16 = seq16;
+  entry.has_pos_full_seq16 = true;
   entry.has_pos_flags = true;
   entry.has_sats = true;
-  entry.pos_flags = (pos_flags_small & 0x0Fu) | ((fix_type & 0x07u) << 4) | ((pos_accuracy_bucket & 0x01u) << 7);
-  entry.sats = (pos_sats & 0x3Fu) | ((pos_accuracy_bucket & 0x06u) << 5);
+  entry.pos_flags = (q.pos_flags_small & 0x0Fu) | ((q.fix_type & 0x07u) << 4) | ((q.pos_accuracy_bucket & 0x01u) << 7);
+  entry.sats = (q.pos_sats & 0x3Fu) | ((q.pos_accuracy_bucket & 0x06u) << 5);
+  entry.has_velocity = pos.has_velocity();
+  entry.velocity = pos.velocity();
+  entry.pos_rx_ms = now_ms;
+  entry.last_seen_ms = now_ms;
+  entry.last_rx_rssi = rssi_dbm;
+  set_dirty();
+  return true;
+}
+
+// apply_pos_delta: Node_Pos_Delta. Reference = position held, valid only while it belongs to the
+// delta's run: the Pos_Full named by ref_seq8, or a delta applied on top of it.
+bool NodeTable::apply_pos_delta(uint64_t node_id,
+                                uint16_t seq16,
+                                uint8_t ref_seq8,
+                                int32_t lat_e7, int32_t lon_e7,
+                                int8_t rssi_dbm,
+                                uint32_t now_ms,
+                                bool relayed,
+                                const protocol::PosVelocity* velocity) {
+  const int idx = find_entry_index(node_id);
+  if (idx < 0) {
+    return false;  // no reference; first contact needs a Pos_Full
+  }
+  NodeEntry& entry = entries_[static_cast<size_t>(idx)];
+  if (relayed) {
+    rssi_dbm = entry.last_rx_rssi;  // relay's RSSI, not this node's link
+  } else {
+    note_link_rx(entry, seq16, rssi_dbm, now_ms);
+  }
   entry.last_seen_ms = now_ms;
   entry.last_rx_rssi = rssi_dbm;
   set_dirty();
+  const Seq16Order order = seq16_order(seq16, entry.last_seq);
+  if (order == Seq16Order::Same || order == Seq16Order::Older) {
+    return true;
+  }
+  entry.last_seq = seq16;
+  if (!entry.pos_valid || !entry.has_pos_full_seq16 ||
+      static_cast<uint8_t>(entry.pos_full_seq16) != ref_seq8 ||
+      static_cast<uint16_t>(seq16 - entry.pos_full_seq16) > kPosDeltaMaxSeqGap) {
+    return false;
+  }
+  entry.lat_e7 = lat_e7;
+  entry.lon_e7 = lon_e7;
+  entry.pos_age_s = 0;
+  entry.last_core_seq16 = seq16;
+  entry.has_velocity = velocity != nullptr;
+  entry.velocity = velocity ? *velocity : protocol::PosVelocity{};
+  entry.pos_rx_ms = now_ms;
+  return true;
+}
+
+bool NodeTable::predicted_position(const NodeEntry& entry, uint32_t now_ms,
+                                   int32_t* out_lat_e7, int32_t* out_lon_e7) {
+  *out_lat_e7 = entry.lat_e7;
+  *out_lon_e7 = entry.lon_e7;
+  if (!entry.pos_valid || !entry.has_velocity || now_ms <= entry.pos_rx_ms) {
+    return false;
+  }
+  protocol::pos_predict_e7(entry.lat_e7, entry.lon_e7, entry.velocity, now_ms - entry.pos_rx_ms,
+                           out_lat_e7, out_lon_e7);
   return true;
 }
 
 // apply_status: v0.2 Node_Status (#435). Full snapshot; does not update position.
-bool NodeTable::apply_status(uint64_t node_id,
-                             uint16_t seq16,
-                             uint8_t battery_percent, uint8_t battery_est_rem_time,
-                             uint8_t tx_power_ch_throttle, uint8_t uptime10m,
-                             uint8_t role_id, uint8_t max_silence_10s,
-                             uint16_t hw_profile_id, uint16_t fw_version_id,
+bool NodeTable::apply_status(const protocol::StatusView& status,
                              int8_t rssi_dbm,
-                             uint32_t now_ms) {
-  (void)tx_power_ch_throttle;
-  (void)role_id;
-  (void)battery_est_rem_time;
+                             uint32_t now_ms,
+                             bool relayed) {
+  const uint64_t node_id = status.node_id();
+  const uint16_t seq16 = status.seq16();
   int idx = find_entry_index(node_id);
   if (idx < 0) {
     int free_idx = find_free_index();
@@ -359,7 +415,7 @@ bool NodeTable::apply_status(uint64_t node_id,
     new_entry.is_self = false;
     new_entry.in_use = true;
     new_entry.last_seen_ms = now_ms;
-    new_entry.last_rx_rssi = rssi_dbm;
+    new_entry.last_rx_rssi = relayed ? 0 : rssi_dbm;
     size_++;
     recompute_collisions();
     set_dirty();
@@ -367,6 +423,11 @@ bool NodeTable::apply_status(uint64_t node_id,
   }
 
   NodeEntry& entry = entries_[static_cast<size_t>(idx)];
+  if (relayed) {
+    rssi_dbm = entry.last_rx_rssi;  // relay's RSSI, not this node's link
+  } else {
+    note_link_rx(entry, seq16, rssi_dbm, now_ms);
+  }
   const Seq16Order order = seq16_order(seq16, entry.last_seq);
   if (order == Seq16Order::Same || order == Seq16Order::Older) {
     entry.last_seen_ms = now_ms;
@@ -375,17 +436,19 @@ bool NodeTable::apply_status(uint64_t node_id,
     return true;
   }
 
+  // battery_est_rem_time, tx_power_ch_throttle and role_id are not held.
   entry.last_seq = seq16;
   entry.has_battery = true;
-  entry.battery_percent = battery_percent;
+  entry.battery_percent = status.battery_percent();
   entry.has_uptime = true;
-  entry.uptime_sec = static_cast<uint32_t>(uptime10m) * 600u;
+  entry.uptime_sec = static_cast<uint32_t>(status.uptime10m()) * 600u;
   entry.has_max_silence = true;
-  entry.max_silence_10s = max_silence_10s;
+  entry.max_silence_10s = status.max_silence_10s();
   entry.has_hw_profile = true;
-  entry.hw_profile_id = hw_profile_id;
+  entry.hw_profile_id = status.hw_profile_id();
   entry.has_fw_version = true;
-  entry.fw_version_id = fw_version_id;
+  entry.fw_version_id = status.fw_version_id();
+  entry.radio_caps = status.radio_caps();
   entry.last_seen_ms = now_ms;
   entry.last_rx_rssi = rssi_dbm;
   set_dirty();
@@ -396,6 +459,20 @@ size_t NodeTable::size() const {
   return size_;
 }
 
+size_t NodeTable::peers_heard_within(uint32_t now_ms, uint32_t max_age_ms) const {
+  size_t count = 0;
+  for (size_t i = 0; i < kMaxNodes; ++i) {
+    const NodeEntry& entry = entries_[i];
+    if (!entry.in_use || entry.is_self) {
+      continue;
+    }
+    if (now_ms - entry.last_seen_ms <= max_age_ms) {
+      count++;
+    }
+  }
+  return count;
+}
+
 size_t NodeTable::get_page(uint32_t now_ms,
                            size_t page_index,
                            size_t page_size,
@@ -446,8 +523,11 @@ size_t NodeTable::get_page(uint32_t now_ms,
     write_u16_le(out_buffer + offset + 8, entry.short_id);
     out_buffer[offset + 10] = flags;
     write_u16_le(out_buffer + offset + 11, age_s);
-    write_u32_le(out_buffer + offset + 13, static_cast<uint32_t>(entry.pos_valid ? entry.lat_e7 : 0));
-    write_u32_le(out_buffer + offset + 17, static_cast<uint32_t>(entry.pos_valid ? entry.lon_e7 : 0));
+    int32_t lat_e7 = 0;
+    int32_t lon_e7 = 0;
+    predicted_position(entry, now_ms, &lat_e7, &lon_e7);
+    write_u32_le(out_buffer + offset + 13, static_cast<uint32_t>(entry.pos_valid ? lat_e7 : 0));
+    write_u32_le(out_buffer + offset + 17, static_cast<uint32_t>(entry.pos_valid ? lon_e7 : 0));
     write_u16_le(out_buffer + offset + 21, entry.pos_valid ? entry.pos_age_s : 0);
     out_buffer[offset + 23] = static_cast<uint8_t>(entry.last_rx_rssi);
     // #419: last_seq not in BLE per canon; offset 24 = snr_last (127 = NA), 25 = reserved.
@@ -460,6 +540,11 @@ size_t NodeTable::get_page(uint32_t now_ms,
   return offset;
 }
 
+void NodeTable::note_link_rx(NodeEntry& entry, uint16_t seq16, int8_t rssi_dbm, uint32_t now_ms) {
+  const bool first = entry.link.rx_count == 0;
+  link_stats_on_rx(entry.link, first, seq16, entry.last_seq, rssi_dbm, now_ms);
+}
+
 size_t NodeTable::get_peer_dump_line(uint32_t now_ms, size_t peer_index, char* buf, size_t cap) const {
   if (!buf || cap == 0) {
     return 0;
@@ -482,13 +567,19 @@ size_t NodeTable::get_peer_dump_line(uint32_t now_ms, size_t peer_index, char* b
   const uint32_t age_ms = now_ms >= entry.last_seen_ms ? (now_ms - entry.last_seen_ms) : 0;
   const uint16_t age_s = clamp_u16(age_ms / 1000);
   const int len = std::snprintf(buf, cap,
-                                "peer shortId=%u ageS=%u grey=%u seq=%u rssi=%d posAgeS=%u",
+                                "peer shortId=%u ageS=%u grey=%u seq=%u rssi=%d posAgeS=%u "
+                                "rssiAvg=%d pdr=%u iaMs=%lu jitMs=%lu dup=%u",
                                 static_cast<unsigned>(entry.short_id),
                                 static_cast<unsigned>(age_s),
                                 grey ? 1u : 0u,
                                 static_cast<unsigned>(entry.last_seq),
                                 static_cast<int>(entry.last_rx_rssi),
-                                static_cast<unsigned>(entry.pos_valid ? entry.pos_age_s : 0));
+                                static_cast<unsigned>(entry.pos_valid ? entry.pos_age_s : 0),
+                                static_cast<int>(link_stats_rssi_dbm(entry.link)),
+                                static_cast<unsigned>(link_stats_pdr_pct(entry.link)),
+                                static_cast<unsigned long>(entry.link.ia_mean_10ms) * 10ul,
+                                static_cast<unsigned long>(entry.link.ia_jitter_10ms) * 10ul,
+                                static_cast<unsigned>(entry.link.dup_count));
   return len > 0 && static_cast<size_t>(len) < cap ? static_cast<size_t>(len) : 0;
 }
 
@@ -551,8 +642,11 @@ size_t NodeTable::get_snapshot_page(uint16_t snapshot_id,
     write_u16_le(out_buffer + offset + 8, entry.short_id);
     out_buffer[offset + 10] = flags;
     write_u16_le(out_buffer + offset + 11, age_s);
-    write_u32_le(out_buffer + offset + 13, static_cast<uint32_t>(entry.pos_valid ? entry.lat_e7 : 0));
-    write_u32_le(out_buffer + offset + 17, static_cast<uint32_t>(entry.pos_valid ? entry.lon_e7 : 0));
+    int32_t lat_e7 = 0;
+    int32_t lon_e7 = 0;
+    predicted_position(entry, snapshot_time_ms_, &lat_e7, &lon_e7);
+    write_u32_le(out_buffer + offset + 13, static_cast<uint32_t>(entry.pos_valid ? lat_e7 : 0));
+    write_u32_le(out_buffer + offset + 17, static_cast<uint32_t>(entry.pos_valid ? lon_e7 : 0));
     write_u16_le(out_buffer + offset + 21, entry.pos_valid ? entry.pos_age_s : 0);
     out_buffer[offset + 23] = static_cast<uint8_t>(entry.last_rx_rssi);
     out_buffer[offset + 24] = static_cast<uint8_t>(entry.snr_last);
@@ -606,6 +700,30 @@ bool NodeTable::find_entry_by_node_id(uint64_t node_id, NodeEntry* out) const {
   return true;
 }
 
+bool NodeTable::resolve_short_id(uint16_t short_id, uint8_t tag, uint64_t* out_node_id) const {
+  if (!out_node_id) {
+    return false;
+  }
+  bool found = false;
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    const NodeEntry& entry = entries_[i];
+    if (!entry.in_use || entry.is_self || entry.short_id != short_id ||
+        static_cast<uint8_t>(entry.node_id & 0x7Fu) != tag) {
+      continue;
+    }
+    if (found) {
+      return false;
+    }
+    *out_node_id = entry.node_id;
+    found = true;
+  }
+  return found;
+}
+
+bool NodeTable::self_short_id_collision() const {
+  return self_index_ >= 0 && entries_[static_cast<size_t>(self_index_)].short_id_collision;
+}
+
 void NodeTable::for_each_used_entry(std::function<void(const NodeEntry&)> fn) const {
   for (size_t i = 0; i < entries_.size(); ++i) {
     if (entries_[i].in_use) {
@@ -723,8 +841,13 @@ bool NodeTable::is_grey(const NodeEntry& entry, uint32_t now_ms) const {
   }
   const uint32_t age_ms = now_ms >= entry.last_seen_ms ? (now_ms - entry.last_seen_ms) : 0;
   const uint32_t age_s = age_ms / 1000;
-  const uint32_t threshold_s =
-      static_cast<uint32_t>(expected_interval_s_) + static_cast<uint32_t>(grace_s_);
+  // A peer advertising a longer maxSilence (Node_Status) may legitimately stay quiet that long.
+  const uint16_t peer_silence_s = entry.has_max_silence
+      ? static_cast<uint16_t>(entry.max_silence_10s * 10u)
+      : 0;
+  const uint32_t threshold_s = peer_silence_s > expected_interval_s_
+      ? static_cast<uint32_t>(peer_silence_s) + compute_grace_s(peer_silence_s)
+      : static_cast<uint32_t>(expected_interval_s_) + static_cast<uint32_t>(grace_s_);
   return age_s > threshold_s;
 }
 
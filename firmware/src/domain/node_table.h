@@ -5,7 +5,15 @@
 #include <cstdint>
 #include <functional>
 
+#include "domain/link_stats.h"
+#include "../../protocol/pos_predict.h"
+
 namespace naviga {
+namespace protocol {
+class PosFullView;
+class StatusView;
+} // namespace protocol
+
 namespace domain {
 
 /** Max length for canonical node_name (self + remote); single field per product truth. Struct/persistence size. */
@@ -42,9 +50,18 @@ struct NodeEntry {
   bool in_use = false;
 
   // ─── Runtime-local decoder state only (NOT canonical product truth; NOT in BLE; NOT persisted) ─
-  // last_core_seq16 set by apply_pos_full (v0.2); used for seq tracking only (#438: no Tail).
+  // last_core_seq16 set by apply_pos_full / apply_pos_delta (v0.2): seq16 of the position held;
+  // seq tracking (#438: no Tail) and the Node_Pos_Delta reference check.
   uint16_t last_core_seq16 = 0;
   bool     has_core_seq16  = false;
+  // seq16 of the last Node_Pos_Full applied: the run a Node_Pos_Delta must belong to (ref_seq8).
+  uint16_t pos_full_seq16 = 0;
+  bool     has_pos_full_seq16 = false;
+  // Dead reckoning: Pos_Velocity sent with the position held, and when that position arrived.
+  bool     has_velocity = false;
+  protocol::PosVelocity velocity{};
+  uint32_t pos_rx_ms = 0;
+  PeerLinkStats link{};  ///< Per-peer link quality (RSSI EWMA, PDR, inter-arrival, dups); every RX path.
 
   // ─── Battery / survivability ──────────────────────────────────────────────
   bool     has_battery       = false;
@@ -59,6 +76,7 @@ struct NodeEntry {
   uint16_t hw_profile_id     = 0xFFFF;  ///< 0xFFFF = not present.
   bool     has_fw_version    = false;
   uint16_t fw_version_id     = 0xFFFF;  ///< 0xFFFF = not present.
+  uint8_t  radio_caps        = 0;       ///< Status radioCaps (PresetSelector); 0 = not advertised. Runtime-local.
 };
 
 class NodeTable {
@@ -66,6 +84,11 @@ class NodeTable {
   static constexpr size_t kMaxNodes = 100;
   static constexpr size_t kRecordBytes = 26;
   static constexpr size_t kDefaultPageSize = 10;
+  /**
+   * Node_Pos_Delta: max seq16 distance from the run's Node_Pos_Full to a delta applied on top of
+   * it. Well below 256, so the delta's 8-bit ref_seq8 names that Pos_Full unambiguously.
+   */
+  static constexpr uint16_t kPosDeltaMaxSeqGap = 32;
 
   static uint16_t compute_short_id(uint64_t node_id);
 
@@ -88,29 +111,54 @@ class NodeTable {
                      uint32_t now_ms);
 
   /**
-   * Apply Node_Pos_Full v0.2 (#435): position + Pos_Quality in one step.
-   * Sets last_core_seq16 := seq16; no Tail ref. Single-packet apply.
+   * Apply Node_Pos_Full v0.2 (#435): position + Pos_Quality in one step, read from a checked
+   * view (pos.ok()) of the received payload. Sets last_core_seq16 := seq16; no Tail ref.
+   * A duplicate or older seq16 only refreshes liveness: lat/lon and quality are not read.
+   * relayed: copy via a mesh relay (protocol::frame_hops > 0); link stats and last_rx_rssi
+   * describe the direct link, so they are left alone.
    */
-  bool apply_pos_full(uint64_t node_id,
-                      uint16_t seq16,
-                      int32_t lat_e7, int32_t lon_e7,
-                      uint8_t fix_type, uint8_t pos_sats,
-                      uint8_t pos_accuracy_bucket, uint8_t pos_flags_small,
+  bool apply_pos_full(const protocol::PosFullView& pos,
                       int8_t rssi_dbm,
-                      uint32_t now_ms);
+                      uint32_t now_ms,
+                      bool relayed = false);
+
+  /**
+   * Apply Node_Pos_Delta: position already resolved by the caller against this entry's lat/lon.
+   * Reference check: applies only if the entry holds the delta's run, i.e. its last applied
+   * Node_Pos_Full has the low byte ref_seq8 and is at most kPosDeltaMaxSeqGap older than seq16.
+   * The position held is then that Pos_Full or a delta of the same run, which the sender keeps
+   * within resolving range. Sets last_core_seq16 := seq16; Pos_Quality is kept. Without a
+   * usable reference the node is still marked heard but the position is not touched and false
+   * is returned. relayed as for apply_pos_full.
+   */
+  bool apply_pos_delta(uint64_t node_id,
+                       uint16_t seq16,
+                       uint8_t ref_seq8,
+                       int32_t lat_e7, int32_t lon_e7,
+                       int8_t rssi_dbm,
+                       uint32_t now_ms,
+                       bool relayed = false,
+                       const protocol::PosVelocity* velocity = nullptr);
+
+  /**
+   * Position of entry at now_ms: extrapolated along its Pos_Velocity from when the position
+   * arrived (at most protocol::kPosPredictMaxMs), else lat/lon as held. What the node is shown
+   * at (snapshot pages, BLE); lat_e7/lon_e7 stay the received position (Pos_Delta reference).
+   * @return true if extrapolated.
+   */
+  static bool predicted_position(const NodeEntry& entry, uint32_t now_ms,
+                                 int32_t* out_lat_e7, int32_t* out_lon_e7);
 
   /**
-   * Apply Node_Status v0.2 (#435): full status snapshot (operational + informative).
-   * Does not update position. Single-packet apply.
+   * Apply Node_Status v0.2 (#435): full status snapshot (operational + informative), including
+   * radioCaps, from a checked view (status.ok()). Does not update position. Single-packet
+   * apply; a duplicate or older seq16 is rejected before the status fields are read. relayed
+   * as for apply_pos_full.
    */
-  bool apply_status(uint64_t node_id,
-                    uint16_t seq16,
-                    uint8_t battery_percent, uint8_t battery_est_rem_time,
-                    uint8_t tx_power_ch_throttle, uint8_t uptime10m,
-                    uint8_t role_id, uint8_t max_silence_10s,
-                    uint16_t hw_profile_id, uint16_t fw_version_id,
+  bool apply_status(const protocol::StatusView& status,
                     int8_t rssi_dbm,
-                    uint32_t now_ms);
+                    uint32_t now_ms,
+                    bool relayed = false);
 
 #if defined(NAVIGA_TEST)
   /** Test-only: copy the NodeEntry for node_id into *out. Returns false if not found.
@@ -119,6 +167,8 @@ class NodeTable {
 #endif
 
   size_t size() const;
+  /** Remote peers heard within max_age_ms of now_ms (self excluded). Channel-load input. */
+  size_t peers_heard_within(uint32_t now_ms, uint32_t max_age_ms) const;
 
   size_t get_page(uint32_t now_ms,
                   size_t page_index,
@@ -146,6 +196,13 @@ class NodeTable {
                                   size_t max_count) const;
   /** Copy entry for node_id into *out. Returns true if found. For BLE targeted read. */
   bool find_entry_by_node_id(uint64_t node_id, NodeEntry* out) const;
+  /**
+   * Short-addressed frames: node_id of the remote entry with this short_id whose low 7 bits equal
+   * tag. Returns false if there is none, or more than one (sender must be heard with full id).
+   */
+  bool resolve_short_id(uint16_t short_id, uint8_t tag, uint64_t* out_node_id) const;
+  /** True if self's short_id equals a peer's in this table (send full id meanwhile). */
+  bool self_short_id_collision() const;
   /** Whether entry is stale at snapshot_time_ms. For BLE export is_stale. */
   bool is_stale(const NodeEntry& entry, uint32_t snapshot_time_ms) const { return is_grey(entry, snapshot_time_ms); }
 
@@ -177,6 +234,8 @@ class NodeTable {
   bool evict_oldest_grey(uint32_t now_ms);
   void recompute_collisions();
   bool is_grey(const NodeEntry& entry, uint32_t now_ms) const;
+  /** Update entry.link for one received frame; call before last_seq is advanced. */
+  static void note_link_rx(NodeEntry& entry, uint16_t seq16, int8_t rssi_dbm, uint32_t now_ms);
   static uint16_t compute_grace_s(uint16_t expected_interval_s);
   size_t build_ordered_indices(std::array<size_t, kMaxNodes>& out_indices) const;
 };
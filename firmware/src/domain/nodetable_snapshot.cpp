@@ -119,6 +119,7 @@ void unpack_record(const uint8_t* in, NodeEntry* e, size_t record_bytes) {
   e->last_seq = 0;
   e->last_core_seq16 = 0;
   e->has_core_seq16 = false;
+  e->has_pos_full_seq16 = false;
   e->in_use = true;
 }
 
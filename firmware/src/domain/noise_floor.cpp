@@ -0,0 +1,53 @@
+#include "domain/noise_floor.h"
+
+namespace naviga {
+namespace domain {
+
+constexpr int16_t NoiseFloor::kBusyMarginDb;
+constexpr uint8_t NoiseFloor::kMaxBusyRun;
+
+namespace {
+
+constexpr int32_t kDownShift = 1;  // 1/2 toward a quieter IDLE sample.
+constexpr int32_t kUpShift = 4;    // 1/16 toward a louder IDLE sample.
+constexpr int32_t kBusyShift = 2;  // 1/4 toward the sample after kMaxBusyRun BUSY samples.
+
+int32_t step_toward(int32_t from, int32_t to, int32_t shift) {
+  const int32_t diff = to - from;
+  const int32_t step = diff / (1 << shift);
+  if (step != 0) {
+    return from + step;
+  }
+  return diff > 0 ? from + 1 : (diff < 0 ? from - 1 : from);
+}
+
+} // namespace
+
+void NoiseFloor::reset() {
+  floor_x16_ = 0;
+  has_floor_ = false;
+  busy_run_ = 0;
+}
+
+ChannelSenseState NoiseFloor::classify(int16_t noise_dbm) {
+  const int32_t sample_x16 = static_cast<int32_t>(noise_dbm) * 16;
+  if (!has_floor_) {
+    floor_x16_ = sample_x16;
+    has_floor_ = true;
+    busy_run_ = 0;
+    return ChannelSenseState::IDLE;
+  }
+  if (sample_x16 <= floor_x16_ + static_cast<int32_t>(kBusyMarginDb) * 16) {
+    floor_x16_ = step_toward(floor_x16_, sample_x16, sample_x16 < floor_x16_ ? kDownShift : kUpShift);
+    busy_run_ = 0;
+    return ChannelSenseState::IDLE;
+  }
+  if (++busy_run_ >= kMaxBusyRun) {
+    floor_x16_ = step_toward(floor_x16_, sample_x16, kBusyShift);
+    busy_run_ = 0;
+  }
+  return ChannelSenseState::BUSY;
+}
+
+} // namespace domain
+} // namespace naviga
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+#include "naviga/hal/interfaces.h"
+
+namespace naviga {
+namespace domain {
+
+/**
+ * Adaptive noise floor for listen-before-talk on ambient-RSSI samples.
+ *
+ * A sample more than kBusyMarginDb above the floor is BUSY. IDLE samples pull the floor
+ * toward them: quickly down (the quietest reading is the best floor estimate), slowly up
+ * (a frame that starts just after an IDLE reading must not drag the floor with it).
+ * After kMaxBusyRun BUSY samples in a row the floor steps a quarter of the way up: a
+ * persistent carrier (local interference, desensing nearby transmitter) becomes the new
+ * floor instead of holding TX off forever.
+ *
+ * The first sample becomes the floor and is IDLE. Fixed point, dBm x 16.
+ */
+class NoiseFloor {
+ public:
+  static constexpr int16_t kBusyMarginDb = 6;
+  static constexpr uint8_t kMaxBusyRun = 8;
+
+  void reset();
+  /** Classify a sample (IDLE / BUSY) and fold it into the floor. */
+  ChannelSenseState classify(int16_t noise_dbm);
+
+  bool has_floor() const { return has_floor_; }
+  int16_t floor_dbm() const { return static_cast<int16_t>(floor_x16_ / 16); }
+
+ private:
+  int32_t floor_x16_ = 0;
+  bool has_floor_ = false;
+  uint8_t busy_run_ = 0;
+};
+
+} // namespace domain
+} // namespace naviga
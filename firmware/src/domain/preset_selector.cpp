@@ -0,0 +1,184 @@
+#include "domain/preset_selector.h"
+
+#include "domain/airtime_model.h"
+#include "../../protocol/status_codec.h"
+
+namespace naviga {
+namespace domain {
+
+constexpr int8_t PresetSelector::kUpRssiDbm;
+constexpr int8_t PresetSelector::kDownRssiDbm;
+constexpr uint8_t PresetSelector::kUpPdrPct;
+constexpr uint8_t PresetSelector::kDownPdrPct;
+constexpr uint32_t PresetSelector::kPeerWindowMs;
+constexpr uint32_t PresetSelector::kUpHoldMs;
+constexpr uint32_t PresetSelector::kAgreeHoldMs;
+constexpr uint32_t PresetSelector::kConfirmMs;
+constexpr uint32_t PresetSelector::kMaxFastDwellMs;
+constexpr uint32_t PresetSelector::kBackoffMinMs;
+constexpr uint32_t PresetSelector::kBackoffMaxMs;
+constexpr uint32_t PresetSelector::kPaybackFactor;
+
+namespace {
+
+constexpr uint8_t preset_bit(RadioPresetId preset) {
+  return static_cast<uint8_t>(preset);
+}
+
+} // namespace
+
+void PresetSelector::configure(uint8_t supported_mask, size_t beacon_frame_len,
+                               uint32_t beacon_interval_ms) {
+  *this = PresetSelector{};
+  enabled_ = true;
+  supported_mask_ = static_cast<uint8_t>((supported_mask & protocol::kRadioCapsPresetMask) | 0x01);
+  frame_len_ = beacon_frame_len;
+  interval_ms_ = beacon_interval_ms;
+}
+
+void PresetSelector::disable() {
+  *this = PresetSelector{};
+}
+
+uint8_t PresetSelector::radio_caps() const {
+  if (!enabled_) {
+    return 0;
+  }
+  return protocol::radio_caps_make(supported_mask_, preset_bit(active_), wants_fast_);
+}
+
+bool PresetSelector::supports(RadioPresetId preset) const {
+  return protocol::radio_caps_supports(supported_mask_, preset_bit(preset));
+}
+
+void PresetSelector::reset_votes() {
+  wants_fast_ = false;
+  up_held_ = false;
+  agree_held_ = false;
+}
+
+void PresetSelector::add_peer(uint32_t now_ms, const PresetPeerView& peer,
+                              PresetPeerSummary* summary) const {
+  if (!summary || now_ms - peer.last_rx_ms > kPeerWindowMs) {
+    return;
+  }
+  summary->peers++;
+  if (protocol::radio_caps_supports(peer.radio_caps, preset_bit(RadioPresetId::Fast))) {
+    summary->fast_capable++;
+  }
+  if (protocol::radio_caps_wants_fast(peer.radio_caps)) {
+    summary->fast_voters++;
+  }
+  if (peer.rssi_dbm >= kUpRssiDbm && peer.pdr_pct >= kUpPdrPct) {
+    summary->links_up++;
+  }
+  if (peer.rssi_dbm < kDownRssiDbm || peer.pdr_pct < kDownPdrPct) {
+    summary->links_down++;
+  }
+  if (active_ == RadioPresetId::Fast &&
+      static_cast<int32_t>(peer.last_rx_ms - switched_ms_) >= 0) {
+    summary->heard_on_fast++;
+  }
+}
+
+RadioPresetId PresetSelector::update(uint32_t now_ms, const PresetPeerSummary& summary) {
+  if (!enabled_) {
+    return active_;
+  }
+
+  if (active_ == RadioPresetId::Fast) {
+    const bool confirmed = now_ms - switched_ms_ < kConfirmMs ||
+                           summary.heard_on_fast >= peers_at_switch_;
+    if (summary.links_down > 0 || !confirmed) {
+      pending_ = RadioPresetId::Default;
+      pending_failure_ = true;
+    } else if (now_ms - switched_ms_ >= kMaxFastDwellMs) {
+      pending_ = RadioPresetId::Default;
+      pending_failure_ = false;
+    } else {
+      pending_ = RadioPresetId::Fast;
+    }
+    return pending_;
+  }
+
+  if (backing_off_ && static_cast<int32_t>(now_ms - backoff_until_ms_) >= 0) {
+    backing_off_ = false;
+  }
+  const bool links_allow = summary.peers > 0 && supports(RadioPresetId::Fast) && !backing_off_ &&
+                           summary.fast_capable == summary.peers &&
+                           summary.links_up == summary.peers &&
+                           switch_pays_off(get_radio_preset(RadioPresetId::Default).air_rate,
+                                           get_radio_preset(RadioPresetId::Fast).air_rate,
+                                           frame_len_, interval_ms_);
+  if (!links_allow) {
+    reset_votes();
+    pending_ = RadioPresetId::Default;
+    return pending_;
+  }
+  if (!up_held_) {
+    up_held_ = true;
+    up_since_ms_ = now_ms;
+  }
+  wants_fast_ = now_ms - up_since_ms_ >= kUpHoldMs;
+  if (!wants_fast_ || summary.fast_voters < summary.peers) {
+    agree_held_ = false;
+    pending_ = RadioPresetId::Default;
+    return pending_;
+  }
+  if (!agree_held_) {
+    agree_held_ = true;
+    agree_since_ms_ = now_ms;
+  }
+  if (now_ms - agree_since_ms_ >= kAgreeHoldMs) {
+    pending_ = RadioPresetId::Fast;
+    peers_at_switch_ = summary.peers;
+  } else {
+    pending_ = RadioPresetId::Default;
+  }
+  return pending_;
+}
+
+void PresetSelector::on_applied(uint32_t now_ms, bool ok) {
+  if (!enabled_ || pending_ == active_) {
+    return;
+  }
+  if (pending_ == RadioPresetId::Fast) {
+    reset_votes();
+    if (ok) {
+      active_ = RadioPresetId::Fast;
+      switched_ms_ = now_ms;
+      return;
+    }
+    pending_failure_ = true;  // radio refused: back off as after a failed attempt
+  } else if (!ok) {
+    return;  // still on Fast; update() asks again
+  } else {
+    active_ = RadioPresetId::Default;
+    switched_ms_ = now_ms;
+  }
+  pending_ = RadioPresetId::Default;
+  if (pending_failure_) {
+    backing_off_ = true;
+    backoff_until_ms_ = now_ms + backoff_ms_;
+    backoff_ms_ = backoff_ms_ >= kBackoffMaxMs / 2 ? kBackoffMaxMs : backoff_ms_ * 2;
+  } else {
+    backoff_ms_ = kBackoffMinMs;
+  }
+  pending_failure_ = false;
+}
+
+bool PresetSelector::switch_pays_off(uint8_t from_air_rate, uint8_t to_air_rate,
+                                     size_t frame_len, uint32_t interval_ms) {
+  const uint32_t from_us = e220_airtime_us(from_air_rate, frame_len);
+  const uint32_t to_us = e220_airtime_us(to_air_rate, frame_len);
+  if (interval_ms == 0 || to_us >= from_us) {
+    return false;
+  }
+  const uint64_t frames = kMaxFastDwellMs / interval_ms;
+  const uint64_t saved_us = frames * (from_us - to_us);
+  const uint64_t cost_us = 2ull * kPaybackFactor * e220_reconfig_blind_ms() * 1000ull;
+  return saved_us >= cost_us;
+}
+
+} // namespace domain
+} // namespace naviga
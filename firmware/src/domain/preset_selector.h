@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "naviga/hal/radio_preset.h"
+
+namespace naviga {
+namespace domain {
+
+/** One peer as PresetSelector sees it: direct link stats plus its Status radioCaps. */
+struct PresetPeerView {
+  int8_t rssi_dbm = 0;      ///< Link RSSI EWMA.
+  uint8_t pdr_pct = 100;    ///< Link delivery ratio.
+  uint8_t radio_caps = 0;   ///< protocol radioCaps from the peer's Status; 0 = not advertised.
+  uint32_t last_rx_ms = 0;  ///< Last direct frame from the peer.
+};
+
+/** Peers counted by PresetSelector::add_peer for one update(). */
+struct PresetPeerSummary {
+  uint16_t peers = 0;          ///< Direct peers heard within kPeerWindowMs.
+  uint16_t fast_capable = 0;   ///< Advertise Fast among their presets.
+  uint16_t fast_voters = 0;    ///< Advertise a vote for Fast.
+  uint16_t links_up = 0;       ///< RSSI and PDR at or above the move-up thresholds.
+  uint16_t links_down = 0;     ///< RSSI or PDR below the fall-back thresholds.
+  uint16_t heard_on_fast = 0;  ///< Heard since the switch to Fast (0 while on Default).
+};
+
+/**
+ * Link-adaptive radio preset: a group of nodes moves from Default (2.4 kbps) to Fast
+ * (4.8 kbps, half the airtime) when every direct link allows it, and back when one does not.
+ * Nodes on different air rates cannot hear each other, so the move is coordinated through the
+ * radioCaps byte of Node_Status (presets supported, active preset, vote for Fast):
+ *
+ *  1. On Default, a node votes for Fast once, for kUpHoldMs in a row, it has at least one
+ *     direct peer, every direct peer advertises Fast, every link is at or above kUpRssiDbm and
+ *     kUpPdrPct, it is not backing off, and switch_pays_off() holds.
+ *  2. It switches when it votes and every direct peer has voted for kAgreeHoldMs.
+ *  3. On Fast it falls back to Default when any link drops below kDownRssiDbm or kDownPdrPct
+ *     (hysteresis), or when fewer peers than before the switch are heard on Fast kConfirmMs
+ *     after it (a peer did not follow, or went away). A fallback doubles a backoff
+ *     (kBackoffMinMs .. kBackoffMaxMs) before the next vote.
+ *  4. After kMaxFastDwellMs on Fast it returns to Default without backoff, so nodes that
+ *     joined on Default (and cannot be heard on Fast) are found and the group re-votes.
+ *
+ * A node that falls back goes silent on Fast, so its peers fall back at their next check.
+ * Peers whose Status carries no radioCaps (older firmware) are not Fast-capable and keep the
+ * group on Default. Pure logic: the caller reads the NodeTable, applies the returned preset to
+ * the radio and reports the result with on_applied().
+ */
+class PresetSelector {
+ public:
+  static constexpr int8_t kUpRssiDbm = -100;
+  static constexpr int8_t kDownRssiDbm = -108;
+  static constexpr uint8_t kUpPdrPct = 90;
+  static constexpr uint8_t kDownPdrPct = 70;
+  static constexpr uint32_t kPeerWindowMs = 180000;
+  static constexpr uint32_t kUpHoldMs = 120000;
+  static constexpr uint32_t kAgreeHoldMs = 60000;
+  static constexpr uint32_t kConfirmMs = 120000;
+  static constexpr uint32_t kMaxFastDwellMs = 1800000;  ///< 30 min.
+  static constexpr uint32_t kBackoffMinMs = 300000;
+  static constexpr uint32_t kBackoffMaxMs = 3600000;
+  static constexpr uint32_t kPaybackFactor = 4;
+
+  /**
+   * Enable with the presets this radio can switch to (bit n = RadioPresetId n) and the own
+   * beacon (frame length, interval) used by switch_pays_off(). Starts on Default.
+   */
+  void configure(uint8_t supported_mask, size_t beacon_frame_len, uint32_t beacon_interval_ms);
+  void disable();
+  bool enabled() const { return enabled_; }
+
+  RadioPresetId active() const { return active_; }
+  /** radioCaps for own Node_Status; 0 (not advertised) when disabled. */
+  uint8_t radio_caps() const;
+
+  /** Count one peer (skipped if not heard within kPeerWindowMs of now_ms). */
+  void add_peer(uint32_t now_ms, const PresetPeerView& peer, PresetPeerSummary* summary) const;
+
+  /** Re-evaluate; returns the preset the radio should be on (active() if no change). */
+  RadioPresetId update(uint32_t now_ms, const PresetPeerSummary& summary);
+
+  /** The radio was (ok) or could not be moved to the preset update() last returned. */
+  void on_applied(uint32_t now_ms, bool ok);
+
+  /**
+   * Whether moving between two air rates pays for itself: own airtime saved over
+   * kMaxFastDwellMs of beacons (frame_len every interval_ms) must be at least kPaybackFactor
+   * times the blind time of switching there and back (e220_reconfig_blind_ms each way).
+   */
+  static bool switch_pays_off(uint8_t from_air_rate, uint8_t to_air_rate, size_t frame_len,
+                              uint32_t interval_ms);
+
+ private:
+  bool supports(RadioPresetId preset) const;
+  void reset_votes();
+
+  bool enabled_ = false;
+  uint8_t supported_mask_ = 0x01;
+  size_t frame_len_ = 0;
+  uint32_t interval_ms_ = 0;
+  RadioPresetId active_ = RadioPresetId::Default;
+  RadioPresetId pending_ = RadioPresetId::Default;
+  bool pending_failure_ = false;  ///< The pending fallback is a failure (backs off).
+
+  bool wants_fast_ = false;
+  bool up_held_ = false;
+  uint32_t up_since_ms_ = 0;
+  bool agree_held_ = false;
+  uint32_t agree_since_ms_ = 0;
+
+  uint32_t switched_ms_ = 0;
+  uint16_t peers_at_switch_ = 0;
+  uint32_t backoff_ms_ = kBackoffMinMs;
+  bool backing_off_ = false;
+  uint32_t backoff_until_ms_ = 0;
+};
+
+} // namespace domain
+} // namespace naviga
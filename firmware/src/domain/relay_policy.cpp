@@ -0,0 +1,110 @@
+#include "domain/relay_policy.h"
+
+#include "../../protocol/bundle_codec.h"
+#include "../../protocol/packet_header.h"
+
+namespace naviga {
+namespace domain {
+
+constexpr size_t RelayPolicy::kDupCacheSize;
+constexpr uint8_t RelayPolicy::kDefaultMaxHops;
+constexpr uint8_t RelayPolicy::kDefaultRebroadcastPct;
+constexpr uint16_t RelayPolicy::kDefaultDutyPermille;
+
+void RelayPolicy::configure(uint64_t self_id, uint8_t max_hops, uint8_t rebroadcast_pct,
+                            uint16_t duty_permille) {
+  self_id_ = self_id;
+  max_hops_ = max_hops > protocol::kMaxRelayHops ? protocol::kMaxRelayHops : max_hops;
+  rebroadcast_pct_ = rebroadcast_pct > 100 ? 100 : rebroadcast_pct;
+  const uint32_t seed = static_cast<uint32_t>(self_id) ^ static_cast<uint32_t>(self_id >> 32);
+  rng_ = seed == 0 ? 0x9E3779B9u : seed;
+  cache_next_ = 0;
+  cache_used_ = 0;
+  budget_.configure(AirtimeBudget::kDefaultWindowMs, duty_permille);
+}
+
+bool RelayPolicy::frame_key(const uint8_t* frame, size_t len, uint64_t* out_node_id,
+                            uint32_t* out_key) {
+  protocol::PacketHeader hdr;
+  if (!frame || !protocol::decode_header(frame, len, &hdr) ||
+      !protocol::validate_header(hdr, len - protocol::kHeaderSize)) {
+    return false;
+  }
+  // seq16 follows payloadVersion + nodeId48; in a bundle, the first sub-record's header too.
+  size_t seq_off = protocol::kBundlePrefixSize;
+  if (hdr.msg_type == protocol::MsgType::BeaconBundle) {
+    seq_off += protocol::kBundleSubHeaderSize;
+  } else if (hdr.msg_type != protocol::MsgType::BeaconPosFull &&
+             hdr.msg_type != protocol::MsgType::BeaconPosDelta &&
+             hdr.msg_type != protocol::MsgType::BeaconStatus) {
+    return false;
+  }
+  const uint8_t* payload = frame + protocol::kHeaderSize;
+  if (hdr.payload_len < seq_off + 2 || payload[0] != protocol::kBundlePayloadVersion) {
+    return false;  // too short, or short-addressed (expand before offering)
+  }
+  const uint64_t node_id = protocol::wire::read_nodeid48_le(payload + 1);
+  const uint16_t seq16 = protocol::wire::read_u16_le(payload + seq_off);
+  // 64-bit mix (murmur3 finaliser) folded to 32 bits.
+  uint64_t x = node_id * 0x9E3779B97F4A7C15ull +
+               ((static_cast<uint64_t>(hdr.msg_type) << 16) | seq16);
+  x ^= x >> 33;
+  x *= 0xFF51AFD7ED558CCDull;
+  x ^= x >> 33;
+  if (out_node_id) { *out_node_id = node_id; }
+  if (out_key) { *out_key = static_cast<uint32_t>(x) ^ static_cast<uint32_t>(x >> 32); }
+  return true;
+}
+
+RelayDecision RelayPolicy::offer(uint32_t now_ms, const uint8_t* frame, size_t len,
+                                 uint32_t airtime_us, uint32_t* out_key) {
+  if (out_key) { *out_key = 0; }
+  uint64_t node_id = 0;
+  uint32_t key = 0;
+  if (!frame_key(frame, len, &node_id, &key) || node_id == self_id_) {
+    return RelayDecision::NOT_RELAYABLE;
+  }
+  if (out_key) { *out_key = key; }
+  if (seen(key)) {
+    return RelayDecision::DUPLICATE;
+  }
+  remember(key);
+  if (!enabled() || protocol::frame_hops(frame) >= max_hops_) {
+    return RelayDecision::HOP_LIMIT;
+  }
+  if (rebroadcast_pct_ < 100 && next_random() % 100u >= rebroadcast_pct_) {
+    return RelayDecision::SKIPPED;
+  }
+  if (!budget_.fits(now_ms, airtime_us, 100)) {
+    return RelayDecision::OVER_BUDGET;
+  }
+  return RelayDecision::RELAY;
+}
+
+bool RelayPolicy::seen(uint32_t key) const {
+  for (size_t i = 0; i < cache_used_; ++i) {
+    if (cache_[i] == key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void RelayPolicy::remember(uint32_t key) {
+  cache_[cache_next_] = key;
+  cache_next_ = static_cast<uint8_t>((cache_next_ + 1u) % kDupCacheSize);
+  if (cache_used_ < kDupCacheSize) {
+    cache_used_++;
+  }
+}
+
+uint32_t RelayPolicy::next_random() {
+  // xorshift32
+  rng_ ^= rng_ << 13;
+  rng_ ^= rng_ >> 17;
+  rng_ ^= rng_ << 5;
+  return rng_;
+}
+
+} // namespace domain
+} // namespace naviga
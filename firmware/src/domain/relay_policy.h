@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "domain/airtime_budget.h"
+
+namespace naviga {
+namespace domain {
+
+/** Outcome of RelayPolicy::offer for one received frame. */
+enum class RelayDecision : uint8_t {
+  RELAY,          ///< Queue a copy with hops + 1.
+  NOT_RELAYABLE,  ///< Not a full-id Pos_Full / Pos_Delta / Status / Bundle, or our own frame.
+  DUPLICATE,      ///< Copy of a frame already seen (directly or via another relay).
+  HOP_LIMIT,      ///< Already relayed max_hops times.
+  SKIPPED,        ///< Not drawn by the rebroadcast probability.
+  OVER_BUDGET,    ///< Relay airtime cap reached.
+};
+
+/**
+ * Bounded-flood relay of other nodes' Node_Pos_Full / Node_Pos_Delta / Node_Status (opt-in, e.g.
+ * Infra role). A Pos_Delta is relayed as received: receivers resolve it against the last
+ * position they hold, direct or relayed, like the original.
+ *
+ * A relayed copy is the originator's frame, byte for byte, with the header hop count
+ * (protocol::frame_hops, reserved bits) incremented. Every frame offered is fingerprinted by
+ * (node_id, msg_type, seq16) into a FIFO cache of the last kDupCacheSize fingerprints, so a
+ * node relays a frame at most once however many copies it hears. A new frame is relayed if it
+ * has been relayed fewer than max_hops times, wins the rebroadcast draw (pct), and fits the
+ * relay's own airtime budget (duty_permille over AirtimeBudget's window, on top of the node's
+ * own TX budget). Fingerprints are 32-bit: a false duplicate (one missed relay) is possible
+ * but rare at 64 entries.
+ */
+class RelayPolicy {
+ public:
+  static constexpr size_t kDupCacheSize = 64;
+  static constexpr uint8_t kDefaultMaxHops = 2;
+  static constexpr uint8_t kDefaultRebroadcastPct = 100;
+  static constexpr uint16_t kDefaultDutyPermille = 5;  ///< 0.5 %.
+
+  /** Enable relaying for self_id and reset the cache and relay budget. max_hops 0 = off. */
+  void configure(uint64_t self_id, uint8_t max_hops, uint8_t rebroadcast_pct,
+                 uint16_t duty_permille);
+  void disable() { max_hops_ = 0; }
+  bool enabled() const { return max_hops_ > 0; }
+
+  /**
+   * Decide whether to relay one received full-id frame (header + payload) of airtime_us.
+   * Relayable frames are remembered in the duplicate cache whatever the outcome.
+   * *out_key (optional) is the frame's fingerprint, 0 if NOT_RELAYABLE.
+   */
+  RelayDecision offer(uint32_t now_ms, const uint8_t* frame, size_t len, uint32_t airtime_us,
+                      uint32_t* out_key = nullptr);
+
+  /** A relayed copy of airtime_us left the queue: charge the relay budget. */
+  void on_relayed(uint32_t now_ms, uint32_t airtime_us) { budget_.record_tx(now_ms, airtime_us); }
+
+  /** Fingerprint of a relayable frame; false for other frames. */
+  static bool frame_key(const uint8_t* frame, size_t len, uint64_t* out_node_id,
+                        uint32_t* out_key);
+
+ private:
+  bool seen(uint32_t key) const;
+  void remember(uint32_t key);
+  uint32_t next_random();
+
+  uint32_t cache_[kDupCacheSize] = {};
+  uint8_t cache_next_ = 0;
+  uint8_t cache_used_ = 0;
+  uint64_t self_id_ = 0;
+  uint8_t max_hops_ = 0;
+  uint8_t rebroadcast_pct_ = kDefaultRebroadcastPct;
+  uint32_t rng_ = 0x9E3779B9u;
+  AirtimeBudget budget_{};
+};
+
+} // namespace domain
+} // namespace naviga
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+namespace naviga {
+namespace domain {
+
+/** RX semantics v0: seq16 ordering with wrap. Per rx_semantics_v0 §1. */
+enum class Seq16Order { Same, Newer, Older };
+
+inline Seq16Order seq16_order(uint16_t incoming, uint16_t last) {
+  const uint16_t delta = static_cast<uint16_t>(incoming - last);
+  if (delta == 0) {
+    return Seq16Order::Same;
+  }
+  /* Forward in ring (0..32767) = newer; backward (32768..65535) = older. */
+  return (delta <= 32767u) ? Seq16Order::Newer : Seq16Order::Older;
+}
+
+} // namespace domain
+} // namespace naviga
@@ -15,13 +15,27 @@ struct TrafficCounters {
   uint32_t tx_enqueue_pos_full = 0;
   uint32_t tx_enqueue_alive    = 0;
   uint32_t tx_enqueue_status   = 0;
+  uint32_t tx_enqueue_pos_delta = 0;
   uint32_t tx_slot_replaced    = 0;  ///< Enqueue replaced an existing slot (coalesce).
   uint32_t tx_starved          = 0;  ///< Dequeue chose one slot; others got starvation increment.
+  uint32_t tx_deferred_budget  = 0;  ///< Slot held back by the airtime budget (once per episode).
+  uint32_t tx_airtime_ms       = 0;  ///< Estimated own airtime of dequeued frames (budgeted dequeue).
+  uint32_t tx_bundles          = 0;  ///< Node_Bundle frames dequeued.
+  uint32_t tx_bundled_subs     = 0;  ///< Sub-messages carried in those bundles.
+  uint32_t tx_airtime_saved_ms = 0;  ///< Separate-frame airtime minus bundle airtime (estimate).
+  uint32_t tx_short_addr       = 0;  ///< Frames dequeued short-addressed (4 B saved each).
+  uint32_t tx_enqueue_relay    = 0;  ///< Mesh relay copies queued (RelayPolicy said RELAY).
+  uint32_t tx_relay_cancelled  = 0;  ///< Queued relay copy dropped: another relay's copy heard first.
+  uint32_t tx_fec              = 0;  ///< Frames dequeued in a Node_Fec envelope.
+  uint32_t tx_status_suppressed = 0;  ///< Unchanged Status not sent (once per min_status_interval).
+  uint32_t tx_status_airtime_saved_ms = 0;  ///< Airtime those would have taken (estimate).
 
   // TX outcome (M1Runtime: after send attempt). AGGREGATE: this node's totals by type.
   uint32_t tx_sent_pos_full = 0;
   uint32_t tx_sent_alive    = 0;
   uint32_t tx_sent_status   = 0;
+  uint32_t tx_sent_pos_delta = 0;
+  uint32_t tx_sent_relay    = 0;
   uint32_t tx_drop_channel_busy = 0;
   uint32_t tx_drop_send_fail   = 0;
 
@@ -30,7 +44,19 @@ struct TrafficCounters {
   uint32_t rx_ok_pos_full = 0;
   uint32_t rx_ok_alive    = 0;
   uint32_t rx_ok_status   = 0;
+  uint32_t rx_ok_pos_delta = 0;
+  uint32_t rx_pos_delta_no_ref = 0;  ///< Pos_Delta without its reference; counted in rx_reject too.
+  uint32_t rx_short_addr_unresolved = 0;  ///< Short-addressed frame, sender not resolved; in rx_reject too.
   uint32_t rx_reject      = 0;  ///< Decode or validate failed (unknown type / bad payload).
+  uint32_t rx_bundled_subs = 0;  ///< Sub-messages applied from received bundles (BeaconLogic).
+  uint32_t rx_relayed      = 0;  ///< Frames received as relay copies (hop count > 0; BeaconLogic).
+  uint32_t rx_relay_dup    = 0;  ///< Frames the relay duplicate cache had already seen (relays only).
+  uint32_t rx_fec_corrected = 0;  ///< Node_Fec frames received with corrupted bytes, corrected.
+  uint32_t rx_fec_fail     = 0;  ///< Node_Fec frames beyond correction; in rx_reject too.
+
+  // Radio preset (M1Runtime: link-adaptive preset selection).
+  uint32_t radio_preset_switch = 0;  ///< Runtime preset changes applied (either direction).
+  uint32_t radio_preset_fail   = 0;  ///< Preset changes the radio refused or did not verify.
 };
 
 }  // namespace domain
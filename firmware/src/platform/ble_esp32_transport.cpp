@@ -22,6 +22,7 @@ constexpr char kNodeNameUuid[] = "6e4f0008-1b9a-4c3a-9a3b-000000000001";
 constexpr char kNodeTableSubscribeUuid[] = "6e4f0009-1b9a-4c3a-9a3b-000000000001";
 constexpr char kProfilesListUuid[] = "6e4f000a-1b9a-4c3a-9a3b-000000000001";
 constexpr char kProfileReadUuid[] = "6e4f000b-1b9a-4c3a-9a3b-000000000001";
+constexpr char kLinkStatsUuid[] = "6e4f000d-1b9a-4c3a-9a3b-000000000001";
 /** S04 #464: Targeted read — write node_id (8 bytes LE), read one canon record. */
 constexpr char kTargetedReadUuid[] = "6e4f000c-1b9a-4c3a-9a3b-000000000001";
 constexpr size_t kMaxDisplayIdentityLen = 32;
@@ -181,6 +182,27 @@ class ProfilesListCallbacks : public BLECharacteristicCallbacks {
   BleEsp32Transport* transport_ = nullptr;
 };
 
+/** Per-peer link stats — single read from core buffer. */
+class LinkStatsCallbacks : public BLECharacteristicCallbacks {
+ public:
+  explicit LinkStatsCallbacks(BleEsp32Transport* transport) : transport_(transport) {}
+
+  void onRead(BLECharacteristic* characteristic) override {
+    if (!characteristic || !transport_) return;
+    BleTransportCore* core = transport_->core_for_callbacks();
+    const uint8_t* data = core->link_stats_data();
+    const size_t len = core->link_stats_len();
+    if (len > 0) {
+      characteristic->setValue(const_cast<uint8_t*>(data), len);
+    } else {
+      characteristic->setValue("");
+    }
+  }
+
+ private:
+  BleEsp32Transport* transport_ = nullptr;
+};
+
 /** S04 #467: Profile read — write request (1B type + 4B id LE), read response (one profile). */
 class ProfileReadCallbacks : public BLECharacteristicCallbacks {
  public:
@@ -306,6 +328,9 @@ void BleEsp32Transport::init() {
       BLECharacteristic::PROPERTY_READ | BLECharacteristic::PROPERTY_WRITE);
   profile_read_char_->setCallbacks(new ProfileReadCallbacks(this));
 
+  link_stats_char_ = service_->createCharacteristic(kLinkStatsUuid, BLECharacteristic::PROPERTY_READ);
+  link_stats_char_->setCallbacks(new LinkStatsCallbacks(this));
+
   service_->start();
 
   advertising_ = BLEDevice::getAdvertising();
@@ -468,6 +493,18 @@ void BleEsp32Transport::clear_profile_read_request() {
   core_.clear_profile_read_request();
 }
 
+void BleEsp32Transport::set_link_stats(const uint8_t* data, size_t len) {
+  core_.set_link_stats(data, len);
+}
+
+const uint8_t* BleEsp32Transport::link_stats_data() const {
+  return core_.link_stats_data();
+}
+
+size_t BleEsp32Transport::link_stats_len() const {
+  return core_.link_stats_len();
+}
+
 bool BleEsp32Transport::connected() const {
   return connected_;
 }
@@ -592,6 +629,18 @@ void BleEsp32Transport::clear_profile_read_request() {
   core_.clear_profile_read_request();
 }
 
+void BleEsp32Transport::set_link_stats(const uint8_t* data, size_t len) {
+  core_.set_link_stats(data, len);
+}
+
+const uint8_t* BleEsp32Transport::link_stats_data() const {
+  return core_.link_stats_data();
+}
+
+size_t BleEsp32Transport::link_stats_len() const {
+  return core_.link_stats_len();
+}
+
 bool BleEsp32Transport::connected() const {
   return connected_;
 }
@@ -71,6 +71,11 @@ class BleEsp32Transport : public IBleTransport {
   size_t profile_read_response_len() const override;
   void clear_profile_read_request() override;
 
+  /** Per-peer link stats (single read). */
+  void set_link_stats(const uint8_t* data, size_t len) override;
+  const uint8_t* link_stats_data() const override;
+  size_t link_stats_len() const override;
+
   /** For GATT callbacks (same TU) to read/write core buffer. */
   BleTransportCore* core_for_callbacks() { return &core_; }
   /** Not used from BLE callback; request handling deferred to runtime loop. */
@@ -91,6 +96,7 @@ class BleEsp32Transport : public IBleTransport {
   BLECharacteristic* node_table_subscribe_char_ = nullptr;
   BLECharacteristic* profiles_list_char_ = nullptr;
   BLECharacteristic* profile_read_char_ = nullptr;
+  BLECharacteristic* link_stats_char_ = nullptr;
   BLECharacteristic* targeted_read_char_ = nullptr;
   bool connected_ = false;
 };
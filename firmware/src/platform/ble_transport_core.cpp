@@ -202,4 +202,20 @@ size_t BleTransportCore::profile_read_response_len() const {
   return profile_read_response_len_;
 }
 
+void BleTransportCore::set_link_stats(const uint8_t* data, size_t len) {
+  const size_t copy_len = std::min(len, link_stats_buf_.size());
+  if (data && copy_len > 0) {
+    std::memcpy(link_stats_buf_.data(), data, copy_len);
+  }
+  link_stats_len_ = copy_len;
+}
+
+const uint8_t* BleTransportCore::link_stats_data() const {
+  return link_stats_buf_.data();
+}
+
+size_t BleTransportCore::link_stats_len() const {
+  return link_stats_len_;
+}
+
 } // namespace naviga
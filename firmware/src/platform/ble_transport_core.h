@@ -77,6 +77,14 @@ class BleTransportCore {
   const uint8_t* profile_read_response_data() const;
   size_t profile_read_response_len() const;
 
+  /** Per-peer link stats (single read): format_ver(1), count(1), count × 16-byte entries. */
+  static constexpr size_t kLinkStatsEntryBytes = 16;
+  static constexpr size_t kMaxLinkStatsEntries = 31;
+  static constexpr size_t kMaxLinkStatsLen = 2 + kMaxLinkStatsEntries * kLinkStatsEntryBytes;
+  void set_link_stats(const uint8_t* data, size_t len);
+  const uint8_t* link_stats_data() const;
+  size_t link_stats_len() const;
+
  private:
   std::array<uint8_t, kMaxDeviceInfoLen> device_info_{};
   size_t device_info_len_ = 0;
@@ -113,6 +121,9 @@ class BleTransportCore {
 
   std::array<uint8_t, kMaxProfileReadResponseLen> profile_read_response_buf_{};
   size_t profile_read_response_len_ = 0;
+
+  std::array<uint8_t, kMaxLinkStatsLen> link_stats_buf_{};
+  size_t link_stats_len_ = 0;
 };
 
 } // namespace naviga
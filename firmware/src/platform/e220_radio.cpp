@@ -13,12 +13,14 @@ namespace naviga {
 namespace {
 
 constexpr UART_BPS_RATE kE220BaudRate = UART_BPS_RATE_9600;
+// Async TX gives up after this long without AUX returning HIGH (library sendMessage: 1000 ms).
+constexpr uint32_t kAsyncTxTimeoutMs = 1000;
 
 // Fixed critical params (not preset-dependent).
 constexpr byte kExpectedUartBaudRate     = UART_BPS_9600;
 constexpr byte kExpectedUartParity       = MODE_00_8N1;
 constexpr byte kExpectedRssiEnable       = RSSI_ENABLED;
-constexpr byte kExpectedLbtEnable        = 0;  // OFF — policy: sense unsupported, jitter-only.
+constexpr byte kExpectedLbtEnable        = 0;  // OFF — host-side sense instead (AmbientRssiSense).
 constexpr byte kExpectedSubPacketSetting = SPS_200_00;
 constexpr byte kExpectedRssiAmbientNoise = RSSI_AMBIENT_NOISE_ENABLED;
 constexpr byte kExpectedAddressHigh      = 0x00;
@@ -103,6 +105,7 @@ bool E220Radio::begin() {
 bool E220Radio::begin(const RadioPreset& preset) {
   last_boot_result_ = E220BootConfigResult::Ok;
   last_boot_message_[0] = '\0';
+  ambient_noise_enabled_ = false;
 
   // Normalize airRate: E220 also uses 2.4 kbps as its lowest supported rate.
   uint8_t norm_air_rate = preset.air_rate;
@@ -145,6 +148,7 @@ bool E220Radio::begin(const RadioPreset& preset) {
   Configuration* cfg = reinterpret_cast<Configuration*>(config.data);
   if (critical_params_match(*cfg, target)) {
     rssi_enabled_ = (cfg->TRANSMISSION_MODE.enableRSSI == RSSI_ENABLED);
+    ambient_noise_enabled_ = true;  // part of critical_params_match
     config.close();
     return true;
   }
@@ -182,6 +186,7 @@ bool E220Radio::begin(const RadioPreset& preset) {
 
   if (vr.all_ok()) {
     last_boot_result_ = E220BootConfigResult::Repaired;
+    ambient_noise_enabled_ = (cfg2->OPTION.RSSIAmbientNoise == kExpectedRssiAmbientNoise);
   } else {
     last_boot_result_ = E220BootConfigResult::RepairFailed;
     std::snprintf(last_boot_message_, kBootMessageLen,
@@ -199,18 +204,84 @@ bool E220Radio::is_ready() const {
   return ready_;
 }
 
+bool E220Radio::apply_preset(const RadioPreset& preset) {
+  if (!ready_ || tx_in_flight_) {
+    return false;
+  }
+  return begin(preset) && last_boot_result_ != E220BootConfigResult::RepairFailed;
+}
+
 bool E220Radio::rssi_available() const {
   return rssi_enabled_;
 }
 
+int E220Radio::available() {
+  return ready_ ? serial_.available() : 0;
+}
+
+int E220Radio::peek_byte() {
+  return ready_ ? serial_.peek() : -1;
+}
+
+int E220Radio::read_byte() {
+  return ready_ ? serial_.read() : -1;
+}
+
+size_t E220Radio::write_bytes(const uint8_t* data, size_t len) {
+  if (!ready_ || !data) {
+    return 0;
+  }
+  late_reply_len_ = 0;  // the reply to this command is the caller's to read
+  return serial_.write(data, len);
+}
+
+void E220Radio::drop_late_reply(uint8_t first_byte, size_t reply_len) {
+  late_reply_first_ = first_byte;
+  late_reply_len_ = reply_len;
+}
+
 bool E220Radio::send(const uint8_t* data, size_t len) {
-  if (!ready_ || !data || len == 0 || len > MAX_SIZE_TX_PACKET) {
+  if (!ready_ || tx_in_flight_ || !data || len == 0 || len > MAX_SIZE_TX_PACKET) {
     return false;
   }
   ResponseStatus status = radio_.sendMessage(data, static_cast<uint8_t>(len));
   return status.code == E220_SUCCESS;
 }
 
+bool E220Radio::send_async(const uint8_t* data, size_t len) {
+  if (!ready_ || tx_in_flight_ || !data || len == 0 || len > MAX_SIZE_TX_PACKET) {
+    return false;
+  }
+  // Transparent mode: the same bytes sendMessage() writes before it blocks on AUX. The UART
+  // driver buffers them (frames fit the TX FIFO), so this returns at once.
+  if (serial_.write(data, len) != len) {
+    return false;
+  }
+  tx_in_flight_ = true;
+  tx_aux_low_seen_ = false;
+  tx_start_ms_ = millis();
+  return true;
+}
+
+RadioTxStatus E220Radio::poll_tx_done() {
+  if (!tx_in_flight_) {
+    return RadioTxStatus::IDLE;
+  }
+  // AUX goes LOW once the module has UART data to send and stays LOW for the whole airtime.
+  const bool aux_high = digitalRead(static_cast<uint8_t>(pins_.lora_aux)) == HIGH;
+  if (!aux_high) {
+    tx_aux_low_seen_ = true;
+  } else if (tx_aux_low_seen_) {
+    tx_in_flight_ = false;
+    return RadioTxStatus::DONE;
+  }
+  if (static_cast<uint32_t>(millis() - tx_start_ms_) >= kAsyncTxTimeoutMs) {
+    tx_in_flight_ = false;
+    return RadioTxStatus::FAILED;
+  }
+  return RadioTxStatus::IN_FLIGHT;
+}
+
 bool E220Radio::recv(uint8_t* out, size_t max_len, size_t* out_len) {
   if (!ready_ || !out_len || max_len == 0) {
     return false;
@@ -219,6 +290,16 @@ bool E220Radio::recv(uint8_t* out, size_t max_len, size_t* out_len) {
     *out_len = 0;
     return false;
   }
+  if (late_reply_len_ > 0 && serial_.peek() == late_reply_first_) {
+    // A command reply that came after its reader gave up: not a frame.
+    uint8_t reply[8];
+    serial_.readBytes(reply, late_reply_len_ < sizeof(reply) ? late_reply_len_ : sizeof(reply));
+    late_reply_len_ = 0;
+    if (radio_.available() <= 0) {
+      *out_len = 0;
+      return false;
+    }
+  }
 
   // Use the String-based receiveMessage() which reads until the UART buffer is drained
   // (no fixed-size requirement). receiveMessage(size) fails with DATA_SIZE_NOT_MATCH
@@ -18,7 +18,7 @@ enum class E220BootConfigResult {
   RepairFailed // Repair attempted but re-read did not match (or write failed).
 };
 
-class E220Radio : public IRadio {
+class E220Radio : public IRadio, public IRadioCmdIo {
  public:
   explicit E220Radio(const Pins& pins);
 
@@ -32,13 +32,28 @@ class E220Radio : public IRadio {
   E220BootConfigResult last_boot_config_result() const { return last_boot_result_; }
   /** Short message for log: what was repaired or failure reason; empty if Ok. */
   const char* last_boot_config_message() const { return last_boot_message_; }
+  /** OPTION.RSSIAmbientNoise read back on at the last begin() (not on RepairFailed): the
+   *  module answers the ambient-noise command instead of sending it on air. */
+  bool ambient_noise_enabled() const { return ambient_noise_enabled_; }
 
   bool send(const uint8_t* data, size_t len) override;
+  /** Writes the frame to the module UART and returns; AUX LOW then HIGH again = on air and done. */
+  bool send_async(const uint8_t* data, size_t len) override;
+  RadioTxStatus poll_tx_done() override;
   bool recv(uint8_t* out, size_t max_len, size_t* out_len) override;
   int8_t last_rssi_dbm() const override;
   bool rssi_available() const override;
   RadioBootConfigResult boot_config_result() const override;
   const char* boot_config_message() const override;
+  /** Runtime preset change via begin(preset) (verify-and-repair); blocks ~e220_reconfig_blind_ms. */
+  bool apply_preset(const RadioPreset& preset) override;
+
+  // IRadioCmdIo: raw module UART (normal mode), for AmbientRssiSense commands.
+  int available() override;
+  int peek_byte() override;
+  int read_byte() override;
+  size_t write_bytes(const uint8_t* data, size_t len) override;
+  void drop_late_reply(uint8_t first_byte, size_t reply_len) override;
 
  private:
   Pins pins_;
@@ -46,7 +61,13 @@ class E220Radio : public IRadio {
   LoRa_E220 radio_;
   bool ready_ = false;
   bool rssi_enabled_ = false;
+  bool ambient_noise_enabled_ = false;
+  uint8_t late_reply_first_ = 0;
+  size_t late_reply_len_ = 0;  ///< Owed command reply for recv() to drop; 0 = none.
   int8_t last_rssi_dbm_ = 0;
+  bool tx_in_flight_ = false;
+  bool tx_aux_low_seen_ = false;
+  uint32_t tx_start_ms_ = 0;
 
   E220BootConfigResult last_boot_result_ = E220BootConfigResult::Ok;
   static constexpr size_t kBootMessageLen = 64;
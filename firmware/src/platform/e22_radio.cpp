@@ -19,6 +19,8 @@ namespace naviga {
 namespace {
 
 constexpr UART_BPS_RATE kE22BaudRate = UART_BPS_RATE_9600;
+// Async TX gives up after this long without AUX returning HIGH (library sendMessage: 1000 ms).
+constexpr uint32_t kAsyncTxTimeoutMs = 1000;
 
 // Fixed critical params (not preset-dependent).
 constexpr byte kExpectedUartBaudRate     = UART_BPS_9600;
@@ -117,6 +119,7 @@ bool E22Radio::begin() {
 bool E22Radio::begin(const RadioPreset& preset) {
   last_boot_result_ = E22BootConfigResult::Ok;
   last_boot_message_[0] = '\0';
+  ambient_noise_enabled_ = false;
 
   // Normalize airRate: E22-400T30D V2 clamps < 2 to 2 (issue #336).
   uint8_t norm_air_rate = preset.air_rate;
@@ -158,6 +161,7 @@ bool E22Radio::begin(const RadioPreset& preset) {
   Configuration* cfg = reinterpret_cast<Configuration*>(config.data);
   if (critical_params_match(*cfg, target)) {
     rssi_enabled_ = (cfg->TRANSMISSION_MODE.enableRSSI == RSSI_ENABLED);
+    ambient_noise_enabled_ = true;  // part of critical_params_match
     config.close();
     // If we only had a clamp (no structural mismatch), keep Repaired status.
     return true;
@@ -197,6 +201,7 @@ bool E22Radio::begin(const RadioPreset& preset) {
 
   if (vr.all_ok()) {
     last_boot_result_ = E22BootConfigResult::Repaired;
+    ambient_noise_enabled_ = (cfg2->OPTION.RSSIAmbientNoise == kExpectedRssiAmbientNoise);
     // last_boot_message_ already has mismatch list or clamp note.
   } else {
     last_boot_result_ = E22BootConfigResult::RepairFailed;
@@ -215,18 +220,84 @@ bool E22Radio::is_ready() const {
   return ready_;
 }
 
+bool E22Radio::apply_preset(const RadioPreset& preset) {
+  if (!ready_ || tx_in_flight_) {
+    return false;
+  }
+  return begin(preset) && last_boot_result_ != E22BootConfigResult::RepairFailed;
+}
+
 bool E22Radio::rssi_available() const {
   return rssi_enabled_;
 }
 
+int E22Radio::available() {
+  return ready_ ? serial_.available() : 0;
+}
+
+int E22Radio::peek_byte() {
+  return ready_ ? serial_.peek() : -1;
+}
+
+int E22Radio::read_byte() {
+  return ready_ ? serial_.read() : -1;
+}
+
+size_t E22Radio::write_bytes(const uint8_t* data, size_t len) {
+  if (!ready_ || !data) {
+    return 0;
+  }
+  late_reply_len_ = 0;  // the reply to this command is the caller's to read
+  return serial_.write(data, len);
+}
+
+void E22Radio::drop_late_reply(uint8_t first_byte, size_t reply_len) {
+  late_reply_first_ = first_byte;
+  late_reply_len_ = reply_len;
+}
+
 bool E22Radio::send(const uint8_t* data, size_t len) {
-  if (!ready_ || !data || len == 0 || len > MAX_SIZE_TX_PACKET) {
+  if (!ready_ || tx_in_flight_ || !data || len == 0 || len > MAX_SIZE_TX_PACKET) {
     return false;
   }
   ResponseStatus status = radio_.sendMessage(data, static_cast<uint8_t>(len));
   return status.code == E22_SUCCESS;
 }
 
+bool E22Radio::send_async(const uint8_t* data, size_t len) {
+  if (!ready_ || tx_in_flight_ || !data || len == 0 || len > MAX_SIZE_TX_PACKET) {
+    return false;
+  }
+  // Transparent mode: the same bytes sendMessage() writes before it blocks on AUX. The UART
+  // driver buffers them (frames fit the TX FIFO), so this returns at once.
+  if (serial_.write(data, len) != len) {
+    return false;
+  }
+  tx_in_flight_ = true;
+  tx_aux_low_seen_ = false;
+  tx_start_ms_ = millis();
+  return true;
+}
+
+RadioTxStatus E22Radio::poll_tx_done() {
+  if (!tx_in_flight_) {
+    return RadioTxStatus::IDLE;
+  }
+  // AUX goes LOW once the module has UART data to send and stays LOW for the whole airtime.
+  const bool aux_high = digitalRead(static_cast<uint8_t>(pins_.lora_aux)) == HIGH;
+  if (!aux_high) {
+    tx_aux_low_seen_ = true;
+  } else if (tx_aux_low_seen_) {
+    tx_in_flight_ = false;
+    return RadioTxStatus::DONE;
+  }
+  if (static_cast<uint32_t>(millis() - tx_start_ms_) >= kAsyncTxTimeoutMs) {
+    tx_in_flight_ = false;
+    return RadioTxStatus::FAILED;
+  }
+  return RadioTxStatus::IN_FLIGHT;
+}
+
 bool E22Radio::recv(uint8_t* out, size_t max_len, size_t* out_len) {
   if (!ready_ || !out_len || max_len == 0) {
     return false;
@@ -235,6 +306,16 @@ bool E22Radio::recv(uint8_t* out, size_t max_len, size_t* out_len) {
     *out_len = 0;
     return false;
   }
+  if (late_reply_len_ > 0 && serial_.peek() == late_reply_first_) {
+    // A command reply that came after its reader gave up: not a frame.
+    uint8_t reply[8];
+    serial_.readBytes(reply, late_reply_len_ < sizeof(reply) ? late_reply_len_ : sizeof(reply));
+    late_reply_len_ = 0;
+    if (radio_.available() <= 0) {
+      *out_len = 0;
+      return false;
+    }
+  }
 
   // Use String-based receiveMessage() — reads until UART buffer is drained.
   // receiveMessage(size) fails with DATA_SIZE_NOT_MATCH for variable-length frames.
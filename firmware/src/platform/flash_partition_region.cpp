@@ -0,0 +1,55 @@
+#include "platform/flash_partition_region.h"
+
+#include <esp_partition.h>
+
+namespace naviga {
+namespace platform {
+
+namespace {
+
+constexpr size_t kSectorSize = 4096;
+
+const esp_partition_t* as_partition(const void* p) {
+  return static_cast<const esp_partition_t*>(p);
+}
+
+} // namespace
+
+bool FlashPartitionRegion::begin(const char* label) {
+  partition_ = esp_partition_find_first(
+      ESP_PARTITION_TYPE_DATA, static_cast<esp_partition_subtype_t>(kEventLogPartitionSubtype), label);
+  return partition_ != nullptr;
+}
+
+size_t FlashPartitionRegion::sector_size() const {
+  return kSectorSize;
+}
+
+size_t FlashPartitionRegion::sector_count() const {
+  return partition_ ? as_partition(partition_)->size / kSectorSize : 0;
+}
+
+bool FlashPartitionRegion::erase_sector(size_t sector) {
+  if (!partition_ || sector >= sector_count()) {
+    return false;
+  }
+  return esp_partition_erase_range(as_partition(partition_), sector * kSectorSize, kSectorSize) ==
+         ESP_OK;
+}
+
+bool FlashPartitionRegion::write(size_t offset, const uint8_t* data, size_t len) {
+  if (!partition_ || !data) {
+    return false;
+  }
+  return esp_partition_write(as_partition(partition_), offset, data, len) == ESP_OK;
+}
+
+bool FlashPartitionRegion::read(size_t offset, uint8_t* out, size_t len) const {
+  if (!partition_ || !out) {
+    return false;
+  }
+  return esp_partition_read(as_partition(partition_), offset, out, len) == ESP_OK;
+}
+
+} // namespace platform
+} // namespace naviga
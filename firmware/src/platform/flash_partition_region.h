@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "naviga/hal/interfaces.h"
+
+namespace naviga {
+namespace platform {
+
+/** Data partition subtype/label reserved for the persistent event log (partitions_naviga.csv). */
+constexpr uint8_t kEventLogPartitionSubtype = 0x40;
+constexpr const char* kEventLogPartitionLabel = "navlog";
+
+/**
+ * IFlashRegion over an ESP-IDF data partition. begin() returns false when the partition is
+ * missing (e.g. device flashed with the stock partition table); the flash log then stays off.
+ */
+class FlashPartitionRegion : public IFlashRegion {
+ public:
+  bool begin(const char* label = kEventLogPartitionLabel);
+
+  size_t sector_size() const override;
+  size_t sector_count() const override;
+  bool erase_sector(size_t sector) override;
+  bool write(size_t offset, const uint8_t* data, size_t len) override;
+  bool read(size_t offset, uint8_t* out, size_t len) const override;
+
+ private:
+  const void* partition_ = nullptr;  ///< const esp_partition_t*
+};
+
+} // namespace platform
+} // namespace naviga
@@ -17,6 +17,13 @@ int GnssUbxUartIo::read_byte() {
   return uart_.read();
 }
 
+size_t GnssUbxUartIo::read_bytes(uint8_t* buf, size_t n) {
+  if (!buf || n == 0) {
+    return 0;
+  }
+  return uart_.read(buf, n);
+}
+
 size_t GnssUbxUartIo::write_bytes(const uint8_t* data, size_t len) {
   if (!data || len == 0) {
     return 0;
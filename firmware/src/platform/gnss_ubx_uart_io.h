@@ -16,6 +16,7 @@ class GnssUbxUartIo : public IGnssUbxIo {
   bool begin(uint32_t baud, int8_t rx_pin, int8_t tx_pin) override;
   int available() override;
   int read_byte() override;
+  size_t read_bytes(uint8_t* buf, size_t n) override;
   size_t write_bytes(const uint8_t* data, size_t len) override;
 
  private:
@@ -2,6 +2,8 @@
 
 #include <Arduino.h>
 
+#include "domain/log_frame.h"
+
 namespace naviga {
 namespace platform {
 
@@ -42,9 +44,8 @@ void print_hex_byte(uint8_t value) {
   Serial.print(out);
 }
 
-size_t record_line_len(const domain::LogRecordView& record) {
-  // "LOG t_ms=" + t_ms + " event=" + event_id + " level=" + level +
-  // " len=" + len + " payload=" + payload_or_dash + "\n"
+// "LOG t_ms=" + t_ms + " event=" + event_id + " level=" + level + " len=" + len + " payload="
+size_t record_prefix_len(const domain::LogRecordView& record) {
   size_t len = 0;
   len += 9;  // "LOG t_ms="
   len += count_digits_u32(record.t_ms);
@@ -55,16 +56,28 @@ size_t record_line_len(const domain::LogRecordView& record) {
   len += 5;  // " len="
   len += count_digits_u8(record.len);
   len += 9;  // " payload="
+  return len;
+}
+
+// Serial.println ends each line with "\r\n".
+constexpr size_t kLineEndLen = 2;
+
+size_t record_line_len(const domain::LogRecordView& record) {
+  const size_t prefix = record_prefix_len(record);
   if (record.len == 0 || !record.payload) {
-    len += 2;  // "-\n"
-  } else {
-    len += static_cast<size_t>(record.len) * 2;
-    len += 1;  // "\n"
+    return prefix + 1 + kLineEndLen;  // "-\r\n"
   }
-  return len;
+  return prefix + static_cast<size_t>(record.len) * 2 + kLineEndLen;  // hex + "\r\n"
 }
 
-void emit_record(void* /*ctx*/, const domain::LogRecordView& record) {
+/** Payload bytes of a line cut to kMaxBytesPerDrain: hex + "~\r\n" after the prefix. */
+uint8_t truncated_payload_len(const domain::LogRecordView& record) {
+  const size_t room = (kMaxBytesPerDrain - record_prefix_len(record) - 1 - kLineEndLen) / 2;
+  return static_cast<uint8_t>(room < record.len ? room : record.len);
+}
+
+/** Prints payload[0..shown); shown < record.len ends the hex with '~' (len= keeps the full size). */
+void emit_record(const domain::LogRecordView& record, uint8_t shown) {
   Serial.print("LOG t_ms=");
   Serial.print(record.t_ms);
   Serial.print(" event=");
@@ -78,34 +91,74 @@ void emit_record(void* /*ctx*/, const domain::LogRecordView& record) {
     Serial.println("-");
     return;
   }
-  for (uint8_t i = 0; i < record.len; ++i) {
+  for (uint8_t i = 0; i < shown; ++i) {
     print_hex_byte(record.payload[i]);
   }
+  if (shown < record.len) {
+    Serial.print("~");
+  }
   Serial.println();
 }
 
+struct DrainContext {
+  LogExportFormat format;
+  size_t budget;
+};
+
+uint32_t g_truncated = 0;
+
+bool emit_if_fits(void* ctx, const domain::LogRecordView& record) {
+  auto* drain = static_cast<DrainContext*>(ctx);
+  if (drain->format == LogExportFormat::kBinary) {
+    // A frame of the largest record (255 B payload) fits in one drain.
+    const size_t needed = domain::log_frame_encoded_len(record);
+    if (needed > drain->budget) {
+      return false;
+    }
+    uint8_t frame[domain::kMaxLogFrameSize];
+    const size_t n = domain::encode_log_frame(record, frame, sizeof(frame));
+    Serial.write(frame, n);
+    drain->budget -= needed;
+    return true;
+  }
+
+  // A text line longer than one drain is cut to fit, so the record still shows up.
+  size_t needed = record_line_len(record);
+  uint8_t shown = record.len;
+  if (needed > kMaxBytesPerDrain) {
+    shown = truncated_payload_len(record);
+    needed = record_prefix_len(record) + static_cast<size_t>(shown) * 2 + 1 + kLineEndLen;
+  }
+  if (needed > drain->budget) {
+    return false;
+  }
+  emit_record(record, shown);
+  if (shown < record.len) {
+    ++g_truncated;
+  }
+  drain->budget -= needed;
+  return true;
+}
+
 } // namespace
 
-void drain_logs_uart(domain::Logger& logger) {
-  if (!Serial) {
+void drain_logs_uart(domain::Logger& logger, LogExportFormat format) {
+  if (!Serial || logger.size() == 0) {
     return;
   }
-  size_t total_len = 0;
-  logger.for_each_record(
-      [](void* ctx, const domain::LogRecordView& record) {
-        auto* total = static_cast<size_t*>(ctx);
-        *total += record_line_len(record);
-      },
-      &total_len);
-
-  if (total_len == 0 || total_len > kMaxBytesPerDrain) {
+  const int writable = Serial.availableForWrite();
+  if (writable <= 0) {
     return;
   }
-  if (Serial.availableForWrite() < total_len) {
-    return;
+  DrainContext ctx{format, static_cast<size_t>(writable)};
+  if (ctx.budget > kMaxBytesPerDrain) {
+    ctx.budget = kMaxBytesPerDrain;
   }
+  logger.drain_while(emit_if_fits, &ctx);
+}
 
-  logger.drain(emit_record, nullptr);
+uint32_t log_export_truncated_count() {
+  return g_truncated;
 }
 
 } // namespace platform
@@ -1,11 +1,28 @@
 #pragma once
 
+#include <cstdint>
+
 #include "domain/logger.h"
 
 namespace naviga {
 namespace platform {
 
-void drain_logs_uart(domain::Logger& logger);
+enum class LogExportFormat : uint8_t {
+  kText = 0,    ///< "LOG t_ms=.. event=.. level=.. len=.. payload=HEX" lines; HEX~ = cut to fit.
+  kBinary = 1,  ///< COBS frames with CRC16 (domain/log_frame.h); ~3x fewer bytes than text.
+};
+
+/**
+ * Incremental drain: emits as many whole records as fit in Serial.availableForWrite()
+ * (capped per call), consuming them from the ring. Remaining records wait for the next call.
+ */
+void drain_logs_uart(domain::Logger& logger, LogExportFormat format = LogExportFormat::kText);
+
+/**
+ * Text records whose line was longer than one drain and went out with the payload cut short
+ * (marked '~'); binary frames always fit. Counted since boot.
+ */
+uint32_t log_export_truncated_count();
 
 } // namespace platform
 } // namespace naviga
@@ -3,6 +3,8 @@
 #include <Arduino.h>
 #include <cstring>
 
+#include "domain/flash_log.h"
+#include "domain/log_frame.h"
 #include "services/gnss_scenario_override.h"
 
 #ifdef ESP32
@@ -19,6 +21,30 @@ void ProvisioningAdapter::set_instrumentation_flag(bool* flag) {
   shell_.set_instrumentation_flag(flag);
 }
 
+void ProvisioningAdapter::set_log_binary_flag(bool* flag) {
+  shell_.set_log_binary_flag(flag);
+}
+
+void ProvisioningAdapter::set_flash_log(domain::FlashLog* log) {
+  flash_log_ = log;
+  shell_.set_flash_log(log);
+}
+
+void ProvisioningAdapter::stream_flash_log() {
+  if (!flash_log_) {
+    return;
+  }
+  flash_log_->flush();
+  flash_log_->for_each_record(
+      [](void* /*ctx*/, const domain::LogRecordView& record) {
+        uint8_t frame[domain::kMaxLogFrameSize];
+        const size_t n = domain::encode_log_frame(record, frame, sizeof(frame));
+        Serial.write(frame, n);
+      },
+      nullptr);
+  Serial.flush();
+}
+
 void ProvisioningAdapter::set_gnss_override(GnssScenarioOverride* ptr) {
   shell_.set_gnss_override(ptr);
 }
@@ -34,6 +60,9 @@ void ProvisioningAdapter::tick(uint32_t /*now_ms*/) {
         char response[ProvisioningShell::kResponseMax] = {};
         bool reboot_requested = false;
         if (shell_.handle_line(line_buf_, response, sizeof(response), &reboot_requested)) {
+          if (shell_.take_flash_log_dump_request()) {
+            stream_flash_log();
+          }
           if (response[0] != '\0') {
             Serial.println(response);
           }
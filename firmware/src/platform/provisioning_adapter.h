@@ -19,6 +19,12 @@ class ProvisioningAdapter {
   /** Optional: enable "debug on/off" in shell to toggle instrumentation (e.g. packet/peer logs). */
   void set_instrumentation_flag(bool* flag);
 
+  /** Optional: enable "logfmt text|bin" in shell to select event log export format. */
+  void set_log_binary_flag(bool* flag);
+
+  /** Optional: enable "flashlog stat|dump|erase"; dump streams binary frames over Serial. */
+  void set_flash_log(domain::FlashLog* log);
+
   /** Optional: enable "gnss off|nofix|fix|move" scenario override in shell (#288). */
   void set_gnss_override(class GnssScenarioOverride* ptr);
 
@@ -26,7 +32,10 @@ class ProvisioningAdapter {
   void tick(uint32_t now_ms);
 
  private:
+  void stream_flash_log();
+
   ProvisioningShell shell_;
+  domain::FlashLog* flash_log_ = nullptr;
   char line_buf_[ProvisioningShell::kLineMax] = {};
   size_t line_len_ = 0;
 };
@@ -14,6 +14,10 @@
 
 namespace naviga {
 
+namespace {
+IRadioCmdIo* g_radio_cmd_io = nullptr;
+} // namespace
+
 // Build HAL preset from product-level FACTORY default for Phase A (boot_pipeline_v0).
 // Phase A applies FACTORY default to hardware; no NVS read. Adapter maps product step to module.
 static RadioPreset preset_from_factory_default() {
@@ -38,13 +42,18 @@ IRadio* create_radio(const HwProfile& profile, bool* radio_ready_out) {
   const RadioPreset preset = preset_from_factory_default();
 #if defined(HW_PROFILE_DEVKIT_E22_OLED_GNSS)
   static E22Radio instance(profile.pins);
-  *radio_ready_out = instance.begin(preset);
-  return &instance;
 #else
   static E220Radio instance(profile.pins);
+#endif
   *radio_ready_out = instance.begin(preset);
+  // The sense command only when the module verified the ambient-noise option; otherwise
+  // (RepairFailed, or older module firmware) it would go out on air as frame bytes.
+  g_radio_cmd_io = (*radio_ready_out && instance.ambient_noise_enabled()) ? &instance : nullptr;
   return &instance;
-#endif
+}
+
+IRadioCmdIo* radio_cmd_io() {
+  return g_radio_cmd_io;
 }
 
 } // namespace naviga
@@ -10,4 +10,9 @@ namespace naviga {
 // Calls begin() internally; radio_ready_out receives the result.
 IRadio* create_radio(const HwProfile& profile, bool* radio_ready_out);
 
+// Raw UART of the radio created by create_radio() (for AmbientRssiSense); nullptr before
+// create_radio(), when the radio did not start, or when its boot config did not verify the
+// ambient-noise option.
+IRadioCmdIo* radio_cmd_io();
+
 } // namespace naviga
@@ -0,0 +1 @@
+#include "../../protocol/bundle_codec.cpp"
@@ -0,0 +1 @@
+#include "../../protocol/fec_codec.cpp"
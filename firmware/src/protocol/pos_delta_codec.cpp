@@ -0,0 +1 @@
+#include "../../protocol/pos_delta_codec.cpp"
@@ -0,0 +1 @@
+#include "../../protocol/short_addr_codec.cpp"
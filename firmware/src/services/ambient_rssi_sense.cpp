@@ -0,0 +1,107 @@
+#include "services/ambient_rssi_sense.h"
+
+namespace naviga {
+
+constexpr uint8_t AmbientRssiSense::kMaxErrorRun;
+constexpr uint32_t AmbientRssiSense::kRetryHoldoffMs;
+
+namespace {
+
+// Read register 0x00 (current ambient noise), length 1.
+constexpr uint8_t kReadNoiseCmd[] = {0xC0, 0xC1, 0xC2, 0xC3, 0x00, 0x01};
+constexpr uint8_t kReplyHeader[] = {0xC1, 0x00, 0x01};
+constexpr size_t kReplyLen = sizeof(kReplyHeader) + 1;
+
+} // namespace
+
+void AmbientRssiSense::set_io(IRadioCmdIo* io, const platform::IClock* clock) {
+  io_ = io;
+  clock_ = clock;
+  floor_.reset();
+  error_run_ = 0;
+  holdoff_start_ms_ = 0;
+  reply_owed_ = false;
+}
+
+bool AmbientRssiSense::can_sense() const {
+  if (!io_ || !clock_) {
+    return false;
+  }
+  return error_run_ < kMaxErrorRun ||
+         static_cast<uint32_t>(clock_->uptime_ms() - holdoff_start_ms_) >= kRetryHoldoffMs;
+}
+
+ChannelSenseResult AmbientRssiSense::no_reply() {
+  owe_reply();
+  if (error_run_ < kMaxErrorRun) {
+    error_run_++;
+  }
+  if (error_run_ >= kMaxErrorRun) {
+    holdoff_start_ms_ = clock_->uptime_ms();  // (re)start the hold-off
+  }
+  return {ChannelSenseState::ERROR, 0};
+}
+
+void AmbientRssiSense::owe_reply() {
+  reply_owed_ = true;
+  io_->drop_late_reply(kReplyHeader[0], kReplyLen);
+}
+
+void AmbientRssiSense::drop_owed_reply() {
+  // 0xC1 never starts a frame (hops 3, payload_len 1), so this is the late reply.
+  for (size_t i = 0; i < kReplyLen && io_->available() > 0; ++i) {
+    io_->read_byte();
+  }
+  reply_owed_ = false;
+}
+
+ChannelSenseResult AmbientRssiSense::sense(uint32_t timeout_ms) {
+  if (!can_sense()) {
+    return {ChannelSenseState::UNSUPPORTED, 0};
+  }
+  if (io_->available() > 0) {
+    if (reply_owed_ && io_->peek_byte() == kReplyHeader[0]) {
+      drop_owed_reply();
+    }
+    if (io_->available() > 0) {
+      return {ChannelSenseState::BUSY, 0};
+    }
+  }
+  if (io_->write_bytes(kReadNoiseCmd, sizeof(kReadNoiseCmd)) != sizeof(kReadNoiseCmd)) {
+    return {ChannelSenseState::ERROR, 0};
+  }
+  reply_owed_ = false;
+
+  uint8_t reply[kReplyLen] = {};
+  size_t got = 0;
+  const platform::millis_t start_ms = clock_->uptime_ms();
+  while (got < kReplyLen) {
+    if (io_->available() > 0) {
+      // Peek first: a byte that does not continue the header belongs to a received frame.
+      const int b = io_->peek_byte();
+      if (b < 0) {
+        continue;
+      }
+      if (got < sizeof(kReplyHeader) && static_cast<uint8_t>(b) != kReplyHeader[got]) {
+        if (got > 0) {
+          return {ChannelSenseState::ERROR, 0};
+        }
+        owe_reply();  // RX interleaved: the reply comes behind the frame
+        return {ChannelSenseState::BUSY, 0};
+      }
+      io_->read_byte();
+      reply[got++] = static_cast<uint8_t>(b);
+      continue;
+    }
+    if (static_cast<uint32_t>(clock_->uptime_ms() - start_ms) >= timeout_ms) {
+      return got == 0 ? no_reply() : ChannelSenseResult{ChannelSenseState::ERROR, 0};
+    }
+    clock_->sleep_ms(1);
+  }
+
+  error_run_ = 0;
+  const int16_t noise_dbm = static_cast<int16_t>(static_cast<int16_t>(reply[3]) - 256);
+  return {floor_.classify(noise_dbm), noise_dbm};
+}
+
+} // namespace naviga
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "domain/noise_floor.h"
+#include "naviga/hal/interfaces.h"
+#include "naviga/platform/clock.h"
+
+namespace naviga {
+
+/**
+ * IChannelSense for EBYTE E220/E22 UART modules with RSSI ambient noise enabled
+ * (OPTION.RSSIAmbientNoise, applied at boot). In normal mode the module answers
+ * C0 C1 C2 C3 00 01 with C1 00 01 <rssi>; current noise is -(256 - rssi) dBm.
+ * Samples are classified against an adaptive domain::NoiseFloor.
+ *
+ * The reply shares the UART with received frames, so sense() reports BUSY without querying
+ * while RX bytes are pending (a frame just arrived; recv() drains it first), and BUSY as well
+ * when frame bytes arrive before the reply; they are left unread for recv(). A reply still owed
+ * then (behind those bytes, or after timeout_ms) is dropped by the next sense() or by the
+ * radio's recv() (IRadioCmdIo::drop_late_reply), never read as a frame or a later answer.
+ *
+ * No reply at all within timeout_ms is ERROR. After kMaxErrorRun of those in a row (module
+ * firmware without the command) can_sense() is false for kRetryHoldoffMs and the send policy
+ * stays on jitter; then one query is tried again.
+ */
+class AmbientRssiSense : public IChannelSense {
+ public:
+  static constexpr uint8_t kMaxErrorRun = 4;
+  static constexpr uint32_t kRetryHoldoffMs = 60000;
+
+  /** io / clock null = unsupported. Resets the noise floor and error count. */
+  void set_io(IRadioCmdIo* io, const platform::IClock* clock);
+
+  bool can_sense() const override;
+  ChannelSenseResult sense(uint32_t timeout_ms) override;
+
+  const domain::NoiseFloor& noise_floor() const { return floor_; }
+
+ private:
+  ChannelSenseResult no_reply();
+  void owe_reply();
+  void drop_owed_reply();
+
+  IRadioCmdIo* io_ = nullptr;
+  const platform::IClock* clock_ = nullptr;
+  domain::NoiseFloor floor_{};
+  uint8_t error_run_ = 0;
+  platform::millis_t holdoff_start_ms_ = 0;
+  bool reply_owed_ = false;
+};
+
+} // namespace naviga
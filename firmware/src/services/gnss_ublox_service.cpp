@@ -121,29 +121,6 @@ bool GnssUbloxService::verify_on_boot(uint32_t timeout_ms) {
   return false;
 }
 
-void GnssUbloxService::apply_fix_from_nav_pvt(uint8_t fix_type,
-                                              int32_t lat_e7,
-                                              int32_t lon_e7,
-                                              uint32_t now_ms) {
-  GNSSFixState fix_state = GNSSFixState::NO_FIX;
-  if (fix_type == 2U) {
-    fix_state = GNSSFixState::FIX_2D;
-  } else if (fix_type >= 3U) {
-    fix_state = GNSSFixState::FIX_3D;
-  }
-
-  const bool pos_valid = (fix_state != GNSSFixState::NO_FIX);
-  snapshot_.fix_state = fix_state;
-  snapshot_.pos_valid = pos_valid;
-
-  if (pos_valid) {
-    snapshot_.lat_e7 = lat_e7;
-    snapshot_.lon_e7 = lon_e7;
-    // Policy: update last_fix_ms on each valid position sample.
-    snapshot_.last_fix_ms = now_ms;
-  }
-}
-
 #if defined(GNSS_PROVIDER_UBLOX)
 void GnssUbloxService::update_nmea_hint(uint8_t byte) {
   if (nmea_hint_) {
@@ -207,20 +184,21 @@ bool GnssUbloxService::tick(uint32_t now_ms) {
     to_read = kMaxReadPerTick;
   }
 
-  bool updated = false;
-  for (uint16_t i = 0; i < to_read; ++i) {
-    const int c = io_->read_byte();
-    if (c < 0) {
-      break;
-    }
-    const uint8_t byte = static_cast<uint8_t>(c);
-    ++bytes_rx_;
+  uint8_t buf[kMaxReadPerTick];
+  const size_t got = io_->read_bytes(buf, to_read);
+  bytes_rx_ += static_cast<uint32_t>(got);
 #if defined(GNSS_PROVIDER_UBLOX)
-    update_nmea_hint(byte);
+  for (size_t i = 0; i < got && !nmea_hint_; ++i) {
+    update_nmea_hint(buf[i]);
+  }
 #endif
 
+  bool updated = false;
+  size_t off = 0;
+  while (off < got) {
     UbxFrameView frame{};
-    const UbxParseStatus status = parser_.push_byte(byte, &frame);
+    UbxParseStatus status = UbxParseStatus::None;
+    off += parser_.push_bytes(buf + off, got - off, &frame, &status);
     if (status == UbxParseStatus::FrameBadChecksum) {
       ++frames_bad_ck_;
       continue;
@@ -232,11 +210,12 @@ bool GnssUbloxService::tick(uint32_t now_ms) {
     ++frames_ok_;
     last_frame_ms_ = now_ms;
 
-    uint8_t fix_type = 0;
-    int32_t lat_e7 = 0;
-    int32_t lon_e7 = 0;
-    if (parse_nav_pvt_fix_lat_lon(frame, &fix_type, &lat_e7, &lon_e7)) {
-      apply_fix_from_nav_pvt(fix_type, lat_e7, lon_e7, now_ms);
+    UbxNavPvt pvt;
+    if (parse_nav_pvt(frame, &pvt)) {
+      apply_nav_pvt(pvt, now_ms, &snapshot_);
+      if (snapshot_.time_valid) {
+        snapshot_.tow_at_ms = now_ms - kNavPvtLatencyMs;  // arrival -> epoch
+      }
       updated = true;
     }
   }
@@ -266,6 +245,8 @@ bool GnssUbloxService::get_diag(GnssUbloxDiag* out) const {
   out->fix_state = snapshot_.fix_state;
   out->lat_e7 = snapshot_.pos_valid ? snapshot_.lat_e7 : 0;
   out->lon_e7 = snapshot_.pos_valid ? snapshot_.lon_e7 : 0;
+  out->num_sv = snapshot_.num_sv;
+  out->h_acc_mm = snapshot_.h_acc_mm;
   return true;
 }
 
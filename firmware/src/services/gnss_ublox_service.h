@@ -18,6 +18,18 @@ class IGnssUbxIo {
   virtual bool begin(uint32_t baud, int8_t rx_pin, int8_t tx_pin) = 0;
   virtual int available() = 0;
   virtual int read_byte() = 0;
+  /** Up to n buffered bytes into buf; returns how many (0 when none). Default: read_byte loop. */
+  virtual size_t read_bytes(uint8_t* buf, size_t n) {
+    size_t got = 0;
+    while (got < n) {
+      const int c = read_byte();
+      if (c < 0) {
+        break;
+      }
+      buf[got++] = static_cast<uint8_t>(c);
+    }
+    return got;
+  }
   virtual size_t write_bytes(const uint8_t* data, size_t len) = 0;
 };
 
@@ -29,6 +41,8 @@ struct GnssUbloxDiag {
   GNSSFixState fix_state = GNSSFixState::NO_FIX;
   int32_t lat_e7 = 0;
   int32_t lon_e7 = 0;
+  uint8_t num_sv = 0;
+  uint32_t h_acc_mm = 0;
 };
 
 struct GnssUbloxDiagEvents {
@@ -50,6 +64,15 @@ class GnssUbloxService : public IGnss {
 
  private:
   static constexpr uint32_t kUartBaud = 9600U;
+  /**
+   * NAV-PVT epoch to the whole frame received, taken off tow_at_ms so GNSS time lines up with
+   * the epoch for slotted TX: receiver output delay (configured, u-blox M8/M10 at 1 Hz) plus the
+   * 100-byte frame at kUartBaud. Loop-tick delay is left to BeaconSendPolicy::kSlotGuardMs.
+   */
+  static constexpr uint32_t kNavPvtOutputDelayMs = 25U;
+  static constexpr uint32_t kNavPvtFrameBytes = 100U;
+  static constexpr uint32_t kNavPvtLatencyMs =
+      kNavPvtOutputDelayMs + (kNavPvtFrameBytes * 10U * 1000U + kUartBaud - 1U) / kUartBaud;
   static constexpr uint16_t kMaxReadPerTick = 256U;
 
   IGnssUbxIo* io_ = nullptr;
@@ -62,8 +85,6 @@ class GnssUbloxService : public IGnss {
   uint32_t frames_bad_ck_ = 0;
   uint32_t last_frame_ms_ = 0;
 
-  void apply_fix_from_nav_pvt(uint8_t fix_type, int32_t lat_e7, int32_t lon_e7, uint32_t now_ms);
-
 #if defined(GNSS_PROVIDER_UBLOX)
   static constexpr uint32_t kNoDataHintDelayMs = 5000U;
   static constexpr uint16_t kNmeaHintWindowBytes = 96U;
@@ -4,6 +4,7 @@
 #include <cstdlib>
 #include <cstring>
 
+#include "domain/flash_log.h"
 #include "platform/naviga_storage.h"
 #include "services/gnss_scenario_override.h"
 
@@ -61,6 +62,12 @@ const char* ProvisioningShell::radio_boot_result_str(int result_enum) {
   }
 }
 
+bool ProvisioningShell::take_flash_log_dump_request() {
+  const bool requested = flash_log_dump_requested_;
+  flash_log_dump_requested_ = false;
+  return requested;
+}
+
 bool ProvisioningShell::handle_line(const char* line,
                                     char* out_response,
                                     size_t out_response_size,
@@ -76,7 +83,7 @@ bool ProvisioningShell::handle_line(const char* line,
 
   if (std::strcmp(t0, "help") == 0) {
     std::snprintf(out_response, out_response_size,
-                  "help|status|get role|radio|profile|set role <0-2>|set radio <0>|profile interval|silence|distance <val>|reset|reboot|debug on|off|gnss ...");
+                  "help|status|get role|radio|profile|set role <0-2>|set radio <0>|profile interval|silence|distance <val>|reset|reboot|debug on|off|logfmt text|bin|flashlog stat|dump|erase|gnss ...");
     return true;
   }
   if (std::strcmp(t0, "debug") == 0) {
@@ -97,6 +104,57 @@ bool ProvisioningShell::handle_line(const char* line,
     std::snprintf(out_response, out_response_size, "ERR: debug on|off");
     return true;
   }
+  if (std::strcmp(t0, "logfmt") == 0) {
+    if (!log_binary_flag_) {
+      std::snprintf(out_response, out_response_size, "ERR: log export not available");
+      return true;
+    }
+    if (std::strcmp(t1, "text") == 0) {
+      *log_binary_flag_ = false;
+      std::snprintf(out_response, out_response_size, "OK; logfmt text");
+      return true;
+    }
+    if (std::strcmp(t1, "bin") == 0) {
+      *log_binary_flag_ = true;
+      std::snprintf(out_response, out_response_size, "OK; logfmt bin (COBS+CRC16 frames)");
+      return true;
+    }
+    std::snprintf(out_response, out_response_size, "ERR: logfmt text|bin");
+    return true;
+  }
+  if (std::strcmp(t0, "flashlog") == 0) {
+    if (!flash_log_ || !flash_log_->is_mounted()) {
+      std::snprintf(out_response, out_response_size, "ERR: flash log not available");
+      return true;
+    }
+    if (std::strcmp(t1, "stat") == 0) {
+      const domain::FlashLogStats& st = flash_log_->stats();
+      std::snprintf(out_response, out_response_size,
+                    "flashlog appended=%lu dropped=%lu flushes=%lu erased=%lu pending=%lu",
+                    static_cast<unsigned long>(st.records_appended),
+                    static_cast<unsigned long>(st.records_dropped),
+                    static_cast<unsigned long>(st.flushes),
+                    static_cast<unsigned long>(st.sectors_erased),
+                    static_cast<unsigned long>(flash_log_->pending_bytes()));
+      return true;
+    }
+    if (std::strcmp(t1, "dump") == 0) {
+      // Response is printed after the binary stream (COBS+CRC16 frames, see domain/log_frame.h).
+      flash_log_dump_requested_ = true;
+      std::snprintf(out_response, out_response_size, "OK; flashlog dump end");
+      return true;
+    }
+    if (std::strcmp(t1, "erase") == 0) {
+      if (!flash_log_->format()) {
+        std::snprintf(out_response, out_response_size, "ERR: flash log erase failed");
+        return true;
+      }
+      std::snprintf(out_response, out_response_size, "OK; flash log erased");
+      return true;
+    }
+    std::snprintf(out_response, out_response_size, "ERR: flashlog stat|dump|erase");
+    return true;
+  }
   if (std::strcmp(t0, "status") == 0) {
     PersistedPointers ptrs{};
     const bool loaded = load_pointers(&ptrs);
@@ -5,6 +5,10 @@
 
 namespace naviga {
 
+namespace domain {
+class FlashLog;
+} // namespace domain
+
 /**
  * Platform-agnostic provisioning command handler per provisioning_interface_v0.
  * No platform I/O or SoC APIs; uses naviga_storage for load/save/reset.
@@ -21,6 +25,15 @@ class ProvisioningShell {
   /** Optional: when set, "debug on" / "debug off" toggle *flag (e.g. instrumentation logging). */
   void set_instrumentation_flag(bool* flag) { instrumentation_flag_ = flag; }
 
+  /** Optional: when set, "logfmt text|bin" selects event log UART export format (*flag true = binary COBS frames). */
+  void set_log_binary_flag(bool* flag) { log_binary_flag_ = flag; }
+
+  /** Optional: when set, "flashlog stat|dump|erase" operate on the persistent event log. */
+  void set_flash_log(domain::FlashLog* log) { flash_log_ = log; }
+
+  /** True once after "flashlog dump": adapter streams the log as binary frames, then clears. */
+  bool take_flash_log_dump_request();
+
   /** Optional: when set, "gnss off|nofix|fix <lat_e7> <lon_e7>|move <dlat_e7> <dlon_e7>" control scenario override (#288). */
   void set_gnss_override(class GnssScenarioOverride* ptr) { gnss_override_ = ptr; }
 
@@ -40,6 +53,9 @@ class ProvisioningShell {
   int radio_boot_result_ = 0;
   char radio_boot_message_[48] = {};
   bool* instrumentation_flag_ = nullptr;
+  bool* log_binary_flag_ = nullptr;
+  domain::FlashLog* flash_log_ = nullptr;
+  bool flash_log_dump_requested_ = false;
   class GnssScenarioOverride* gnss_override_ = nullptr;
 };
 
@@ -4,11 +4,18 @@
 
 namespace naviga {
 
+constexpr size_t SelfUpdatePolicy::kVelocityWindow;
+constexpr double SelfUpdatePolicy::kVelocityDeadbandMps;
+
 void SelfUpdatePolicy::init() {
   has_commit_ = false;
   last_committed_ms_ = 0;
   last_lat_e7_ = 0;
   last_lon_e7_ = 0;
+  last_h_acc_mm_ = 0;
+  velocity_ = protocol::PosVelocity{};
+  fix_count_ = 0;
+  fix_head_ = 0;
 }
 
 void SelfUpdatePolicy::set_max_silence_ms(uint32_t max_silence_ms) {
@@ -23,24 +30,89 @@ void SelfUpdatePolicy::set_min_distance_m(double min_distance_m) {
   min_distance_m_ = min_distance_m;
 }
 
+void SelfUpdatePolicy::set_predictive(bool enabled) {
+  predictive_ = enabled;
+  velocity_ = protocol::PosVelocity{};
+}
+
+void SelfUpdatePolicy::set_accuracy_gate(bool enabled) {
+  accuracy_gate_ = enabled;
+}
+
+protocol::PosQuality SelfUpdatePolicy::pos_quality(const GnssSnapshot& snapshot) {
+  const uint8_t fix_type = snapshot.fix_state == GNSSFixState::FIX_3D   ? protocol::kPosFix3D
+                           : snapshot.fix_state == GNSSFixState::FIX_2D ? protocol::kPosFix2D
+                                                                        : protocol::kPosFixNone;
+  if (!snapshot.quality_valid) {
+    return protocol::make_pos_quality(fix_type, 0, 0, 0);
+  }
+  return protocol::make_pos_quality(fix_type, snapshot.num_sv, snapshot.h_acc_mm, snapshot.g_speed_mm_s);
+}
+
+void SelfUpdatePolicy::note_fix(const GnssSnapshot& snapshot) {
+  // One entry per fix: the provider may hand out the same snapshot more than once.
+  const Fix& newest = fixes_[(fix_head_ + kVelocityWindow - 1) % kVelocityWindow];
+  if (fix_count_ > 0 && newest.ms == snapshot.last_fix_ms) {
+    return;
+  }
+  fixes_[fix_head_] = {snapshot.last_fix_ms, snapshot.lat_e7, snapshot.lon_e7};
+  fix_head_ = (fix_head_ + 1) % kVelocityWindow;
+  if (fix_count_ < kVelocityWindow) {
+    fix_count_++;
+  }
+}
+
+protocol::PosVelocity SelfUpdatePolicy::measure_velocity() const {
+  if (fix_count_ < 2) {
+    return protocol::PosVelocity{};
+  }
+  const Fix& oldest = fixes_[(fix_head_ + kVelocityWindow - fix_count_) % kVelocityWindow];
+  const Fix& newest = fixes_[(fix_head_ + kVelocityWindow - 1) % kVelocityWindow];
+  const uint32_t dt_ms = newest.ms - oldest.ms;
+  if (dt_ms == 0 ||
+      distance_m_e7(oldest.lat_e7, oldest.lon_e7, newest.lat_e7, newest.lon_e7) <
+          kVelocityDeadbandMps * static_cast<double>(dt_ms) / 1000.0) {
+    return protocol::PosVelocity{};
+  }
+  return protocol::pos_velocity_from_e7(oldest.lat_e7, oldest.lon_e7, newest.lat_e7, newest.lon_e7,
+                                        dt_ms);
+}
+
 SelfUpdateDecision SelfUpdatePolicy::evaluate(uint32_t now_ms, const GnssSnapshot& snapshot) {
   if (!snapshot.pos_valid) {
     return {SelfUpdateReason::NONE, 0.0, 0};
   }
 
+  if (predictive_) {
+    note_fix(snapshot);
+  }
+
   if (!has_commit_) {
     return {SelfUpdateReason::FIRST_FIX, 0.0, 0};
   }
 
   const uint32_t dt_ms = now_ms - last_committed_ms_;
+  // Predictive: distance from where receivers place us now, not from the last commit.
+  int32_t ref_lat_e7 = last_lat_e7_;
+  int32_t ref_lon_e7 = last_lon_e7_;
+  if (predictive_) {
+    protocol::pos_predict_e7(last_lat_e7_, last_lon_e7_, velocity_, dt_ms, &ref_lat_e7, &ref_lon_e7);
+  }
   const double distance_m =
-      distance_m_e7(last_lat_e7_, last_lon_e7_, snapshot.lat_e7, snapshot.lon_e7);
+      distance_m_e7(ref_lat_e7, ref_lon_e7, snapshot.lat_e7, snapshot.lon_e7);
 
   if (max_silence_ms_ > 0 && dt_ms >= max_silence_ms_) {
     return {SelfUpdateReason::MAX_SILENCE, distance_m, dt_ms};
   }
 
-  if (dt_ms >= min_time_ms_ && distance_m >= min_distance_m_) {
+  double threshold_m = min_distance_m_;
+  if (accuracy_gate_ && snapshot.quality_valid) {
+    const double error_m = static_cast<double>(last_h_acc_mm_ + snapshot.h_acc_mm) / 1000.0;
+    if (error_m > threshold_m) {
+      threshold_m = error_m;
+    }
+  }
+  if (dt_ms >= min_time_ms_ && distance_m >= threshold_m) {
     return {SelfUpdateReason::DISTANCE, distance_m, dt_ms};
   }
 
@@ -52,6 +124,12 @@ void SelfUpdatePolicy::commit(uint32_t now_ms, const GnssSnapshot& snapshot) {
   last_committed_ms_ = now_ms;
   last_lat_e7_ = snapshot.lat_e7;
   last_lon_e7_ = snapshot.lon_e7;
+  last_h_acc_mm_ = snapshot.quality_valid ? snapshot.h_acc_mm : 0;
+  if (predictive_) {
+    const bool stopped = snapshot.quality_valid &&
+                         snapshot.g_speed_mm_s < static_cast<uint32_t>(kVelocityDeadbandMps * 1000.0);
+    velocity_ = stopped ? protocol::PosVelocity{} : measure_velocity();
+  }
 }
 
 } // namespace naviga
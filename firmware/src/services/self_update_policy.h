@@ -3,6 +3,8 @@
 #include <cstdint>
 
 #include "naviga/hal/interfaces.h"
+#include "../../protocol/pos_full_codec.h"
+#include "../../protocol/pos_predict.h"
 
 namespace naviga {
 
@@ -28,10 +30,43 @@ class SelfUpdatePolicy {
   void set_min_time_ms(uint32_t min_time_ms);
   /** Role-derived: min displacement (m) before next position commit; Person 25, Dog 15, Infra 100. */
   void set_min_distance_m(double min_distance_m);
+  /**
+   * Dead reckoning (protocol/pos_predict.h): DISTANCE once the position receivers extrapolate
+   * from the last commit and its velocity() is min_distance_m off, instead of once the node
+   * has moved that far. A node moving steadily then only commits at max silence. Off by default.
+   */
+  void set_predictive(bool enabled);
+  bool predictive() const { return predictive_; }
+  /**
+   * Accuracy gate: DISTANCE also needs the fix to leave the error circles, i.e. a move of at
+   * least hAcc at the last commit + hAcc now (GnssSnapshot::h_acc_mm). A stationary receiver
+   * wandering under poor sky then stays put. No effect while the provider reports no quality.
+   * Off by default.
+   */
+  void set_accuracy_gate(bool enabled);
+  bool accuracy_gate() const { return accuracy_gate_; }
   SelfUpdateDecision evaluate(uint32_t now_ms, const GnssSnapshot& snapshot);
   void commit(uint32_t now_ms, const GnssSnapshot& snapshot);
+  /** Velocity taken with the last commit (predictive only; zero when slower than the deadband). */
+  const protocol::PosVelocity& velocity() const { return velocity_; }
+
+  /** Pos_Quality of snapshot (protocol::make_pos_quality); 2D fix only when it has no quality. */
+  static protocol::PosQuality pos_quality(const GnssSnapshot& snapshot);
+
+  /** Fixes the velocity is measured over (1 Hz GNSS: a 4 s baseline). */
+  static constexpr size_t kVelocityWindow = 5;
+  /** Slower than this over the window, or by reported ground speed, counts as stationary. */
+  static constexpr double kVelocityDeadbandMps = 0.5;
 
  private:
+  struct Fix {
+    uint32_t ms;
+    int32_t lat_e7;
+    int32_t lon_e7;
+  };
+  void note_fix(const GnssSnapshot& snapshot);
+  protocol::PosVelocity measure_velocity() const;
+
   bool has_commit_ = false;
   uint32_t last_committed_ms_ = 0;
   int32_t last_lat_e7_ = 0;
@@ -39,6 +74,13 @@ class SelfUpdatePolicy {
   uint32_t max_silence_ms_ = 72000;
   uint32_t min_time_ms_ = 18000;
   double min_distance_m_ = 25.0;
+  bool predictive_ = false;
+  bool accuracy_gate_ = false;
+  uint32_t last_h_acc_mm_ = 0;  ///< hAcc of the last commit; 0 = unknown.
+  protocol::PosVelocity velocity_{};
+  Fix fixes_[kVelocityWindow] = {};
+  size_t fix_count_ = 0;
+  size_t fix_head_ = 0;  ///< Next slot to write; the newest fix is just before it.
 };
 
 } // namespace naviga
@@ -1,5 +1,7 @@
 #include "services/ubx_nav_pvt_parser.h"
 
+#include <cstring>
+
 namespace naviga {
 
 constexpr uint8_t UbxStreamParser::kSync1;
@@ -8,6 +10,8 @@ constexpr uint8_t UbxStreamParser::kClassNav;
 constexpr uint8_t UbxStreamParser::kIdNavPvt;
 constexpr uint16_t UbxStreamParser::kNavPvtPayloadLen;
 constexpr size_t UbxStreamParser::kMaxPayloadLen;
+constexpr uint8_t UbxNavPvt::kValidTime;
+constexpr uint8_t UbxNavPvt::kFlagGnssFixOk;
 
 namespace {
 
@@ -19,6 +23,11 @@ inline int32_t read_i32_le(const uint8_t* p) {
   return static_cast<int32_t>(raw);
 }
 
+inline bool is_nav_pvt(const UbxFrameView& frame) {
+  return frame.msg_class == UbxStreamParser::kClassNav && frame.msg_id == UbxStreamParser::kIdNavPvt &&
+         frame.payload && frame.payload_len == UbxStreamParser::kNavPvtPayloadLen;
+}
+
 } // namespace
 
 void UbxStreamParser::reset() {
@@ -119,6 +128,110 @@ UbxParseStatus UbxStreamParser::push_byte(uint8_t byte, UbxFrameView* out_frame)
   return UbxParseStatus::None;
 }
 
+size_t UbxStreamParser::push_bytes(const uint8_t* data,
+                                   size_t len,
+                                   UbxFrameView* out_frame,
+                                   UbxParseStatus* out_status) {
+  UbxParseStatus status = UbxParseStatus::None;
+  size_t i = 0;
+  if (!data || !out_frame) {
+    reset();
+    i = len;
+  }
+  while (i < len && status == UbxParseStatus::None) {
+    if (state_ == State::kWaitSync1) {
+      const void* sync = std::memchr(data + i, kSync1, len - i);
+      if (!sync) {
+        i = len;
+        break;
+      }
+      i = static_cast<size_t>(static_cast<const uint8_t*>(sync) - data) + 1;
+      state_ = State::kWaitSync2;
+    } else if (state_ == State::kPayload) {
+      size_t n = static_cast<size_t>(payload_len_ - payload_pos_);
+      if (n > len - i) {
+        n = len - i;
+      }
+      const uint8_t* src = data + i;
+      uint8_t* dst = payload_ + payload_pos_;
+      uint8_t ck_a = ck_a_;
+      uint8_t ck_b = ck_b_;
+      for (size_t k = 0; k < n; ++k) {
+        const uint8_t v = src[k];
+        dst[k] = v;
+        ck_a = static_cast<uint8_t>(ck_a + v);
+        ck_b = static_cast<uint8_t>(ck_b + ck_a);
+      }
+      ck_a_ = ck_a;
+      ck_b_ = ck_b;
+      payload_pos_ = static_cast<uint16_t>(payload_pos_ + n);
+      i += n;
+      if (payload_pos_ >= payload_len_) {
+        state_ = State::kCkA;
+      }
+    } else {
+      status = push_byte(data[i++], out_frame);
+    }
+  }
+  if (out_status) {
+    *out_status = status;
+  }
+  return i;
+}
+
+bool parse_nav_pvt(const UbxFrameView& frame, UbxNavPvt* out) {
+  if (!out || !is_nav_pvt(frame)) {
+    return false;
+  }
+
+  // UBX-NAV-PVT offsets in payload (u-blox 8): iTOW @ 0, valid @ 11, fixType @ 20, flags @ 21,
+  // numSV @ 23, lon @ 24, lat @ 28, hAcc @ 40, gSpeed @ 60.
+  const uint8_t* p = frame.payload;
+  out->itow_ms = static_cast<uint32_t>(read_i32_le(p));
+  out->valid = p[11];
+  out->fix_type = p[20];
+  out->flags = p[21];
+  out->num_sv = p[23];
+  out->lon_e7 = read_i32_le(p + 24);
+  out->lat_e7 = read_i32_le(p + 28);
+  out->h_acc_mm = static_cast<uint32_t>(read_i32_le(p + 40));
+  out->g_speed_mm_s = read_i32_le(p + 60);
+  return true;
+}
+
+void apply_nav_pvt(const UbxNavPvt& pvt, uint32_t now_ms, GnssSnapshot* snapshot) {
+  if (!snapshot) {
+    return;
+  }
+  GNSSFixState fix_state = GNSSFixState::NO_FIX;
+  if ((pvt.flags & UbxNavPvt::kFlagGnssFixOk) != 0) {
+    if (pvt.fix_type == 2U) {
+      fix_state = GNSSFixState::FIX_2D;
+    } else if (pvt.fix_type >= 3U && pvt.fix_type <= 4U) {
+      fix_state = GNSSFixState::FIX_3D;
+    }
+  }
+
+  snapshot->fix_state = fix_state;
+  snapshot->pos_valid = (fix_state != GNSSFixState::NO_FIX);
+  snapshot->quality_valid = true;
+  snapshot->num_sv = pvt.num_sv;
+  snapshot->h_acc_mm = pvt.h_acc_mm;
+  snapshot->g_speed_mm_s = pvt.g_speed_mm_s > 0 ? static_cast<uint32_t>(pvt.g_speed_mm_s) : 0U;
+  if (snapshot->pos_valid) {
+    snapshot->lat_e7 = pvt.lat_e7;
+    snapshot->lon_e7 = pvt.lon_e7;
+    // Policy: update last_fix_ms on each valid position sample.
+    snapshot->last_fix_ms = now_ms;
+  }
+
+  snapshot->time_valid = (pvt.valid & UbxNavPvt::kValidTime) != 0;
+  if (snapshot->time_valid) {
+    snapshot->tow_ms = pvt.itow_ms;
+    snapshot->tow_at_ms = now_ms;
+  }
+}
+
 bool parse_nav_pvt_fix_lat_lon(const UbxFrameView& frame,
                                uint8_t* out_fix_type,
                                int32_t* out_lat_e7,
@@ -126,19 +239,25 @@ bool parse_nav_pvt_fix_lat_lon(const UbxFrameView& frame,
   if (!out_fix_type || !out_lat_e7 || !out_lon_e7) {
     return false;
   }
-  if (frame.msg_class != UbxStreamParser::kClassNav || frame.msg_id != UbxStreamParser::kIdNavPvt) {
+  UbxNavPvt pvt;
+  if (!parse_nav_pvt(frame, &pvt)) {
     return false;
   }
-  if (!frame.payload || frame.payload_len != UbxStreamParser::kNavPvtPayloadLen) {
+  *out_fix_type = pvt.fix_type;
+  *out_lat_e7 = pvt.lat_e7;
+  *out_lon_e7 = pvt.lon_e7;
+  return true;
+}
+
+bool parse_nav_pvt_itow(const UbxFrameView& frame, uint32_t* out_itow_ms) {
+  if (!out_itow_ms) {
     return false;
   }
-
-  // UBX-NAV-PVT offsets in payload (u-blox 8):
-  // fixType @ 20, lon @ 24, lat @ 28.
-  const uint8_t* p = frame.payload;
-  *out_fix_type = p[20];
-  *out_lon_e7 = read_i32_le(p + 24);
-  *out_lat_e7 = read_i32_le(p + 28);
+  UbxNavPvt pvt;
+  if (!parse_nav_pvt(frame, &pvt) || (pvt.valid & UbxNavPvt::kValidTime) == 0) {
+    return false;
+  }
+  *out_itow_ms = pvt.itow_ms;
   return true;
 }
 
@@ -3,6 +3,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "naviga/hal/interfaces.h"
+
 namespace naviga {
 
 struct UbxFrameView {
@@ -28,6 +30,13 @@ class UbxStreamParser {
   static constexpr size_t kMaxPayloadLen = 128;
 
   UbxParseStatus push_byte(uint8_t byte, UbxFrameView* out_frame);
+  /**
+   * Block entry point, same result as push_byte over data[0..len): feeds bytes until a frame
+   * ends and returns how many it consumed, with *out_status FrameOk / FrameBadChecksum for that
+   * frame (None when data ran out first). The sync byte is searched with memchr and payload
+   * spans are copied and checksummed in one pass. out_frame stays valid until the next push.
+   */
+  size_t push_bytes(const uint8_t* data, size_t len, UbxFrameView* out_frame, UbxParseStatus* out_status);
 
  private:
   enum class State : uint8_t {
@@ -56,9 +65,38 @@ class UbxStreamParser {
   uint8_t rx_ck_a_ = 0;
 };
 
+/** UBX-NAV-PVT fields the firmware uses (u-blox 8 payload offsets in parse_nav_pvt). */
+struct UbxNavPvt {
+  static constexpr uint8_t kValidTime = 0x02;     ///< valid: iTOW is GNSS time.
+  static constexpr uint8_t kFlagGnssFixOk = 0x01; ///< flags: fix within DOP/accuracy masks.
+
+  uint32_t itow_ms = 0;     ///< GPS time of week, ms.
+  uint8_t valid = 0;        ///< validDate [0], validTime [1], fullyResolved [2].
+  uint8_t fix_type = 0;     ///< 0 none, 1 DR only, 2 2D, 3 3D, 4 GNSS+DR, 5 time only.
+  uint8_t flags = 0;        ///< gnssFixOK [0], diffSoln [1], ...
+  uint8_t num_sv = 0;       ///< Satellites used in the solution.
+  int32_t lon_e7 = 0;
+  int32_t lat_e7 = 0;
+  uint32_t h_acc_mm = 0;    ///< Horizontal accuracy estimate.
+  int32_t g_speed_mm_s = 0; ///< Ground speed (2D).
+};
+
+/** Decode a NAV-PVT frame; false for any other message or a short payload. */
+bool parse_nav_pvt(const UbxFrameView& frame, UbxNavPvt* out);
+
+/**
+ * Fold a decoded NAV-PVT solution into a GNSS snapshot. A fix counts (FIX_2D/FIX_3D) only when
+ * the receiver also sets gnssFixOK: without it u-blox flags the position as outside its masks.
+ * Fills the quality fields (num_sv, h_acc_mm, g_speed_mm_s) for every solution.
+ */
+void apply_nav_pvt(const UbxNavPvt& pvt, uint32_t now_ms, GnssSnapshot* snapshot);
+
 bool parse_nav_pvt_fix_lat_lon(const UbxFrameView& frame,
                                uint8_t* out_fix_type,
                                int32_t* out_lat_e7,
                                int32_t* out_lon_e7);
 
+/** NAV-PVT iTOW (GPS time of week, ms); false unless the receiver flags the time valid. */
+bool parse_nav_pvt_itow(const UbxFrameView& frame, uint32_t* out_itow_ms);
+
 } // namespace naviga
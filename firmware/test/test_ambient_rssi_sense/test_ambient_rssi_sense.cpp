@@ -0,0 +1,225 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "../../src/services/ambient_rssi_sense.h"
+#include "../../src/services/ambient_rssi_sense.cpp"
+#include "../../src/domain/noise_floor.cpp"
+
+using naviga::AmbientRssiSense;
+using naviga::ChannelSenseResult;
+using naviga::ChannelSenseState;
+using naviga::IRadioCmdIo;
+using naviga::platform::IClock;
+using naviga::platform::millis_t;
+
+namespace {
+
+/** Module UART: answers each read-noise command with the next queued RSSI byte. */
+class MockRadioUart : public IRadioCmdIo {
+ public:
+  std::vector<uint8_t> written;
+  std::deque<uint8_t> rx;
+  std::deque<int> replies;  ///< Raw RSSI byte per command; -1 = no reply.
+  bool bad_header = false;
+  size_t drop_len = 0;  ///< Late reply recv() would drop (drop_late_reply).
+
+  int available() override { return static_cast<int>(rx.size()); }
+  int peek_byte() override { return rx.empty() ? -1 : rx.front(); }
+  int read_byte() override {
+    if (rx.empty()) {
+      return -1;
+    }
+    const uint8_t b = rx.front();
+    rx.pop_front();
+    return b;
+  }
+  size_t write_bytes(const uint8_t* data, size_t len) override {
+    written.insert(written.end(), data, data + len);
+    drop_len = 0;
+    if (!replies.empty()) {
+      const int v = replies.front();
+      replies.pop_front();
+      if (v >= 0) {
+        rx.push_back(bad_header ? 0x55 : 0xC1);
+        rx.push_back(0x00);
+        rx.push_back(0x01);
+        rx.push_back(static_cast<uint8_t>(v));
+      }
+    }
+    return len;
+  }
+  void drop_late_reply(uint8_t first_byte, size_t reply_len) override {
+    TEST_ASSERT_EQUAL_HEX8(0xC1, first_byte);
+    drop_len = reply_len;
+  }
+};
+
+class FakeClock : public IClock {
+ public:
+  millis_t uptime_ms() const override { return now_ms; }
+  void sleep_ms(millis_t duration_ms) const override { now_ms += duration_ms; }
+  mutable millis_t now_ms = 1000;
+};
+
+uint8_t rssi_byte(int dbm) {
+  return static_cast<uint8_t>(256 + dbm);
+}
+
+} // namespace
+
+void test_reads_ambient_noise_and_tracks_floor() {
+  MockRadioUart uart;
+  FakeClock clock;
+  AmbientRssiSense sense;
+  TEST_ASSERT_FALSE(sense.can_sense());
+  sense.set_io(&uart, &clock);
+  TEST_ASSERT_TRUE(sense.can_sense());
+
+  uart.replies = {rssi_byte(-110), rssi_byte(-112), rssi_byte(-90), rssi_byte(-108)};
+  ChannelSenseResult r = sense.sense(20);
+  TEST_ASSERT_EQUAL(ChannelSenseState::IDLE, r.state);
+  TEST_ASSERT_EQUAL_INT16(-110, r.noise_dbm);
+  const uint8_t cmd[] = {0xC0, 0xC1, 0xC2, 0xC3, 0x00, 0x01};
+  TEST_ASSERT_EQUAL_UINT32(sizeof(cmd), uart.written.size());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(cmd, uart.written.data(), sizeof(cmd));
+
+  TEST_ASSERT_EQUAL(ChannelSenseState::IDLE, sense.sense(20).state);
+  TEST_ASSERT_EQUAL_INT16(-111, sense.noise_floor().floor_dbm());  // halfway down
+
+  r = sense.sense(20);
+  TEST_ASSERT_EQUAL(ChannelSenseState::BUSY, r.state);  // frame on air: 21 dB over floor
+  TEST_ASSERT_EQUAL_INT16(-90, r.noise_dbm);
+  TEST_ASSERT_EQUAL_INT16(-111, sense.noise_floor().floor_dbm());
+  TEST_ASSERT_EQUAL(ChannelSenseState::IDLE, sense.sense(20).state);  // within margin
+}
+
+void test_persistent_carrier_raises_floor() {
+  MockRadioUart uart;
+  FakeClock clock;
+  AmbientRssiSense sense;
+  sense.set_io(&uart, &clock);
+  uart.replies = {rssi_byte(-115)};
+  sense.sense(20);
+
+  int busy = 0;
+  for (int i = 0; i < 64; ++i) {
+    uart.replies.push_back(rssi_byte(-95));
+    if (sense.sense(20).state == ChannelSenseState::BUSY) {
+      busy++;
+    } else {
+      break;
+    }
+  }
+  TEST_ASSERT_TRUE(busy > naviga::domain::NoiseFloor::kMaxBusyRun);
+  TEST_ASSERT_TRUE(busy < 64);  // the carrier became the floor
+}
+
+void test_pending_rx_is_busy_without_command() {
+  MockRadioUart uart;
+  FakeClock clock;
+  AmbientRssiSense sense;
+  sense.set_io(&uart, &clock);
+  uart.rx = {0x08, 0x11};
+  TEST_ASSERT_EQUAL(ChannelSenseState::BUSY, sense.sense(20).state);
+  TEST_ASSERT_EQUAL_UINT32(0, uart.written.size());
+  TEST_ASSERT_EQUAL_UINT32(2, uart.rx.size());  // frame left for recv()
+}
+
+/** A frame that reaches the UART between the command and the reply. */
+class RacingRadioUart : public MockRadioUart {
+ public:
+  size_t write_bytes(const uint8_t* data, size_t len) override {
+    rx.push_back(0x0F);
+    rx.push_back(0x0C);
+    return MockRadioUart::write_bytes(data, len);
+  }
+};
+
+void test_frame_after_command_is_busy_and_reply_dropped() {
+  RacingRadioUart uart;
+  FakeClock clock;
+  AmbientRssiSense sense;
+  sense.set_io(&uart, &clock);
+  for (uint8_t i = 0; i < 2 * AmbientRssiSense::kMaxErrorRun; ++i) {
+    uart.rx.clear();
+    uart.replies = {rssi_byte(-60)};
+    TEST_ASSERT_EQUAL(ChannelSenseState::BUSY, sense.sense(20).state);
+    TEST_ASSERT_EQUAL_UINT32(6, uart.rx.size());
+    TEST_ASSERT_EQUAL_UINT8(0x0F, uart.rx.front());  // frame bytes still first for recv()
+    TEST_ASSERT_EQUAL_UINT32(4, uart.drop_len);       // reply behind them is not a frame
+  }
+  TEST_ASSERT_TRUE(sense.can_sense());  // interleaved RX is not an error
+
+  // recv() took the frame; the stale reply at the head is dropped before the next query.
+  uart.rx.pop_front();
+  uart.rx.pop_front();
+  uart.replies = {rssi_byte(-110)};
+  const size_t written = uart.written.size();
+  TEST_ASSERT_EQUAL(ChannelSenseState::BUSY, sense.sense(20).state);  // races again
+  TEST_ASSERT_EQUAL_UINT32(written + 6, uart.written.size());
+  TEST_ASSERT_EQUAL_UINT32(6, uart.rx.size());
+  TEST_ASSERT_EQUAL_UINT8(rssi_byte(-110), uart.rx.back());  // only the new reply is left
+}
+
+void test_no_reply_times_out_then_holds_off() {
+  MockRadioUart uart;
+  FakeClock clock;
+  AmbientRssiSense sense;
+  sense.set_io(&uart, &clock);
+
+  uart.replies = {-1};
+  const millis_t start = clock.now_ms;
+  TEST_ASSERT_EQUAL(ChannelSenseState::ERROR, sense.sense(20).state);
+  TEST_ASSERT_EQUAL_UINT32(20, clock.now_ms - start);
+  TEST_ASSERT_EQUAL_UINT32(4, uart.drop_len);
+
+  // The reply arrives late: dropped, and the next query reads its own answer.
+  uart.rx = {0xC1, 0x00, 0x01, rssi_byte(-60)};
+  uart.replies = {rssi_byte(-100)};
+  ChannelSenseResult r = sense.sense(20);
+  TEST_ASSERT_EQUAL(ChannelSenseState::IDLE, r.state);
+  TEST_ASSERT_EQUAL_INT16(-100, r.noise_dbm);
+  TEST_ASSERT_EQUAL_UINT32(0, uart.rx.size());
+
+  // A frame byte where the reply should start: BUSY, left for recv(), not counted.
+  uart.bad_header = true;
+  uart.replies = {rssi_byte(-100)};
+  TEST_ASSERT_EQUAL(ChannelSenseState::BUSY, sense.sense(20).state);
+  TEST_ASSERT_EQUAL_UINT32(4, uart.rx.size());
+  uart.bad_header = false;
+  uart.rx.clear();
+
+  for (uint8_t i = 0; i < AmbientRssiSense::kMaxErrorRun; ++i) {
+    TEST_ASSERT_TRUE(sense.can_sense());
+    TEST_ASSERT_EQUAL(ChannelSenseState::ERROR, sense.sense(20).state);
+  }
+  TEST_ASSERT_FALSE(sense.can_sense());
+  TEST_ASSERT_EQUAL(ChannelSenseState::UNSUPPORTED, sense.sense(20).state);
+
+  // After the hold-off one query is tried; silence holds off again.
+  clock.now_ms += AmbientRssiSense::kRetryHoldoffMs;
+  TEST_ASSERT_TRUE(sense.can_sense());
+  TEST_ASSERT_EQUAL(ChannelSenseState::ERROR, sense.sense(20).state);
+  TEST_ASSERT_FALSE(sense.can_sense());
+
+  // A reply after the next hold-off ends the error run.
+  clock.now_ms += AmbientRssiSense::kRetryHoldoffMs;
+  uart.replies = {rssi_byte(-100)};
+  TEST_ASSERT_EQUAL(ChannelSenseState::IDLE, sense.sense(20).state);
+  uart.replies = {-1};
+  TEST_ASSERT_EQUAL(ChannelSenseState::ERROR, sense.sense(20).state);
+  TEST_ASSERT_TRUE(sense.can_sense());
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_reads_ambient_noise_and_tracks_floor);
+  RUN_TEST(test_persistent_carrier_raises_floor);
+  RUN_TEST(test_pending_rx_is_busy_without_command);
+  RUN_TEST(test_frame_after_command_is_busy_and_reply_dropped);
+  RUN_TEST(test_no_reply_times_out_then_holds_off);
+  return UNITY_END();
+}
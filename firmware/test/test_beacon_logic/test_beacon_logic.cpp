@@ -1,11 +1,17 @@
 #include <unity.h>
 
+#include <cmath>
 #include <cstdint>
 
 #include "../../src/domain/beacon_logic.h"
 #include "../../src/domain/beacon_logic.cpp"
+#include "../../src/domain/airtime_budget.cpp"
+#include "../../src/domain/airtime_model.cpp"
+#include "../../src/domain/channel_load.cpp"
 #include "../../src/domain/node_table.h"
 #include "../../src/domain/node_table.cpp"
+#include "../../src/domain/link_stats.cpp"
+#include "../../src/domain/relay_policy.cpp"
 #include "../../protocol/geo_beacon_codec.h"
 #include "../../protocol/geo_beacon_codec.cpp"
 #include "../../protocol/alive_codec.h"
@@ -13,21 +19,31 @@
 #include "../../protocol/tail2_codec.h"
 #include "../../protocol/info_codec.h"
 #include "../../protocol/pos_full_codec.h"
+#include "../../protocol/bundle_codec.cpp"
+#include "../../protocol/fec_codec.cpp"
+#include "../../protocol/pos_delta_codec.cpp"
 #include "../../protocol/pos_full_codec.cpp"
+#include "../../protocol/short_addr_codec.cpp"
 #include "../../protocol/status_codec.h"
 #include "../../protocol/status_codec.cpp"
 
+using naviga::domain::AirtimeBudget;
 using naviga::domain::BeaconLogic;
+using naviga::domain::ChannelLoad;
 using naviga::domain::NodeTable;
 using naviga::domain::NodeEntry;
 using naviga::domain::PacketLogType;
+using naviga::domain::RelayDecision;
+using naviga::domain::RelayPolicy;
 using naviga::domain::SelfTelemetry;
 using naviga::domain::TrafficCounters;
 using naviga::domain::TxPriority;
 using naviga::domain::TxBestEffortClass;
+using naviga::domain::e220_airtime_us;
 using naviga::domain::kSlotPosFull;
 using naviga::domain::kSlotAlive;
 using naviga::domain::kSlotStatus;
+using naviga::domain::kSlotRelay;
 using naviga::protocol::AliveFields;
 using naviga::protocol::GeoBeaconFields;
 using naviga::protocol::Tail1Fields;
@@ -76,8 +92,8 @@ void test_tx_cadence() {
   GeoBeaconFields fields{};
   fields.node_id   = 0x0000334455667788ULL;
   fields.pos_valid = 1;
-  fields.lat_deg   = 55.7558;
-  fields.lon_deg   = 37.6173;
+  fields.lat_e7    = 557558000;
+  fields.lon_e7    = 376173000;
 
   uint8_t buffer[kTestBufSize] = {};
   size_t out_len = 0;
@@ -95,8 +111,8 @@ void test_seq16_default_first_packet_is_one() {
   GeoBeaconFields fields{};
   fields.node_id   = 0x0000334455667788ULL;
   fields.pos_valid = 1;
-  fields.lat_deg   = 55.7558;
-  fields.lon_deg   = 37.6173;
+  fields.lat_e7    = 557558000;
+  fields.lon_e7    = 376173000;
   uint8_t buffer[kTestBufSize] = {};
   size_t out_len = 0;
   TEST_ASSERT_TRUE(logic.build_tx(1000, fields, buffer, sizeof(buffer), &out_len));
@@ -113,8 +129,8 @@ void test_seq16_set_initial_then_first_packet_is_initial_plus_one() {
   GeoBeaconFields fields{};
   fields.node_id   = 0x0000334455667788ULL;
   fields.pos_valid = 1;
-  fields.lat_deg   = 55.7558;
-  fields.lon_deg   = 37.6173;
+  fields.lat_e7    = 557558000;
+  fields.lon_e7    = 376173000;
   uint8_t buffer[kTestBufSize] = {};
   size_t out_len = 0;
   TEST_ASSERT_TRUE(logic.build_tx(1000, fields, buffer, sizeof(buffer), &out_len));
@@ -130,8 +146,8 @@ void test_seq16_set_initial_100_first_packet_is_101() {
   GeoBeaconFields fields{};
   fields.node_id   = 1;
   fields.pos_valid = 1;
-  fields.lat_deg   = 0.0;
-  fields.lon_deg   = 0.0;
+  fields.lat_e7    = 0;
+  fields.lon_e7    = 0;
   uint8_t buffer[kTestBufSize] = {};
   size_t out_len = 0;
   TEST_ASSERT_TRUE(logic.build_tx(1000, fields, buffer, sizeof(buffer), &out_len));
@@ -146,8 +162,8 @@ void test_seq16_wraparound_first_packet_is_zero() {
   GeoBeaconFields fields{};
   fields.node_id   = 1;
   fields.pos_valid = 1;
-  fields.lat_deg   = 0.0;
-  fields.lon_deg   = 0.0;
+  fields.lat_e7    = 0;
+  fields.lon_e7    = 0;
   uint8_t buffer[kTestBufSize] = {};
   size_t out_len = 0;
   TEST_ASSERT_TRUE(logic.build_tx(1000, fields, buffer, sizeof(buffer), &out_len));
@@ -164,8 +180,8 @@ void test_tx_max_silence_triggers_core() {
   GeoBeaconFields fields{};
   fields.node_id   = 1;
   fields.pos_valid = 1;
-  fields.lat_deg   = 0.0;
-  fields.lon_deg   = 0.0;
+  fields.lat_e7    = 0;
+  fields.lon_e7    = 0;
 
   uint8_t buffer[kTestBufSize] = {};
   size_t out_len = 0;
@@ -215,8 +231,8 @@ void test_tx_min_interval_no_update_no_send() {
   GeoBeaconFields fields{};
   fields.node_id   = 1;
   fields.pos_valid = 1;
-  fields.lat_deg   = 0.0001;
-  fields.lon_deg   = 0.0002;
+  fields.lat_e7    = 1000;
+  fields.lon_e7    = 2000;
 
   uint8_t buffer[kTestBufSize] = {};
   size_t out_len = 1;
@@ -232,8 +248,8 @@ void test_tx_payload_correctness() {
   GeoBeaconFields fields{};
   fields.node_id   = 0x0000CCDDEEFF0011ULL;
   fields.pos_valid = 1;
-  fields.lat_deg   = 55.7558;
-  fields.lon_deg   = 37.6173;
+  fields.lat_e7    = 557558000;
+  fields.lon_e7    = 376173000;
 
   uint8_t buffer[kPosFullFrameSize] = {};
   size_t out_len = 0;
@@ -245,8 +261,8 @@ void test_tx_payload_correctness() {
       buffer + 2, out_len - 2, &decoded);
   TEST_ASSERT_EQUAL(naviga::protocol::PosFullDecodeError::Ok, err);
   TEST_ASSERT_EQUAL_UINT64(fields.node_id, decoded.node_id);
-  TEST_ASSERT_TRUE(decoded.lat_deg > 55.7557 && decoded.lat_deg < 55.7559);
-  TEST_ASSERT_TRUE(decoded.lon_deg > 37.6172 && decoded.lon_deg < 37.6174);
+  TEST_ASSERT_INT32_WITHIN(100, 557558000, decoded.lat_e7);  // u24 step ~107 e7
+  TEST_ASSERT_INT32_WITHIN(200, 376173000, decoded.lon_e7);
   TEST_ASSERT_EQUAL_UINT16(1, decoded.seq16);
 
   TEST_ASSERT_TRUE(logic.build_tx(20, fields, buffer, sizeof(buffer), &out_len));
@@ -283,8 +299,8 @@ void test_rx_pos_full_applies_position_and_quality() {
   naviga::protocol::PosFullFields pos{};
   pos.node_id = 0x0000112233445566ULL;
   pos.seq16 = 3;
-  pos.lat_deg = 55.0;
-  pos.lon_deg = 37.0;
+  pos.lat_e7 = 550000000;
+  pos.lon_e7 = 370000000;
   pos.fix_type = 2;
   pos.pos_sats = 10;
   pos.pos_accuracy_bucket = 4;
@@ -311,6 +327,72 @@ void test_rx_pos_full_applies_position_and_quality() {
   TEST_ASSERT_EQUAL_UINT8(138, entry.sats);      // 10 | ((4 & 0x06u) << 5)
 }
 
+void test_rx_pos_full_duplicate_seq_keeps_position() {
+  BeaconLogic logic;
+  NodeTable table;
+  naviga::protocol::PosFullFields pos{};
+  pos.node_id = 0x0000112233445566ULL;
+  pos.seq16 = 7;
+  pos.lat_e7 = 550000000;
+  pos.lon_e7 = 370000000;
+  pos.fix_type = 2;
+  pos.pos_sats = 10;
+  uint8_t frame[naviga::protocol::kPosFullFrameSize] = {};
+  size_t written = naviga::protocol::encode_pos_full_frame(pos, frame, sizeof(frame));
+  TEST_ASSERT_TRUE(logic.on_rx(2000, frame, written, -60, table));
+  NodeEntry first{};
+  TEST_ASSERT_TRUE(table.find_entry_for_test(pos.node_id, &first));
+
+  // Same seq16 with a different body: refreshes liveness only.
+  pos.lat_e7 = 560000000;
+  pos.pos_sats = 3;
+  written = naviga::protocol::encode_pos_full_frame(pos, frame, sizeof(frame));
+  TEST_ASSERT_TRUE(logic.on_rx(2500, frame, written, -61, table));
+  NodeEntry entry{};
+  TEST_ASSERT_TRUE(table.find_entry_for_test(pos.node_id, &entry));
+  TEST_ASSERT_EQUAL_INT32(first.lat_e7, entry.lat_e7);
+  TEST_ASSERT_EQUAL_UINT8(first.sats, entry.sats);
+  TEST_ASSERT_EQUAL_UINT32(2500, entry.last_seen_ms);
+
+  // Older seq16: same.
+  pos.seq16 = 6;
+  written = naviga::protocol::encode_pos_full_frame(pos, frame, sizeof(frame));
+  TEST_ASSERT_TRUE(logic.on_rx(3000, frame, written, -61, table));
+  TEST_ASSERT_TRUE(table.find_entry_for_test(pos.node_id, &entry));
+  TEST_ASSERT_EQUAL_INT32(first.lat_e7, entry.lat_e7);
+  TEST_ASSERT_EQUAL_UINT16(7, entry.last_core_seq16);
+
+  pos.seq16 = 8;
+  written = naviga::protocol::encode_pos_full_frame(pos, frame, sizeof(frame));
+  TEST_ASSERT_TRUE(logic.on_rx(3500, frame, written, -61, table));
+  TEST_ASSERT_TRUE(table.find_entry_for_test(pos.node_id, &entry));
+  TEST_ASSERT_INT32_WITHIN(200, 560000000, entry.lat_e7);
+  TEST_ASSERT_EQUAL_UINT16(8, entry.last_core_seq16);
+}
+
+void test_rx_status_max_silence_sets_peer_grey_threshold() {
+  BeaconLogic logic;
+  NodeTable table;
+  table.set_expected_interval_s(20);  // grey after 20 s + 5 s grace
+  naviga::protocol::StatusFields st{};
+  st.node_id = 0x0000AABBCCDDEE11ULL;
+  st.seq16 = 1;
+  st.max_silence_10s = 30;  // 300 s: grey after 300 s + 75 s grace
+  uint8_t frame[naviga::protocol::kStatusFrameSize] = {};
+  const size_t written = naviga::protocol::encode_status_frame(st, frame, sizeof(frame));
+  TEST_ASSERT_TRUE(logic.on_rx(1000, frame, written, -50, table));
+  TEST_ASSERT_TRUE(table.upsert_remote(0x0000AABBCCDDEE22ULL, false, 0, 0, 0, -50, 1, 1000));
+
+  NodeEntry quiet{};
+  NodeEntry plain{};
+  TEST_ASSERT_TRUE(table.find_entry_for_test(st.node_id, &quiet));
+  TEST_ASSERT_TRUE(table.find_entry_for_test(0x0000AABBCCDDEE22ULL, &plain));
+  TEST_ASSERT_FALSE(table.is_stale(quiet, 1000 + 200000));
+  TEST_ASSERT_TRUE(table.is_stale(plain, 1000 + 200000));
+  TEST_ASSERT_FALSE(table.is_stale(quiet, 1000 + 375000));
+  TEST_ASSERT_TRUE(table.is_stale(quiet, 1000 + 376000));
+}
+
 void test_rx_status_applies_full_snapshot() {
   BeaconLogic logic;
   NodeTable table;
@@ -342,6 +424,18 @@ void test_rx_status_applies_full_snapshot() {
   TEST_ASSERT_EQUAL_UINT8(6, entry.max_silence_10s);
   TEST_ASSERT_EQUAL_UINT16(0x0201, entry.hw_profile_id);
   TEST_ASSERT_EQUAL_UINT16(0x0403, entry.fw_version_id);
+  TEST_ASSERT_EQUAL_UINT8(0, entry.radio_caps);  // 19-byte payload: not advertised
+
+  // Status with the trailing radioCaps byte (20-byte payload).
+  st.seq16 = 6;
+  st.radio_caps = naviga::protocol::radio_caps_make(0x07, 1, false);
+  uint8_t caps_frame[naviga::protocol::kStatusMaxFrameSize] = {};
+  const size_t caps_len = naviga::protocol::encode_status_frame(st, caps_frame, sizeof(caps_frame));
+  TEST_ASSERT_EQUAL(naviga::protocol::kStatusMaxFrameSize, caps_len);
+  TEST_ASSERT_TRUE(logic.on_rx(4000, caps_frame, caps_len, -50, table));
+  TEST_ASSERT_TRUE(table.find_entry_for_test(st.node_id, &entry));
+  TEST_ASSERT_EQUAL_UINT16(6, entry.last_seq);
+  TEST_ASSERT_EQUAL_UINT8(st.radio_caps, entry.radio_caps);
 }
 
 // ── RX: Alive dispatch ──────────────────────────────────────────────────────
@@ -385,8 +479,8 @@ void test_rx_alive_does_not_overwrite_core_position() {
   naviga::protocol::PosFullFields pos{};
   pos.node_id = node_id;
   pos.seq16   = 1;
-  pos.lat_deg = 55.0;
-  pos.lon_deg = 37.0;
+  pos.lat_e7 = 550000000;
+  pos.lon_e7 = 370000000;
   pos.fix_type = 1;
   pos.pos_sats = 0;
   pos.pos_accuracy_bucket = 0;
@@ -475,6 +569,36 @@ void test_decode_header_accepts_0x06() {
                     static_cast<int>(hdr.msg_type));
 }
 
+void test_decode_header_accepts_only_registered_msgtypes() {
+  for (uint8_t mt = 0; mt < naviga::protocol::kMsgTypeCount; ++mt) {
+    const uint16_t h = static_cast<uint16_t>((mt << 9) | 9u);
+    const uint8_t frame[2] = {static_cast<uint8_t>(h & 0xFFu), static_cast<uint8_t>(h >> 8)};
+    naviga::protocol::PacketHeader hdr{};
+    const bool expected = mt == 0x02 || mt == 0x06 || mt == 0x07 || mt == 0x08 || mt == 0x09 ||
+                          mt == 0x0A;
+    TEST_ASSERT_EQUAL(expected, naviga::protocol::decode_header(frame, sizeof(frame), &hdr));
+    TEST_ASSERT_EQUAL(expected, naviga::protocol::msg_type_rx_accepted(mt));
+  }
+}
+
+void test_packet_log_type_names_and_counters() {
+  TEST_ASSERT_EQUAL_STRING("POS_FULL", naviga::domain::packet_log_type_str(PacketLogType::POS_FULL));
+  TEST_ASSERT_EQUAL_STRING("RELAY", naviga::domain::packet_log_type_str(PacketLogType::RELAY));
+  TEST_ASSERT_EQUAL_STRING("CORE", naviga::domain::packet_log_type_str(PacketLogType::CORE));
+
+  TrafficCounters c{};
+  naviga::domain::count_tx_sent(c, PacketLogType::POS_DELTA);
+  naviga::domain::count_tx_sent(c, PacketLogType::RELAY);
+  naviga::domain::count_tx_sent(c, PacketLogType::TAIL1);  // no slot: ignored
+  naviga::domain::count_rx_ok(c, PacketLogType::STATUS);
+  naviga::domain::count_rx_ok(c, PacketLogType::RELAY);    // no slot: ignored
+  TEST_ASSERT_EQUAL_UINT32(1, c.tx_sent_pos_delta);
+  TEST_ASSERT_EQUAL_UINT32(1, c.tx_sent_relay);
+  TEST_ASSERT_EQUAL_UINT32(0, c.tx_sent_pos_full + c.tx_sent_alive + c.tx_sent_status);
+  TEST_ASSERT_EQUAL_UINT32(1, c.rx_ok_status);
+  TEST_ASSERT_EQUAL_UINT32(0, c.rx_ok_pos_full + c.rx_ok_alive + c.rx_ok_pos_delta);
+}
+
 // ── Tail-1 codec: golden vectors ────────────────────────────────────────────
 // New layout: Common(9B) + ref_core_seq16(2B) [+ posFlags + sats]
 // kTail1FrameMin = 13 B, kTail1FrameMax = 15 B
@@ -730,12 +854,12 @@ void test_info_decode_bad_version_dropped() {
 // ── TX queue: helpers ────────────────────────────────────────────────────────
 
 static GeoBeaconFields make_self_fields(uint64_t node_id, bool pos_valid,
-                                        double lat = 55.0, double lon = 37.0) {
+                                        int32_t lat_e7 = 550000000, int32_t lon_e7 = 370000000) {
   GeoBeaconFields f{};
   f.node_id   = node_id;
   f.pos_valid = pos_valid ? 1 : 0;
-  f.lat_deg   = lat;
-  f.lon_deg   = lon;
+  f.lat_e7    = lat_e7;
+  f.lon_e7    = lon_e7;
   return f;
 }
 
@@ -807,7 +931,7 @@ void test_txq_core_replacement_replaces_tail_too() {
   const uint16_t first_seq = pos_full_frame_seq16(logic.slot(kSlotPosFull).frame);
   TEST_ASSERT_EQUAL_UINT32(0, logic.slot(kSlotPosFull).replaced_count);
 
-  self.lat_deg += 0.001;
+  self.lat_e7 += 10000;  // 0.001 deg
   logic.update_tx_queue(2000, self, telem, true);
   const uint16_t second_seq = pos_full_frame_seq16(logic.slot(kSlotPosFull).frame);
 
@@ -951,6 +1075,61 @@ void test_txq_422_status_throttle_min_interval_respected() {
   TEST_ASSERT_EQUAL_UINT32(1000, logic.slot(kSlotStatus).created_at_ms);
 }
 
+/** One formation pass; a Status formed is dequeued and reported sent. */
+bool send_status_if_formed(BeaconLogic& logic, uint32_t now_ms, const GeoBeaconFields& self,
+                           SelfTelemetry* telem) {
+  telem->uptime_sec = now_ms / 1000u;  // not part of the content hash
+  logic.update_tx_queue(now_ms, self, *telem, false);
+  if (!logic.slot(kSlotStatus).present) {
+    return false;
+  }
+  uint8_t buf[65] = {};
+  size_t len = 0;
+  if (!logic.dequeue_tx(now_ms, buf, sizeof(buf), &len)) {
+    return false;
+  }
+  logic.on_status_sent(now_ms);
+  return true;
+}
+
+void test_txq_status_unchanged_waits_for_T_status_max() {
+  BeaconLogic logic;
+  logic.set_min_interval_ms(1000);
+  logic.set_max_silence_ms(0);  // no position / Alive: Status only
+  logic.set_min_status_interval_ms(30000);
+  logic.set_T_status_max_ms(300000);
+  logic.set_status_suppress_unchanged(true);
+  TrafficCounters counters{};
+  logic.set_traffic_counters(&counters);
+
+  const GeoBeaconFields self = make_self_fields(0x0000AABBCCDDEEFFULL, false);
+  SelfTelemetry telem{};
+  telem.has_battery = true;
+  telem.battery_percent = 90;
+  telem.has_uptime = true;
+
+  TEST_ASSERT_TRUE(send_status_if_formed(logic, 1000, self, &telem));    // bootstrap
+  TEST_ASSERT_TRUE(send_status_if_formed(logic, 31000, self, &telem));   // bootstrap
+  TEST_ASSERT_FALSE(send_status_if_formed(logic, 61000, self, &telem));  // unchanged: suppressed
+  TEST_ASSERT_EQUAL_UINT32(1, counters.tx_status_suppressed);
+  TEST_ASSERT_TRUE(counters.tx_status_airtime_saved_ms > 0);
+  TEST_ASSERT_FALSE(send_status_if_formed(logic, 61500, self, &telem));
+  TEST_ASSERT_EQUAL_UINT32(1, counters.tx_status_suppressed);  // once per min_status_interval
+  TEST_ASSERT_FALSE(send_status_if_formed(logic, 91000, self, &telem));
+  TEST_ASSERT_EQUAL_UINT32(2, counters.tx_status_suppressed);
+
+  telem.battery_percent = 80;
+  // Changed: sent at the usual interval.
+  TEST_ASSERT_TRUE(send_status_if_formed(logic, 95000, self, &telem));
+  TEST_ASSERT_FALSE(send_status_if_formed(logic, 125000, self, &telem));
+  TEST_ASSERT_TRUE(send_status_if_formed(logic, 395000, self, &telem));  // T_status_max refresh
+  TEST_ASSERT_EQUAL_UINT32(4, counters.tx_enqueue_status);
+
+  // Off: the unchanged snapshot goes out every min_status_interval.
+  logic.set_status_suppress_unchanged(false);
+  TEST_ASSERT_TRUE(send_status_if_formed(logic, 425000, self, &telem));
+}
+
 void test_txq_uptime_only_enqueues_operational_not_informative() {
   // has_uptime=true → 0x04 enqueued; has_max_silence=false → 0x05 NOT enqueued.
   BeaconLogic logic;
@@ -1356,8 +1535,8 @@ void test_txq_informative_dequeued_correctly() {
 // ── TX queue: P1 reserved + full priority ordering ───────────────────────────
 
 void test_txq_p1_never_assigned_in_formation() {
-  // P1_SESSION_MESH is reserved for future Session/Mesh packets.
-  // The formation pass MUST NOT assign P1 to any current OOTB packet type.
+  // P1_SESSION_MESH carries mesh relay copies (queued on RX) and future Session/Mesh packets.
+  // The formation pass MUST NOT assign P1 to any own OOTB packet type.
   // Verify that after a full formation pass (all 5 slots), no slot has P1.
   BeaconLogic logic;
   logic.set_min_interval_ms(1000);
@@ -1548,6 +1727,730 @@ void test_traffic_counters_starved() {
   TEST_ASSERT_EQUAL_UINT32(1, c.tx_starved);
 }
 
+void test_airtime_budget_window_slides() {
+  AirtimeBudget budget;
+  budget.configure(120000, 10);  // 12 x 10 s buckets, 1% -> 1.2 s per window
+  TEST_ASSERT_EQUAL_UINT32(1200000, budget.budget_us());
+
+  budget.record_tx(0, 1000);
+  budget.record_tx(15000, 500);
+  TEST_ASSERT_EQUAL_UINT32(1500, budget.used_us(20000));
+  TEST_ASSERT_EQUAL_UINT32(500, budget.used_us(120000));  // bucket 0 left the window
+  TEST_ASSERT_EQUAL_UINT32(0, budget.used_us(130000));
+
+  TEST_ASSERT_TRUE(budget.fits(20000, 898500, 75));   // 1500 + 898500 = 75% of budget
+  TEST_ASSERT_FALSE(budget.fits(20000, 898501, 75));
+  TEST_ASSERT_TRUE(budget.fits(20000, 1198500, 100));
+}
+
+// Airtime budget: P3 held back (slot kept) when tight, P0 never; airtime charged to counters.
+void test_txq_budget_defers_p3_never_p0() {
+  BeaconLogic logic;
+  logic.set_min_interval_ms(1000);
+  logic.set_max_silence_ms(30000);
+  TrafficCounters c{};
+  logic.set_traffic_counters(&c);
+  AirtimeBudget budget;
+  budget.configure(120000, 2);  // 240 ms per 2 min; P3 limit 180 ms
+  logic.set_airtime_budget(&budget);
+
+  const uint64_t node_id = 0x0000AABBCCDDEEFFULL;
+  GeoBeaconFields self = make_self_fields(node_id, true);
+  SelfTelemetry telem{};
+  telem.has_battery = true;
+  telem.battery_percent = 90;
+
+  logic.update_tx_queue(1000, self, telem, false);
+  logic.update_tx_queue(1000, self, telem, true);
+  TEST_ASSERT_TRUE(logic.slot(kSlotPosFull).present);
+  TEST_ASSERT_TRUE(logic.slot(kSlotStatus).present);
+
+  uint8_t buf[65] = {};
+  size_t out_len = 0;
+  PacketLogType ptype = PacketLogType::CORE;
+  TEST_ASSERT_TRUE(logic.dequeue_tx(1000, buf, sizeof(buf), &out_len, &ptype));
+  TEST_ASSERT_EQUAL(static_cast<int>(PacketLogType::POS_FULL), static_cast<int>(ptype));
+  const uint32_t pos_airtime_us = e220_airtime_us(2, out_len);
+  TEST_ASSERT_EQUAL_UINT32(pos_airtime_us, budget.used_us(1000));
+  TEST_ASSERT_EQUAL_UINT32((pos_airtime_us + 500u) / 1000u, c.tx_airtime_ms);
+
+  // Status (~131 ms) on top of PosFull (~122 ms) exceeds the P3 share: deferred, slot kept.
+  TEST_ASSERT_FALSE(logic.dequeue_tx(2000, buf, sizeof(buf), &out_len, &ptype));
+  TEST_ASSERT_TRUE(logic.slot(kSlotStatus).present);
+  TEST_ASSERT_EQUAL_UINT32(1, c.tx_deferred_budget);
+  TEST_ASSERT_FALSE(logic.dequeue_tx(3000, buf, sizeof(buf), &out_len, &ptype));
+  TEST_ASSERT_EQUAL_UINT32(1, c.tx_deferred_budget);  // once per deferral episode
+
+  // P0 is never held back, even past the whole budget.
+  logic.update_tx_queue(4000, self, telem, true);
+  TEST_ASSERT_TRUE(logic.dequeue_tx(4000, buf, sizeof(buf), &out_len, &ptype));
+  TEST_ASSERT_EQUAL(static_cast<int>(PacketLogType::POS_FULL), static_cast<int>(ptype));
+  TEST_ASSERT_TRUE(budget.used_us(4000) > budget.budget_us());
+
+  // Once the window slides past the PosFull airtime, Status goes.
+  TEST_ASSERT_TRUE(logic.dequeue_tx(130000, buf, sizeof(buf), &out_len, &ptype));
+  TEST_ASSERT_EQUAL(static_cast<int>(PacketLogType::STATUS), static_cast<int>(ptype));
+  TEST_ASSERT_FALSE(logic.has_pending_tx());
+}
+
+void test_channel_load_stretch_bounds_and_smoothing() {
+  ChannelLoad load;
+  load.update(0, 122000, 22000, 110000);
+  TEST_ASSERT_EQUAL_UINT32(ChannelLoad::kScaleOne, load.scale_q8());  // alone: no stretch
+  TEST_ASSERT_EQUAL_UINT32(22000, load.stretch(22000));
+
+  // 99 peers at 22 s with 122 ms beacons offer ~55% -> wanted ~2.77x at a 20% target.
+  load.set_active_peers(99);
+  load.update(5000, 122000, 22000, 110000);
+  TEST_ASSERT_EQUAL_UINT32(ChannelLoad::kScaleOne, load.scale_q8());  // rate-limited
+  load.update(10000, 122000, 22000, 110000);
+  TEST_ASSERT_EQUAL_UINT32(256 + (709 - 256) / 4, load.scale_q8());   // moves 1/4 of the way
+  for (uint32_t t = 20000; t <= 600000; t += 10000) {
+    load.update(t, 122000, 22000, 110000);
+  }
+  TEST_ASSERT_EQUAL_UINT32(709, load.scale_q8());
+  const uint32_t stretched = load.stretch(22000);
+  TEST_ASSERT_TRUE(stretched >= 22000u * 709u / 256u * 3u / 4u);
+  TEST_ASSERT_TRUE(stretched <= 22000u * 709u / 256u);
+
+  // Never beyond the role's max silence.
+  load.set_active_peers(400);
+  for (uint32_t t = 610000; t <= 1200000; t += 10000) {
+    load.update(t, 122000, 22000, 110000);
+  }
+  TEST_ASSERT_EQUAL_UINT32(110000u * 256u / 22000u, load.scale_q8());
+  TEST_ASSERT_TRUE(load.stretch(22000) <= 110000u);
+
+  // Heard utilisation: 600 ms of airtime over a 10 s span = 60 permille.
+  ChannelLoad heard;
+  heard.on_airtime(5000, 600000);
+  TEST_ASSERT_EQUAL_UINT32(60, heard.utilisation_permille(10000));
+}
+
+// Congested channel: PosFull waits for the stretched interval, keeping the position update.
+void test_txq_channel_load_stretches_min_interval() {
+  BeaconLogic logic;
+  logic.set_min_interval_ms(22000);
+  logic.set_max_silence_ms(110000);
+  ChannelLoad load;
+  load.set_active_peers(99);
+  logic.set_channel_load(&load);
+
+  GeoBeaconFields self = make_self_fields(0x0000AABBCCDDEEFFULL, true);
+  SelfTelemetry telem{};
+  uint8_t buf[65] = {};
+  size_t out_len = 0;
+
+  logic.update_tx_queue(30000, self, telem, true);
+  TEST_ASSERT_TRUE(logic.slot(kSlotPosFull).present);
+  TEST_ASSERT_TRUE(logic.dequeue_tx(30000, buf, sizeof(buf), &out_len));
+
+  for (uint32_t t = 40000; t <= 230000; t += 10000) {
+    logic.update_tx_queue(t, self, telem, false);  // converge the load estimate
+    logic.dequeue_tx(t, buf, sizeof(buf), &out_len);
+  }
+  const uint32_t t0 = 231000;
+  logic.update_tx_queue(t0, self, telem, true);
+  logic.dequeue_tx(t0, buf, sizeof(buf), &out_len);
+  const uint32_t interval = logic.effective_min_interval_ms();
+  TEST_ASSERT_TRUE(interval > 40000u);
+  TEST_ASSERT_TRUE(interval <= 110000u);
+
+  // Position update at role min interval: held, not sent, not dropped.
+  logic.update_tx_queue(t0 + 22000, self, telem, true);
+  TEST_ASSERT_FALSE(logic.slot(kSlotPosFull).present);
+  logic.update_tx_queue(t0 + 23000, self, telem, false);
+  TEST_ASSERT_FALSE(logic.slot(kSlotPosFull).present);
+  const uint32_t upper = 22000u * load.scale_q8() / ChannelLoad::kScaleOne;  // dither <= 1
+  logic.update_tx_queue(t0 + upper + 1000, self, telem, false);
+  TEST_ASSERT_TRUE(logic.slot(kSlotPosFull).present);
+}
+
+void test_txq_bundling_holds_status_for_pos_full() {
+  BeaconLogic logic;
+  logic.set_min_interval_ms(1000);
+  logic.set_max_silence_ms(120000);
+  logic.set_bundling(true);
+  TrafficCounters c{};
+  logic.set_traffic_counters(&c);
+
+  GeoBeaconFields self = make_self_fields(0x0000AABBCCDDEEFFULL, true);
+  SelfTelemetry telem{};
+  telem.has_battery = true;
+  telem.battery_percent = 50;
+  uint8_t buf[65] = {};
+  size_t out_len = 0;
+  PacketLogType ptype = PacketLogType::CORE;
+
+  // Status alone is held for the next PosFull.
+  logic.update_tx_queue(1000, self, telem, false);
+  TEST_ASSERT_TRUE(logic.slot(kSlotStatus).present);
+  TEST_ASSERT_FALSE(logic.dequeue_tx(1000, buf, sizeof(buf), &out_len, &ptype));
+  TEST_ASSERT_TRUE(logic.slot(kSlotStatus).present);
+
+  logic.update_tx_queue(2000, self, telem, true);
+  TEST_ASSERT_TRUE(logic.dequeue_tx(2000, buf, sizeof(buf), &out_len, &ptype));
+  TEST_ASSERT_EQUAL(35u, out_len);
+  TEST_ASSERT_EQUAL(static_cast<int>(PacketLogType::POS_FULL), static_cast<int>(ptype));
+  TEST_ASSERT_TRUE(logic.last_dequeue_has_status());
+  TEST_ASSERT_FALSE(logic.slot(kSlotPosFull).present);
+  TEST_ASSERT_FALSE(logic.slot(kSlotStatus).present);
+  TEST_ASSERT_EQUAL_UINT32(1, c.tx_bundles);
+  TEST_ASSERT_EQUAL_UINT32(2, c.tx_bundled_subs);
+  const uint32_t saved_us = e220_airtime_us(2, kPosFullFrameSize) +
+                            e220_airtime_us(2, kStatusFrameSize) - e220_airtime_us(2, 35);
+  TEST_ASSERT_EQUAL_UINT32((saved_us + 500u) / 1000u, c.tx_airtime_saved_ms);
+
+  // Receiver demultiplexes both sub-messages.
+  NodeTable table;
+  PacketLogType rx_type = PacketLogType::ALIVE;
+  TEST_ASSERT_TRUE(logic.on_rx(3000, buf, out_len, -50, table, nullptr, nullptr, nullptr, &rx_type));
+  TEST_ASSERT_EQUAL(static_cast<int>(PacketLogType::POS_FULL), static_cast<int>(rx_type));
+  TEST_ASSERT_EQUAL_UINT32(2, c.rx_bundled_subs);
+  NodeEntry entry{};
+  TEST_ASSERT_TRUE(table.find_entry_for_test(self.node_id, &entry));
+  TEST_ASSERT_TRUE(entry.pos_valid);
+  TEST_ASSERT_TRUE(entry.has_battery);
+  TEST_ASSERT_EQUAL_UINT8(50, entry.battery_percent);
+}
+
+void test_txq_predictive_frames_and_rx_extrapolation() {
+  namespace p = naviga::protocol;
+  BeaconLogic tx;
+  tx.set_min_interval_ms(1000);
+  tx.set_max_silence_ms(120000);
+  tx.set_min_status_interval_ms(1000000);
+  tx.set_pos_delta(true);
+  BeaconLogic rx;
+  NodeTable table;
+  const uint64_t node_id = 0x0000AABBCCDDEE22ULL;
+  const uint32_t lat_u24 = p::lat_e7_to_u24(550000000);
+  const uint32_t lon_u24 = p::lon_e7_to_u24(370000000);
+  p::PosVelocity vel;
+  vel.lat = 160;  // 10 u24 per second
+  vel.lon = -160;
+  SelfTelemetry telem{};
+  uint8_t buf[64] = {};
+  size_t out_len = 0;
+
+  // Committed at 1000 ms, sent at 5000 ms: the frame carries the position moved on 4 s.
+  tx.set_self_velocity(vel, 1000);
+  tx.update_tx_queue(5000, make_self_fields(node_id, true), telem, true);
+  TEST_ASSERT_TRUE(tx.dequeue_tx(5000, buf, sizeof(buf), &out_len));
+  TEST_ASSERT_EQUAL(p::kPosFullMaxFrameSize, out_len);
+  const p::PosFullView view(buf + 2, out_len - 2);
+  TEST_ASSERT_EQUAL_INT32(p::u24_to_lat_e7(lat_u24 + 40), view.lat_e7());
+  TEST_ASSERT_EQUAL_INT32(p::u24_to_lon_e7(lon_u24 - 40), view.lon_e7());
+
+  // The receiver extrapolates from reception: at 15 s it shows the sender's own prediction.
+  TEST_ASSERT_TRUE(rx.on_rx(5000, buf, out_len, -50, table));
+  NodeEntry entry{};
+  TEST_ASSERT_TRUE(table.find_entry_for_test(node_id, &entry));
+  TEST_ASSERT_TRUE(entry.has_velocity);
+  int32_t lat_e7 = 0;
+  int32_t lon_e7 = 0;
+  TEST_ASSERT_TRUE(NodeTable::predicted_position(entry, 15000, &lat_e7, &lon_e7));
+  TEST_ASSERT_EQUAL_INT32(p::u24_to_lat_e7(lat_u24 + 140), lat_e7);
+  TEST_ASSERT_EQUAL_INT32(p::u24_to_lon_e7(lon_u24 - 140), lon_e7);
+  TEST_ASSERT_EQUAL_INT32(view.lat_e7(), entry.lat_e7);  // held position unchanged
+
+  // Pos_Delta carries the velocity too; without it the receiver stops extrapolating.
+  tx.update_tx_queue(7000, make_self_fields(node_id, true), telem, true);
+  TEST_ASSERT_TRUE(tx.dequeue_tx(7000, buf, sizeof(buf), &out_len));
+  TEST_ASSERT_EQUAL(p::kPosDeltaMaxFrameSize, out_len);
+  TEST_ASSERT_TRUE(rx.on_rx(7000, buf, out_len, -50, table));
+  TEST_ASSERT_TRUE(table.find_entry_for_test(node_id, &entry));
+  TEST_ASSERT_EQUAL_INT32(p::u24_to_lat_e7(lat_u24 + 60), entry.lat_e7);
+  TEST_ASSERT_TRUE(entry.has_velocity);
+  TEST_ASSERT_EQUAL_UINT32(7000, entry.pos_rx_ms);
+
+  tx.clear_self_velocity();
+  tx.update_tx_queue(9000, make_self_fields(node_id, true), telem, true);
+  TEST_ASSERT_TRUE(tx.dequeue_tx(9000, buf, sizeof(buf), &out_len));
+  TEST_ASSERT_EQUAL(p::kPosDeltaFrameSize, out_len);
+  TEST_ASSERT_TRUE(rx.on_rx(9000, buf, out_len, -50, table));
+  TEST_ASSERT_TRUE(table.find_entry_for_test(node_id, &entry));
+  TEST_ASSERT_FALSE(entry.has_velocity);
+  TEST_ASSERT_FALSE(NodeTable::predicted_position(entry, 15000, &lat_e7, &lon_e7));
+  TEST_ASSERT_EQUAL_INT32(p::u24_to_lat_e7(lat_u24), lat_e7);
+}
+
+void test_self_pos_quality_buckets_flags_and_tx() {
+  namespace p = naviga::protocol;
+  // §3 buckets; a bound belongs to the coarser bucket.
+  TEST_ASSERT_EQUAL_UINT8(0, p::pos_accuracy_bucket_from_mm(0));
+  TEST_ASSERT_EQUAL_UINT8(7, p::pos_accuracy_bucket_from_mm(999));
+  TEST_ASSERT_EQUAL_UINT8(6, p::pos_accuracy_bucket_from_mm(1000));
+  TEST_ASSERT_EQUAL_UINT8(5, p::pos_accuracy_bucket_from_mm(2000));
+  TEST_ASSERT_EQUAL_UINT8(4, p::pos_accuracy_bucket_from_mm(9999));
+  TEST_ASSERT_EQUAL_UINT8(3, p::pos_accuracy_bucket_from_mm(10000));
+  TEST_ASSERT_EQUAL_UINT8(2, p::pos_accuracy_bucket_from_mm(49999));
+  TEST_ASSERT_EQUAL_UINT8(1, p::pos_accuracy_bucket_from_mm(50000));
+
+  p::PosQuality q = p::make_pos_quality(p::kPosFix3D, 80, 3500, 1200);
+  TEST_ASSERT_EQUAL_UINT8(p::kPosFix3D, q.fix_type);
+  TEST_ASSERT_EQUAL_UINT8(63, q.pos_sats);
+  TEST_ASSERT_EQUAL_UINT8(5, q.pos_accuracy_bucket);
+  TEST_ASSERT_EQUAL_UINT8(p::kPosFlagValid | p::kPosFlagMoving, q.pos_flags_small);
+  q = p::make_pos_quality(p::kPosFix2D, 4, 3500, 0);
+  TEST_ASSERT_EQUAL_UINT8(p::kPosFlagValid | p::kPosFlagDegraded, q.pos_flags_small);
+  q = p::make_pos_quality(p::kPosFix2D, 0, 0, 0);  // provider without quality: not degraded
+  TEST_ASSERT_EQUAL_UINT8(p::kPosFlagValid, q.pos_flags_small);
+  TEST_ASSERT_EQUAL_UINT8(0, p::make_pos_quality(p::kPosFixNone, 9, 3500, 900).pos_flags_small);
+
+  BeaconLogic tx;
+  tx.set_min_interval_ms(1000);
+  tx.set_max_silence_ms(120000);
+  tx.set_min_status_interval_ms(1000000);
+  const uint64_t node_id = 0x0000AABBCCDDEE33ULL;
+  SelfTelemetry telem{};
+  uint8_t buf[64] = {};
+  size_t out_len = 0;
+
+  // Default before any GNSS quality: 2D, nothing else known.
+  tx.update_tx_queue(5000, make_self_fields(node_id, true), telem, true);
+  TEST_ASSERT_TRUE(tx.dequeue_tx(5000, buf, sizeof(buf), &out_len));
+  p::PosQuality got = p::PosFullView(buf + 2, out_len - 2).quality();
+  TEST_ASSERT_EQUAL_UINT8(p::kPosFix2D, got.fix_type);
+  TEST_ASSERT_EQUAL_UINT8(0, got.pos_sats);
+  TEST_ASSERT_EQUAL_UINT8(0, got.pos_flags_small);
+
+  tx.set_self_pos_quality(p::make_pos_quality(p::kPosFix3D, 9, 3500, 0));
+  tx.update_tx_queue(7000, make_self_fields(node_id, true), telem, true);
+  TEST_ASSERT_TRUE(tx.dequeue_tx(7000, buf, sizeof(buf), &out_len));
+  got = p::PosFullView(buf + 2, out_len - 2).quality();
+  TEST_ASSERT_EQUAL_UINT8(p::kPosFix3D, got.fix_type);
+  TEST_ASSERT_EQUAL_UINT8(9, got.pos_sats);
+  TEST_ASSERT_EQUAL_UINT8(5, got.pos_accuracy_bucket);
+  TEST_ASSERT_EQUAL_UINT8(p::kPosFlagValid, got.pos_flags_small);
+
+  // Extrapolated position: estimated and moving.
+  p::PosVelocity vel;
+  vel.lat = 160;
+  tx.set_self_velocity(vel, 8000);
+  tx.update_tx_queue(10000, make_self_fields(node_id, true), telem, true);
+  TEST_ASSERT_TRUE(tx.dequeue_tx(10000, buf, sizeof(buf), &out_len));
+  got = p::PosFullView(buf + 2, out_len - 2).quality();
+  TEST_ASSERT_EQUAL_UINT8(p::kPosFlagValid | p::kPosFlagMoving | p::kPosFlagEstimated,
+                          got.pos_flags_small);
+}
+
+void test_txq_pos_delta_refresh_and_reference_check() {
+  BeaconLogic tx;
+  tx.set_min_interval_ms(1000);
+  tx.set_max_silence_ms(120000);
+  tx.set_min_status_interval_ms(1000000);
+  tx.set_pos_delta(true);
+  BeaconLogic rx;
+  TrafficCounters rxc{};
+  rx.set_traffic_counters(&rxc);
+  NodeTable table;
+
+  const uint64_t node_id = 0x0000AABBCCDDEEFFULL;
+  SelfTelemetry telem{};
+  uint8_t buf[65] = {};
+  size_t out_len = 0;
+  PacketLogType ptype = PacketLogType::CORE;
+  int32_t lat = 550000000;
+  const PacketLogType expect_type[] = {PacketLogType::POS_FULL, PacketLogType::POS_DELTA,
+                                       PacketLogType::POS_DELTA, PacketLogType::POS_DELTA,
+                                       PacketLogType::POS_FULL, PacketLogType::POS_DELTA,
+                                       PacketLogType::POS_DELTA};
+  for (uint32_t i = 0; i < 7; ++i) {
+    lat += 30000;  // 0.003 deg, ~330 m
+    const uint32_t now = 2000 + i * 2000;
+    tx.update_tx_queue(now, make_self_fields(node_id, true, lat), telem, true);
+    TEST_ASSERT_TRUE(tx.dequeue_tx(now, buf, sizeof(buf), &out_len, &ptype));
+    TEST_ASSERT_EQUAL(static_cast<int>(expect_type[i]), static_cast<int>(ptype));
+    TEST_ASSERT_EQUAL(ptype == PacketLogType::POS_FULL ? kPosFullFrameSize
+                                                        : naviga::protocol::kPosDeltaFrameSize,
+                      out_len);
+    if (i == 5) {
+      continue;  // lost on air: the next delta of the run still resolves
+    }
+    TEST_ASSERT_TRUE(rx.on_rx(now, buf, out_len, -50, table));
+
+    // Receiver ends up exactly where a Pos_Full of the same fix would put it.
+    naviga::protocol::PosFullFields full{};
+    full.lat_e7 = lat;
+    full.lon_e7 = 370000000;
+    uint8_t full_frame[kPosFullFrameSize] = {};
+    naviga::protocol::encode_pos_full_frame(full, full_frame, sizeof(full_frame));
+    naviga::protocol::PosFullFields decoded{};
+    naviga::protocol::decode_pos_full_payload(full_frame + 2, kPosFullFrameSize - 2, &decoded);
+    NodeEntry entry{};
+    TEST_ASSERT_TRUE(table.find_entry_for_test(node_id, &entry));
+    TEST_ASSERT_EQUAL_INT32(decoded.lat_e7, entry.lat_e7);
+    TEST_ASSERT_EQUAL_INT32(decoded.lon_e7, entry.lon_e7);
+  }
+
+  // A jump beyond kPosDeltaMaxStep goes out as Pos_Full.
+  tx.update_tx_queue(20000, make_self_fields(node_id, true, lat + 200000), telem, true);
+  TEST_ASSERT_TRUE(tx.dequeue_tx(20000, buf, sizeof(buf), &out_len, &ptype));
+  TEST_ASSERT_EQUAL(static_cast<int>(PacketLogType::POS_FULL), static_cast<int>(ptype));
+
+  // Unknown sender: no reference, nothing applied.
+  NodeTable fresh;
+  tx.update_tx_queue(22000, make_self_fields(node_id, true, lat + 210000), telem, true);
+  TEST_ASSERT_TRUE(tx.dequeue_tx(22000, buf, sizeof(buf), &out_len, &ptype));
+  TEST_ASSERT_EQUAL(static_cast<int>(PacketLogType::POS_DELTA), static_cast<int>(ptype));
+  TEST_ASSERT_FALSE(rx.on_rx(22000, buf, out_len, -50, fresh));
+  TEST_ASSERT_EQUAL_UINT32(1, rxc.rx_pos_delta_no_ref);
+
+  // Reference too old (seq gap > kPosDeltaMaxSeqGap): marked heard, position untouched.
+  NodeEntry before{};
+  TEST_ASSERT_TRUE(table.find_entry_for_test(node_id, &before));
+  uint8_t late[naviga::protocol::kPosDeltaFrameSize] = {};
+  naviga::protocol::PosDeltaFields d{};
+  d.node_id = node_id;
+  d.seq16 = static_cast<uint16_t>(before.pos_full_seq16 + NodeTable::kPosDeltaMaxSeqGap + 1u);
+  d.ref_seq8 = static_cast<uint8_t>(before.pos_full_seq16);
+  naviga::protocol::encode_pos_delta_frame(d, late, sizeof(late));
+  TEST_ASSERT_FALSE(rx.on_rx(30000, late, sizeof(late), -50, table));
+  NodeEntry after{};
+  TEST_ASSERT_TRUE(table.find_entry_for_test(node_id, &after));
+  TEST_ASSERT_EQUAL_INT32(before.lat_e7, after.lat_e7);
+  TEST_ASSERT_EQUAL_UINT32(30000u, after.last_seen_ms);
+}
+
+void test_txq_pos_delta_bounded_by_run_and_missed_frames() {
+  BeaconLogic tx;
+  tx.set_min_interval_ms(1000);
+  tx.set_max_silence_ms(120000);
+  tx.set_min_status_interval_ms(1000000);
+  tx.set_pos_delta(true);
+  BeaconLogic rx;
+  TrafficCounters rxc{};
+  rx.set_traffic_counters(&rxc);
+  NodeTable table;
+
+  const uint64_t node_id = 0x0000AABBCCDDEEFFULL;
+  SelfTelemetry telem{};
+  uint8_t frames[8][65] = {};
+  size_t lens[8] = {};
+  PacketLogType types[8] = {};
+  int32_t lats[8] = {};
+  // ~600 u24 units per frame: each step fits kPosDeltaMaxStep, two do not.
+  for (uint32_t i = 0; i < 8; ++i) {
+    lats[i] = 550000000 + static_cast<int32_t>(i) * 64373;
+    const uint32_t now = 2000 + i * 2000;
+    tx.update_tx_queue(now, make_self_fields(node_id, true, lats[i]), telem, true);
+    TEST_ASSERT_TRUE(tx.dequeue_tx(now, frames[i], sizeof(frames[i]), &lens[i], &types[i]));
+  }
+  // Bounded against the run's Pos_Full, not the previous delta: runs of one delta.
+  for (uint32_t i = 0; i < 8; ++i) {
+    TEST_ASSERT_EQUAL(static_cast<int>(i % 2 == 0 ? PacketLogType::POS_FULL : PacketLogType::POS_DELTA),
+                      static_cast<int>(types[i]));
+  }
+
+  // Receiver hears frame 0, misses 1-4, then hears delta 5 (~3000 units away, past the
+  // 12-bit wrap): its run's Pos_Full was missed, so it is not applied.
+  TEST_ASSERT_TRUE(rx.on_rx(2000, frames[0], lens[0], -50, table));
+  TEST_ASSERT_FALSE(rx.on_rx(12000, frames[5], lens[5], -50, table));
+  TEST_ASSERT_EQUAL_UINT32(1, rxc.rx_pos_delta_no_ref);
+  NodeEntry entry{};
+  TEST_ASSERT_TRUE(table.find_entry_for_test(node_id, &entry));
+  const int32_t lat0 = naviga::protocol::u24_to_lat_e7(naviga::protocol::lat_e7_to_u24(lats[0]));
+  TEST_ASSERT_EQUAL_INT32(lat0, entry.lat_e7);
+  TEST_ASSERT_EQUAL_UINT32(12000u, entry.last_seen_ms);
+
+  // The next run's Pos_Full and delta apply exactly.
+  for (uint32_t i = 6; i < 8; ++i) {
+    TEST_ASSERT_TRUE(rx.on_rx(2000 + i * 2000, frames[i], lens[i], -50, table));
+    TEST_ASSERT_TRUE(table.find_entry_for_test(node_id, &entry));
+    TEST_ASSERT_EQUAL_INT32(naviga::protocol::u24_to_lat_e7(naviga::protocol::lat_e7_to_u24(lats[i])),
+                            entry.lat_e7);
+  }
+}
+
+void test_txq_short_addr_cadence_and_rx_resolve() {
+  BeaconLogic tx;
+  tx.set_min_interval_ms(1000);
+  tx.set_max_silence_ms(120000);
+  tx.set_min_status_interval_ms(1000000);
+  tx.set_short_addr(true);
+  BeaconLogic rx;
+  TrafficCounters rxc{};
+  rx.set_traffic_counters(&rxc);
+  NodeTable table;
+
+  const uint64_t node_id = 0x0000AABBCCDDEEFFULL;
+  SelfTelemetry telem{};
+  uint8_t buf[65] = {};
+  size_t out_len = 0;
+  uint8_t first_short[65] = {};
+  size_t first_short_len = 0;
+  for (uint32_t i = 0; i < 4; ++i) {
+    const uint32_t now = 2000 + i * 2000;
+    tx.update_tx_queue(now, make_self_fields(node_id, true, 550000000 + 10000 * static_cast<int32_t>(i)), telem, true);
+    TEST_ASSERT_TRUE(tx.dequeue_tx(now, buf, sizeof(buf), &out_len));
+    // Full id first (receivers create the entry from it), then every other Pos_Full.
+    const bool is_short = (i % 2) == 1;
+    TEST_ASSERT_EQUAL(is_short ? kPosFullFrameSize - naviga::protocol::kShortAddrSavedBytes
+                               : kPosFullFrameSize,
+                      out_len);
+    TEST_ASSERT_EQUAL(is_short, naviga::protocol::is_short_addr_payload(buf + 2, out_len - 2));
+    TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(i + 1), tx.last_dequeue_seq16());
+    if (is_short && first_short_len == 0) {
+      std::memcpy(first_short, buf, out_len);
+      first_short_len = out_len;
+    }
+    TEST_ASSERT_TRUE(rx.on_rx(now, buf, out_len, -50, table));
+    NodeEntry entry{};
+    TEST_ASSERT_TRUE(table.find_entry_for_test(node_id, &entry));
+    TEST_ASSERT_EQUAL_UINT16(static_cast<uint16_t>(i + 1), entry.last_core_seq16);
+  }
+
+  // On air: the sender's NodeTable short_id and the tag from its node id.
+  uint16_t short_id = 0;
+  uint8_t tag = 0;
+  TEST_ASSERT_TRUE(naviga::protocol::short_addr_peek(first_short + 2, first_short_len - 2, &short_id, &tag));
+  TEST_ASSERT_EQUAL_UINT16(NodeTable::compute_short_id(node_id), short_id);
+  TEST_ASSERT_EQUAL_UINT8(0x7F, tag);
+
+  // Receiver that never heard the full id: dropped and counted.
+  NodeTable fresh;
+  TEST_ASSERT_FALSE(rx.on_rx(10000, first_short, first_short_len, -50, fresh));
+  TEST_ASSERT_EQUAL_UINT32(1, rxc.rx_short_addr_unresolved);
+  TEST_ASSERT_EQUAL(0u, fresh.size());
+
+  // Same short_id, different tag: not resolved.
+  first_short[2] = static_cast<uint8_t>(naviga::protocol::kShortAddrFlag | 0x01);
+  TEST_ASSERT_FALSE(rx.on_rx(10000, first_short, first_short_len, -50, table));
+  TEST_ASSERT_EQUAL_UINT32(2, rxc.rx_short_addr_unresolved);
+}
+
+void test_txq_fec_wraps_positions_and_rx_corrects() {
+  BeaconLogic tx;
+  tx.set_min_interval_ms(1000);
+  tx.set_max_silence_ms(120000);
+  tx.set_min_status_interval_ms(1000000);
+  tx.set_fec_parity(8);
+  TrafficCounters txc{};
+  tx.set_traffic_counters(&txc);
+  BeaconLogic rx;
+  TrafficCounters rxc{};
+  rx.set_traffic_counters(&rxc);
+  NodeTable table;
+
+  const uint64_t node_id = 0x0000AABBCCDDEEFFULL;
+  SelfTelemetry telem{};
+  uint8_t buf[65] = {};
+  size_t out_len = 0;
+  tx.update_tx_queue(2000, make_self_fields(node_id, true, 550000000), telem, true);
+  PacketLogType type = PacketLogType::ALIVE;
+  TEST_ASSERT_TRUE(tx.dequeue_tx(2000, buf, sizeof(buf), &out_len, &type));
+  TEST_ASSERT_TRUE(type == PacketLogType::POS_FULL);
+  TEST_ASSERT_EQUAL(naviga::protocol::fec_frame_size(kPosFullFrameSize, 8), out_len);
+  TEST_ASSERT_EQUAL_UINT8(0x0A << 1, buf[1]);
+  TEST_ASSERT_EQUAL_UINT32(1, txc.tx_fec);
+
+  // Four corrupted bytes: corrected, position applied.
+  buf[5] ^= 0xFF;
+  buf[9] ^= 0x10;
+  buf[14] ^= 0x01;
+  buf[out_len - 1] ^= 0x80;
+  TEST_ASSERT_TRUE(rx.on_rx(2000, buf, out_len, -50, table));
+  NodeEntry entry{};
+  TEST_ASSERT_TRUE(table.find_entry_for_test(node_id, &entry));
+  TEST_ASSERT_TRUE(entry.pos_valid);
+  TEST_ASSERT_EQUAL_UINT16(1, entry.last_core_seq16);
+  TEST_ASSERT_EQUAL_UINT32(1, rxc.rx_fec_corrected);
+
+  // Five: beyond correction, dropped and counted.
+  tx.update_tx_queue(4000, make_self_fields(node_id, true, 550100000), telem, true);
+  TEST_ASSERT_TRUE(tx.dequeue_tx(4000, buf, sizeof(buf), &out_len));
+  for (size_t i = 4; i < 9; ++i) {
+    buf[i] ^= 0x33;
+  }
+  TEST_ASSERT_FALSE(rx.on_rx(4000, buf, out_len, -50, table));
+  TEST_ASSERT_EQUAL_UINT32(1, rxc.rx_fec_fail);
+  TEST_ASSERT_TRUE(table.find_entry_for_test(node_id, &entry));
+  TEST_ASSERT_EQUAL_UINT16(1, entry.last_core_seq16);
+
+  // Invalid parity length: off.
+  tx.set_fec_parity(5);
+  tx.update_tx_queue(6000, make_self_fields(node_id, true, 550200000), telem, true);
+  TEST_ASSERT_TRUE(tx.dequeue_tx(6000, buf, sizeof(buf), &out_len));
+  TEST_ASSERT_EQUAL(kPosFullFrameSize, out_len);
+}
+
+namespace {
+
+size_t make_pos_full(uint64_t node_id, uint16_t seq16, int32_t lat_e7, uint8_t* out) {
+  naviga::protocol::PosFullFields pos{};
+  pos.node_id = node_id;
+  pos.seq16 = seq16;
+  pos.lat_e7 = lat_e7;
+  pos.lon_e7 = 370000000;
+  return naviga::protocol::encode_pos_full_frame(pos, out, kPosFullFrameSize);
+}
+
+} // namespace
+
+void test_relay_policy_dedupe_hops_probability_budget() {
+  using naviga::protocol::frame_hops;
+  using naviga::protocol::set_frame_hops;
+  const uint64_t self_id = 0x0000111111111111ULL;
+  const uint64_t peer_id = 0x0000AABBCCDDEEFFULL;
+  uint8_t frame[kPosFullFrameSize] = {};
+  make_pos_full(peer_id, 5, 550000000, frame);
+
+  // Hop count lives in the reserved bits; the header still decodes.
+  set_frame_hops(frame, 5);
+  TEST_ASSERT_EQUAL_UINT8(5, frame_hops(frame));
+  naviga::protocol::PacketHeader hdr{};
+  TEST_ASSERT_TRUE(naviga::protocol::decode_header(frame, sizeof(frame), &hdr));
+  TEST_ASSERT_EQUAL(static_cast<int>(naviga::protocol::MsgType::BeaconPosFull), static_cast<int>(hdr.msg_type));
+  TEST_ASSERT_EQUAL_UINT8(17, hdr.payload_len);
+  set_frame_hops(frame, 0);
+  TEST_ASSERT_EQUAL_UINT8(0, frame_hops(frame));
+
+  RelayPolicy relay;
+  TEST_ASSERT_FALSE(relay.enabled());
+  relay.configure(self_id, 2, 100, RelayPolicy::kDefaultDutyPermille);
+  uint32_t key = 0;
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::RELAY), static_cast<int>(relay.offer(1000, frame, sizeof(frame), 50000, &key)));
+  TEST_ASSERT_NOT_EQUAL(0u, key);
+  // Any later copy, direct or relayed, is a duplicate.
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::DUPLICATE), static_cast<int>(relay.offer(1100, frame, sizeof(frame), 50000)));
+  set_frame_hops(frame, 1);
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::DUPLICATE), static_cast<int>(relay.offer(1200, frame, sizeof(frame), 50000)));
+
+  // Hop limit: a copy already relayed max_hops times goes no further (but is remembered).
+  uint8_t far[kPosFullFrameSize] = {};
+  make_pos_full(peer_id, 6, 550000000, far);
+  set_frame_hops(far, 2);
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::HOP_LIMIT), static_cast<int>(relay.offer(1300, far, sizeof(far), 50000)));
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::DUPLICATE), static_cast<int>(relay.offer(1400, far, sizeof(far), 50000)));
+
+  // Pos_Delta is relayed, keyed on (node, msg_type, seq16) like Pos_Full.
+  naviga::protocol::PosDeltaFields delta{};
+  delta.node_id = peer_id;
+  delta.seq16 = 6;
+  uint8_t delta_frame[kTestBufSize] = {};
+  const size_t delta_len = naviga::protocol::encode_pos_delta_frame(delta, delta_frame, sizeof(delta_frame));
+  uint32_t delta_key = 0;
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::RELAY), static_cast<int>(relay.offer(1450, delta_frame, delta_len, 50000, &delta_key)));
+  TEST_ASSERT_NOT_EQUAL(0u, delta_key);
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::DUPLICATE), static_cast<int>(relay.offer(1460, delta_frame, delta_len, 50000)));
+
+  // Own frames, Alive and short-addressed frames are never relayed.
+  uint8_t own[kPosFullFrameSize] = {};
+  make_pos_full(self_id, 7, 550000000, own);
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::NOT_RELAYABLE), static_cast<int>(relay.offer(1500, own, sizeof(own), 50000)));
+  AliveFields alive{};
+  alive.node_id = peer_id;
+  alive.seq = 8;
+  uint8_t alive_frame[kTestBufSize] = {};
+  const size_t alive_len = encode_alive_frame(alive, alive_frame, sizeof(alive_frame));
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::NOT_RELAYABLE), static_cast<int>(relay.offer(1600, alive_frame, alive_len, 50000)));
+  uint8_t short_frame[kPosFullFrameSize] = {};
+  make_pos_full(peer_id, 9, 550000000, short_frame);
+  const size_t short_len = naviga::protocol::short_addr_compact(
+      short_frame, kPosFullFrameSize, NodeTable::compute_short_id(peer_id), short_frame, sizeof(short_frame));
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::NOT_RELAYABLE), static_cast<int>(relay.offer(1700, short_frame, short_len, 50000)));
+
+  // The FIFO cache forgets after kDupCacheSize newer frames.
+  for (uint16_t i = 0; i < RelayPolicy::kDupCacheSize; ++i) {
+    uint8_t other[kPosFullFrameSize] = {};
+    make_pos_full(peer_id + 1, i, 550000000, other);
+    relay.offer(2000, other, sizeof(other), 0);
+  }
+  set_frame_hops(frame, 0);
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::RELAY), static_cast<int>(relay.offer(3000, frame, sizeof(frame), 50000)));
+
+  // Airtime cap: 0.1 % of 10 min = 600 ms.
+  relay.configure(self_id, 2, 100, 1);
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::RELAY), static_cast<int>(relay.offer(1000, frame, sizeof(frame), 500000)));
+  relay.on_relayed(1000, 500000);
+  uint8_t next[kPosFullFrameSize] = {};
+  make_pos_full(peer_id, 10, 550000000, next);
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::OVER_BUDGET), static_cast<int>(relay.offer(1000, next, sizeof(next), 500000)));
+
+  // Rebroadcast probability 0: nothing is drawn.
+  relay.configure(self_id, 2, 0, RelayPolicy::kDefaultDutyPermille);
+  TEST_ASSERT_EQUAL(static_cast<int>(RelayDecision::SKIPPED), static_cast<int>(relay.offer(1000, frame, sizeof(frame), 50000)));
+}
+
+void test_relay_queues_hop_copy_and_receivers_apply_it() {
+  using naviga::protocol::frame_hops;
+  using naviga::protocol::set_frame_hops;
+  const uint64_t relay_id = 0x0000111111111111ULL;
+  const uint64_t peer_id = 0x0000AABBCCDDEEFFULL;
+  const uint64_t far_id = 0x0000222222222222ULL;
+
+  BeaconLogic relay;
+  RelayPolicy policy;
+  policy.configure(relay_id, RelayPolicy::kDefaultMaxHops, 100, RelayPolicy::kDefaultDutyPermille);
+  relay.set_relay(&policy);
+  TrafficCounters rc{};
+  relay.set_traffic_counters(&rc);
+  NodeTable relay_table;
+  relay_table.init_self(relay_id, 0);
+
+  uint8_t frame[kPosFullFrameSize] = {};
+  make_pos_full(peer_id, 5, 550000000, frame);
+  TEST_ASSERT_TRUE(relay.on_rx(1000, frame, sizeof(frame), -60, relay_table));
+  const naviga::domain::TxSlot& queued = relay.slot(kSlotRelay);
+  TEST_ASSERT_TRUE(queued.present);
+  TEST_ASSERT_EQUAL(static_cast<int>(TxPriority::P1_SESSION_MESH), static_cast<int>(queued.priority));
+  TEST_ASSERT_EQUAL(static_cast<int>(PacketLogType::RELAY), static_cast<int>(queued.pkt_type));
+  TEST_ASSERT_EQUAL(kPosFullFrameSize, queued.frame_len);
+  TEST_ASSERT_EQUAL_UINT8(1, frame_hops(queued.frame));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(frame + 2, queued.frame + 2, kPosFullFrameSize - 2);
+  TEST_ASSERT_EQUAL_UINT32(1, rc.tx_enqueue_relay);
+
+  // Sent as received: not short-addressed or bundled, and not our seq16.
+  relay.set_short_addr(true);
+  relay.set_bundling(true);
+  uint8_t buf[65] = {};
+  size_t out_len = 0;
+  PacketLogType ptype = PacketLogType::CORE;
+  TEST_ASSERT_TRUE(relay.dequeue_tx(1500, buf, sizeof(buf), &out_len, &ptype));
+  TEST_ASSERT_EQUAL(static_cast<int>(PacketLogType::RELAY), static_cast<int>(ptype));
+  TEST_ASSERT_EQUAL(kPosFullFrameSize, out_len);
+  TEST_ASSERT_EQUAL_UINT8(1, frame_hops(buf));
+  TEST_ASSERT_EQUAL_UINT16(0, relay.last_dequeue_seq16());
+
+  // A receiver applies the relayed copy without taking the relay's RSSI as the peer's link.
+  BeaconLogic rx;
+  TrafficCounters rxc{};
+  rx.set_traffic_counters(&rxc);
+  NodeTable table;
+  table.init_self(far_id, 0);
+  uint8_t direct[kPosFullFrameSize] = {};
+  make_pos_full(peer_id, 4, 540000000, direct);
+  TEST_ASSERT_TRUE(rx.on_rx(900, direct, sizeof(direct), -50, table));
+  TEST_ASSERT_FALSE(rx.heard_relayed_within(900, 110000));
+  TEST_ASSERT_TRUE(rx.on_rx(1600, buf, out_len, -95, table));
+  TEST_ASSERT_TRUE(rx.heard_relayed_within(1600 + 110000, 110000));
+  TEST_ASSERT_FALSE(rx.heard_relayed_within(1601 + 110000, 110000));
+  NodeEntry entry{};
+  TEST_ASSERT_TRUE(table.find_entry_for_test(peer_id, &entry));
+  TEST_ASSERT_EQUAL_UINT16(5, entry.last_core_seq16);
+  TEST_ASSERT_EQUAL_INT8(-50, entry.last_rx_rssi);
+  TEST_ASSERT_EQUAL_UINT16(1, entry.link.rx_count);
+  TEST_ASSERT_EQUAL_UINT32(1600u, entry.last_seen_ms);
+  TEST_ASSERT_EQUAL_UINT32(1, rxc.rx_relayed);
+
+  // Own frame relayed back: not applied to the self entry.
+  uint8_t own[kPosFullFrameSize] = {};
+  make_pos_full(far_id, 9, 100000000, own);
+  set_frame_hops(own, 1);
+  TEST_ASSERT_FALSE(rx.on_rx(1700, own, sizeof(own), -70, table));
+
+  // Next frame queued; another relay's copy heard first cancels ours.
+  make_pos_full(peer_id, 6, 550000000, frame);
+  TEST_ASSERT_TRUE(relay.on_rx(2000, frame, sizeof(frame), -60, relay_table));
+  TEST_ASSERT_TRUE(relay.slot(kSlotRelay).present);
+  set_frame_hops(frame, 1);
+  TEST_ASSERT_TRUE(relay.on_rx(2100, frame, sizeof(frame), -80, relay_table));
+  TEST_ASSERT_FALSE(relay.slot(kSlotRelay).present);
+  TEST_ASSERT_EQUAL_UINT32(1, rc.tx_relay_cancelled);
+  TEST_ASSERT_EQUAL_UINT32(1, rc.rx_relay_dup);
+}
+
 int main(int argc, char** argv) {
   UNITY_BEGIN();
   RUN_TEST(test_tx_cadence);
@@ -1561,7 +2464,9 @@ int main(int argc, char** argv) {
   RUN_TEST(test_tx_payload_correctness);
   RUN_TEST(test_rx_v01_packets_dropped);
   RUN_TEST(test_rx_pos_full_applies_position_and_quality);
+  RUN_TEST(test_rx_pos_full_duplicate_seq_keeps_position);
   RUN_TEST(test_rx_status_applies_full_snapshot);
+  RUN_TEST(test_rx_status_max_silence_sets_peer_grey_threshold);
   RUN_TEST(test_rx_alive_success_updates_node_table);
   RUN_TEST(test_rx_alive_does_not_overwrite_core_position);
   RUN_TEST(test_rx_invalid_frame_too_short);
@@ -1569,6 +2474,8 @@ int main(int argc, char** argv) {
   RUN_TEST(test_rx_payload_len_mismatch_dropped);
   RUN_TEST(test_decode_header_rejects_v01_msgtypes);
   RUN_TEST(test_decode_header_accepts_0x06);
+  RUN_TEST(test_decode_header_accepts_only_registered_msgtypes);
+  RUN_TEST(test_packet_log_type_names_and_counters);
   // Tail-1 codec
   RUN_TEST(test_tail1_codec_base_round_trip);
   RUN_TEST(test_tail1_codec_extended_round_trip);
@@ -1594,6 +2501,7 @@ int main(int argc, char** argv) {
   RUN_TEST(test_txq_empty_telemetry_no_operational_no_informative);
   RUN_TEST(test_txq_op_info_not_enqueued_before_cadence);
   RUN_TEST(test_txq_422_status_throttle_min_interval_respected);
+  RUN_TEST(test_txq_status_unchanged_waits_for_T_status_max);
   RUN_TEST(test_txq_uptime_only_enqueues_operational_not_informative);
   RUN_TEST(test_txq_max_silence_only_enqueues_informative_not_operational);
   RUN_TEST(test_txq_status_encodes_role_id_from_telemetry);
@@ -1620,5 +2528,18 @@ int main(int argc, char** argv) {
   RUN_TEST(test_txq_priority_ordering_p0_beats_all);
   RUN_TEST(test_traffic_counters_enqueue_and_slot_replaced);
   RUN_TEST(test_traffic_counters_starved);
+  RUN_TEST(test_airtime_budget_window_slides);
+  RUN_TEST(test_txq_budget_defers_p3_never_p0);
+  RUN_TEST(test_channel_load_stretch_bounds_and_smoothing);
+  RUN_TEST(test_txq_channel_load_stretches_min_interval);
+  RUN_TEST(test_txq_bundling_holds_status_for_pos_full);
+  RUN_TEST(test_txq_predictive_frames_and_rx_extrapolation);
+  RUN_TEST(test_self_pos_quality_buckets_flags_and_tx);
+  RUN_TEST(test_txq_pos_delta_refresh_and_reference_check);
+  RUN_TEST(test_txq_pos_delta_bounded_by_run_and_missed_frames);
+  RUN_TEST(test_txq_short_addr_cadence_and_rx_resolve);
+  RUN_TEST(test_txq_fec_wraps_positions_and_rx_corrects);
+  RUN_TEST(test_relay_policy_dedupe_hops_probability_budget);
+  RUN_TEST(test_relay_queues_hop_copy_and_receivers_apply_it);
   return UNITY_END();
 }
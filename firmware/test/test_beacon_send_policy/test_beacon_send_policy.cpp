@@ -4,6 +4,7 @@
 
 #include "../../src/domain/beacon_send_policy.h"
 #include "../../src/domain/beacon_send_policy.cpp"
+#include "../../src/domain/airtime_model.cpp"
 #include "../../lib/NavigaCore/include/naviga/hal/mocks/mock_channel_sense.h"
 #include "../../lib/NavigaCore/src/mocks/mock_channel_sense.cpp"
 
@@ -73,11 +74,65 @@ void test_send_success_resets_backoff() {
   TEST_ASSERT_FALSE(policy.has_pending());
 }
 
+void test_slotted_waits_for_own_slot_and_falls_back_to_jitter() {
+  BeaconSendPolicy policy;
+  policy.init(1);
+  policy.set_jitter_ms(0);
+  policy.set_slotting(0x0000AABBCCDDEEFFULL, 200);  // 50 slots per 10 s superframe
+
+  // No GNSS time yet: jitter mode.
+  TEST_ASSERT_FALSE(policy.slotted(1000));
+  policy.on_payload_built(1000);
+  TEST_ASSERT_TRUE(policy.ready_to_attempt(1000));
+  policy.on_send_result(true, 1000);
+
+  // GNSS time: attempts start on a slot boundary of GPS time, at most the next superframe.
+  policy.set_gnss_time(500000, 2000);  // tow 500 s at uptime 2 s
+  for (uint32_t now = 2000; now < 60000; now += 3700) {
+    TEST_ASSERT_TRUE(policy.slotted(now));
+    policy.on_payload_built(now);
+    uint32_t t = now;
+    while (!policy.ready_to_attempt(t)) {
+      t++;
+    }
+    TEST_ASSERT_TRUE(t - now < 2 * BeaconSendPolicy::kSuperframeMs);
+    TEST_ASSERT_EQUAL_UINT32(0, (500000 + (t - 2000)) % 200);
+    policy.on_send_result(true, t);
+  }
+
+  // Different superframes pick different slots for the same node.
+  bool moved = false;
+  uint32_t first_offset = 0;
+  for (uint32_t sf = 0; sf < 8; ++sf) {
+    const uint32_t now = 100000 + sf * BeaconSendPolicy::kSuperframeMs;
+    policy.set_gnss_time(sf * BeaconSendPolicy::kSuperframeMs, now);
+    policy.on_payload_built(now);
+    uint32_t t = now;
+    while (!policy.ready_to_attempt(t)) {
+      t++;
+    }
+    if (sf == 0) {
+      first_offset = t - now;
+    } else if (t - now != first_offset) {
+      moved = true;
+    }
+    policy.on_send_result(true, t);
+  }
+  TEST_ASSERT_TRUE(moved);
+
+  // Reference too old: back to jitter.
+  policy.set_gnss_time(0, 200000);
+  TEST_ASSERT_FALSE(policy.slotted(200000 + BeaconSendPolicy::kMaxGnssTimeAgeMs + 1));
+  policy.clear_gnss_time();
+  TEST_ASSERT_FALSE(policy.slotted(200000));
+}
+
 int main(int argc, char** argv) {
   UNITY_BEGIN();
   RUN_TEST(test_sense_unsupported_allows_send);
   RUN_TEST(test_sense_busy_defers);
   RUN_TEST(test_send_fail_increases_backoff);
   RUN_TEST(test_send_success_resets_backoff);
+  RUN_TEST(test_slotted_waits_for_own_slot_and_falls_back_to_jitter);
   return UNITY_END();
 }
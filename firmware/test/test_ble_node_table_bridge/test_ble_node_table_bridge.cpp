@@ -6,6 +6,7 @@
 #include "../../protocol/ble_node_table_bridge.cpp"
 #include "../../src/domain/node_table.h"
 #include "../../src/domain/node_table.cpp"
+#include "../../src/domain/link_stats.cpp"
 #include "../../lib/NavigaCore/include/naviga/hal/mocks/mock_ble_transport.h"
 #include "../../lib/NavigaCore/src/mocks/mock_ble_transport.cpp"
 
@@ -244,6 +245,40 @@ void test_subscription_exported_field_change_triggers_update() {
   TEST_ASSERT_EQUAL_UINT64(0x2222222222222222ULL, read_u64_le(transport.subscription_update_data() + 1));
 }
 
+/** Link stats export: self skipped, newest-heard peer first, 16-byte entries. */
+void test_link_stats_export_order_and_layout() {
+  MockBleTransport transport;
+  BleNodeTableBridge bridge;
+  NodeTable table;
+  table.set_expected_interval_s(10);
+  table.init_self(0x1111111111111111ULL, 1000);
+
+  table.upsert_remote(0x0000AABBCCDDEEFFULL, true, 1, 2, 0, -70, 1, 1000);
+  table.upsert_remote(0x0000AABBCCDDEEFFULL, true, 1, 2, 0, -70, 3, 2000);  // seq 2 lost
+  table.upsert_remote(0x0000112233445566ULL, true, 1, 2, 0, -50, 1, 3000);
+
+  bridge.update_link_stats(table, transport);
+  TEST_ASSERT_EQUAL(2 + 2 * BleNodeTableBridge::kLinkStatsEntryBytes, transport.link_stats_len());
+  const uint8_t* p = transport.link_stats_data();
+  TEST_ASSERT_EQUAL_UINT8(BleNodeTableBridge::kLinkStatsFormatVer, p[0]);
+  TEST_ASSERT_EQUAL_UINT8(2, p[1]);
+
+  const uint8_t* first = p + 2;
+  TEST_ASSERT_EQUAL_UINT8(0x66, first[0]);
+  TEST_ASSERT_EQUAL_UINT8(0x11, first[5]);
+  TEST_ASSERT_EQUAL_INT8(-50, static_cast<int8_t>(first[6]));
+  TEST_ASSERT_EQUAL_UINT8(100, first[7]);
+
+  const uint8_t* second = first + BleNodeTableBridge::kLinkStatsEntryBytes;
+  TEST_ASSERT_EQUAL_UINT8(0xFF, second[0]);
+  TEST_ASSERT_EQUAL_UINT8(0xAA, second[5]);
+  TEST_ASSERT_EQUAL_INT8(-70, static_cast<int8_t>(second[6]));
+  TEST_ASSERT_EQUAL_UINT8(67, second[7]);
+  TEST_ASSERT_EQUAL_UINT16(100, read_u16_le(second + 8));
+  TEST_ASSERT_EQUAL_UINT16(0, read_u16_le(second + 12));
+  TEST_ASSERT_EQUAL_UINT16(1, read_u16_le(second + 14));
+}
+
 int main(int argc, char** argv) {
   UNITY_BEGIN();
   RUN_TEST(test_device_info_payload);
@@ -254,5 +289,6 @@ int main(int argc, char** argv) {
   RUN_TEST(test_subscription_batch_actual_packed_count);
   RUN_TEST(test_subscription_batch_overflow_retention);
   RUN_TEST(test_subscription_exported_field_change_triggers_update);
+  RUN_TEST(test_link_stats_export_order_and_layout);
   return UNITY_END();
 }
@@ -0,0 +1,66 @@
+/**
+ * Node_Bundle (0x08) codec: whole Pos_Full / Status frames packed into one bundle and read back.
+ * Codec-only; BeaconLogic bundling on TX and RX stays in test_beacon_logic.
+ */
+#include <unity.h>
+
+#include <cstdint>
+
+#include "../../protocol/bundle_codec.h"
+#include "../../protocol/bundle_codec.cpp"
+#include "../../protocol/pos_full_codec.h"
+#include "../../protocol/pos_full_codec.cpp"
+#include "../../protocol/status_codec.h"
+#include "../../protocol/status_codec.cpp"
+
+using naviga::protocol::kPosFullFrameSize;
+using naviga::protocol::kStatusFrameSize;
+
+void test_bundle_codec_round_trip() {
+  namespace p = naviga::protocol;
+  const uint64_t node_id = 0x0000AABBCCDDEE11ULL;
+  p::PosFullFields pos{};
+  pos.node_id = node_id;
+  pos.seq16 = 9;
+  pos.lat_e7 = 550000000;
+  pos.lon_e7 = 370000000;
+  uint8_t pos_frame[kPosFullFrameSize] = {};
+  TEST_ASSERT_EQUAL(kPosFullFrameSize, p::encode_pos_full_frame(pos, pos_frame, sizeof(pos_frame)));
+  p::StatusFields st{};
+  st.node_id = node_id;
+  st.seq16 = 10;
+  st.battery_percent = 80;
+  uint8_t st_frame[kStatusFrameSize] = {};
+  TEST_ASSERT_EQUAL(kStatusFrameSize, p::encode_status_frame(st, st_frame, sizeof(st_frame)));
+
+  uint8_t bundle[p::kMaxFrameSize] = {};
+  size_t len = 0;
+  TEST_ASSERT_TRUE(p::bundle_begin(node_id, bundle, sizeof(bundle), &len));
+  TEST_ASSERT_TRUE(p::bundle_append_frame(pos_frame, sizeof(pos_frame), bundle, sizeof(bundle), &len));
+  TEST_ASSERT_TRUE(p::bundle_append_frame(st_frame, sizeof(st_frame), bundle, sizeof(bundle), &len));
+  TEST_ASSERT_EQUAL(35u, len);
+
+  // Other node's frame and nested bundles are rejected; bundle unchanged.
+  st_frame[4] ^= 0x01;
+  TEST_ASSERT_FALSE(p::bundle_append_frame(st_frame, sizeof(st_frame), bundle, sizeof(bundle), &len));
+  st_frame[4] ^= 0x01;
+  TEST_ASSERT_FALSE(p::bundle_append_frame(bundle, len, bundle, sizeof(bundle), &len));
+  TEST_ASSERT_EQUAL(35u, len);
+
+  p::PacketHeader hdr{};
+  TEST_ASSERT_TRUE(p::decode_header(bundle, len, &hdr));
+  TEST_ASSERT_EQUAL(static_cast<int>(p::MsgType::BeaconBundle), static_cast<int>(hdr.msg_type));
+  uint8_t out[p::kMaxFrameSize] = {};
+  TEST_ASSERT_EQUAL(kPosFullFrameSize, p::bundle_unpack(bundle + 2, len - 2, 0, out, sizeof(out)));
+  TEST_ASSERT_EQUAL_MEMORY(pos_frame, out, kPosFullFrameSize);
+  TEST_ASSERT_EQUAL(kStatusFrameSize, p::bundle_unpack(bundle + 2, len - 2, 1, out, sizeof(out)));
+  TEST_ASSERT_EQUAL_MEMORY(st_frame, out, kStatusFrameSize);
+  TEST_ASSERT_EQUAL(0u, p::bundle_unpack(bundle + 2, len - 2, 2, out, sizeof(out)));
+  TEST_ASSERT_EQUAL(0u, p::bundle_unpack(bundle + 2, len - 3, 1, out, sizeof(out)));  // truncated
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_bundle_codec_round_trip);
+  return UNITY_END();
+}
@@ -0,0 +1,88 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include "../../protocol/fec_codec.h"
+#include "../../protocol/fec_codec.cpp"
+
+namespace {
+
+uint32_t fec_test_rand(uint32_t* state) {
+  *state = *state * 1103515245u + 12345u;
+  return *state >> 16;
+}
+
+} // namespace
+
+void test_fec_codec_corrects_up_to_half_parity() {
+  uint32_t rng = 12345u;
+  uint8_t frame[40] = {};
+  naviga::protocol::PacketHeader hdr;
+  hdr.msg_type = naviga::protocol::MsgType::BeaconPosFull;
+  hdr.payload_len = 17;
+  TEST_ASSERT_TRUE(naviga::protocol::encode_header(hdr, frame, sizeof(frame)));
+  for (size_t i = 2; i < 19; ++i) {
+    frame[i] = static_cast<uint8_t>(fec_test_rand(&rng));
+  }
+
+  for (uint8_t parity = naviga::protocol::kFecParityMin; parity <= naviga::protocol::kFecParityMax;
+       parity = static_cast<uint8_t>(parity + 2)) {
+    uint8_t wrapped[65] = {};
+    const size_t len = naviga::protocol::fec_wrap(frame, 19, parity, wrapped, sizeof(wrapped));
+    TEST_ASSERT_EQUAL(naviga::protocol::fec_frame_size(19, parity), len);
+    naviga::protocol::PacketHeader outer{};
+    TEST_ASSERT_TRUE(naviga::protocol::decode_header(wrapped, len, &outer));
+    TEST_ASSERT_TRUE(outer.msg_type == naviga::protocol::MsgType::BeaconFec);
+    TEST_ASSERT_EQUAL_UINT8(0, naviga::protocol::frame_hops(wrapped));
+
+    for (int trial = 0; trial < 50; ++trial) {
+      // Up to parity / 2 distinct bytes, anywhere but the msg_type bits of the outer header.
+      uint8_t rx[65] = {};
+      std::memcpy(rx, wrapped, len);
+      const uint8_t errors = static_cast<uint8_t>(1 + fec_test_rand(&rng) % (parity / 2));
+      const size_t start = fec_test_rand(&rng);
+      for (uint8_t e = 0; e < errors; ++e) {
+        const size_t at = 1 + (start + e) % (len - 1);
+        rx[at] ^= static_cast<uint8_t>(at == 1 ? 0x01 : 1 + fec_test_rand(&rng) % 255);
+      }
+      uint8_t inner[65] = {};
+      uint8_t corrected = 0;
+      TEST_ASSERT_EQUAL(19u, naviga::protocol::fec_unwrap(rx, len, inner, sizeof(inner), &corrected));
+      TEST_ASSERT_EQUAL_UINT8(errors, corrected);
+      TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, inner, 19);
+    }
+  }
+
+  // Corrupted parity_len byte: recovered by trying the other lengths.
+  uint8_t wrapped[65] = {};
+  const size_t len = naviga::protocol::fec_wrap(frame, 19, 8, wrapped, sizeof(wrapped));
+  wrapped[2] = 0x5A;
+  uint8_t inner[65] = {};
+  TEST_ASSERT_EQUAL(19u, naviga::protocol::fec_unwrap(wrapped, len, inner, sizeof(inner)));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, inner, 19);
+
+  // Beyond the parity: rejected, not miscorrected into another frame.
+  wrapped[2] = 8;
+  for (size_t i = 3; i < 3 + 6; ++i) {
+    wrapped[i] ^= 0xA5;
+  }
+  TEST_ASSERT_EQUAL(0u, naviga::protocol::fec_unwrap(wrapped, len, inner, sizeof(inner)));
+
+  // Invalid parity lengths, nested envelopes and oversize frames are refused.
+  TEST_ASSERT_EQUAL(0u, naviga::protocol::fec_wrap(frame, 19, 3, wrapped, sizeof(wrapped)));
+  TEST_ASSERT_EQUAL(0u, naviga::protocol::fec_wrap(frame, 19, 18, wrapped, sizeof(wrapped)));
+  const size_t again = naviga::protocol::fec_wrap(frame, 19, 2, wrapped, sizeof(wrapped));
+  uint8_t nested[65] = {};
+  TEST_ASSERT_EQUAL(0u, naviga::protocol::fec_wrap(wrapped, again, 2, nested, sizeof(nested)));
+  uint8_t big[2 + 50] = {};
+  hdr.payload_len = 50;
+  TEST_ASSERT_TRUE(naviga::protocol::encode_header(hdr, big, sizeof(big)));
+  TEST_ASSERT_EQUAL(0u, naviga::protocol::fec_wrap(big, sizeof(big), 16, nested, sizeof(nested)));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fec_codec_corrects_up_to_half_parity);
+  return UNITY_END();
+}
@@ -0,0 +1,178 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <cstdio>
+
+#include "../../src/domain/log_frame.cpp"
+#include "../../src/domain/logger.cpp"
+#include "../../src/domain/flash_log.h"
+#include "../../src/domain/flash_log.cpp"
+#include "naviga/hal/mocks/file_flash_region.h"
+
+using naviga::FileFlashRegion;
+using naviga::domain::FlashLog;
+using naviga::domain::LogEventId;
+using naviga::domain::LogLevel;
+using naviga::domain::LogRecordView;
+using naviga::domain::Logger;
+
+namespace {
+
+constexpr const char* kPath = "flash_log_test.bin";
+constexpr size_t kSectorSize = 512;
+constexpr size_t kSectorCount = 4;
+
+struct Collected {
+  uint32_t t_ms[2048] = {};
+  uint8_t first_payload[2048] = {};
+  size_t count = 0;
+};
+
+void collect(void* ctx, const LogRecordView& record) {
+  auto* c = static_cast<Collected*>(ctx);
+  if (c->count < 2048) {
+    c->first_payload[c->count] = record.len > 0 ? record.payload[0] : 0;
+    c->t_ms[c->count++] = record.t_ms;
+  }
+}
+
+LogRecordView make_record(uint32_t t_ms, const uint8_t* payload, uint8_t len) {
+  return LogRecordView{t_ms, LogEventId::RADIO_RX_OK, LogLevel::kInfo, payload, len};
+}
+
+} // namespace
+
+void setUp() {
+  std::remove(kPath);
+}
+
+void tearDown() {
+  std::remove(kPath);
+}
+
+void test_persists_across_remount() {
+  FileFlashRegion region(kPath, kSectorSize, kSectorCount);
+  TEST_ASSERT_TRUE(region.open());
+  FlashLog log;
+  TEST_ASSERT_TRUE(log.mount(&region));
+
+  const uint8_t payload[3] = {7, 8, 9};
+  for (uint32_t i = 0; i < 10; ++i) {
+    TEST_ASSERT_TRUE(log.append(make_record(100 + i, payload, sizeof(payload))));
+  }
+  TEST_ASSERT_TRUE(log.flush());
+  TEST_ASSERT_EQUAL_UINT32(0, log.pending_bytes());
+
+  FlashLog reopened;
+  TEST_ASSERT_TRUE(reopened.mount(&region));
+  Collected c{};
+  reopened.for_each_record(collect, &c);
+  TEST_ASSERT_EQUAL_UINT32(10, c.count);
+  TEST_ASSERT_EQUAL_UINT32(100, c.t_ms[0]);
+  TEST_ASSERT_EQUAL_UINT32(109, c.t_ms[9]);
+  TEST_ASSERT_EQUAL_UINT8(7, c.first_payload[5]);
+
+  // Appends after remount continue after the existing records.
+  TEST_ASSERT_TRUE(reopened.append(make_record(200, payload, sizeof(payload))));
+  TEST_ASSERT_TRUE(reopened.flush());
+  Collected c2{};
+  reopened.for_each_record(collect, &c2);
+  TEST_ASSERT_EQUAL_UINT32(11, c2.count);
+  TEST_ASSERT_EQUAL_UINT32(200, c2.t_ms[10]);
+}
+
+void test_wraps_oldest_first_and_levels_wear() {
+  FileFlashRegion region(kPath, kSectorSize, kSectorCount);
+  TEST_ASSERT_TRUE(region.open());
+  FlashLog log;
+  TEST_ASSERT_TRUE(log.mount(&region));
+
+  const uint8_t payload[8] = {1, 2, 3, 4, 5, 6, 7, 8};  // 19-byte records
+  uint32_t t = 0;
+  for (int round = 0; round < 40; ++round) {
+    for (int i = 0; i < 20; ++i) {
+      TEST_ASSERT_TRUE(log.append(make_record(t++, payload, sizeof(payload))));
+    }
+    TEST_ASSERT_TRUE(log.flush());
+  }
+
+  Collected c{};
+  log.for_each_record(collect, &c);
+  TEST_ASSERT_TRUE(c.count > 0);
+  TEST_ASSERT_TRUE(c.count < t);
+  for (size_t i = 1; i < c.count; ++i) {
+    TEST_ASSERT_EQUAL_UINT32(c.t_ms[i - 1] + 1, c.t_ms[i]);
+  }
+  TEST_ASSERT_EQUAL_UINT32(t - 1, c.t_ms[c.count - 1]);
+
+  uint32_t min_erase = region.erase_count(0);
+  uint32_t max_erase = min_erase;
+  for (size_t s = 1; s < kSectorCount; ++s) {
+    const uint32_t e = region.erase_count(s);
+    min_erase = e < min_erase ? e : min_erase;
+    max_erase = e > max_erase ? e : max_erase;
+  }
+  TEST_ASSERT_TRUE(max_erase - min_erase <= 1);
+}
+
+void test_torn_record_ends_sector() {
+  FileFlashRegion region(kPath, kSectorSize, kSectorCount);
+  TEST_ASSERT_TRUE(region.open());
+  FlashLog log;
+  TEST_ASSERT_TRUE(log.mount(&region));
+  const uint8_t payload[2] = {0xAA, 0xBB};
+  TEST_ASSERT_TRUE(log.append(make_record(1, payload, 2)));
+  TEST_ASSERT_TRUE(log.append(make_record(2, payload, 2)));
+  TEST_ASSERT_TRUE(log.flush());
+
+  // Simulate a reset mid-write of a third record: tag + partial header, no CRC.
+  const uint8_t partial[4] = {0x5A, 0x03, 0x00, 0x00};
+  TEST_ASSERT_TRUE(region.write(FlashLog::kSectorHeaderSize + 2 * 13, partial, sizeof(partial)));
+
+  FlashLog reopened;
+  TEST_ASSERT_TRUE(reopened.mount(&region));
+  TEST_ASSERT_TRUE(reopened.append(make_record(4, payload, 2)));
+  TEST_ASSERT_TRUE(reopened.flush());
+  Collected c{};
+  reopened.for_each_record(collect, &c);
+  TEST_ASSERT_EQUAL_UINT32(3, c.count);
+  TEST_ASSERT_EQUAL_UINT32(1, c.t_ms[0]);
+  TEST_ASSERT_EQUAL_UINT32(2, c.t_ms[1]);
+  TEST_ASSERT_EQUAL_UINT32(4, c.t_ms[2]);
+}
+
+void test_tick_bounds_write_frequency() {
+  FileFlashRegion region(kPath, kSectorSize, kSectorCount);
+  TEST_ASSERT_TRUE(region.open());
+  FlashLog log;
+  TEST_ASSERT_TRUE(log.mount(&region));
+
+  // Logger mirrors every record into the flash batch.
+  Logger logger;
+  logger.set_sink(FlashLog::sink, &log);
+  TEST_ASSERT_TRUE(logger.log(10, LogEventId::BLE_CONNECT, LogLevel::kInfo));
+  TEST_ASSERT_EQUAL_UINT32(FlashLog::kRecordOverhead, log.pending_bytes());
+
+  const uint32_t writes_before = region.write_calls();
+  TEST_ASSERT_FALSE(log.tick(5000));
+  TEST_ASSERT_TRUE(log.tick(FlashLog::kFlushIntervalMs));
+  TEST_ASSERT_EQUAL_UINT32(writes_before + 1, region.write_calls());
+
+  // Batch pressure flushes early, but never sooner than kMinFlushSpacingMs.
+  const uint8_t payload[40] = {};
+  while (log.append(make_record(1, payload, sizeof(payload)))) {
+  }
+  TEST_ASSERT_TRUE(log.stats().records_dropped > 0);
+  TEST_ASSERT_FALSE(log.tick(FlashLog::kFlushIntervalMs + 500));
+  TEST_ASSERT_TRUE(log.tick(FlashLog::kFlushIntervalMs + FlashLog::kMinFlushSpacingMs));
+  TEST_ASSERT_EQUAL_UINT32(0, log.pending_bytes());
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_persists_across_remount);
+  RUN_TEST(test_wraps_oldest_first_and_levels_wear);
+  RUN_TEST(test_torn_record_ends_sector);
+  RUN_TEST(test_tick_bounds_write_frequency);
+  return UNITY_END();
+}
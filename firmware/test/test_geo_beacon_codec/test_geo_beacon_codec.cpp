@@ -6,6 +6,7 @@
 #include "../../protocol/packet_header.h"
 #include "../../protocol/geo_beacon_codec.h"
 #include "../../protocol/geo_beacon_codec.cpp"
+#include "../../protocol/geo_u24.h"
 #include "../../protocol/alive_codec.h"
 
 using naviga::protocol::AliveDecodeError;
@@ -32,11 +33,7 @@ using naviga::protocol::decode_alive_payload;
 using naviga::protocol::encode_alive_frame;
 using naviga::protocol::validate_header;
 
-static constexpr double kDegTol = 0.00003;
-
-static bool deg_near(double a, double b, double tol) {
-  return (a - b) < tol && (b - a) < tol;
-}
+static constexpr int32_t kE7Tol = 300;  // 0.00003 deg, above the packed24 step of 1/16777215
 
 // ═══════════════════════════════════════════════════════════════════════════
 // SECTION 1: Packet header encode/decode golden vectors
@@ -176,8 +173,8 @@ void test_framed_core_golden_encode() {
   GeoBeaconFields in{};
   in.node_id   = 0x0000AABBCCDDEEFFULL;
   in.pos_valid = 1;
-  in.lat_deg   = 55.7558;
-  in.lon_deg   = 37.6173;
+  in.lat_e7    = 557558000;
+  in.lon_e7    = 376173000;
   in.seq       = 1;
 
   uint8_t buf[kGeoBeaconFrameSize] = {};
@@ -216,8 +213,8 @@ void test_framed_core_golden_decode() {
   TEST_ASSERT_EQUAL_UINT64(0x0000AABBCCDDEEFFULL, out.node_id);
   TEST_ASSERT_EQUAL_UINT16(1, out.seq);
   TEST_ASSERT_EQUAL_UINT8(1, out.pos_valid);
-  TEST_ASSERT_TRUE(deg_near(out.lat_deg, 55.7558, kDegTol));
-  TEST_ASSERT_TRUE(deg_near(out.lon_deg, 37.6173, kDegTol));
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, 557558000, out.lat_e7);
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, 376173000, out.lon_e7);
 }
 
 // decode_geo_beacon_frame rejects wrong msg_type.
@@ -253,8 +250,8 @@ void test_payload_golden_vector_encode() {
   GeoBeaconFields in{};
   in.node_id   = 0x0000AABBCCDDEEFFULL;
   in.pos_valid = 1;
-  in.lat_deg   = 55.7558;
-  in.lon_deg   = 37.6173;
+  in.lat_e7    = 557558000;
+  in.lon_e7    = 376173000;
   in.seq       = 1;
 
   // encode_geo_beacon now requires kGeoBeaconFrameSize buffer.
@@ -287,16 +284,16 @@ void test_payload_golden_vector_decode() {
   TEST_ASSERT_EQUAL_UINT64(0x0000AABBCCDDEEFFULL, out.node_id);
   TEST_ASSERT_EQUAL_UINT16(1, out.seq);
   TEST_ASSERT_EQUAL_UINT8(1, out.pos_valid);
-  TEST_ASSERT_TRUE(deg_near(out.lat_deg, 55.7558, kDegTol));
-  TEST_ASSERT_TRUE(deg_near(out.lon_deg, 37.6173, kDegTol));
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, 557558000, out.lat_e7);
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, 376173000, out.lon_e7);
 }
 
 void test_round_trip() {
   GeoBeaconFields in{};
   in.node_id   = 0x0000AABBCCDDEEFFULL;
   in.pos_valid = 1;
-  in.lat_deg   = 55.7558;
-  in.lon_deg   = 37.6173;
+  in.lat_e7    = 557558000;
+  in.lon_e7    = 376173000;
   in.seq       = 4567;
 
   uint8_t buf[kGeoBeaconFrameSize] = {};
@@ -309,8 +306,8 @@ void test_round_trip() {
   TEST_ASSERT_EQUAL_UINT64(in.node_id, out.node_id);
   TEST_ASSERT_EQUAL_UINT16(in.seq, out.seq);
   TEST_ASSERT_EQUAL_UINT8(1, out.pos_valid);
-  TEST_ASSERT_TRUE(deg_near(out.lat_deg, in.lat_deg, kDegTol));
-  TEST_ASSERT_TRUE(deg_near(out.lon_deg, in.lon_deg, kDegTol));
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, in.lat_e7, out.lat_e7);
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, in.lon_e7, out.lon_e7);
 }
 
 void test_round_trip_extremes() {
@@ -322,48 +319,48 @@ void test_round_trip_extremes() {
   uint8_t buf[kGeoBeaconFrameSize] = {};
   GeoBeaconFields out{};
 
-  in.lat_deg = 90.0; in.lon_deg = 180.0;
+  in.lat_e7 = 900000000; in.lon_e7 = 1800000000;
   TEST_ASSERT_EQUAL_UINT32(kGeoBeaconFrameSize, encode_geo_beacon(in, ByteSpan{buf, sizeof(buf)}));
   TEST_ASSERT_EQUAL(DecodeError::Ok, decode_geo_beacon(ConstByteSpan{buf + kHeaderSize, kGeoBeaconSize}, &out));
-  TEST_ASSERT_TRUE(deg_near(out.lat_deg, 90.0, kDegTol));
-  TEST_ASSERT_TRUE(deg_near(out.lon_deg, 180.0, kDegTol));
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, 900000000, out.lat_e7);
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, 1800000000, out.lon_e7);
 
-  in.lat_deg = -90.0; in.lon_deg = -180.0;
+  in.lat_e7 = -900000000; in.lon_e7 = -1800000000;
   TEST_ASSERT_EQUAL_UINT32(kGeoBeaconFrameSize, encode_geo_beacon(in, ByteSpan{buf, sizeof(buf)}));
   TEST_ASSERT_EQUAL(DecodeError::Ok, decode_geo_beacon(ConstByteSpan{buf + kHeaderSize, kGeoBeaconSize}, &out));
-  TEST_ASSERT_TRUE(deg_near(out.lat_deg, -90.0, kDegTol));
-  TEST_ASSERT_TRUE(deg_near(out.lon_deg, -180.0, kDegTol));
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, -900000000, out.lat_e7);
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, -1800000000, out.lon_e7);
 
-  in.lat_deg = 0.0; in.lon_deg = 0.0;
+  in.lat_e7 = 0; in.lon_e7 = 0;
   TEST_ASSERT_EQUAL_UINT32(kGeoBeaconFrameSize, encode_geo_beacon(in, ByteSpan{buf, sizeof(buf)}));
   TEST_ASSERT_EQUAL(DecodeError::Ok, decode_geo_beacon(ConstByteSpan{buf + kHeaderSize, kGeoBeaconSize}, &out));
-  TEST_ASSERT_TRUE(deg_near(out.lat_deg, 0.0, kDegTol));
-  TEST_ASSERT_TRUE(deg_near(out.lon_deg, 0.0, kDegTol));
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, 0, out.lat_e7);
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, 0, out.lon_e7);
 }
 
 void test_clamp_out_of_range_lat() {
   GeoBeaconFields in{};
-  in.node_id = 1; in.pos_valid = 1; in.lat_deg = 200.0; in.lon_deg = 0.0; in.seq = 1;
+  in.node_id = 1; in.pos_valid = 1; in.lat_e7 = 2000000000; in.lon_e7 = 0; in.seq = 1;
   uint8_t buf[kGeoBeaconFrameSize] = {};
   TEST_ASSERT_EQUAL_UINT32(kGeoBeaconFrameSize, encode_geo_beacon(in, ByteSpan{buf, sizeof(buf)}));
   GeoBeaconFields out{};
   TEST_ASSERT_EQUAL(DecodeError::Ok, decode_geo_beacon(ConstByteSpan{buf + kHeaderSize, kGeoBeaconSize}, &out));
-  TEST_ASSERT_TRUE(deg_near(out.lat_deg, 90.0, kDegTol));
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, 900000000, out.lat_e7);
 }
 
 void test_clamp_out_of_range_lon() {
   GeoBeaconFields in{};
-  in.node_id = 1; in.pos_valid = 1; in.lat_deg = 0.0; in.lon_deg = -500.0; in.seq = 1;
+  in.node_id = 1; in.pos_valid = 1; in.lat_e7 = 0; in.lon_e7 = -2000000000; in.seq = 1;
   uint8_t buf[kGeoBeaconFrameSize] = {};
   TEST_ASSERT_EQUAL_UINT32(kGeoBeaconFrameSize, encode_geo_beacon(in, ByteSpan{buf, sizeof(buf)}));
   GeoBeaconFields out{};
   TEST_ASSERT_EQUAL(DecodeError::Ok, decode_geo_beacon(ConstByteSpan{buf + kHeaderSize, kGeoBeaconSize}, &out));
-  TEST_ASSERT_TRUE(deg_near(out.lon_deg, -180.0, kDegTol));
+  TEST_ASSERT_INT32_WITHIN(kE7Tol, -1800000000, out.lon_e7);
 }
 
 void test_encode_no_fix_returns_zero() {
   GeoBeaconFields in{};
-  in.node_id = 1; in.pos_valid = 0; in.lat_deg = 55.7558; in.lon_deg = 37.6173; in.seq = 1;
+  in.node_id = 1; in.pos_valid = 0; in.lat_e7 = 557558000; in.lon_e7 = 376173000; in.seq = 1;
   uint8_t buf[kGeoBeaconFrameSize] = {};
   TEST_ASSERT_EQUAL_UINT32(0, encode_geo_beacon(in, ByteSpan{buf, sizeof(buf)}));
 }
@@ -384,7 +381,7 @@ void test_decode_short_buffer() {
 
 void test_bad_payload_version() {
   GeoBeaconFields in{};
-  in.node_id = 1; in.pos_valid = 1; in.lat_deg = 0.0; in.lon_deg = 0.0; in.seq = 0;
+  in.node_id = 1; in.pos_valid = 1; in.lat_e7 = 0; in.lon_e7 = 0; in.seq = 0;
   uint8_t buf[kGeoBeaconFrameSize] = {};
   TEST_ASSERT_EQUAL_UINT32(kGeoBeaconFrameSize, encode_geo_beacon(in, ByteSpan{buf, sizeof(buf)}));
   buf[kHeaderSize] = 0xFF;  // corrupt payloadVersion
@@ -396,7 +393,7 @@ void test_bad_payload_version() {
 void test_nodeid48_upper_bits_stripped() {
   GeoBeaconFields in{};
   in.node_id = 0xDEAD001122334455ULL;
-  in.pos_valid = 1; in.lat_deg = 0.0; in.lon_deg = 0.0; in.seq = 0;
+  in.pos_valid = 1; in.lat_e7 = 0; in.lon_e7 = 0; in.seq = 0;
   uint8_t buf[kGeoBeaconFrameSize] = {};
   TEST_ASSERT_EQUAL_UINT32(kGeoBeaconFrameSize, encode_geo_beacon(in, ByteSpan{buf, sizeof(buf)}));
   GeoBeaconFields out{};
@@ -544,6 +541,72 @@ void test_alive_roundtrip() {
   TEST_ASSERT_FALSE(out.has_status);
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// SECTION 5: Integer packed24 lat/lon vs the former double formulas
+// ═══════════════════════════════════════════════════════════════════════════
+
+using naviga::protocol::kGeoU24Max;
+using naviga::protocol::kLatE7Max;
+using naviga::protocol::kLonE7Max;
+using naviga::protocol::lat_e7_to_u24;
+using naviga::protocol::lon_e7_to_u24;
+using naviga::protocol::u24_to_lat_e7;
+using naviga::protocol::u24_to_lon_e7;
+
+static uint32_t double_lat_to_u24(int32_t lat_e7) {
+  return static_cast<uint32_t>(std::round((lat_e7 * 1e-7 + 90.0) / 180.0 * 16777215.0));
+}
+
+static uint32_t double_lon_to_u24(int32_t lon_e7) {
+  return static_cast<uint32_t>(std::round((lon_e7 * 1e-7 + 180.0) / 360.0 * 16777215.0));
+}
+
+static uint32_t lcg_next(uint32_t* state) {
+  *state = *state * 1664525u + 1013904223u;
+  return *state;
+}
+
+void test_u24_decode_matches_double_exhaustive() {
+  uint32_t lat_mismatch = 0;
+  uint32_t lon_mismatch = 0;
+  for (uint32_t v = 0; v <= kGeoU24Max; ++v) {
+    const double lat = static_cast<double>(v) / 16777215.0 * 180.0 - 90.0;
+    const double lon = static_cast<double>(v) / 16777215.0 * 360.0 - 180.0;
+    if (u24_to_lat_e7(v) != static_cast<int32_t>(std::llround(lat * 1e7))) lat_mismatch++;
+    if (u24_to_lon_e7(v) != static_cast<int32_t>(std::llround(lon * 1e7))) lon_mismatch++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, lat_mismatch);
+  TEST_ASSERT_EQUAL_UINT32(0, lon_mismatch);
+}
+
+void test_u24_encode_matches_double_randomized() {
+  // Range ends and zero, then a deterministic pseudo-random sweep of both ranges.
+  const int32_t edges[] = {-kLatE7Max, -kLatE7Max + 1, -1, 0, 1, kLatE7Max - 1, kLatE7Max};
+  for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); ++i) {
+    TEST_ASSERT_EQUAL_UINT32(double_lat_to_u24(edges[i]), lat_e7_to_u24(edges[i]));
+    TEST_ASSERT_EQUAL_UINT32(double_lon_to_u24(edges[i] * 2), lon_e7_to_u24(edges[i] * 2));
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, lat_e7_to_u24(-kLatE7Max));
+  TEST_ASSERT_EQUAL_UINT32(kGeoU24Max, lat_e7_to_u24(kLatE7Max));
+  TEST_ASSERT_EQUAL_UINT32(0, lon_e7_to_u24(-kLonE7Max));
+  TEST_ASSERT_EQUAL_UINT32(kGeoU24Max, lon_e7_to_u24(kLonE7Max));
+
+  uint32_t state = 0x4E415649u;
+  uint32_t lat_mismatch = 0;
+  uint32_t lon_mismatch = 0;
+  for (uint32_t i = 0; i < 2000000u; ++i) {
+    const int32_t lat_e7 =
+        static_cast<int32_t>(lcg_next(&state) % (2u * kLatE7Max + 1u)) - kLatE7Max;
+    const int32_t lon_e7 = static_cast<int32_t>(
+        static_cast<int64_t>(lcg_next(&state) % (2u * static_cast<uint32_t>(kLonE7Max) + 1u)) -
+        kLonE7Max);
+    if (lat_e7_to_u24(lat_e7) != double_lat_to_u24(lat_e7)) lat_mismatch++;
+    if (lon_e7_to_u24(lon_e7) != double_lon_to_u24(lon_e7)) lon_mismatch++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, lat_mismatch);
+  TEST_ASSERT_EQUAL_UINT32(0, lon_mismatch);
+}
+
 int main(int argc, char** argv) {
   UNITY_BEGIN();
 
@@ -588,5 +651,9 @@ int main(int argc, char** argv) {
   RUN_TEST(test_alive_decode_bad_payload_version);
   RUN_TEST(test_alive_roundtrip);
 
+  // Integer packed24 lat/lon
+  RUN_TEST(test_u24_decode_matches_double_exhaustive);
+  RUN_TEST(test_u24_encode_matches_double_randomized);
+
   return UNITY_END();
 }
@@ -28,6 +28,27 @@ void test_mock_radio_send_and_recv() {
   TEST_ASSERT_EQUAL_INT8(-42, radio.last_rssi_dbm());
 }
 
+void test_mock_radio_async_send_completion() {
+  MockRadio radio;
+  uint8_t payload[4] = {1, 2, 3, 4};
+  TEST_ASSERT_EQUAL(RadioTxStatus::IDLE, radio.poll_tx_done());
+
+  radio.set_async_completion(2, true);
+  TEST_ASSERT_TRUE(radio.send_async(payload, sizeof(payload)));
+  TEST_ASSERT_EQUAL_UINT32(1, radio.tx_count());
+  TEST_ASSERT_FALSE(radio.send_async(payload, sizeof(payload)));  // one frame in flight
+  TEST_ASSERT_EQUAL(RadioTxStatus::IN_FLIGHT, radio.poll_tx_done());
+  TEST_ASSERT_EQUAL(RadioTxStatus::IN_FLIGHT, radio.poll_tx_done());
+  TEST_ASSERT_EQUAL(RadioTxStatus::DONE, radio.poll_tx_done());
+  TEST_ASSERT_EQUAL(RadioTxStatus::IDLE, radio.poll_tx_done());
+
+  radio.set_async_completion(0, false);
+  TEST_ASSERT_TRUE(radio.send_async(payload, 2));
+  TEST_ASSERT_EQUAL_UINT32(2, radio.last_tx_len());
+  TEST_ASSERT_EQUAL(RadioTxStatus::FAILED, radio.poll_tx_done());
+  TEST_ASSERT_EQUAL(RadioTxStatus::IDLE, radio.poll_tx_done());
+}
+
 void test_mock_ble_transport_store() {
   MockBleTransport ble;
   uint8_t dev_info[4] = {0xAA, 0xBB, 0xCC, 0xDD};
@@ -42,7 +63,12 @@ void test_mock_ble_transport_store() {
 
 void test_mock_gnss_snapshot() {
   MockGnss gnss;
-  GnssSnapshot snap{GNSSFixState::FIX_3D, true, 123, 456, 1000};
+  GnssSnapshot snap{};
+  snap.fix_state = GNSSFixState::FIX_3D;
+  snap.pos_valid = true;
+  snap.lat_e7 = 123;
+  snap.lon_e7 = 456;
+  snap.last_fix_ms = 1000;
   gnss.set_snapshot(snap);
   GnssSnapshot out{};
   TEST_ASSERT_TRUE(gnss.get_snapshot(&out));
@@ -64,6 +90,7 @@ void test_mock_log() {
 int main(int argc, char** argv) {
   UNITY_BEGIN();
   RUN_TEST(test_mock_radio_send_and_recv);
+  RUN_TEST(test_mock_radio_async_send_completion);
   RUN_TEST(test_mock_ble_transport_store);
   RUN_TEST(test_mock_gnss_snapshot);
   RUN_TEST(test_mock_log);
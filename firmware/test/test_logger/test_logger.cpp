@@ -4,11 +4,16 @@
 
 #include "../../src/domain/logger.h"
 #include "../../src/domain/logger.cpp"
+#include "../../src/domain/log_frame.h"
+#include "../../src/domain/log_frame.cpp"
 
 using naviga::domain::LogEventId;
 using naviga::domain::LogLevel;
 using naviga::domain::LogRecordView;
 using naviga::domain::Logger;
+using naviga::domain::decode_log_frame;
+using naviga::domain::encode_log_frame;
+using naviga::domain::log_frame_encoded_len;
 
 struct EventCapture {
   LogEventId ids[8] = {};
@@ -78,10 +83,80 @@ void test_drain_order_and_clear() {
   TEST_ASSERT_EQUAL_UINT32(0, logger.size());
 }
 
+struct BudgetSink {
+  size_t budget = 0;
+  EventCapture capture{};
+};
+
+bool take_if_budget(void* ctx, const LogRecordView& record) {
+  auto* sink = static_cast<BudgetSink*>(ctx);
+  const size_t cost = 8 + record.len;
+  if (cost > sink->budget) {
+    return false;
+  }
+  sink->budget -= cost;
+  capture_event(&sink->capture, record);
+  return true;
+}
+
+void test_drain_while_consumes_only_accepted() {
+  uint8_t storage[128] = {};
+  Logger logger(storage, sizeof(storage));
+  const uint8_t payload[4] = {1, 2, 3, 4};
+  TEST_ASSERT_TRUE(logger.log(1, LogEventId::RADIO_TX_OK, LogLevel::kInfo, payload, 4));
+  TEST_ASSERT_TRUE(logger.log(2, LogEventId::RADIO_RX_OK, LogLevel::kInfo, payload, 4));
+  TEST_ASSERT_TRUE(logger.log(3, LogEventId::DECODE_OK, LogLevel::kInfo, payload, 4));
+
+  BudgetSink sink{};
+  sink.budget = 30;  // two 12-byte records fit, third does not
+  TEST_ASSERT_EQUAL_UINT32(2, logger.drain_while(take_if_budget, &sink));
+  TEST_ASSERT_EQUAL_UINT32(2, sink.capture.count);
+  TEST_ASSERT_EQUAL(LogEventId::RADIO_RX_OK, sink.capture.ids[1]);
+  TEST_ASSERT_EQUAL_UINT32(12, logger.size());
+
+  // Cursor advanced: next drain resumes at the kept record, new records append after it.
+  TEST_ASSERT_TRUE(logger.log(4, LogEventId::BLE_READ, LogLevel::kInfo));
+  BudgetSink rest{};
+  rest.budget = 100;
+  TEST_ASSERT_EQUAL_UINT32(2, logger.drain_while(take_if_budget, &rest));
+  TEST_ASSERT_EQUAL(LogEventId::DECODE_OK, rest.capture.ids[0]);
+  TEST_ASSERT_EQUAL(LogEventId::BLE_READ, rest.capture.ids[1]);
+  TEST_ASSERT_EQUAL_UINT32(0, logger.size());
+}
+
+void test_log_frame_roundtrip_and_size() {
+  const uint8_t payload[4] = {0x00, 0x12, 0x00, 0xFF};
+  LogRecordView record{123456, LogEventId::RADIO_RX_OK, LogLevel::kInfo, payload, 4};
+
+  uint8_t frame[naviga::domain::kMaxLogFrameSize] = {};
+  const size_t n = encode_log_frame(record, frame, sizeof(frame));
+  TEST_ASSERT_EQUAL_UINT32(log_frame_encoded_len(record), n);
+  TEST_ASSERT_EQUAL_UINT8(0x00, frame[n - 1]);
+  for (size_t i = 0; i + 1 < n; ++i) {
+    TEST_ASSERT_TRUE(frame[i] != 0x00);
+  }
+
+  LogRecordView out{};
+  uint8_t out_payload[255] = {};
+  TEST_ASSERT_TRUE(decode_log_frame(frame, n - 1, &out, out_payload));
+  TEST_ASSERT_EQUAL_UINT32(123456, out.t_ms);
+  TEST_ASSERT_EQUAL(LogEventId::RADIO_RX_OK, out.event_id);
+  TEST_ASSERT_EQUAL_UINT8(4, out.len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(payload, out.payload, 4);
+
+  // Text form: "LOG t_ms=123456 event=259 level=1 len=4 payload=001200FF\n" (57 bytes).
+  TEST_ASSERT_TRUE(n * 3 <= 57);
+
+  frame[3] ^= 0x01;
+  TEST_ASSERT_FALSE(decode_log_frame(frame, n - 1, &out, out_payload));
+}
+
 int main(int argc, char** argv) {
   UNITY_BEGIN();
   RUN_TEST(test_wraparound_drop_oldest);
   RUN_TEST(test_le_serialization);
   RUN_TEST(test_drain_order_and_clear);
+  RUN_TEST(test_drain_while_consumes_only_accepted);
+  RUN_TEST(test_log_frame_roundtrip_and_size);
   return UNITY_END();
 }
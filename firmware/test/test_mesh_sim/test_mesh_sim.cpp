@@ -0,0 +1,155 @@
+#include <unity.h>
+
+#include <cstdint>
+
+#include "../../src/domain/airtime_model.h"
+#include "../../src/domain/airtime_model.cpp"
+#include "../../src/domain/channel_load.cpp"
+#include "../../src/domain/airtime_budget.cpp"
+#include "../../src/domain/beacon_logic.cpp"
+#include "../../src/domain/beacon_send_policy.cpp"
+#include "../../src/domain/node_table.cpp"
+#include "../../src/domain/link_stats.cpp"
+#include "../../src/domain/noise_floor.cpp"
+#include "../../src/domain/relay_policy.cpp"
+#include "../../src/services/self_update_policy.cpp"
+#include "../../src/utils/geo_utils.cpp"
+#include "../../protocol/geo_beacon_codec.cpp"
+#include "../../protocol/bundle_codec.cpp"
+#include "../../protocol/fec_codec.cpp"
+#include "../../protocol/pos_delta_codec.cpp"
+#include "../../protocol/pos_full_codec.cpp"
+#include "../../protocol/short_addr_codec.cpp"
+#include "../../protocol/status_codec.cpp"
+#include "../../sim/sim_medium.cpp"
+#include "../../sim/sim_node.cpp"
+#include "../../sim/mesh_sim.cpp"
+
+using naviga::domain::e220_airtime_us;
+using naviga::sim::MeshSim;
+using naviga::sim::MeshSimConfig;
+using naviga::sim::RxOutcome;
+using naviga::sim::SimMedium;
+using naviga::sim::SimRadioParams;
+
+namespace {
+
+SimRadioParams no_fade_params() {
+  SimRadioParams p{};
+  p.shadow_sigma_db = 0.0f;
+  return p;
+}
+
+uint64_t outcome(const SimMedium& m, RxOutcome o) {
+  return m.stats().outcome[static_cast<size_t>(o)];
+}
+
+} // namespace
+
+void test_airtime_model_bench_slope_and_rate_scaling() {
+  // PosFull frame: 2 B header + 17 B payload, plus 8 B PHY overhead at ~4.51 ms/B (2.4 kbps).
+  TEST_ASSERT_EQUAL_UINT32(27u * 4511u, e220_airtime_us(2, 19));
+  TEST_ASSERT_EQUAL_UINT32((27u * 4511u + 1u) / 2u, e220_airtime_us(3, 19));
+  TEST_ASSERT_TRUE(e220_airtime_us(2, 21) > e220_airtime_us(2, 19));
+  TEST_ASSERT_EQUAL_UINT32(e220_airtime_us(2, 19), e220_airtime_us(0xFF, 19));
+}
+
+void test_medium_capture_collision_and_half_duplex() {
+  const uint8_t frame[19] = {0x11, 0x0C};
+  uint8_t out[naviga::protocol::kMaxFrameSize] = {};
+  size_t out_len = 0;
+
+  // Near sender (50 m) captures over a far one (2 km) at receiver 1.
+  SimMedium m;
+  m.init(no_fade_params(), 3, 1);
+  m.set_position(0, 0.0, 0.0);
+  m.set_position(1, 50.0, 0.0);
+  m.set_position(2, 2050.0, 0.0);
+  m.begin_tx(2, frame, sizeof(frame), 0);
+  m.begin_tx(0, frame, sizeof(frame), 1000);
+  while (m.next_end_us() != UINT64_MAX) {
+    m.complete_next();
+  }
+  TEST_ASSERT_TRUE(m.pop_rx(1, out, sizeof(out), &out_len, nullptr));
+  TEST_ASSERT_EQUAL_UINT32(sizeof(frame), out_len);
+  TEST_ASSERT_FALSE(m.pop_rx(1, out, sizeof(out), &out_len, nullptr));
+  TEST_ASSERT_EQUAL_UINT64(1, outcome(m, RxOutcome::kOk));
+  // Far frame lost at 1 (captured); 0 and 2 were each transmitting during the other's frame.
+  TEST_ASSERT_EQUAL_UINT64(1, outcome(m, RxOutcome::kCollision));
+  TEST_ASSERT_EQUAL_UINT64(2, outcome(m, RxOutcome::kHalfDuplex));
+
+  // Equal power at receiver 1: both frames lost.
+  SimMedium e;
+  e.init(no_fade_params(), 3, 1);
+  e.set_position(0, 0.0, 0.0);
+  e.set_position(1, 500.0, 0.0);
+  e.set_position(2, 1000.0, 0.0);
+  e.begin_tx(0, frame, sizeof(frame), 0);
+  e.begin_tx(2, frame, sizeof(frame), 5000);
+  while (e.next_end_us() != UINT64_MAX) {
+    e.complete_next();
+  }
+  TEST_ASSERT_FALSE(e.pop_rx(1, out, sizeof(out), &out_len, nullptr));
+  TEST_ASSERT_EQUAL_UINT64(0, outcome(e, RxOutcome::kOk));
+  TEST_ASSERT_EQUAL_UINT64(2, outcome(e, RxOutcome::kCollision));
+  TEST_ASSERT_TRUE(e.stats().busy_us < e.stats().airtime_us_total);
+}
+
+void test_two_node_sim_delivers_positions() {
+  MeshSimConfig cfg{};
+  cfg.node_count = 2;
+  cfg.duration_s = 1800.0;
+  cfg.seed = 7;
+  MeshSim sim;
+  sim.init(cfg);
+  sim.pin_node(0, 0.0, 0.0);
+  sim.pin_node(1, 300.0, 0.0);
+  sim.run();
+
+  const naviga::sim::MeshSimReport& r = sim.report();
+  TEST_ASSERT_TRUE(r.tx_pos_full > 0);
+  TEST_ASSERT_TRUE(r.pdr >= 0.95);
+  TEST_ASSERT_EQUAL_UINT64(0, r.stale_never);
+  // Stationary nodes still send PosFull at max silence (110 s for Person); allow one loss.
+  TEST_ASSERT_TRUE(r.stale_max_s <= 2 * 110.0 + 1.0);
+  TEST_ASSERT_EQUAL_UINT32(2, sim.node(0).node_table().size());
+  TEST_ASSERT_EQUAL_UINT32(2, sim.node(1).node_table().size());
+}
+
+void test_predictive_dogs_send_fewer_positions_with_bounded_error() {
+  // Dogs on straight random-waypoint legs, no pauses: the case dead reckoning is for.
+  MeshSimConfig cfg{};
+  cfg.node_count = 6;
+  cfg.duration_s = 1800.0;
+  cfg.area_m = 1500.0;
+  cfg.max_pause_ms = 0;
+  cfg.roles = naviga::sim::SimRoleMix::kDog;
+  cfg.radio = no_fade_params();
+  cfg.seed = 11;
+  cfg.predictive = true;
+  MeshSimConfig plain_cfg = cfg;
+  plain_cfg.predictive = false;
+
+  MeshSim predictive;
+  predictive.init(cfg);
+  predictive.run();
+  MeshSim plain;
+  plain.init(plain_cfg);
+  plain.run();
+
+  const naviga::sim::MeshSimReport& p = predictive.report();
+  const naviga::sim::MeshSimReport& q = plain.report();
+  TEST_ASSERT_TRUE(p.pos_err_samples > 0);
+  TEST_ASSERT_TRUE(2 * (p.tx_pos_full + p.tx_pos_delta) < q.tx_pos_full + q.tx_pos_delta);
+  TEST_ASSERT_TRUE(p.pos_err_mean_m < q.pos_err_mean_m);
+  TEST_ASSERT_TRUE(p.pos_err_p95_m <= q.pos_err_p95_m);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_airtime_model_bench_slope_and_rate_scaling);
+  RUN_TEST(test_medium_capture_collision_and_half_duplex);
+  RUN_TEST(test_two_node_sim_delivers_positions);
+  RUN_TEST(test_predictive_dogs_send_fewer_positions_with_bounded_error);
+  return UNITY_END();
+}
@@ -0,0 +1,155 @@
+#include <unity.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "../../src/domain/mp_logger.h"
+#include "../../src/domain/mp_logger.cpp"
+
+using naviga::domain::LogEventId;
+using naviga::domain::LogLevel;
+using naviga::domain::LogRecordView;
+using naviga::domain::MpLogger;
+
+namespace {
+
+constexpr int kProducers = 4;
+constexpr uint32_t kRecordsPerProducer = 20000;
+
+struct CheckState {
+  uint32_t received = 0;
+  uint32_t torn = 0;
+  uint32_t out_of_order = 0;
+  uint32_t last_counter[kProducers] = {};
+  bool seen[kProducers] = {};
+};
+
+/** Payload = producer id, counter LE (4 bytes), then bytes derived from both; torn if any mismatch. */
+void fill_payload(uint8_t producer, uint32_t counter, uint8_t* out) {
+  out[0] = producer;
+  out[1] = static_cast<uint8_t>(counter & 0xFF);
+  out[2] = static_cast<uint8_t>((counter >> 8) & 0xFF);
+  out[3] = static_cast<uint8_t>((counter >> 16) & 0xFF);
+  out[4] = static_cast<uint8_t>((counter >> 24) & 0xFF);
+  for (uint8_t i = 5; i < MpLogger::kMaxPayload; ++i) {
+    out[i] = static_cast<uint8_t>(producer * 31 + counter + i);
+  }
+}
+
+void check_record(void* ctx, const LogRecordView& record) {
+  auto* state = static_cast<CheckState*>(ctx);
+  ++state->received;
+  if (!record.payload || record.len != MpLogger::kMaxPayload) {
+    ++state->torn;
+    return;
+  }
+  const uint8_t producer = record.payload[0];
+  const uint32_t counter = static_cast<uint32_t>(record.payload[1]) |
+                           static_cast<uint32_t>(record.payload[2]) << 8 |
+                           static_cast<uint32_t>(record.payload[3]) << 16 |
+                           static_cast<uint32_t>(record.payload[4]) << 24;
+  uint8_t expected[MpLogger::kMaxPayload] = {};
+  fill_payload(producer, counter, expected);
+  if (producer >= kProducers || std::memcmp(expected, record.payload, sizeof(expected)) != 0 ||
+      record.t_ms != counter || static_cast<uint16_t>(record.event_id) != 0x0100 + producer) {
+    ++state->torn;
+    return;
+  }
+  if (state->seen[producer] && counter <= state->last_counter[producer]) {
+    ++state->out_of_order;
+  }
+  state->seen[producer] = true;
+  state->last_counter[producer] = counter;
+}
+
+} // namespace
+
+void test_single_thread_fifo_and_drop_on_full() {
+  MpLogger logger;
+  for (uint32_t i = 0; i < MpLogger::kSlotCount; ++i) {
+    TEST_ASSERT_TRUE(logger.log(i, LogEventId::RADIO_RX_OK, LogLevel::kInfo));
+  }
+  TEST_ASSERT_FALSE(logger.log(999, LogEventId::RADIO_RX_OK, LogLevel::kInfo));
+  TEST_ASSERT_EQUAL_UINT32(1, logger.dropped_full());
+  TEST_ASSERT_EQUAL_UINT32(MpLogger::kSlotCount, logger.size());
+
+  uint8_t big[MpLogger::kMaxPayload + 1] = {};
+  TEST_ASSERT_FALSE(logger.log(1, LogEventId::RADIO_RX_OK, LogLevel::kInfo, big, sizeof(big)));
+  TEST_ASSERT_EQUAL_UINT32(1, logger.dropped_oversize());
+
+  uint32_t expected_t = 0;
+  logger.drain([](void* ctx, const LogRecordView& r) {
+    auto* t = static_cast<uint32_t*>(ctx);
+    TEST_ASSERT_EQUAL_UINT32(*t, r.t_ms);
+    ++*t;
+  }, &expected_t);
+  TEST_ASSERT_EQUAL_UINT32(MpLogger::kSlotCount, expected_t);
+  TEST_ASSERT_EQUAL_UINT32(0, logger.size());
+  TEST_ASSERT_TRUE(logger.log(1000, LogEventId::BLE_READ, LogLevel::kDebug));
+  TEST_ASSERT_EQUAL_UINT32(1, logger.size());
+}
+
+void test_drain_while_stops_and_resumes() {
+  MpLogger logger;
+  for (uint32_t i = 0; i < 5; ++i) {
+    TEST_ASSERT_TRUE(logger.log(i, LogEventId::DECODE_OK, LogLevel::kInfo));
+  }
+  uint32_t budget = 3;
+  const size_t taken = logger.drain_while([](void* ctx, const LogRecordView&) {
+    auto* b = static_cast<uint32_t*>(ctx);
+    if (*b == 0) return false;
+    --*b;
+    return true;
+  }, &budget);
+  TEST_ASSERT_EQUAL_UINT32(3, taken);
+  TEST_ASSERT_EQUAL_UINT32(2, logger.size());
+}
+
+void test_multi_producer_stress_no_torn_records() {
+  MpLogger logger;
+  std::atomic<bool> done{false};
+  std::atomic<uint32_t> accepted{0};
+  CheckState state{};
+
+  std::thread consumer([&]() {
+    while (!done.load()) {
+      logger.drain(check_record, &state);
+    }
+    logger.drain(check_record, &state);
+  });
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&, p]() {
+      uint8_t payload[MpLogger::kMaxPayload] = {};
+      for (uint32_t i = 0; i < kRecordsPerProducer; ++i) {
+        fill_payload(static_cast<uint8_t>(p), i, payload);
+        if (logger.log(i, static_cast<LogEventId>(0x0100 + p), LogLevel::kDebug, payload,
+                       sizeof(payload))) {
+          accepted.fetch_add(1);
+        }
+      }
+    });
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  done.store(true);
+  consumer.join();
+
+  TEST_ASSERT_EQUAL_UINT32(0, state.torn);
+  TEST_ASSERT_EQUAL_UINT32(0, state.out_of_order);
+  TEST_ASSERT_EQUAL_UINT32(accepted.load(), state.received);
+  TEST_ASSERT_EQUAL_UINT32(kProducers * kRecordsPerProducer, accepted.load() + logger.dropped_full());
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_single_thread_fifo_and_drop_on_full);
+  RUN_TEST(test_drain_while_stops_and_resumes);
+  RUN_TEST(test_multi_producer_stress_no_torn_records);
+  return UNITY_END();
+}
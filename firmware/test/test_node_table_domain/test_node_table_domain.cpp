@@ -6,6 +6,7 @@
 
 #include "../../src/domain/node_table.h"
 #include "../../src/domain/node_table.cpp"
+#include "../../src/domain/link_stats.cpp"
 #include "../../src/domain/nodetable_snapshot.h"
 #include "../../src/domain/nodetable_snapshot.cpp"
 
@@ -513,6 +514,76 @@ void test_set_self_node_name_max_length_safe() {
   TEST_ASSERT_EQUAL('\0', e.node_name[24]);
 }
 
+/* Link stats: seq16 gaps count as lost; PDR = rx / (rx + lost). */
+void test_link_stats_pdr_from_seq_gaps() {
+  NodeTable table;
+  table.init_self(0x1111111111111111ULL, 0);
+  const uint64_t remote_id = 0x5555555555555555ULL;
+  TEST_ASSERT_TRUE(table.upsert_remote(remote_id, true, 1, 2, 0, -40, 10, 1000));
+  TEST_ASSERT_TRUE(table.upsert_remote(remote_id, true, 1, 2, 0, -40, 11, 2000));
+  /* 12, 13 missing. */
+  TEST_ASSERT_TRUE(table.upsert_remote(remote_id, true, 1, 2, 0, -40, 14, 3000));
+  NodeEntry entry{};
+  TEST_ASSERT_TRUE(table.find_entry_for_test(remote_id, &entry));
+  TEST_ASSERT_EQUAL_UINT16(3, entry.link.rx_count);
+  TEST_ASSERT_EQUAL_UINT16(2, entry.link.lost_count);
+  TEST_ASSERT_EQUAL_UINT8(60, naviga::domain::link_stats_pdr_pct(entry.link));
+}
+
+/* Link stats: duplicate and older seq16 count as dup, not as rx or lost. */
+void test_link_stats_duplicates_and_reorder() {
+  NodeTable table;
+  table.init_self(0x1111111111111111ULL, 0);
+  const uint64_t remote_id = 0x6666666666666666ULL;
+  TEST_ASSERT_TRUE(table.upsert_remote(remote_id, true, 1, 2, 0, -40, 100, 1000));
+  TEST_ASSERT_TRUE(table.upsert_remote(remote_id, true, 1, 2, 0, -40, 100, 1100));
+  TEST_ASSERT_TRUE(table.upsert_remote(remote_id, true, 1, 2, 0, -40, 99, 1200));
+  NodeEntry entry{};
+  TEST_ASSERT_TRUE(table.find_entry_for_test(remote_id, &entry));
+  TEST_ASSERT_EQUAL_UINT16(1, entry.link.rx_count);
+  TEST_ASSERT_EQUAL_UINT16(0, entry.link.lost_count);
+  TEST_ASSERT_EQUAL_UINT16(2, entry.link.dup_count);
+  TEST_ASSERT_EQUAL_UINT8(100, naviga::domain::link_stats_pdr_pct(entry.link));
+}
+
+/* Link stats: RSSI EWMA moves toward new samples; inter-arrival mean/jitter track spacing. */
+void test_link_stats_rssi_ewma_and_inter_arrival() {
+  naviga::domain::PeerLinkStats stats{};
+  naviga::domain::link_stats_on_rx(stats, true, 0, 0, -80, 0);
+  TEST_ASSERT_EQUAL_INT8(-80, naviga::domain::link_stats_rssi_dbm(stats));
+  uint32_t now_ms = 0;
+  uint16_t seq = 0;
+  for (uint16_t i = 0; i < 50; ++i) {
+    now_ms += 1000;
+    naviga::domain::link_stats_on_rx(stats, false, static_cast<uint16_t>(seq + 1), seq, -60, now_ms);
+    ++seq;
+  }
+  TEST_ASSERT_INT_WITHIN(1, -60, naviga::domain::link_stats_rssi_dbm(stats));
+  TEST_ASSERT_EQUAL_UINT16(100, stats.ia_mean_10ms);
+  TEST_ASSERT_EQUAL_UINT16(0, stats.ia_jitter_10ms);
+
+  /* Alternating 0.5 s / 1.5 s spacing keeps the mean near 1 s and raises jitter. */
+  for (uint16_t i = 0; i < 100; ++i) {
+    now_ms += (i % 2 == 0) ? 500 : 1500;
+    naviga::domain::link_stats_on_rx(stats, false, static_cast<uint16_t>(seq + 1), seq, -60, now_ms);
+    ++seq;
+  }
+  TEST_ASSERT_UINT32_WITHIN(10, 100, stats.ia_mean_10ms);
+  TEST_ASSERT_TRUE(stats.ia_jitter_10ms >= 30);
+}
+
+/* Link stats: window halves rx/lost together so PDR keeps the recent ratio. */
+void test_link_stats_window_decay() {
+  naviga::domain::PeerLinkStats stats{};
+  naviga::domain::link_stats_on_rx(stats, true, 0, 0, -70, 0);
+  for (uint32_t i = 1; i <= 1000; ++i) {
+    const uint16_t seq = static_cast<uint16_t>(2 * i);  // every other frame lost
+    naviga::domain::link_stats_on_rx(stats, false, seq, static_cast<uint16_t>(seq - 2), -70, i * 1000);
+  }
+  TEST_ASSERT_TRUE(static_cast<uint32_t>(stats.rx_count) + stats.lost_count < naviga::domain::kLinkStatsWindow);
+  TEST_ASSERT_UINT32_WITHIN(2, 50, naviga::domain::link_stats_pdr_pct(stats));
+}
+
 int main(int argc, char** argv) {
   UNITY_BEGIN();
   RUN_TEST(test_self_init_and_serialization);
@@ -538,5 +609,9 @@ int main(int argc, char** argv) {
   RUN_TEST(test_set_self_node_name);
   RUN_TEST(test_set_self_node_name_no_self);
   RUN_TEST(test_set_self_node_name_max_length_safe);
+  RUN_TEST(test_link_stats_pdr_from_seq_gaps);
+  RUN_TEST(test_link_stats_duplicates_and_reorder);
+  RUN_TEST(test_link_stats_rssi_ewma_and_inter_arrival);
+  RUN_TEST(test_link_stats_window_decay);
   return UNITY_END();
 }
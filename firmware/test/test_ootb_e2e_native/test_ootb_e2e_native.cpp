@@ -8,8 +8,13 @@
 #include "../../protocol/alive_codec.h"
 #include "../../src/domain/beacon_logic.h"
 #include "../../src/domain/beacon_logic.cpp"
+#include "../../src/domain/airtime_budget.cpp"
+#include "../../src/domain/airtime_model.cpp"
+#include "../../src/domain/channel_load.cpp"
 #include "../../src/domain/node_table.h"
 #include "../../src/domain/node_table.cpp"
+#include "../../src/domain/link_stats.cpp"
+#include "../../src/domain/relay_policy.cpp"
 #include "../../lib/NavigaCore/include/naviga/hal/mocks/mock_ble_transport.h"
 #include "../../lib/NavigaCore/src/mocks/mock_ble_transport.cpp"
 
@@ -74,8 +79,8 @@ void test_e2e_beacon_to_ble_bridge() {
   // NodeID48: upper 16 bits = 0x0000 so round-trip through codec is lossless.
   fields.node_id = 0x0000030405060708ULL;
   fields.pos_valid = 1;
-  fields.lat_deg = 55.7558;   // Moscow — canonical example from beacon_payload_encoding_v0 §5.1
-  fields.lon_deg = 37.6173;
+  fields.lat_e7 = 557558000;  // Moscow — canonical example from beacon_payload_encoding_v0 §5.1
+  fields.lon_e7 = 376173000;
 
   uint8_t payload[naviga::protocol::kPosFullFrameSize] = {};
   size_t payload_len = 0;
@@ -1,3 +1,7 @@
+#include "../../protocol/bundle_codec.cpp"
+#include "../../protocol/fec_codec.cpp"
+#include "../../protocol/pos_delta_codec.cpp"
 #include "../../protocol/geo_beacon_codec.cpp"
 #include "../../protocol/pos_full_codec.cpp"
+#include "../../protocol/short_addr_codec.cpp"
 #include "../../protocol/status_codec.cpp"
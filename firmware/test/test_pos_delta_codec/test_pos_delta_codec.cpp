@@ -0,0 +1,117 @@
+/**
+ * Node_Pos_Delta (0x09) codec: layout with ref_seq8, pos_delta_resolve around the 12-bit wrap,
+ * and the Pos_Velocity trailer it shares with Node_Pos_Full. Codec-only; run bounds and the
+ * receiver's run check stay in test_beacon_logic.
+ */
+#include <unity.h>
+
+#include <cstdint>
+
+#include "../../protocol/pos_delta_codec.h"
+#include "../../protocol/pos_delta_codec.cpp"
+#include "../../protocol/pos_full_codec.h"
+#include "../../protocol/pos_full_codec.cpp"
+#include "../../protocol/pos_predict.h"
+
+void test_pos_delta_codec_round_trip_and_resolve() {
+  namespace p = naviga::protocol;
+  p::PosDeltaFields d{};
+  d.node_id = 0x0000AABBCCDDEE11ULL;
+  d.seq16 = 0x0103;
+  d.ref_seq8 = 0xFE;
+  d.lat_lsb = 0x0ABC;
+  d.lon_lsb = 0x0FFF;
+  uint8_t frame[p::kPosDeltaFrameSize] = {};
+  TEST_ASSERT_EQUAL(15u, p::encode_pos_delta_frame(d, frame, sizeof(frame)));
+  p::PacketHeader hdr{};
+  TEST_ASSERT_TRUE(p::decode_header(frame, sizeof(frame), &hdr));
+  TEST_ASSERT_EQUAL(static_cast<int>(p::MsgType::BeaconPosDelta), static_cast<int>(hdr.msg_type));
+  TEST_ASSERT_EQUAL_UINT8(13, hdr.payload_len);
+  TEST_ASSERT_EQUAL_UINT8(0xFE, frame[2 + 9]);  // ref_seq8 right after seq16
+
+  p::PosDeltaFields out{};
+  TEST_ASSERT_EQUAL(static_cast<int>(p::PosDeltaDecodeError::Ok),
+                    static_cast<int>(p::decode_pos_delta_payload(frame + 2, 13, &out)));
+  TEST_ASSERT_EQUAL_UINT64(d.node_id, out.node_id);
+  TEST_ASSERT_EQUAL_UINT16(0x0103, out.seq16);
+  TEST_ASSERT_EQUAL_UINT8(0xFE, out.ref_seq8);
+  TEST_ASSERT_EQUAL_UINT16(0x0ABC, out.lat_lsb);
+  TEST_ASSERT_EQUAL_UINT16(0x0FFF, out.lon_lsb);
+
+  // Nearest u24 with the given low bits, across the 12-bit wrap in both directions.
+  uint32_t v = 0;
+  TEST_ASSERT_TRUE(p::pos_delta_resolve(0x123FF0, 0x010, &v));
+  TEST_ASSERT_EQUAL_HEX32(0x124010, v);
+  TEST_ASSERT_TRUE(p::pos_delta_resolve(0x124010, 0xFF0, &v));
+  TEST_ASSERT_EQUAL_HEX32(0x123FF0, v);
+  TEST_ASSERT_TRUE(p::pos_delta_resolve(0x124010, 0x810, &v));  // -2048
+  TEST_ASSERT_EQUAL_HEX32(0x123810, v);
+  TEST_ASSERT_FALSE(p::pos_delta_resolve(0x000010, 0xF00, &v));  // below 0
+}
+
+void test_pos_velocity_trailer_and_predictor() {
+  namespace p = naviga::protocol;
+  // Integer prediction on the u24 grid: rounded, capped at kPosPredictMaxMs, clamped.
+  TEST_ASSERT_EQUAL_UINT32(1100, p::pos_predict_u24(1000, 160, 10000));
+  TEST_ASSERT_EQUAL_UINT32(999, p::pos_predict_u24(1000, -8, 1000));  // -0.5 rounds away
+  TEST_ASSERT_EQUAL_UINT32(1120, p::pos_predict_u24(1000, 16, 200000));
+  TEST_ASSERT_EQUAL_UINT32(0, p::pos_predict_u24(5, -p::kPosVelocityMax, 120000));
+  TEST_ASSERT_EQUAL_UINT32(p::kGeoU24Max, p::pos_predict_u24(p::kGeoU24Max - 5, 100, 10000));
+
+  // 12 m north, 2000 e7 west in 4 s: 3 m/s = 40 steps of 0.075 m/s.
+  p::PosVelocity v = p::pos_velocity_from_e7(550000000, 370000000, 550001078, 369998000, 4000);
+  TEST_ASSERT_EQUAL_INT16(40, v.lat);
+  TEST_ASSERT_EQUAL_INT16(-37, v.lon);
+  v = p::pos_velocity_from_e7(0, 0, 10000000, 0, 1000);
+  TEST_ASSERT_EQUAL_INT16(p::kPosVelocityMax, v.lat);
+
+  // Pos_Full: 20-byte payload with the trailer; a 17-byte one reads as no velocity.
+  p::PosFullFields pos{};
+  pos.node_id = 0x0000AABBCCDDEE11ULL;
+  pos.seq16 = 9;
+  pos.lat_e7 = 550000000;
+  pos.lon_e7 = 370000000;
+  pos.has_velocity = true;
+  pos.vel_lat = -p::kPosVelocityMax;
+  pos.vel_lon = 1234;
+  uint8_t frame[p::kPosFullMaxFrameSize] = {};
+  TEST_ASSERT_EQUAL(22u, p::encode_pos_full_frame(pos, frame, sizeof(frame)));
+  p::PacketHeader hdr{};
+  TEST_ASSERT_TRUE(p::decode_header(frame, 22, &hdr));
+  TEST_ASSERT_EQUAL_UINT8(20, hdr.payload_len);
+  const p::PosFullView view(frame + 2, 20);
+  TEST_ASSERT_TRUE(view.ok());
+  TEST_ASSERT_TRUE(view.has_velocity());
+  TEST_ASSERT_EQUAL_INT16(-p::kPosVelocityMax, view.velocity().lat);
+  TEST_ASSERT_EQUAL_INT16(1234, view.velocity().lon);
+  p::PosFullFields out{};
+  TEST_ASSERT_EQUAL(static_cast<int>(p::PosFullDecodeError::Ok),
+                    static_cast<int>(p::decode_pos_full_payload(frame + 2, 20, &out)));
+  TEST_ASSERT_TRUE(out.has_velocity);
+  TEST_ASSERT_EQUAL_INT16(1234, out.vel_lon);
+  const p::PosFullView plain(frame + 2, p::kPosFullPayloadSize);
+  TEST_ASSERT_TRUE(plain.ok());
+  TEST_ASSERT_FALSE(plain.has_velocity());
+  TEST_ASSERT_EQUAL_INT16(0, plain.velocity().lat);
+
+  p::PosDeltaFields d{};
+  d.node_id = pos.node_id;
+  d.seq16 = 10;
+  d.has_velocity = true;
+  d.vel_lat = 5;
+  d.vel_lon = -6;
+  TEST_ASSERT_EQUAL(18u, p::encode_pos_delta_frame(d, frame, sizeof(frame)));
+  p::PosDeltaFields dout{};
+  TEST_ASSERT_EQUAL(static_cast<int>(p::PosDeltaDecodeError::Ok),
+                    static_cast<int>(p::decode_pos_delta_payload(frame + 2, 16, &dout)));
+  TEST_ASSERT_TRUE(dout.has_velocity);
+  TEST_ASSERT_EQUAL_INT16(5, dout.vel_lat);
+  TEST_ASSERT_EQUAL_INT16(-6, dout.vel_lon);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_pos_delta_codec_round_trip_and_resolve);
+  RUN_TEST(test_pos_velocity_trailer_and_predictor);
+  return UNITY_END();
+}
@@ -0,0 +1,217 @@
+#include <unity.h>
+
+#include <cstdint>
+
+#include "../../src/domain/preset_selector.h"
+#include "../../src/domain/preset_selector.cpp"
+#include "../../src/domain/airtime_model.cpp"
+#include "../../protocol/pos_full_codec.h"
+#include "../../protocol/status_codec.cpp"
+
+using naviga::RadioPresetId;
+using naviga::domain::PresetPeerSummary;
+using naviga::domain::PresetPeerView;
+using naviga::domain::PresetSelector;
+namespace p = naviga::protocol;
+
+namespace {
+
+constexpr uint32_t kBeaconIntervalMs = 18000;
+constexpr uint8_t kFastCapable = 0x07;
+
+PresetPeerView peer(int8_t rssi_dbm, uint8_t pdr_pct, uint8_t caps, uint32_t last_rx_ms) {
+  PresetPeerView v;
+  v.rssi_dbm = rssi_dbm;
+  v.pdr_pct = pdr_pct;
+  v.radio_caps = caps;
+  v.last_rx_ms = last_rx_ms;
+  return v;
+}
+
+uint8_t caps(bool wants_fast, RadioPresetId active = RadioPresetId::Default) {
+  return p::radio_caps_make(kFastCapable, static_cast<uint8_t>(active), wants_fast);
+}
+
+/** Two close peers heard at now_ms with the given votes. */
+PresetPeerSummary close_pair(const PresetSelector& sel, uint32_t now_ms, bool votes) {
+  PresetPeerSummary s{};
+  sel.add_peer(now_ms, peer(-70, 100, caps(votes), now_ms), &s);
+  sel.add_peer(now_ms, peer(-85, 95, caps(votes), now_ms), &s);
+  return s;
+}
+
+/** Drive sel from start_ms in 10 s steps until it asks for Fast; returns that time (0 = never). */
+uint32_t run_until_fast(PresetSelector& sel, uint32_t start_ms, uint32_t limit_ms) {
+  for (uint32_t t = start_ms; t <= start_ms + limit_ms; t += 10000) {
+    const bool peers_vote = t >= start_ms + PresetSelector::kUpHoldMs;
+    if (sel.update(t, close_pair(sel, t, peers_vote)) == RadioPresetId::Fast) {
+      return t;
+    }
+  }
+  return 0;
+}
+
+} // namespace
+
+void test_radio_caps_roundtrip_in_status() {
+  TEST_ASSERT_EQUAL_UINT8(0, PresetSelector{}.radio_caps());
+  const uint8_t c = caps(true, RadioPresetId::Fast);
+  TEST_ASSERT_TRUE(p::radio_caps_supports(c, 1));
+  TEST_ASSERT_EQUAL_UINT8(1, p::radio_caps_active(c));
+  TEST_ASSERT_TRUE(p::radio_caps_wants_fast(c));
+  TEST_ASSERT_FALSE(p::radio_caps_supports(p::radio_caps_make(0, 0, false), 1));
+  TEST_ASSERT_EQUAL_UINT8(0x01, p::radio_caps_make(0, 0, false));  // present byte never 0
+
+  p::StatusFields st{};
+  st.node_id = 0x112233445566ull;
+  st.seq16 = 7;
+  uint8_t frame[p::kStatusMaxFrameSize] = {};
+  TEST_ASSERT_EQUAL(p::kStatusFrameSize, p::encode_status_frame(st, frame, sizeof(frame)));
+  st.radio_caps = c;
+  TEST_ASSERT_EQUAL(0u, p::encode_status_frame(st, frame, p::kStatusFrameSize));
+  TEST_ASSERT_EQUAL(p::kStatusMaxFrameSize, p::encode_status_frame(st, frame, sizeof(frame)));
+
+  p::StatusFields out{};
+  TEST_ASSERT_EQUAL(p::StatusDecodeError::Ok,
+                    p::decode_status_payload(frame + p::kHeaderSize, p::kStatusPayloadSize + 1, &out));
+  TEST_ASSERT_EQUAL_UINT8(c, out.radio_caps);
+  // 19-byte payload (older sender): caps not advertised.
+  TEST_ASSERT_EQUAL(p::StatusDecodeError::Ok,
+                    p::decode_status_payload(frame + p::kHeaderSize, p::kStatusPayloadSize, &out));
+  TEST_ASSERT_EQUAL_UINT8(0, out.radio_caps);
+}
+
+void test_reconfig_cost_and_payback() {
+  // 200 ms settle + 50 B at 9600 8N1 (53 ms) + 40 ms apply + 40 ms back to normal.
+  TEST_ASSERT_EQUAL_UINT32(333, naviga::domain::e220_reconfig_blind_ms());
+  TEST_ASSERT_TRUE(PresetSelector::switch_pays_off(2, 3, p::kPosFullFrameSize, kBeaconIntervalMs));
+  // A beacon every 6 min saves ~0.3 s of airtime per dwell: not worth 2.7 s of blind time.
+  TEST_ASSERT_FALSE(PresetSelector::switch_pays_off(2, 3, p::kPosFullFrameSize, 360000));
+  TEST_ASSERT_FALSE(PresetSelector::switch_pays_off(3, 2, p::kPosFullFrameSize, kBeaconIntervalMs));
+  TEST_ASSERT_FALSE(PresetSelector::switch_pays_off(2, 3, p::kPosFullFrameSize, 0));
+}
+
+void test_votes_after_hold_and_switches_on_agreement() {
+  PresetSelector sel;
+  PresetPeerSummary none{};
+  TEST_ASSERT_EQUAL(RadioPresetId::Default, sel.update(1000, close_pair(sel, 1000, true)));  // disabled
+  sel.configure(kFastCapable, p::kPosFullFrameSize, kBeaconIntervalMs);
+  TEST_ASSERT_EQUAL(RadioPresetId::Default, sel.update(1000, none));  // no peers: stay
+
+  const uint32_t t0 = 10000;
+  PresetPeerSummary s = close_pair(sel, t0, false);
+  TEST_ASSERT_EQUAL_UINT16(2, s.peers);
+  TEST_ASSERT_EQUAL_UINT16(2, s.links_up);
+  TEST_ASSERT_EQUAL(RadioPresetId::Default, sel.update(t0, s));
+  TEST_ASSERT_FALSE(p::radio_caps_wants_fast(sel.radio_caps()));
+  sel.update(t0 + PresetSelector::kUpHoldMs, close_pair(sel, t0 + PresetSelector::kUpHoldMs, false));
+  TEST_ASSERT_TRUE(p::radio_caps_wants_fast(sel.radio_caps()));  // voting, peers not yet
+
+  const uint32_t t_fast = run_until_fast(sel, t0 + PresetSelector::kUpHoldMs, 600000);
+  TEST_ASSERT_EQUAL_UINT32(t0 + 2 * PresetSelector::kUpHoldMs + PresetSelector::kAgreeHoldMs, t_fast);
+  TEST_ASSERT_EQUAL(RadioPresetId::Default, sel.active());  // until the radio confirms
+  sel.on_applied(t_fast, true);
+  TEST_ASSERT_EQUAL(RadioPresetId::Fast, sel.active());
+  TEST_ASSERT_EQUAL_UINT8(1, p::radio_caps_active(sel.radio_caps()));
+}
+
+void test_unknown_caps_or_weak_link_blocks_vote() {
+  PresetSelector sel;
+  sel.configure(kFastCapable, p::kPosFullFrameSize, kBeaconIntervalMs);
+  for (uint32_t t = 0; t <= 600000; t += 10000) {
+    PresetPeerSummary s{};
+    sel.add_peer(t, peer(-70, 100, caps(true), t), &s);
+    sel.add_peer(t, peer(-70, 100, 0, t), &s);  // older firmware: no radioCaps
+    TEST_ASSERT_EQUAL(RadioPresetId::Default, sel.update(t, s));
+  }
+  TEST_ASSERT_FALSE(p::radio_caps_wants_fast(sel.radio_caps()));
+
+  sel.configure(kFastCapable, p::kPosFullFrameSize, kBeaconIntervalMs);
+  for (uint32_t t = 0; t <= 600000; t += 10000) {
+    PresetPeerSummary s{};
+    sel.add_peer(t, peer(-70, 100, caps(true), t), &s);
+    sel.add_peer(t, peer(-104, 100, caps(true), t), &s);  // between down and up thresholds
+    TEST_ASSERT_EQUAL_UINT16(0, s.links_down);
+    TEST_ASSERT_EQUAL(RadioPresetId::Default, sel.update(t, s));
+  }
+
+  // A radio that only has Default never votes; stale peers are not counted.
+  sel.configure(0x01, p::kPosFullFrameSize, kBeaconIntervalMs);
+  TEST_ASSERT_EQUAL_UINT32(0, run_until_fast(sel, 0, 600000));
+  PresetPeerSummary s{};
+  sel.add_peer(PresetSelector::kPeerWindowMs + 1, peer(-70, 100, caps(true), 0), &s);
+  TEST_ASSERT_EQUAL_UINT16(0, s.peers);
+}
+
+void test_fallback_on_weak_link_backs_off_and_doubles() {
+  PresetSelector sel;
+  sel.configure(kFastCapable, p::kPosFullFrameSize, kBeaconIntervalMs);
+  uint32_t t = run_until_fast(sel, 0, 600000);
+  sel.on_applied(t, true);
+
+  // On Fast: hysteresis keeps it there at -104 dBm / 80 %.
+  t += 10000;
+  PresetPeerSummary s{};
+  sel.add_peer(t, peer(-104, 80, caps(false, RadioPresetId::Fast), t), &s);
+  sel.add_peer(t, peer(-80, 100, caps(false, RadioPresetId::Fast), t), &s);
+  TEST_ASSERT_EQUAL_UINT16(2, s.heard_on_fast);
+  TEST_ASSERT_EQUAL(RadioPresetId::Fast, sel.update(t, s));
+
+  t += 10000;
+  s = PresetPeerSummary{};
+  sel.add_peer(t, peer(-110, 80, caps(false, RadioPresetId::Fast), t), &s);
+  sel.add_peer(t, peer(-80, 100, caps(false, RadioPresetId::Fast), t), &s);
+  TEST_ASSERT_EQUAL(RadioPresetId::Default, sel.update(t, s));
+  sel.on_applied(t, true);
+  TEST_ASSERT_EQUAL(RadioPresetId::Default, sel.active());
+
+  // Backoff: no vote for kBackoffMinMs even with perfect links.
+  const uint32_t fell_back = t;
+  TEST_ASSERT_EQUAL_UINT32(0, run_until_fast(sel, t + 10000, PresetSelector::kBackoffMinMs - 20000));
+  t = run_until_fast(sel, fell_back + PresetSelector::kBackoffMinMs, 600000);
+  TEST_ASSERT_TRUE(t != 0);
+  sel.on_applied(t, true);
+
+  // Second failure: a peer does not show up on Fast within kConfirmMs → backoff doubles.
+  t += PresetSelector::kConfirmMs;
+  s = PresetPeerSummary{};
+  sel.add_peer(t, peer(-70, 100, caps(false, RadioPresetId::Fast), t), &s);
+  sel.add_peer(t, peer(-70, 100, caps(true), t - PresetSelector::kConfirmMs - 5000), &s);
+  TEST_ASSERT_EQUAL_UINT16(1, s.heard_on_fast);
+  TEST_ASSERT_EQUAL(RadioPresetId::Default, sel.update(t, s));
+  sel.on_applied(t, true);
+  TEST_ASSERT_EQUAL_UINT32(0, run_until_fast(sel, t, 2 * PresetSelector::kBackoffMinMs - 10000));
+}
+
+void test_max_dwell_returns_without_backoff_and_radio_refusal_backs_off() {
+  PresetSelector sel;
+  sel.configure(kFastCapable, p::kPosFullFrameSize, kBeaconIntervalMs);
+  uint32_t t = run_until_fast(sel, 0, 600000);
+  sel.on_applied(t, true);
+  const uint32_t switched = t;
+  for (t = switched + 10000; t < switched + PresetSelector::kMaxFastDwellMs; t += 10000) {
+    TEST_ASSERT_EQUAL(RadioPresetId::Fast, sel.update(t, close_pair(sel, t, false)));
+  }
+  TEST_ASSERT_EQUAL(RadioPresetId::Default, sel.update(t, close_pair(sel, t, false)));
+  sel.on_applied(t, false);  // radio busy: still on Fast, asked again
+  TEST_ASSERT_EQUAL(RadioPresetId::Fast, sel.active());
+  TEST_ASSERT_EQUAL(RadioPresetId::Default, sel.update(t + 10000, close_pair(sel, t + 10000, false)));
+  sel.on_applied(t + 10000, true);
+  // Rendezvous, not a failure: re-votes at once.
+  const uint32_t again = run_until_fast(sel, t + 20000, 600000);
+  TEST_ASSERT_EQUAL_UINT32(t + 20000 + PresetSelector::kUpHoldMs + PresetSelector::kAgreeHoldMs, again);
+  sel.on_applied(again, false);  // module did not verify Fast
+  TEST_ASSERT_EQUAL(RadioPresetId::Default, sel.active());
+  TEST_ASSERT_EQUAL_UINT32(0, run_until_fast(sel, again + 10000, PresetSelector::kBackoffMinMs - 20000));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_radio_caps_roundtrip_in_status);
+  RUN_TEST(test_reconfig_cost_and_payback);
+  RUN_TEST(test_votes_after_hold_and_switches_on_agreement);
+  RUN_TEST(test_unknown_caps_or_weak_link_blocks_vote);
+  RUN_TEST(test_fallback_on_weak_link_backs_off_and_doubles);
+  RUN_TEST(test_max_dwell_returns_without_backoff_and_radio_refusal_backs_off);
+  return UNITY_END();
+}
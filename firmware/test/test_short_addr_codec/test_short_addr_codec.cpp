@@ -0,0 +1,98 @@
+/**
+ * Short addressing: compact / peek / expand of the 3-byte tag + short_id prefix on any v0.2 frame.
+ * Codec-only; TX cadence and RX resolution through the NodeTable stay in test_beacon_logic.
+ */
+#include <unity.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include "../../protocol/pos_full_codec.h"
+#include "../../protocol/pos_full_codec.cpp"
+#include "../../protocol/short_addr_codec.h"
+#include "../../protocol/short_addr_codec.cpp"
+
+using naviga::protocol::kPosFullFrameSize;
+using naviga::protocol::kShortAddrSavedBytes;
+
+namespace {
+
+size_t make_pos_full(uint64_t node_id, uint16_t seq16, uint8_t* out, size_t out_cap) {
+  naviga::protocol::PosFullFields pos{};
+  pos.node_id = node_id;
+  pos.seq16 = seq16;
+  pos.lat_e7 = 550000000;
+  pos.lon_e7 = 370000000;
+  return naviga::protocol::encode_pos_full_frame(pos, out, out_cap);
+}
+
+} // namespace
+
+void test_short_addr_compact_peek_expand_round_trip() {
+  namespace p = naviga::protocol;
+  const uint64_t node_id = 0x0000AABBCCDDEEFFULL;
+  uint8_t full[p::kMaxFrameSize] = {};
+  TEST_ASSERT_EQUAL(kPosFullFrameSize, make_pos_full(node_id, 0x0102, full, sizeof(full)));
+  TEST_ASSERT_FALSE(p::is_short_addr_payload(full + 2, kPosFullFrameSize - 2));
+
+  // flag | tag, short_id LE, then the payload from seq16 on.
+  uint8_t compact[p::kMaxFrameSize] = {};
+  const size_t len = p::short_addr_compact(full, kPosFullFrameSize, 0x1234, compact, sizeof(compact));
+  TEST_ASSERT_EQUAL(kPosFullFrameSize - kShortAddrSavedBytes, len);
+  p::PacketHeader hdr{};
+  TEST_ASSERT_TRUE(p::decode_header(compact, len, &hdr));
+  TEST_ASSERT_TRUE(hdr.msg_type == p::MsgType::BeaconPosFull);
+  TEST_ASSERT_EQUAL_UINT8(len - 2, hdr.payload_len);
+  TEST_ASSERT_EQUAL_UINT8(0x80 | 0x7F, compact[2]);
+  TEST_ASSERT_EQUAL_UINT8(0x34, compact[3]);
+  TEST_ASSERT_EQUAL_UINT8(0x12, compact[4]);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(full + 9, compact + 5, kPosFullFrameSize - 9);
+  TEST_ASSERT_TRUE(p::is_short_addr_payload(compact + 2, len - 2));
+
+  uint16_t short_id = 0;
+  uint8_t tag = 0;
+  TEST_ASSERT_TRUE(p::short_addr_peek(compact + 2, len - 2, &short_id, &tag));
+  TEST_ASSERT_EQUAL_UINT16(0x1234, short_id);
+  TEST_ASSERT_EQUAL_UINT8(p::short_addr_tag(node_id), tag);
+  TEST_ASSERT_FALSE(p::short_addr_peek(full + 2, kPosFullFrameSize - 2, &short_id, &tag));
+
+  uint8_t expanded[p::kMaxFrameSize] = {};
+  TEST_ASSERT_EQUAL(kPosFullFrameSize,
+                    p::short_addr_expand(compact, len, node_id, expanded, sizeof(expanded)));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(full, expanded, kPosFullFrameSize);
+
+  // In place: out may alias the frame.
+  uint8_t in_place[p::kMaxFrameSize] = {};
+  std::memcpy(in_place, full, kPosFullFrameSize);
+  TEST_ASSERT_EQUAL(len, p::short_addr_compact(in_place, kPosFullFrameSize, 0x1234, in_place,
+                                               sizeof(in_place)));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(compact, in_place, len);
+}
+
+void test_short_addr_rejects_wrong_addressing_and_small_buffers() {
+  namespace p = naviga::protocol;
+  const uint64_t node_id = 0x0000AABBCCDDEE11ULL;
+  uint8_t full[p::kMaxFrameSize] = {};
+  TEST_ASSERT_EQUAL(kPosFullFrameSize, make_pos_full(node_id, 7, full, sizeof(full)));
+  uint8_t compact[p::kMaxFrameSize] = {};
+  const size_t len = p::short_addr_compact(full, kPosFullFrameSize, 0xBEEF, compact, sizeof(compact));
+  TEST_ASSERT_EQUAL(kPosFullFrameSize - kShortAddrSavedBytes, len);
+
+  uint8_t out[p::kMaxFrameSize] = {};
+  // Already short-addressed / still full-id.
+  TEST_ASSERT_EQUAL(0u, p::short_addr_compact(compact, len, 0xBEEF, out, sizeof(out)));
+  TEST_ASSERT_EQUAL(0u, p::short_addr_expand(full, kPosFullFrameSize, node_id, out, sizeof(out)));
+  // Output too small, or expand onto its own input.
+  TEST_ASSERT_EQUAL(0u, p::short_addr_compact(full, kPosFullFrameSize, 0xBEEF, out, len - 1));
+  TEST_ASSERT_EQUAL(0u, p::short_addr_expand(compact, len, node_id, out, kPosFullFrameSize - 1));
+  TEST_ASSERT_EQUAL(0u, p::short_addr_expand(compact, len, node_id, compact, sizeof(compact)));
+  // Header payload_len disagreeing with the frame length.
+  TEST_ASSERT_EQUAL(0u, p::short_addr_expand(compact, len - 1, node_id, out, sizeof(out)));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_short_addr_compact_peek_expand_round_trip);
+  RUN_TEST(test_short_addr_rejects_wrong_addressing_and_small_buffers);
+  return UNITY_END();
+}
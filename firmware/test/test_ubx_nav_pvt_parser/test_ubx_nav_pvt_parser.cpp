@@ -1,19 +1,41 @@
 #include <unity.h>
 
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
 #include "../../src/services/ubx_nav_pvt_parser.h"
 #include "../../src/services/ubx_nav_pvt_parser.cpp"
 
+using naviga::GnssSnapshot;
+using naviga::GNSSFixState;
 using naviga::UbxFrameView;
+using naviga::UbxNavPvt;
 using naviga::UbxParseStatus;
 using naviga::UbxStreamParser;
+using naviga::apply_nav_pvt;
+using naviga::parse_nav_pvt;
 using naviga::parse_nav_pvt_fix_lat_lon;
+using naviga::parse_nav_pvt_itow;
 
 namespace {
 
-std::vector<uint8_t> make_nav_pvt_frame(uint8_t fix_type, int32_t lat_e7, int32_t lon_e7) {
+void put_u32_le(std::vector<uint8_t>* payload, size_t off, uint32_t v) {
+  for (size_t i = 0; i < 4; ++i) {
+    (*payload)[off + i] = static_cast<uint8_t>((v >> (8 * i)) & 0xFF);
+  }
+}
+
+struct PvtQuality {
+  uint8_t flags;
+  uint8_t num_sv;
+  uint32_t h_acc_mm;
+  int32_t g_speed_mm_s;
+};
+
+std::vector<uint8_t> make_nav_pvt_frame(uint8_t fix_type, int32_t lat_e7, int32_t lon_e7,
+                                        uint32_t itow_ms = 0, uint8_t valid = 0,
+                                        PvtQuality quality = PvtQuality{0x01, 0, 0, 0}) {
   std::vector<uint8_t> frame;
   frame.reserve(2 + 4 + UbxStreamParser::kNavPvtPayloadLen + 2);
   frame.push_back(UbxStreamParser::kSync1);
@@ -24,6 +46,11 @@ std::vector<uint8_t> make_nav_pvt_frame(uint8_t fix_type, int32_t lat_e7, int32_
   frame.push_back(static_cast<uint8_t>((UbxStreamParser::kNavPvtPayloadLen >> 8) & 0xFF));
 
   std::vector<uint8_t> payload(UbxStreamParser::kNavPvtPayloadLen, 0);
+  payload[0] = static_cast<uint8_t>(itow_ms & 0xFF);
+  payload[1] = static_cast<uint8_t>((itow_ms >> 8) & 0xFF);
+  payload[2] = static_cast<uint8_t>((itow_ms >> 16) & 0xFF);
+  payload[3] = static_cast<uint8_t>((itow_ms >> 24) & 0xFF);
+  payload[11] = valid;
   payload[20] = fix_type;
   payload[24] = static_cast<uint8_t>(lon_e7 & 0xFF);
   payload[25] = static_cast<uint8_t>((lon_e7 >> 8) & 0xFF);
@@ -33,6 +60,10 @@ std::vector<uint8_t> make_nav_pvt_frame(uint8_t fix_type, int32_t lat_e7, int32_
   payload[29] = static_cast<uint8_t>((lat_e7 >> 8) & 0xFF);
   payload[30] = static_cast<uint8_t>((lat_e7 >> 16) & 0xFF);
   payload[31] = static_cast<uint8_t>((lat_e7 >> 24) & 0xFF);
+  payload[21] = quality.flags;
+  payload[23] = quality.num_sv;
+  put_u32_le(&payload, 40, quality.h_acc_mm);
+  put_u32_le(&payload, 60, static_cast<uint32_t>(quality.g_speed_mm_s));
 
   uint8_t ck_a = 0;
   uint8_t ck_b = 0;
@@ -88,9 +119,166 @@ void test_parse_nav_pvt_bad_checksum() {
   TEST_ASSERT_EQUAL(static_cast<int>(UbxParseStatus::FrameBadChecksum), static_cast<int>(status));
 }
 
+void test_parse_nav_pvt_itow_requires_valid_time() {
+  const uint32_t itow = 345600123;  // Thursday
+  for (uint8_t valid : {static_cast<uint8_t>(0x00), static_cast<uint8_t>(0x07)}) {
+    std::vector<uint8_t> bytes = make_nav_pvt_frame(3, 1, 2, itow, valid);
+    UbxStreamParser parser;
+    UbxFrameView frame{};
+    for (uint8_t b : bytes) {
+      parser.push_byte(b, &frame);
+    }
+    uint32_t out = 0;
+    TEST_ASSERT_EQUAL(valid != 0, parse_nav_pvt_itow(frame, &out));
+    TEST_ASSERT_EQUAL_UINT32(valid != 0 ? itow : 0u, out);
+  }
+}
+
+UbxFrameView push_frame(UbxStreamParser* parser, const std::vector<uint8_t>& bytes) {
+  UbxFrameView frame{};
+  for (uint8_t b : bytes) {
+    parser->push_byte(b, &frame);
+  }
+  return frame;
+}
+
+void test_parse_nav_pvt_quality_fields() {
+  UbxStreamParser parser;
+  const UbxFrameView frame = push_frame(
+      &parser, make_nav_pvt_frame(3, 571844000, 383663000, 1000, 0x07, PvtQuality{0x01, 11, 4200, 1350}));
+  UbxNavPvt pvt;
+  TEST_ASSERT_TRUE(parse_nav_pvt(frame, &pvt));
+  TEST_ASSERT_EQUAL_UINT32(1000, pvt.itow_ms);
+  TEST_ASSERT_EQUAL_UINT8(0x07, pvt.valid);
+  TEST_ASSERT_EQUAL_UINT8(3, pvt.fix_type);
+  TEST_ASSERT_EQUAL_UINT8(0x01, pvt.flags);
+  TEST_ASSERT_EQUAL_UINT8(11, pvt.num_sv);
+  TEST_ASSERT_EQUAL_INT32(571844000, pvt.lat_e7);
+  TEST_ASSERT_EQUAL_INT32(383663000, pvt.lon_e7);
+  TEST_ASSERT_EQUAL_UINT32(4200, pvt.h_acc_mm);
+  TEST_ASSERT_EQUAL_INT32(1350, pvt.g_speed_mm_s);
+
+  GnssSnapshot snap{};
+  apply_nav_pvt(pvt, 5000, &snap);
+  TEST_ASSERT_TRUE(snap.pos_valid);
+  TEST_ASSERT_EQUAL(static_cast<int>(GNSSFixState::FIX_3D), static_cast<int>(snap.fix_state));
+  TEST_ASSERT_TRUE(snap.quality_valid);
+  TEST_ASSERT_EQUAL_UINT8(11, snap.num_sv);
+  TEST_ASSERT_EQUAL_UINT32(4200, snap.h_acc_mm);
+  TEST_ASSERT_EQUAL_UINT32(1350, snap.g_speed_mm_s);
+  TEST_ASSERT_EQUAL_UINT32(5000, snap.last_fix_ms);
+  TEST_ASSERT_TRUE(snap.time_valid);
+  TEST_ASSERT_EQUAL_UINT32(1000, snap.tow_ms);
+}
+
+void test_apply_nav_pvt_requires_gnss_fix_ok() {
+  // A 3D solution without gnssFixOK, and a time-only solution, are no fix; position is kept.
+  const struct {
+    uint8_t fix_type;
+    uint8_t flags;
+    bool pos_valid;
+  } cases[] = {{3, 0x01, true}, {3, 0x00, false}, {5, 0x01, false}, {2, 0x01, true}, {4, 0x01, true}};
+  for (const auto& c : cases) {
+    UbxStreamParser parser;
+    const UbxFrameView frame =
+        push_frame(&parser, make_nav_pvt_frame(c.fix_type, 2, 3, 0, 0, PvtQuality{c.flags, 6, 30000, 0}));
+    UbxNavPvt pvt;
+    TEST_ASSERT_TRUE(parse_nav_pvt(frame, &pvt));
+    GnssSnapshot snap{};
+    snap.lat_e7 = 7;
+    snap.last_fix_ms = 100;
+    apply_nav_pvt(pvt, 2000, &snap);
+    TEST_ASSERT_EQUAL(c.pos_valid, snap.pos_valid);
+    TEST_ASSERT_EQUAL_INT32(c.pos_valid ? 2 : 7, snap.lat_e7);
+    TEST_ASSERT_EQUAL_UINT32(c.pos_valid ? 2000u : 100u, snap.last_fix_ms);
+    TEST_ASSERT_EQUAL_UINT32(30000, snap.h_acc_mm);
+  }
+}
+
+struct ParsedFrame {
+  UbxParseStatus status;
+  int32_t lat_e7;
+};
+
+std::vector<ParsedFrame> parse_stream_bytewise(const std::vector<uint8_t>& stream) {
+  std::vector<ParsedFrame> out;
+  UbxStreamParser parser;
+  for (uint8_t b : stream) {
+    UbxFrameView frame{};
+    const UbxParseStatus st = parser.push_byte(b, &frame);
+    if (st != UbxParseStatus::None) {
+      UbxNavPvt pvt;
+      out.push_back({st, st == UbxParseStatus::FrameOk && parse_nav_pvt(frame, &pvt) ? pvt.lat_e7 : 0});
+    }
+  }
+  return out;
+}
+
+std::vector<ParsedFrame> parse_stream_blocks(const std::vector<uint8_t>& stream, size_t chunk) {
+  std::vector<ParsedFrame> out;
+  UbxStreamParser parser;
+  for (size_t start = 0; start < stream.size(); start += chunk) {
+    const size_t len = stream.size() - start < chunk ? stream.size() - start : chunk;
+    size_t off = 0;
+    while (off < len) {
+      UbxFrameView frame{};
+      UbxParseStatus st = UbxParseStatus::None;
+      const size_t used = parser.push_bytes(stream.data() + start + off, len - off, &frame, &st);
+      if (used == 0) {
+        return out;  // stalled: the frame count check fails
+      }
+      off += used;
+      if (st != UbxParseStatus::None) {
+        UbxNavPvt pvt;
+        out.push_back({st, st == UbxParseStatus::FrameOk && parse_nav_pvt(frame, &pvt) ? pvt.lat_e7 : 0});
+      }
+    }
+  }
+  return out;
+}
+
+void test_push_bytes_matches_push_byte() {
+  // NMEA chatter, stray sync bytes, a doubled sync, sync bytes inside a payload, a bad checksum
+  // and an oversized length, around valid NAV-PVT frames.
+  std::vector<uint8_t> stream;
+  auto append = [&stream](const std::vector<uint8_t>& bytes) {
+    stream.insert(stream.end(), bytes.begin(), bytes.end());
+  };
+  const char* nmea = "$GNGGA,123519,5544.000,N,03736.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+  append(std::vector<uint8_t>(nmea, nmea + std::strlen(nmea)));
+  append(make_nav_pvt_frame(3, 0x62B50001, 10));
+  append({0xB5, 0x00, 0xB5});
+  append(make_nav_pvt_frame(3, 2, 20));
+  std::vector<uint8_t> bad = make_nav_pvt_frame(3, 3, 30);
+  bad.back() ^= 0x5A;
+  append(bad);
+  append({0xB5, 0x62, 0x01, 0x07, 0xC8, 0x00});  // 200-byte payload: over kMaxPayloadLen
+  append(make_nav_pvt_frame(2, 4, 40));
+  append(std::vector<uint8_t>(nmea, nmea + std::strlen(nmea)));
+  append(make_nav_pvt_frame(3, 5, 50));
+
+  const std::vector<ParsedFrame> expect = parse_stream_bytewise(stream);
+  TEST_ASSERT_EQUAL(5, static_cast<int>(expect.size()));
+  TEST_ASSERT_EQUAL_INT32(0x62B50001, expect[0].lat_e7);
+  TEST_ASSERT_EQUAL(static_cast<int>(UbxParseStatus::FrameBadChecksum), static_cast<int>(expect[2].status));
+  for (size_t chunk : {static_cast<size_t>(1), static_cast<size_t>(3), static_cast<size_t>(7),
+                       static_cast<size_t>(64), stream.size()}) {
+    const std::vector<ParsedFrame> got = parse_stream_blocks(stream, chunk);
+    TEST_ASSERT_EQUAL(static_cast<int>(expect.size()), static_cast<int>(got.size()));
+    for (size_t i = 0; i < expect.size(); ++i) {
+      TEST_ASSERT_EQUAL(static_cast<int>(expect[i].status), static_cast<int>(got[i].status));
+      TEST_ASSERT_EQUAL_INT32(expect[i].lat_e7, got[i].lat_e7);
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   UNITY_BEGIN();
   RUN_TEST(test_parse_nav_pvt_valid_frame);
   RUN_TEST(test_parse_nav_pvt_bad_checksum);
+  RUN_TEST(test_parse_nav_pvt_itow_requires_valid_time);
+  RUN_TEST(test_parse_nav_pvt_quality_fields);
+  RUN_TEST(test_apply_nav_pvt_requires_gnss_fix_ok);
+  RUN_TEST(test_push_bytes_matches_push_byte);
   return UNITY_END();
 }
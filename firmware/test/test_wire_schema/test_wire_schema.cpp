@@ -0,0 +1,341 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include "../../protocol/wire_schema.h"
+#include "../../protocol/alive_codec.h"
+#include "../../protocol/info_codec.h"
+#include "../../protocol/pos_delta_codec.h"
+#include "../../protocol/pos_delta_codec.cpp"
+#include "../../protocol/pos_full_codec.h"
+#include "../../protocol/pos_full_codec.cpp"
+#include "../../protocol/status_codec.h"
+#include "../../protocol/status_codec.cpp"
+#include "../../protocol/tail1_codec.h"
+#include "../../protocol/tail2_codec.h"
+
+namespace p = naviga::protocol;
+namespace wire = naviga::protocol::wire;
+
+namespace {
+
+struct Sample {
+  uint8_t a = 0;
+  uint16_t b = 0;
+  uint8_t c = 0;
+  uint64_t d = 0;
+};
+
+// 1 + 3 + 10 + 3 + 40 + 7 = 64 bits: fields straddle byte boundaries in both directions.
+typedef wire::Layout<1,
+    wire::Const<3, 5>,
+    wire::Field<Sample, uint8_t, &Sample::a, 1>,
+    wire::Field<Sample, uint16_t, &Sample::b, 10>,
+    wire::Field<Sample, uint8_t, &Sample::c, 3>,
+    wire::Field<Sample, uint64_t, &Sample::d, 40>,
+    wire::Const<7, 0>>
+    SampleWire;
+
+constexpr uint64_t kNodeId = 0x0000AABBCCDDEEFFULL;
+
+void assert_frame(const uint8_t* expected, size_t expected_len, const uint8_t* frame,
+                  size_t len) {
+  TEST_ASSERT_EQUAL_UINT32(expected_len, len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, frame, expected_len);
+}
+
+} // namespace
+
+void test_layout_sizes() {
+  TEST_ASSERT_EQUAL_UINT32(1, SampleWire::kOffset);
+  TEST_ASSERT_EQUAL_UINT32(8, SampleWire::kSize);
+  TEST_ASSERT_EQUAL_UINT32(9, SampleWire::kEnd);
+  TEST_ASSERT_EQUAL_UINT32(17, p::kPosFullPayloadSize);
+  TEST_ASSERT_EQUAL_UINT32(19, p::kStatusPayloadSize);
+  TEST_ASSERT_EQUAL_UINT32(20, p::StatusRadioCapsWire::kEnd);
+  TEST_ASSERT_EQUAL_UINT32(10, p::kTail2OffsetUptime);
+}
+
+void test_layout_packs_lsb_first() {
+  Sample in;
+  in.a = 1;
+  in.b = 0x2D5;
+  in.c = 6;
+  in.d = 0x123456789AULL;
+  uint8_t buf[10];
+  memset(buf, 0xEE, sizeof(buf));
+  SampleWire::encode(in, buf);
+
+  // Bits from 0: const 101, a 1, b 1011010101, c 110, d 0x123456789A, const 0000000.
+  const uint64_t w = 5ull | (1ull << 3) | (0x2D5ull << 4) | (6ull << 14) |
+                     (0x123456789Aull << 17);
+  TEST_ASSERT_EQUAL_HEX8(0xEE, buf[0]);  // before Offset: untouched
+  for (size_t i = 0; i < 8; ++i) {
+    TEST_ASSERT_EQUAL_HEX8(static_cast<uint8_t>(w >> (8 * i)), buf[1 + i]);
+  }
+  TEST_ASSERT_EQUAL_HEX8(0xEE, buf[9]);  // after kEnd: untouched
+
+  Sample out;
+  TEST_ASSERT_TRUE(SampleWire::valid(buf));
+  SampleWire::decode(buf, &out);
+  TEST_ASSERT_EQUAL_UINT8(in.a, out.a);
+  TEST_ASSERT_EQUAL_HEX16(in.b, out.b);
+  TEST_ASSERT_EQUAL_UINT8(in.c, out.c);
+  TEST_ASSERT_EQUAL_HEX64(in.d, out.d);
+}
+
+void test_layout_masks_wide_values() {
+  Sample in;
+  in.a = 0xFE;     // low bit 0
+  in.b = 0xFFFF;   // 10 bits kept
+  in.c = 0x0F;     // 3 bits kept
+  in.d = ~0ull;    // 40 bits kept
+  uint8_t buf[9] = {};
+  SampleWire::encode(in, buf);
+  TEST_ASSERT_TRUE(SampleWire::valid(buf));
+
+  Sample out;
+  SampleWire::decode(buf, &out);
+  TEST_ASSERT_EQUAL_UINT8(0, out.a);
+  TEST_ASSERT_EQUAL_HEX16(0x3FF, out.b);
+  TEST_ASSERT_EQUAL_UINT8(7, out.c);
+  TEST_ASSERT_EQUAL_HEX64(0xFFFFFFFFFFULL, out.d);
+  TEST_ASSERT_EQUAL_HEX8(0x01, buf[8]);  // top bit of d, then the zero constant
+}
+
+void test_layout_valid_checks_constants() {
+  Sample in;
+  uint8_t buf[9] = {};
+  SampleWire::encode(in, buf);
+  TEST_ASSERT_TRUE(SampleWire::valid(buf));
+  buf[1] ^= 0x01;  // first constant
+  TEST_ASSERT_FALSE(SampleWire::valid(buf));
+  buf[1] ^= 0x01;
+  buf[8] ^= 0x80;  // last constant
+  TEST_ASSERT_FALSE(SampleWire::valid(buf));
+  buf[8] ^= 0x80;
+  buf[5] ^= 0xFF;  // member bits only
+  TEST_ASSERT_TRUE(SampleWire::valid(buf));
+}
+
+// Golden frames below were produced by the handwritten codecs the schemas replaced.
+
+void test_pos_full_golden() {
+  p::PosFullFields in;
+  in.node_id = kNodeId;
+  in.seq16 = 0x1234;
+  in.lat_e7 = 557558000;
+  in.lon_e7 = 376173000;
+  in.fix_type = 2;
+  in.pos_sats = 11;
+  in.pos_accuracy_bucket = 5;
+  in.pos_flags_small = 0xA;
+  const uint8_t expected[] = {0x11, 0x0C, 0x00, 0xFF, 0xEE, 0xDD, 0xCC, 0xBB, 0xAA, 0x34,
+                              0x12, 0x10, 0x4C, 0xCF, 0x05, 0xC0, 0x9A, 0x5A, 0xAA};
+  uint8_t frame[32];
+  memset(frame, 0x55, sizeof(frame));
+  assert_frame(expected, sizeof(expected), frame, p::encode_pos_full_frame(in, frame, sizeof(frame)));
+
+  p::PosFullFields out;
+  TEST_ASSERT_EQUAL(p::PosFullDecodeError::Ok,
+                    p::decode_pos_full_payload(frame + p::kHeaderSize, p::kPosFullPayloadSize, &out));
+  TEST_ASSERT_EQUAL_HEX64(kNodeId, out.node_id);
+  TEST_ASSERT_EQUAL_UINT16(0x1234, out.seq16);
+  TEST_ASSERT_INT32_WITHIN(100, in.lat_e7, out.lat_e7);
+  TEST_ASSERT_INT32_WITHIN(200, in.lon_e7, out.lon_e7);
+  TEST_ASSERT_EQUAL_UINT8(2, out.fix_type);
+  TEST_ASSERT_EQUAL_UINT8(11, out.pos_sats);
+  TEST_ASSERT_EQUAL_UINT8(5, out.pos_accuracy_bucket);
+  TEST_ASSERT_EQUAL_UINT8(0xA, out.pos_flags_small);
+
+  frame[p::kHeaderSize] = 0x01;
+  TEST_ASSERT_EQUAL(p::PosFullDecodeError::BadPayloadVersion,
+                    p::decode_pos_full_payload(frame + p::kHeaderSize, p::kPosFullPayloadSize, &out));
+}
+
+void test_status_golden() {
+  p::StatusFields in;
+  in.node_id = kNodeId;
+  in.seq16 = 0x0102;
+  in.battery_percent = 87;
+  in.battery_est_rem_time = 12;
+  in.tx_power_ch_throttle = 0x31;
+  in.uptime10m = 200;
+  in.role_id = 2;
+  in.max_silence_10s = 9;
+  in.hw_profile_id = 0x0203;
+  in.fw_version_id = 0x0405;
+  const uint8_t expected[] = {0x13, 0x0E, 0x00, 0xFF, 0xEE, 0xDD, 0xCC, 0xBB, 0xAA, 0x02, 0x01,
+                              0x57, 0x0C, 0x31, 0xC8, 0x02, 0x09, 0x03, 0x02, 0x05, 0x04};
+  uint8_t frame[32];
+  assert_frame(expected, sizeof(expected), frame, p::encode_status_frame(in, frame, sizeof(frame)));
+
+  in.radio_caps = 0x2B;
+  const uint8_t expected_caps[] = {0x14, 0x0E, 0x00, 0xFF, 0xEE, 0xDD, 0xCC, 0xBB,
+                                   0xAA, 0x02, 0x01, 0x57, 0x0C, 0x31, 0xC8, 0x02,
+                                   0x09, 0x03, 0x02, 0x05, 0x04, 0x2B};
+  assert_frame(expected_caps, sizeof(expected_caps), frame,
+               p::encode_status_frame(in, frame, sizeof(frame)));
+
+  p::StatusFields out;
+  TEST_ASSERT_EQUAL(p::StatusDecodeError::Ok,
+                    p::decode_status_payload(frame + p::kHeaderSize, 20, &out));
+  TEST_ASSERT_EQUAL_UINT8(87, out.battery_percent);
+  TEST_ASSERT_EQUAL_HEX16(0x0405, out.fw_version_id);
+  TEST_ASSERT_EQUAL_HEX8(0x2B, out.radio_caps);
+  TEST_ASSERT_EQUAL(p::StatusDecodeError::Ok,
+                    p::decode_status_payload(frame + p::kHeaderSize, 19, &out));
+  TEST_ASSERT_EQUAL_HEX8(0, out.radio_caps);
+}
+
+void test_pos_delta_golden() {
+  p::PosDeltaFields in;
+  in.node_id = kNodeId;
+  in.seq16 = 0xBEEF;
+  in.ref_seq8 = 0xE0;
+  in.lat_lsb = 0xABC;
+  in.lon_lsb = 0x123;
+  const uint8_t expected[] = {0x0D, 0x12, 0x00, 0xFF, 0xEE, 0xDD, 0xCC, 0xBB,
+                              0xAA, 0xEF, 0xBE, 0xE0, 0xBC, 0x3A, 0x12};
+  uint8_t frame[32];
+  assert_frame(expected, sizeof(expected), frame, p::encode_pos_delta_frame(in, frame, sizeof(frame)));
+
+  p::PosDeltaFields out;
+  TEST_ASSERT_EQUAL(p::PosDeltaDecodeError::Ok,
+                    p::decode_pos_delta_payload(frame + p::kHeaderSize, p::kPosDeltaPayloadSize, &out));
+  TEST_ASSERT_EQUAL_HEX8(0xE0, out.ref_seq8);
+  TEST_ASSERT_EQUAL_HEX16(0xABC, out.lat_lsb);
+  TEST_ASSERT_EQUAL_HEX16(0x123, out.lon_lsb);
+}
+
+void test_tail_and_info_golden() {
+  uint8_t frame[32];
+
+  p::Tail1Fields t1;
+  t1.node_id = kNodeId;
+  t1.seq16 = 0x0010;
+  t1.ref_core_seq16 = 0x000F;
+  t1.has_pos_flags = true;
+  t1.pos_flags = 0x05;
+  t1.has_sats = true;
+  t1.sats = 9;
+  const uint8_t tail1[] = {0x0D, 0x06, 0x00, 0xFF, 0xEE, 0xDD, 0xCC, 0xBB,
+                           0xAA, 0x10, 0x00, 0x0F, 0x00, 0x05, 0x09};
+  assert_frame(tail1, sizeof(tail1), frame, p::encode_tail1_frame(t1, frame, sizeof(frame)));
+
+  p::Tail2Fields t2;
+  t2.node_id = kNodeId;
+  t2.seq16 = 0x0011;
+  t2.has_battery = true;
+  t2.battery_percent = 77;
+  t2.has_uptime = true;
+  t2.uptime_sec = 0x01020304;
+  const uint8_t tail2[] = {0x0E, 0x08, 0x00, 0xFF, 0xEE, 0xDD, 0xCC, 0xBB,
+                           0xAA, 0x11, 0x00, 0x4D, 0x04, 0x03, 0x02, 0x01};
+  assert_frame(tail2, sizeof(tail2), frame, p::encode_tail2_frame(t2, frame, sizeof(frame)));
+
+  p::InfoFields info;
+  info.node_id = kNodeId;
+  info.seq16 = 0x0012;
+  info.has_max_silence = true;
+  info.max_silence_10s = 9;
+  info.has_hw_profile = true;
+  info.hw_profile_id = 0x0203;
+  info.has_fw_version = true;
+  info.fw_version_id = 0x0405;
+  const uint8_t expected_info[] = {0x0E, 0x0A, 0x00, 0xFF, 0xEE, 0xDD, 0xCC, 0xBB,
+                                   0xAA, 0x12, 0x00, 0x09, 0x03, 0x02, 0x05, 0x04};
+  assert_frame(expected_info, sizeof(expected_info), frame,
+               p::encode_info_frame(info, frame, sizeof(frame)));
+
+  // Truncated to maxSilence + hwProfile: fwVersion falls back to "not present".
+  p::InfoFields out;
+  TEST_ASSERT_EQUAL(p::InfoDecodeError::Ok,
+                    p::decode_info_payload(frame + p::kHeaderSize, p::kInfoSizeWithHwProfile, &out));
+  TEST_ASSERT_TRUE(out.has_hw_profile);
+  TEST_ASSERT_EQUAL_HEX16(0x0203, out.hw_profile_id);
+  TEST_ASSERT_FALSE(out.has_fw_version);
+  TEST_ASSERT_EQUAL_HEX16(0xFFFF, out.fw_version_id);
+}
+
+void test_views_read_fields_in_place() {
+  p::PosFullFields pos;
+  pos.node_id = kNodeId;
+  pos.seq16 = 0x1234;
+  pos.lat_e7 = -337000000;
+  pos.lon_e7 = 1512000000;
+  pos.fix_type = 3;
+  pos.pos_sats = 17;
+  pos.pos_accuracy_bucket = 6;
+  pos.pos_flags_small = 0x9;
+  uint8_t frame[32];
+  p::encode_pos_full_frame(pos, frame, sizeof(frame));
+  const uint8_t* payload = frame + p::kHeaderSize;
+
+  p::PosFullFields decoded;
+  TEST_ASSERT_EQUAL(p::PosFullDecodeError::Ok,
+                    p::decode_pos_full_payload(payload, p::kPosFullPayloadSize, &decoded));
+  const p::PosFullView view(payload, p::kPosFullPayloadSize);
+  TEST_ASSERT_TRUE(view.ok());
+  TEST_ASSERT_EQUAL_HEX64(kNodeId, view.node_id());
+  TEST_ASSERT_EQUAL_HEX16(0x1234, view.seq16());
+  TEST_ASSERT_EQUAL_INT32(decoded.lat_e7, view.lat_e7());
+  TEST_ASSERT_EQUAL_INT32(decoded.lon_e7, view.lon_e7());
+  const p::PosQuality q = view.quality();
+  TEST_ASSERT_EQUAL_UINT8(3, q.fix_type);
+  TEST_ASSERT_EQUAL_UINT8(17, q.pos_sats);
+  TEST_ASSERT_EQUAL_UINT8(6, q.pos_accuracy_bucket);
+  TEST_ASSERT_EQUAL_UINT8(0x9, q.pos_flags_small);
+
+  TEST_ASSERT_EQUAL(p::PosFullDecodeError::ShortBuffer,
+                    p::PosFullView(payload, p::kPosFullPayloadSize - 1).error());
+  TEST_ASSERT_EQUAL(p::PosFullDecodeError::ShortBuffer, p::PosFullView(nullptr, 32).error());
+  frame[p::kHeaderSize] = 0x01;
+  TEST_ASSERT_EQUAL(p::PosFullDecodeError::BadPayloadVersion,
+                    p::PosFullView(payload, p::kPosFullPayloadSize).error());
+
+  p::StatusFields st;
+  st.node_id = kNodeId;
+  st.seq16 = 0x0102;
+  st.battery_percent = 87;
+  st.battery_est_rem_time = 12;
+  st.tx_power_ch_throttle = 0x31;
+  st.uptime10m = 200;
+  st.role_id = 2;
+  st.max_silence_10s = 9;
+  st.hw_profile_id = 0x0203;
+  st.fw_version_id = 0x0405;
+  st.radio_caps = 0x2B;
+  p::encode_status_frame(st, frame, sizeof(frame));
+
+  const p::StatusView sv(payload, 20);
+  TEST_ASSERT_TRUE(sv.ok());
+  TEST_ASSERT_EQUAL_HEX64(kNodeId, sv.node_id());
+  TEST_ASSERT_EQUAL_HEX16(0x0102, sv.seq16());
+  TEST_ASSERT_EQUAL_UINT8(87, sv.battery_percent());
+  TEST_ASSERT_EQUAL_UINT8(12, sv.battery_est_rem_time());
+  TEST_ASSERT_EQUAL_HEX8(0x31, sv.tx_power_ch_throttle());
+  TEST_ASSERT_EQUAL_UINT8(200, sv.uptime10m());
+  TEST_ASSERT_EQUAL_UINT8(2, sv.role_id());
+  TEST_ASSERT_EQUAL_UINT8(9, sv.max_silence_10s());
+  TEST_ASSERT_EQUAL_HEX16(0x0203, sv.hw_profile_id());
+  TEST_ASSERT_EQUAL_HEX16(0x0405, sv.fw_version_id());
+  TEST_ASSERT_EQUAL_HEX8(0x2B, sv.radio_caps());
+  TEST_ASSERT_EQUAL_HEX8(0, p::StatusView(payload, 19).radio_caps());
+  TEST_ASSERT_EQUAL(p::StatusDecodeError::ShortBuffer, p::StatusView(payload, 18).error());
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_layout_sizes);
+  RUN_TEST(test_layout_packs_lsb_first);
+  RUN_TEST(test_layout_masks_wide_values);
+  RUN_TEST(test_layout_valid_checks_constants);
+  RUN_TEST(test_pos_full_golden);
+  RUN_TEST(test_status_golden);
+  RUN_TEST(test_pos_delta_golden);
+  RUN_TEST(test_tail_and_info_golden);
+  RUN_TEST(test_views_read_fields_in_place);
+  return UNITY_END();
+}